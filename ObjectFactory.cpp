@@ -3,50 +3,156 @@
 #include "helper/ObjectLoading/loadObj.hpp"
 #include "helper/Texture/CubeMap.hpp"
 #include "helper/Texture/Texture.hpp"
+#include "helper/Texture/BlockCompression.hpp"
+#include "helper/Texture/Ktx2Texture.hpp"
 #include <vulkan/vulkan_core.h>
+#include <chrono>
+#include <iomanip>
+
+namespace {
+    template<typename T>
+    bool isReady(const std::shared_future<T>& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+}
+
+// ------------------------------------------------------------
+// Synchrone Varianten: gleiche Arbeit wie die Async-Versionen, nur sofort abgewartet
+// ------------------------------------------------------------
 
 RenderObject ObjectFactory::createGenericObject(const char* modelPath,
                                          const char* vertShaderPath,
                                          const char* fragShaderPath,
                                          const char* texturePath,
-                                         const glm::mat4& modelMatrix, 
                                          VkRenderPass renderPass,
                                          PipelineType type,
-                                        uint32_t subpassIndex)
+                                        uint32_t subpassIndex,
+                                        VertexFormat format)
 {
-    GraphicsPipeline* pipeline = new GraphicsPipeline(
-        _device,
-        _colorFormat,
-        _depthFormat,
-        vertShaderPath, 
-        fragShaderPath,
-        renderPass,
-        _descriptorSetLayout,
-        type,
-        subpassIndex
-    );
+    return createGenericObjectAsync(modelPath, vertShaderPath, fragShaderPath, texturePath,
+                                    renderPass, type, subpassIndex, format).get();
+}
 
-    std::vector<Vertex> vertices;
-    _loader.objLoader(modelPath, vertices);
+RenderObject ObjectFactory::createSkybox(VkRenderPass renderPass, const std::array<const char*, 6>& cubemapFaces) {
+    return createSkyboxAsync(renderPass, cubemapFaces).get();
+}
 
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device, _commandPool, _graphicsQueue, vertices);
+RenderObject ObjectFactory::createSnowflake(const char* texturePath, 
+                                           VkRenderPass renderPass,
+                                           VkBuffer particleBuffer, 
+                                           VkDescriptorSetLayout snowDescriptorSetLayout) {
+    return createSnowflakeAsync(texturePath, renderPass, particleBuffer, snowDescriptorSetLayout).get();
+}
 
-    Texture* tex = new Texture(_physicalDevice, _device, _commandPool, _graphicsQueue, texturePath);
+LightSourceObject ObjectFactory::createLightSource(const glm::vec3& position,
+                                                const glm::vec3& color,
+                                                float intensity,
+                                                float radius,
+                                                VkRenderPass renderPass) {
+    return createLightSourceAsync(position, color, intensity, radius, renderPass).get();
+}
 
-    RenderObject obj{};
-    obj.vertexBuffer = vertexBuffer;
-    obj.vertexCount = static_cast<uint32_t>(vertices.size());
-    obj.textureImageView = tex->getImageView();
-    obj.textureSampler = tex->getSampler();
-    obj.pipeline = pipeline;
-    obj.modelMatrix = modelMatrix;
-    obj.texture = tex;
+RenderObject ObjectFactory::createLitObject(const char* modelPath,
+                                          const char* texturePath,
+                                          VkRenderPass renderPass,
+                                          VertexFormat format) {
+    return createLitObjectAsync(modelPath, texturePath, renderPass, format).get();
+}
 
-    return obj;
+DeferredRenderObject ObjectFactory::createDeferredObject(const char* modelPath,const char* texturePath,VkRenderPass renderPass,VertexFormat format){
+    return createDeferredObjectAsync(modelPath, texturePath, renderPass, format).get();
 }
 
+RenderObject ObjectFactory::createReflectiveObject(
+    const char* modelPath,
+    ReflectionProbe* probe,
+    VkRenderPass renderPass,
+    VertexFormat format)
+{
+    return createReflectiveObjectAsync(modelPath, probe, renderPass, format).get();
+}
 
-RenderObject ObjectFactory::createSkybox(VkRenderPass renderPass, const std::array<const char*, 6>& cubemapFaces) {
+// ------------------------------------------------------------
+// Asynchrone Varianten
+// ------------------------------------------------------------
+
+AssetHandle<RenderObject> ObjectFactory::createGenericObjectAsync(const char* modelPath,
+                                                                  const char* vertShaderPath,
+                                                                  const char* fragShaderPath,
+                                                                  const char* texturePath,
+                                                                  VkRenderPass renderPass,
+                                                                  PipelineType type,
+                                                                  uint32_t subpassIndex,
+                                                                  VertexFormat format)
+{
+    auto mesh = loadMeshAsync(modelPath, format);
+    auto image = loadImageAsync(texturePath);
+    std::string texture(texturePath);
+    std::string vertShader(vertShaderPath);
+    std::string fragShader(fragShaderPath);
+
+    return enqueueGpuJob<RenderObject>(
+        [mesh, image]() { return isReady(mesh) && isReady(image); },
+        [=]() {
+            GraphicsPipeline* pipeline = new GraphicsPipeline(
+                _device,
+                _colorFormat,
+                _depthFormat,
+                shaderPath(vertShader).c_str(),
+                shaderPath(fragShader).c_str(),
+                renderPass,
+                _descriptorSetLayout,
+                type,
+                subpassIndex,
+                format,
+                _textureSetLayout
+            );
+
+            std::shared_ptr<Texture> tex = acquireTexture(texture, image);
+
+            RenderObject obj{};
+            uploadMesh(mesh.get(), obj);
+            obj.textureImageView = tex->getImageView();
+            obj.textureSampler = tex->getSampler();
+            obj.pipeline = pipeline;
+            obj.texture = tex;
+            return obj;
+        });
+}
+
+AssetHandle<RenderObject> ObjectFactory::createSkyboxAsync(VkRenderPass renderPass, const std::array<const char*, 6>& cubemapFaces) {
+    // Alle 6 Faces parallel dekodieren
+    std::array<std::shared_future<ImageData>, 6> faces;
+    for (size_t i = 0; i < faces.size(); ++i) {
+        faces[i] = loadImageAsync(cubemapFaces[i]);
+    }
+
+    return enqueueGpuJob<RenderObject>(
+        [faces]() {
+            for (const auto& face : faces) {
+                if (!isReady(face)) return false;
+            }
+            return true;
+        },
+        [=]() {
+            std::array<ImageData, 6> images;
+            for (size_t i = 0; i < faces.size(); ++i) {
+                images[i] = faces[i].get();
+            }
+            return buildSkybox(renderPass, images);
+        });
+}
+
+AssetHandle<RenderObject> ObjectFactory::createSkyboxAsync(VkRenderPass renderPass, const char* cubemapKtx2) {
+    std::string path(cubemapKtx2);
+    auto faces = _pool.submit([path]() { return Ktx2Texture::loadCubeFaces(path); }).share();
+
+    return enqueueGpuJob<RenderObject>(
+        [faces]() { return isReady(faces); },
+        [=]() { return buildSkybox(renderPass, faces.get()); });
+}
+
+RenderObject ObjectFactory::buildSkybox(VkRenderPass renderPass, const std::array<ImageData, 6>& faces) {
     std::vector<Vertex> vertices = {
         {{-1.0f,  1.0f, -1.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
         {{-1.0f, -1.0f, -1.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
@@ -100,163 +206,276 @@ RenderObject ObjectFactory::createSkybox(VkRenderPass renderPass, const std::arr
         _device,
         _colorFormat,
         _depthFormat,
-        "shaders/skybox.vert.spv",
-        "shaders/skybox.frag.spv",
+        shaderPath("shaders/skybox.vert.spv").c_str(),
+        shaderPath("shaders/skybox.frag.spv").c_str(),
         renderPass,
         _descriptorSetLayout,
         PipelineType::SKYBOX,
-        2
+        2,
+        VertexFormat::FULL,
+        _textureSetLayout
     );
 
-    InitBuffer buff;
-
-    VkBuffer vertexBuffer = buff.createVertexBuffer(_physicalDevice, _device, _commandPool, _graphicsQueue, vertices);
+    MeshData mesh;
+    LoadObj::indexVertices(vertices, mesh);
 
     CubeMap* cubemap = new CubeMap(_physicalDevice, _device,
-                                   _commandPool, _graphicsQueue, cubemapFaces);
+                                   _commandPool, _graphicsQueue, faces);
+    if (BlockCompression::isCompressed(cubemap->getFormat())) {
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Skybox: " << BlockCompression::formatName(cubemap->getFormat()) << ", "
+                  << cubemap->getByteSize() / (1024.0 * 1024.0) << " MB statt "
+                  << cubemap->getUncompressedByteSize() / (1024.0 * 1024.0) << " MB"
+                  << std::defaultfloat << std::endl;
+    }
 
     RenderObject obj{};
-    obj.vertexBuffer = vertexBuffer;
-    obj.vertexCount = static_cast<uint32_t>(vertices.size());
+    uploadMesh(mesh, obj);
     obj.textureImageView = cubemap->getImageView();
     obj.textureSampler = cubemap->getSampler();
     obj.pipeline = pipeline;
-    obj.modelMatrix = glm::mat4(1.0f);
-
     return obj;
 }
 
-RenderObject ObjectFactory::createSnowflake(const char* texturePath, 
-                                           VkRenderPass renderPass,
-                                           VkBuffer particleBuffer, 
-                                           VkDescriptorSetLayout snowDescriptorSetLayout) {
-    std::vector<Vertex> vertices = {
-        // Quad in XY-Ebene, Normale zeigt in +Z
-        {{-0.1f, -0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
-        {{ 0.1f, -0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
-        {{ 0.1f,  0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
-        
-        {{ 0.1f,  0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
-        {{-0.1f,  0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
-        {{-0.1f, -0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}}
-    };
-
-    GraphicsPipeline* pipeline = new GraphicsPipeline(
-        _device,
-        _colorFormat,
-        _depthFormat,
-        "shaders/snow.vert.spv",
-        "shaders/snow.frag.spv",
-        renderPass,
-        snowDescriptorSetLayout,
-        PipelineType::STANDARD,
-        2
-    );
-
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device, _commandPool, _graphicsQueue, vertices);
-
-    Texture* tex = new Texture(_physicalDevice, _device, _commandPool, _graphicsQueue, texturePath);
+AssetHandle<RenderObject> ObjectFactory::createSnowflakeAsync(const char* texturePath, 
+                                                              VkRenderPass renderPass,
+                                                              VkBuffer particleBuffer, 
+                                                              VkDescriptorSetLayout snowDescriptorSetLayout) {
+    auto image = loadImageAsync(texturePath);
+    std::string texture(texturePath);
+
+    return enqueueGpuJob<RenderObject>(
+        [image]() { return isReady(image); },
+        [=]() {
+            std::vector<Vertex> vertices = {
+                // Quad in XY-Ebene, Normale zeigt in +Z
+                {{-0.1f, -0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
+                {{ 0.1f, -0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
+                {{ 0.1f,  0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
+                
+                {{ 0.1f,  0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
+                {{-0.1f,  0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
+                {{-0.1f, -0.1f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}}
+            };
+
+            GraphicsPipeline* pipeline = new GraphicsPipeline(
+                _device,
+                _colorFormat,
+                _depthFormat,
+                "shaders/snow.vert.spv",
+                "shaders/snow.frag.spv",
+                renderPass,
+                snowDescriptorSetLayout,
+                PipelineType::STANDARD,
+                2
+            );
+
+            MeshData mesh;
+            LoadObj::indexVertices(vertices, mesh);
+
+            std::shared_ptr<Texture> tex = acquireTexture(texture, image);
+
+            RenderObject obj{};
+            uploadMesh(mesh, obj);
+            obj.textureImageView = tex->getImageView();
+            obj.textureSampler = tex->getSampler();
+            obj.pipeline = pipeline;
+            obj.instanceBuffer = particleBuffer;
+            obj.instanceCount = NUMBER_PARTICLES;
+            obj.texture = tex;
+            return obj;
+        });
+}
 
-    RenderObject obj{};
-    obj.vertexBuffer = vertexBuffer;
-    obj.vertexCount = static_cast<uint32_t>(vertices.size());
-    obj.textureImageView = tex->getImageView();
-    obj.textureSampler = tex->getSampler();
-    obj.pipeline = pipeline;
-    obj.modelMatrix = glm::mat4(1.0f);
-    obj.instanceBuffer = particleBuffer;
-    obj.instanceCount = NUMBER_PARTICLES;
-    obj.isSnow = true;
-    obj.texture = tex;
+AssetHandle<LightSourceObject> ObjectFactory::createLightSourceAsync(const glm::vec3& position,
+                                                                     const glm::vec3& color,
+                                                                     float intensity,
+                                                                     float radius,
+                                                                     VkRenderPass renderPass) {
+    auto mesh = loadMeshAsync("models/teapot.obj");
+    std::string texture("textures/white.png");
+    auto image = loadImageAsync(texture.c_str());
+
+    return enqueueGpuJob<LightSourceObject>(
+        [mesh, image]() { return isReady(mesh) && isReady(image); },
+        [=]() {
+            LightSourceObject light;
+            light.position = position;
+            light.color = color;
+            light.intensity = intensity;
+            light.radius = radius;
+
+            GraphicsPipeline* pipeline = new GraphicsPipeline(
+                _device,
+                _colorFormat,
+                _depthFormat,
+                shaderPath("shaders/testapp.vert.spv").c_str(),
+                shaderPath("shaders/testapp.frag.spv").c_str(),
+                renderPass,
+                _descriptorSetLayout,
+                PipelineType::STANDARD,2,
+                VertexFormat::FULL,
+                _textureSetLayout
+            );
+           
+            std::shared_ptr<Texture> tex = acquireTexture(texture, image);
+            
+            uploadMesh(mesh.get(), light.renderObject);
+            light.renderObject.textureImageView = tex->getImageView();
+            light.renderObject.textureSampler = tex->getSampler();
+            light.renderObject.pipeline = pipeline;
+            light.renderObject.instanceCount = 1;
+            light.renderObject.texture = tex;
+            return light;
+        });
+}
 
-    return obj;
+AssetHandle<RenderObject> ObjectFactory::createLitObjectAsync(const char* modelPath,
+                                                              const char* texturePath,
+                                                              VkRenderPass renderPass,
+                                                              VertexFormat format) {
+    auto mesh = loadMeshAsync(modelPath, format);
+    auto image = loadImageAsync(texturePath);
+    std::string texture(texturePath);
+
+    return enqueueGpuJob<RenderObject>(
+        [mesh, image]() { return isReady(mesh) && isReady(image); },
+        [=]() {
+            GraphicsPipeline* pipeline = new GraphicsPipeline(
+                _device,
+                _colorFormat,
+                _depthFormat,
+                shaderPath("shaders/lit.vert.spv").c_str(),
+                shaderPath("shaders/lit.frag.spv").c_str(),
+                renderPass,
+                _litDescriptorSetLayout,
+                PipelineType::STANDARD,
+                2,
+                format,
+                _textureSetLayout
+            );
+            
+            std::shared_ptr<Texture> tex = acquireTexture(texture, image);
+            
+            RenderObject obj{};
+            uploadMesh(mesh.get(), obj);
+            obj.textureImageView = tex->getImageView();
+            obj.textureSampler = tex->getSampler();
+            obj.pipeline = pipeline;
+            obj.texture = tex;
+            return obj;
+        });
 }
 
-LightSourceObject ObjectFactory::createLightSource(const glm::vec3& position,
-                                                const glm::vec3& color,
-                                                float intensity,
-                                                float radius,
-                                                VkRenderPass renderPass) {
-    LightSourceObject light;
-    light.position = position;
-    light.color = color;
-    light.intensity = intensity;
-    light.radius = radius;
-    
-    std::vector<Vertex> sphereVertices;
-    _loader.objLoader("models/teapot.obj", sphereVertices);
-    
-    GraphicsPipeline* pipeline = new GraphicsPipeline(
-        _device,
-        _colorFormat,
-        _depthFormat,
-        "shaders/testapp.vert.spv",
-        "shaders/testapp.frag.spv",
-        renderPass,
-        _descriptorSetLayout,
-        PipelineType::STANDARD,2
-    );
-   
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device,
-                                                    _commandPool, _graphicsQueue, sphereVertices);
-    
-    Texture* tex = new Texture(_physicalDevice, _device, _commandPool, _graphicsQueue, 
-                              "textures/white.png");
-    
-    glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), position);
-    modelMatrix = glm::scale(modelMatrix, glm::vec3(0.02f));
-    
-    light.renderObject.vertexBuffer = vertexBuffer;
-    light.renderObject.vertexCount = static_cast<uint32_t>(sphereVertices.size());
-    light.renderObject.textureImageView = tex->getImageView();
-    light.renderObject.textureSampler = tex->getSampler();
-    light.renderObject.pipeline = pipeline;
-    light.renderObject.modelMatrix = modelMatrix;
-    light.renderObject.instanceCount = 1;
-    light.renderObject.isLit = false;
-    light.renderObject.texture = tex;
-    
-    return light;
+AssetHandle<DeferredRenderObject> ObjectFactory::createDeferredObjectAsync(const char* modelPath,
+                                                                           const char* texturePath,
+                                                                           VkRenderPass renderPass,
+                                                                           VertexFormat format) {
+    auto mesh = loadMeshAsync(modelPath, format);
+    auto image = loadImageAsync(texturePath);
+    std::string texture(texturePath);
+
+    return enqueueGpuJob<DeferredRenderObject>(
+        [mesh, image]() { return isReady(mesh) && isReady(image); },
+        [=]() {
+            DeferredRenderObject deferredObj{};
+
+            // Load geometry
+            RenderObject geometry{};
+            uploadMesh(mesh.get(), geometry);
+
+            // Load texture
+            std::shared_ptr<Texture> tex = acquireTexture(texture, image);
+
+            // Pipeline for Depth Prepass (Subpass 0)
+            GraphicsPipeline* depthPipeline = new GraphicsPipeline(
+                _device, _colorFormat, _depthFormat,
+                shaderPath("shaders/depth_only.vert.spv").c_str(),
+                shaderPath("shaders/depth_only.frag.spv").c_str(),
+                renderPass,
+                _descriptorSetLayout,
+                PipelineType::DEPTH_ONLY,
+                0,  // Subpass 0
+                format,
+                _textureSetLayout
+            );
+
+            deferredObj.depthPass = geometry;
+            deferredObj.depthPass.textureImageView = tex->getImageView();
+            deferredObj.depthPass.textureSampler = tex->getSampler();
+            deferredObj.depthPass.texture = tex;
+            deferredObj.depthPass.pipeline = depthPipeline;
+            deferredObj.depthPass.instanceCount = 1;
+
+            // Pipeline for G-Buffer Pass (Subpass 1)
+            GraphicsPipeline* gbufferPipeline = new GraphicsPipeline(
+                _device, _colorFormat, _depthFormat,
+                shaderPath("shaders/gbuffer.vert.spv").c_str(),
+                shaderPath("shaders/gbuffer.frag.spv").c_str(),
+                renderPass,
+                _descriptorSetLayout,
+                PipelineType::GBUFFER,
+                1,  // Subpass 1
+                format,
+                _textureSetLayout
+            );
+
+            deferredObj.gbufferPass = geometry;
+            deferredObj.gbufferPass.textureImageView = tex->getImageView();
+            deferredObj.gbufferPass.textureSampler = tex->getSampler();
+            deferredObj.gbufferPass.texture = tex;
+            deferredObj.gbufferPass.pipeline = gbufferPipeline;
+            deferredObj.gbufferPass.instanceCount = 1;
+
+            return deferredObj;
+        });
 }
 
-RenderObject ObjectFactory::createLitObject(const char* modelPath,
-                                          const char* texturePath,
-                                          const glm::mat4& modelMatrix,
-                                          VkRenderPass renderPass) {
-    GraphicsPipeline* pipeline = new GraphicsPipeline(
-        _device,
-        _colorFormat,
-        _depthFormat,
-        "shaders/lit.vert.spv",
-        "shaders/lit.frag.spv",
-        renderPass,
-        _litDescriptorSetLayout,
-        PipelineType::STANDARD,
-        2
-    );
-    
-    std::vector<Vertex> vertices;
-    _loader.objLoader(modelPath, vertices);
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device,
-                                                    _commandPool, _graphicsQueue, vertices);
-    
-    Texture* tex = new Texture(_physicalDevice, _device, _commandPool, _graphicsQueue, texturePath);
-    
-    RenderObject obj{};
-    obj.vertexBuffer = vertexBuffer;
-    obj.vertexCount = static_cast<uint32_t>(vertices.size());
-    obj.textureImageView = tex->getImageView();
-    obj.textureSampler = tex->getSampler();
-    obj.pipeline = pipeline;
-    obj.modelMatrix = modelMatrix;
-    obj.isLit = true;
-    obj.texture = tex;
-    
-    return obj;
+AssetHandle<RenderObject> ObjectFactory::createReflectiveObjectAsync(
+    const char* modelPath,
+    ReflectionProbe* probe,
+    VkRenderPass renderPass,
+    VertexFormat format)
+{
+    auto mesh = loadMeshAsync(modelPath, format);
+
+    return enqueueGpuJob<RenderObject>(
+        [mesh]() { return isReady(mesh); },
+        [=]() {
+            // Pipeline
+            GraphicsPipeline* pipeline = new GraphicsPipeline(
+                _device,
+                _colorFormat,
+                _depthFormat,
+                shaderPath("shaders/renderToTexture.vert.spv").c_str(),
+                shaderPath("shaders/renderToTexture.frag.spv").c_str(),
+                renderPass,
+                _descriptorSetLayout,
+                PipelineType::STANDARD,
+                2,
+                format,
+                _textureSetLayout
+            );
+
+            // Model hochladen
+            RenderObject obj{};
+            uploadMesh(mesh.get(), obj);
+            obj.textureImageView = probe->getCubemapView();
+            obj.textureSampler = probe->getCubemapSampler();
+            obj.pipeline = pipeline;
+            obj.instanceCount = 1;
+            obj.texture = nullptr;
+
+            std::cout << "Reflective object created with cubemap" << std::endl;
+            return obj;
+        });
 }
 
-RenderObject ObjectFactory::createMirror(const glm::mat4& modelMatrix, 
-                                         VkRenderPass renderPass,
+// ------------------------------------------------------------
+// Ohne Dateizugriff - bleiben synchron
+// ------------------------------------------------------------
+
+RenderObject ObjectFactory::createMirror(VkRenderPass renderPass,
                                          PipelineType pipelineType) {
     std::vector<Vertex> vertices = {
         {{-1.0f,  1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
@@ -279,86 +498,30 @@ RenderObject ObjectFactory::createMirror(const glm::mat4& modelMatrix,
         _device,
         _colorFormat,
         _depthFormat,
-        "shaders/testapp.vert.spv",
-        fragShader,
+        shaderPath("shaders/testapp.vert.spv").c_str(),
+        shaderPath(fragShader).c_str(),
         renderPass,
         _descriptorSetLayout,
         pipelineType,
-        2
+        2,
+        VertexFormat::FULL,
+        _textureSetLayout
     );
 
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(
-        _physicalDevice, _device, _commandPool, _graphicsQueue, vertices);
+    MeshData mesh;
+    LoadObj::indexVertices(vertices, mesh);
 
-    Texture* tex = new Texture(_physicalDevice, _device, _commandPool, 
-                               _graphicsQueue, "textures/mirror.jpg");
+    std::shared_ptr<Texture> tex = _textureManager.acquire("textures/mirror.jpg");
 
     RenderObject obj{};
-    obj.vertexBuffer = vertexBuffer;
-    obj.vertexCount = static_cast<uint32_t>(vertices.size());
+    uploadMesh(mesh, obj);
     obj.textureImageView = tex->getImageView();
     obj.textureSampler = tex->getSampler();
     obj.pipeline = pipeline;
-    obj.modelMatrix = modelMatrix;
     obj.texture = tex;
 
     return obj;
 }
-DeferredRenderObject ObjectFactory::createDeferredObject(const char* modelPath,const char* texturePath,const glm::mat4& modelMatrix,VkRenderPass renderPass){
-    DeferredRenderObject deferredObj{};
-
-    // Load geometry
-    std::vector<Vertex> vertices;
-    _loader.objLoader(modelPath, vertices);
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device,
-                                                     _commandPool, _graphicsQueue, vertices);
-
-    // Load texture
-    Texture* tex = new Texture(_physicalDevice, _device, _commandPool, _graphicsQueue, texturePath);
-
-    // Pipeline for Depth Prepass (Subpass 0)
-    GraphicsPipeline* depthPipeline = new GraphicsPipeline(
-        _device, _colorFormat, _depthFormat,
-        "shaders/depth_only.vert.spv",
-        "shaders/depth_only.frag.spv",
-        renderPass,
-        _descriptorSetLayout,
-        PipelineType::DEPTH_ONLY,
-        0  // Subpass 0
-    );
-
-    deferredObj.depthPass.vertexBuffer = vertexBuffer;
-    deferredObj.depthPass.vertexCount = static_cast<uint32_t>(vertices.size());
-    deferredObj.depthPass.textureImageView = tex->getImageView();
-    deferredObj.depthPass.textureSampler = tex->getSampler();
-    deferredObj.depthPass.pipeline = depthPipeline;
-    deferredObj.depthPass.modelMatrix = modelMatrix;
-    deferredObj.depthPass.instanceCount = 1;
-    deferredObj.depthPass.isDeferred =true;
-
-    // Pipeline for G-Buffer Pass (Subpass 1)
-    GraphicsPipeline* gbufferPipeline = new GraphicsPipeline(
-        _device, _colorFormat, _depthFormat,
-        "shaders/gbuffer.vert.spv",
-        "shaders/gbuffer.frag.spv",
-        renderPass,
-        _descriptorSetLayout,
-        PipelineType::GBUFFER,
-        1  // Subpass 1
-    );
-
-    deferredObj.gbufferPass.vertexBuffer = vertexBuffer;
-    deferredObj.gbufferPass.vertexCount = static_cast<uint32_t>(vertices.size());
-    deferredObj.gbufferPass.textureImageView = tex->getImageView();
-    deferredObj.gbufferPass.textureSampler = tex->getSampler();
-    deferredObj.gbufferPass.pipeline = gbufferPipeline;
-    deferredObj.gbufferPass.modelMatrix = modelMatrix;
-    deferredObj.gbufferPass.instanceCount = 1;
-    deferredObj.gbufferPass.isDeferred =true;
-
-    return deferredObj;
-}
-
 
 RenderObject ObjectFactory::createLightingQuad(VkRenderPass renderPass,
                                               VkDescriptorSetLayout lightingLayout)
@@ -383,55 +546,340 @@ RenderObject ObjectFactory::createLightingQuad(VkRenderPass renderPass,
         2  // Subpass 2
     );
 
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device,
-                                                    _commandPool, _graphicsQueue, vertices);
-
+    // bleibt ohne Index Buffer: lighting.vert erzeugt die Positionen aus gl_VertexIndex
     RenderObject obj{};
-    obj.vertexBuffer = vertexBuffer;
-    obj.vertexCount = static_cast<uint32_t>(vertices.size());
+    assignMesh(acquireMesh("", vertices.data(), static_cast<uint32_t>(vertices.size()),
+                           VertexFormat::FULL, VertexQuantization{}, nullptr, 0, VK_INDEX_TYPE_UINT32), obj);
     obj.pipeline = pipeline;
-    obj.modelMatrix = glm::mat4(1.0f);
     obj.instanceCount = 1;
 
     return obj;
 }
 
-RenderObject ObjectFactory::createReflectiveObject(
-    const char* modelPath,
-    ReflectionProbe* probe,
-    const glm::mat4& modelMatrix,
-    VkRenderPass renderPass)
-{
-    // Pipeline
-    GraphicsPipeline* pipeline = new GraphicsPipeline(
-        _device,
-        _colorFormat,
-        _depthFormat,
-        "shaders/renderToTexture.vert.spv",
-        "shaders/renderToTexture.frag.spv",
-        renderPass,
-        _descriptorSetLayout,
-        PipelineType::STANDARD,
-        2
-    );
+// ------------------------------------------------------------
+// GPU-Job Queue (nur Hauptthread)
+// ------------------------------------------------------------
 
-    // Model laden
-    std::vector<Vertex> vertices;
-    _loader.objLoader(modelPath, vertices);
+size_t ObjectFactory::processUploads(bool wait, size_t maxJobs) {
+    // Buffer und Texturen aller Jobs dieses Aufrufs gehen in einen Submit des UploadManagers
+    if (_uploadManager) {
+        _uploadManager->completedValue();
+    }
+    _textureManager.beginBatch();
+    _buff._uploadManager = _uploadManager;
+    size_t done = 0;
+    for (auto it = _gpuJobs.begin(); it != _gpuJobs.end() && done < maxJobs;) {
+        if (it->ready()) {
+            GpuJob job = std::move(*it);
+            it = _gpuJobs.erase(it);
+            job.run();
+            ++done;
+        } else {
+            ++it;
+        }
+    }
 
-    VkBuffer vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device, _commandPool, _graphicsQueue, vertices);
-   
-    RenderObject obj{};
-    obj.vertexBuffer = vertexBuffer;
-    obj.vertexCount = static_cast<uint32_t>(vertices.size());
-    obj.textureImageView = probe->getCubemapView();
-    obj.textureSampler = probe->getCubemapSampler();
-    obj.pipeline = pipeline;
-    obj.modelMatrix = modelMatrix;
-    obj.instanceCount = 1;
-    obj.texture = nullptr;
+    // Nichts fertig: ältesten Job ausführen, der blockiert in future.get() bis sein CPU-Teil da ist
+    if (done == 0 && wait && !_gpuJobs.empty()) {
+        GpuJob job = std::move(_gpuJobs.front());
+        _gpuJobs.pop_front();
+        job.run();
+        ++done;
+    }
+    _buff._uploadManager = nullptr;
+    _textureManager.endBatch();
+    if (_uploadManager) {
+        _uploadManager->submit();
+    }
+    return done;
+}
 
-    std::cout << "Reflective object created with cubemap" << std::endl;
+void ObjectFactory::finishUploads() {
+    while (!_gpuJobs.empty()) {
+        processUploads(true);
+    }
+}
 
-    return obj;
-}
\ No newline at end of file
+// ------------------------------------------------------------
+// Laden (Worker-Threads) und Hochladen (Hauptthread)
+// ------------------------------------------------------------
+
+std::string ObjectFactory::meshKey(const std::string& modelPath, VertexFormat format) {
+    std::string key = MeshRegistry::normalizePath(modelPath);
+    if (format != VertexFormat::FULL) {
+        key += "#";
+        key += VertexCompression::nameOf(format);
+    }
+    return key;
+}
+
+ObjectFactory::LoadedMesh ObjectFactory::loadMeshData(const std::string& modelPath, VertexFormat format) {
+    LoadedMesh loaded;
+    loaded.path = meshKey(modelPath, format);
+    loaded.source = modelPath;
+    loaded.format = format;
+
+    // Schneller Pfad: gültiger .bmesh Cache, wird später direkt aus dem mmap hochgeladen
+    auto cache = std::make_shared<MeshCache>();
+    if (cache->open(modelPath)) {
+        loaded.cache = cache;
+        if (format != VertexFormat::FULL) {
+            loaded.vertices = VertexCompression::encode(static_cast<const Vertex*>(cache->vertexData()),
+                                                        cache->vertexCount(), format,
+                                                        cache->boundsMin(), cache->boundsMax(), loaded.quant);
+        }
+        // der Cache selbst ist gemappt, nur die kodierte Kopie liegt im Heap
+        loaded.memory = HostMemoryTag(MemoryCategory::Mesh, loaded.vertices.size());
+        return loaded;
+    }
+
+    // Kalter Pfad: OBJ parsen und Cache für den nächsten Start schreiben
+    auto start = std::chrono::high_resolution_clock::now();
+    LoadObj loader;
+    if (!loader.objLoader(modelPath, loaded.mesh)) {
+        throw std::runtime_error("ObjectFactory::loadMeshData: failed to load " + modelPath);
+    }
+    float coldMs = std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+    if (!MeshCache::write(modelPath, loaded.mesh, coldMs)) {
+        std::cerr << "Mesh-Cache für " << modelPath << " konnte nicht geschrieben werden" << std::endl;
+    }
+    if (format != VertexFormat::FULL) {
+        loaded.vertices = VertexCompression::encode(loaded.mesh.vertices.data(), loaded.mesh.vertices.size(),
+                                                    format, loaded.mesh.boundsMin, loaded.mesh.boundsMax,
+                                                    loaded.quant);
+    }
+    loaded.memory = HostMemoryTag(MemoryCategory::Mesh,
+                                  loaded.mesh.vertices.size() * sizeof(Vertex)
+                                  + loaded.mesh.indices.size() * sizeof(uint32_t)
+                                  + loaded.mesh.meshlets.size() * sizeof(Meshlet)
+                                  + loaded.vertices.size());
+    return loaded;
+}
+
+std::shared_future<ObjectFactory::LoadedMesh> ObjectFactory::loadMeshAsync(const char* modelPath, VertexFormat format) {
+    std::string path = MeshRegistry::normalizePath(modelPath);
+    // gleiche Datei in einem anderen Vertex-Format ist ein eigenes Mesh
+    std::string key = meshKey(path, format);
+
+    // Schon auf der GPU: gar nichts laden, uploadMesh findet es über den Pfad
+    if (_meshRegistry.containsPath(key)) {
+        std::promise<LoadedMesh> done;
+        LoadedMesh loaded;
+        loaded.path = key;
+        loaded.format = format;
+        done.set_value(std::move(loaded));
+        return done.get_future().share();
+    }
+
+    // Wird gerade schon geladen (z.B. teapot.obj für jede Lichtquelle): gleiches future
+    auto pending = _pendingMeshLoads.find(key);
+    if (pending != _pendingMeshLoads.end()) {
+        return pending->second;
+    }
+
+    auto future = _pool.submit([path, format]() { return loadMeshData(path, format); }).share();
+    _pendingMeshLoads.emplace(key, future);
+    return future;
+}
+
+std::shared_future<ImageData> ObjectFactory::loadImageAsync(const char* texturePath) {
+    std::string path = MeshRegistry::normalizePath(texturePath);
+
+    // Schon hochgeladen: nicht nochmal dekodieren, acquireTexture findet sie
+    if (_textureManager.contains(path)) {
+        std::promise<ImageData> done;
+        done.set_value(ImageData{});
+        return done.get_future().share();
+    }
+
+    // Wird gerade schon dekodiert (z.B. white.png für jede Lichtquelle)
+    auto pending = _pendingImageLoads.find(path);
+    if (pending != _pendingImageLoads.end()) {
+        return pending->second;
+    }
+
+    // mit Texture-Streaming gleich hier auf dem Worker auf die groben Levels reduzieren
+    auto future = _pool.submit([this, path]() {
+        return _textureManager.initialLevels(ImageData::load(path));
+    }).share();
+    _pendingImageLoads.emplace(path, future);
+    return future;
+}
+
+std::string ObjectFactory::shaderPath(const std::string& path) const {
+    return _bindless ? bindlessShaderPath(path) : path;
+}
+
+std::shared_ptr<Texture> ObjectFactory::acquireTexture(const std::string& path,
+                                                       const std::shared_future<ImageData>& image) {
+    std::shared_ptr<Texture> texture = _textureManager.find(path);
+    if (!texture) {
+        // leeres ImageData: war beim Laden schon da, inzwischen aber wieder freigegeben
+        texture = image.get().pixels ? _textureManager.acquire(path, image.get())
+                                     : _textureManager.acquire(path);
+    }
+    _pendingImageLoads.erase(MeshRegistry::normalizePath(path));
+    return texture;
+}
+
+void ObjectFactory::uploadMesh(const MeshData& mesh, RenderObject& obj, const std::string& path) {
+    assignMesh(acquireMesh(path, mesh.vertices.data(), static_cast<uint32_t>(mesh.vertices.size()),
+                           VertexFormat::FULL, VertexQuantization{}, mesh.indices,
+                           mesh.lods, mesh.boundsMin, mesh.boundsMax, mesh.meshlets), obj);
+}
+
+void ObjectFactory::uploadMesh(const LoadedMesh& mesh, RenderObject& obj) {
+    // gleicher Pfad (im gleichen Format) schon hochgeladen?
+    if (std::shared_ptr<GpuMesh> existing = _meshRegistry.findByPath(mesh.path)) {
+        assignMesh(existing, obj);
+        _pendingMeshLoads.erase(mesh.path);
+        return;
+    }
+
+    // FULL: direkt aus dem mmap bzw. MeshData, sonst die auf dem Worker kodierten Vertices
+    const bool encoded = mesh.format != VertexFormat::FULL;
+    const void* vertexData = encoded ? static_cast<const void*>(mesh.vertices.data())
+                           : mesh.cache ? mesh.cache->vertexData()
+                           : static_cast<const void*>(mesh.mesh.vertices.data());
+    const uint32_t vertexCount = mesh.cache ? mesh.cache->vertexCount()
+                                            : static_cast<uint32_t>(mesh.mesh.vertices.size());
+
+    if (mesh.cache) {
+        const MeshCache& cache = *mesh.cache;
+        assignMesh(acquireMesh(mesh.path, vertexData, vertexCount, mesh.format, mesh.quant,
+                               cache.indexData(), cache.indexCount(), cache.indexType(),
+                               cache.lods(), cache.boundsMin(), cache.boundsMax(), cache.meshlets()), obj);
+    } else {
+        assignMesh(acquireMesh(mesh.path, vertexData, vertexCount, mesh.format, mesh.quant,
+                               mesh.mesh.indices, mesh.mesh.lods, mesh.mesh.boundsMin, mesh.mesh.boundsMax,
+                               mesh.mesh.meshlets), obj);
+    }
+    if (obj.mesh->sourcePath.empty()) {
+        obj.mesh->sourcePath = mesh.source;
+    }
+    _pendingMeshLoads.erase(mesh.path);
+}
+
+AssetHandle<bool> ObjectFactory::reloadMesh(const std::shared_ptr<GpuMesh>& mesh) {
+    if (mesh->resident || mesh->sourcePath.empty()) {
+        return {};
+    }
+    auto loaded = loadMeshAsync(mesh->sourcePath.c_str(), mesh->format);
+    return enqueueGpuJob<bool>(
+        [loaded]() { return loaded.wait_for(std::chrono::seconds(0)) == std::future_status::ready; },
+        [this, loaded, mesh]() {
+            // gleicher Inhalt -> acquireMesh setzt die Buffer in mesh ein
+            RenderObject scratch;
+            uploadMesh(loaded.get(), scratch);
+            return mesh->resident;
+        });
+}
+
+std::shared_ptr<GpuMesh> ObjectFactory::acquireMesh(const std::string& path,
+                                                    const void* vertexData, uint32_t vertexCount,
+                                                    VertexFormat format, const VertexQuantization& quant,
+                                                    const std::vector<uint32_t>& indices,
+                                                    const std::vector<MeshLod>& lods,
+                                                    const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                                                    const std::vector<Meshlet>& meshlets) {
+    const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+    // wie im Mesh-Cache: 16 Bit Indices wenn möglich, damit der Inhalts-Hash gleich ausfällt
+    if (InitBuffer::chooseIndexType(vertexCount) == VK_INDEX_TYPE_UINT16) {
+        std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        return acquireMesh(path, vertexData, vertexCount, format, quant,
+                           shortIndices.data(), indexCount, VK_INDEX_TYPE_UINT16, lods, boundsMin, boundsMax, meshlets);
+    }
+    return acquireMesh(path, vertexData, vertexCount, format, quant,
+                       indices.data(), indexCount, VK_INDEX_TYPE_UINT32, lods, boundsMin, boundsMax, meshlets);
+}
+
+std::shared_ptr<GpuMesh> ObjectFactory::acquireMesh(const std::string& path,
+                                                    const void* vertexData, uint32_t vertexCount,
+                                                    VertexFormat format, const VertexQuantization& quant,
+                                                    const void* indexData, uint32_t indexCount,
+                                                    VkIndexType indexType,
+                                                    const std::vector<MeshLod>& lods,
+                                                    const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                                                    const std::vector<Meshlet>& meshlets) {
+    const uint32_t stride = VertexCompression::strideOf(format);
+    const VkDeviceSize vertexBytes = static_cast<VkDeviceSize>(stride) * static_cast<VkDeviceSize>(vertexCount);
+    const VkDeviceSize indexBytes = (indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t))
+                                  * static_cast<VkDeviceSize>(indexCount);
+
+    // Inhalts-Hash über Anzahl/Format, Dekodier-Parameter, Vertices und Indices
+    const uint32_t counts[4] = { vertexCount, indexCount, static_cast<uint32_t>(indexType),
+                                 static_cast<uint32_t>(format) };
+    uint64_t contentHash = MeshCache::hashBytes(counts, sizeof(counts));
+    contentHash = MeshCache::hashBytes(&quant, sizeof(quant), contentHash);
+    contentHash = MeshCache::hashBytes(vertexData, static_cast<size_t>(vertexBytes), contentHash);
+    if (indexCount > 0) {
+        contentHash = MeshCache::hashBytes(indexData, static_cast<size_t>(indexBytes), contentHash);
+    }
+    if (!lods.empty()) {
+        contentHash = MeshCache::hashBytes(lods.data(), lods.size() * sizeof(MeshLod), contentHash);
+    }
+    if (!meshlets.empty()) {
+        contentHash = MeshCache::hashBytes(meshlets.data(), meshlets.size() * sizeof(Meshlet), contentHash);
+    }
+
+    if (std::shared_ptr<GpuMesh> existing = _meshRegistry.findByContent(contentHash)) {
+        _meshRegistry.addPathAlias(path, existing);
+        return existing;
+    }
+
+    GpuMesh gpu;
+    _buff._uploadTicket = 0;
+    gpu.vertexBuffer = _buff.createVertexBuffer(_physicalDevice, _device, _commandPool,
+                                                _graphicsQueue, vertexData, vertexCount, stride);
+    gpu.vertexBufferMemory = _buff._vertexBufferMemory;
+    gpu.vertexCount = vertexCount;
+    gpu.format = format;
+    gpu.quant = quant;
+    if (indexCount > 0) {
+        gpu.indexBuffer = _buff.createIndexBuffer(_physicalDevice, _device, _commandPool, _graphicsQueue,
+                                                  indexData, indexCount, indexType);
+        gpu.indexBufferMemory = _buff._indexBufferMemory;
+        gpu.indexCount = indexCount;
+        gpu.indexType = indexType;
+    }
+    gpu.byteSize = vertexBytes + (indexCount > 0 ? indexBytes : 0);
+    if (!meshlets.empty() && indexCount > 0) {
+        const VkDeviceSize meshletBytes = meshlets.size() * sizeof(Meshlet);
+        gpu.meshletBuffer = _buff.createStorageBuffer(_physicalDevice, _device, _commandPool, _graphicsQueue,
+                                                      meshlets.data(), meshletBytes);
+        gpu.meshletBufferMemory = _buff._storageBufferMemory;
+        gpu.meshletCount = static_cast<uint32_t>(meshlets.size());
+        gpu.byteSize += meshletBytes;
+    }
+    gpu.uploadTicket = _buff._uploadTicket;
+    gpu.lods = lods;
+    gpu.boundsCenter = (boundsMin + boundsMax) * 0.5f;
+    gpu.boundsRadius = glm::length(boundsMax - boundsMin) * 0.5f;
+
+    // gleicher Inhalt wie ein ausgelagertes Mesh: Buffer dort wieder einsetzen, damit alle
+    // Objekte mit diesem GpuMesh (Scene::refreshMesh) sie bekommen
+    if (std::shared_ptr<GpuMesh> evicted = _meshRegistry.findEvicted(contentHash)) {
+        _meshRegistry.restore(*evicted, gpu);
+        _meshRegistry.addPathAlias(path, evicted);
+        return evicted;
+    }
+    return _meshRegistry.insert(path, contentHash, gpu);
+}
+
+void ObjectFactory::assignMesh(const std::shared_ptr<GpuMesh>& mesh, RenderObject& obj) {
+    obj.mesh = mesh;
+    obj.vertexBuffer = mesh->vertexBuffer;
+    obj.vertexCount = mesh->vertexCount;
+    obj.indexBuffer = mesh->indexBuffer;
+    obj.indexCount = mesh->indexCount;
+    obj.indexType = mesh->indexType;
+    obj.vertexFormat = mesh->format;
+    obj.quant = mesh->quant;
+    obj.lods = mesh->lods;
+    obj.boundsCenter = mesh->boundsCenter;
+    obj.boundsRadius = mesh->boundsRadius;
+    obj.meshletBuffer = mesh->meshletBuffer;
+    obj.meshletCount = mesh->meshletCount;
+}
@@ -6,11 +6,51 @@
 #include "helper/Rendering/GraphicsPipeline.hpp"
 #include "Scene.hpp"
 #include "helper/initBuffer.hpp"
+#include "helper/UploadManager.hpp"
+#include "helper/MemoryReport.hpp"
 #include "helper/ObjectLoading/loadObj.hpp"
 #include "helper/Compute/Snow.hpp"
 #include "helper/MirrorSystem.hpp"
 #include "helper/renderToTexture/ReflectionProbe.hpp"
+#include "helper/ObjectLoading/MeshCache.hpp"
+#include "helper/ObjectLoading/MeshRegistry.hpp"
+#include "helper/ObjectLoading/VertexCompression.hpp"
+#include "helper/Texture/TextureManager.hpp"
+#include "helper/Texture/ImageData.hpp"
+#include "helper/Threading/ThreadPool.hpp"
 #include <array>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+class ObjectFactory;
+
+// Handle auf ein asynchron erzeugtes Objekt. get() blockiert, bis das Objekt
+// fertig ist, und arbeitet währenddessen die GPU-Uploads der Factory ab
+// (darf deshalb nur auf dem Hauptthread aufgerufen werden).
+template<typename T>
+class AssetHandle {
+public:
+    AssetHandle() = default;
+    AssetHandle(ObjectFactory* factory, std::shared_future<T> future)
+        : _factory(factory), _future(std::move(future)) {}
+
+    bool ready() const {
+        return _future.valid() &&
+               _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    // false = leeres Handle (nichts angestoßen)
+    bool valid() const { return _future.valid(); }
+    T get();
+
+private:
+    ObjectFactory* _factory = nullptr;
+    std::shared_future<T> _future;
+};
 
 
 class ObjectFactory {
@@ -19,39 +59,107 @@ public:
                  VkCommandPool commandPool, VkQueue graphicsQueue,
                  VkFormat colorFormat, VkFormat depthFormat,
                  VkDescriptorSetLayout descriptorSetLayout,
-                 VkDescriptorSetLayout litDescriptorSetLayout)
+                 VkDescriptorSetLayout litDescriptorSetLayout,
+                 UploadManager* uploadManager = nullptr)
         : _physicalDevice(physicalDevice), _device(device),
           _commandPool(commandPool), _graphicsQueue(graphicsQueue),
           _colorFormat(colorFormat), _depthFormat(depthFormat),
           _descriptorSetLayout(descriptorSetLayout),
-          _litDescriptorSetLayout(litDescriptorSetLayout) {}
+          _litDescriptorSetLayout(litDescriptorSetLayout),
+          _meshRegistry(device),
+          _uploadManager(uploadManager),
+          _textureManager(physicalDevice, device, commandPool, graphicsQueue, uploadManager) {}
+
+    ObjectFactory(const ObjectFactory&) = delete;
+    ObjectFactory& operator=(const ObjectFactory&) = delete;
+
+    // Asynchrone Varianten: OBJ/Mesh-Cache und Bild-Dekodierung laufen im ThreadPool,
+    // alle Vulkan-Aufrufe (Uploads, Pipelines) nur in processUploads() auf dem Hauptthread
+    AssetHandle<RenderObject> createGenericObjectAsync(const char* modelPath,
+                                                       const char* vertShaderPath,
+                                                       const char* fragShaderPath,
+                                                       const char* texturePath,
+                                                       VkRenderPass renderPass,
+                                                       PipelineType type, uint32_t subpassIndex,
+                                                       VertexFormat format = VertexFormat::FULL);
+    AssetHandle<DeferredRenderObject> createDeferredObjectAsync(const char* modelPath,
+                                                                const char* texturePath,
+                                                                VkRenderPass renderPass,
+                                                                VertexFormat format = VertexFormat::FULL);
+    AssetHandle<RenderObject> createSkyboxAsync(VkRenderPass renderPass, const std::array<const char*, 6>& cubemapFaces);
+    // Variante mit einer Cubemap-.ktx2 (alle Faces und Mip-Levels in einer Datei)
+    AssetHandle<RenderObject> createSkyboxAsync(VkRenderPass renderPass, const char* cubemapKtx2);
+    AssetHandle<RenderObject> createSnowflakeAsync(const char* texturePath,
+                                                   VkRenderPass renderPass,
+                                                   VkBuffer particleBuffer,
+                                                   VkDescriptorSetLayout snowDescriptorSetLayout);
+    AssetHandle<LightSourceObject> createLightSourceAsync(const glm::vec3& position,
+                                                          const glm::vec3& color,
+                                                          float intensity,
+                                                          float radius,
+                                                          VkRenderPass renderPass);
+    AssetHandle<RenderObject> createLitObjectAsync(const char* modelPath, const char* texturePath,
+                                                   VkRenderPass renderPass,
+                                                   VertexFormat format = VertexFormat::FULL);
+    AssetHandle<RenderObject> createReflectiveObjectAsync(const char* modelPath, ReflectionProbe* probe,
+                                                          VkRenderPass renderPass,
+                                                          VertexFormat format = VertexFormat::FULL);
+
+    // Führt alle GPU-Jobs aus, deren CPU-Teil fertig ist (höchstens maxJobs, z.B. pro Frame).
+    // Ist keiner fertig und wait == true, wird der älteste abgewartet. Rückgabe: Anzahl ausgeführter Jobs
+    size_t processUploads(bool wait, size_t maxJobs = SIZE_MAX);
+    // Arbeitet alle ausstehenden GPU-Jobs ab
+    void finishUploads();
+
+    // Geteilte Vertex-/Index-Buffer aller erzeugten Objekte (Statistik, Aufräumen)
+    MeshRegistry& getMeshRegistry() { return _meshRegistry; }
+    // Geteilte Texturen und Sampler
+    TextureManager& getTextureManager() { return _textureManager; }
+    // nullptr = alle Uploads synchron über _graphicsQueue
+    UploadManager* getUploadManager() { return _uploadManager; }
+    VkDevice getDevice() const { return _device; }
+
+    // Lädt ein vom ResidencyManager ausgelagertes Mesh im ThreadPool neu; die Buffer werden in
+    // processUploads() wieder in mesh eingesetzt (true, sobald resident). Leeres Handle, wenn
+    // mesh schon resident ist oder keine Modelldatei hat
+    AssetHandle<bool> reloadMesh(const std::shared_ptr<GpuMesh>& mesh);
+
+    // Bindless-Modus: Mesh-Pipelines laden die .bindless-Shadervarianten, die Layouts
+    // aus dem Konstruktor müssen dann das globale Bindless-Layout (Set 0) sein,
+    // textureSetLayout kommt als Set 1 dazu
+    void enableBindless(VkDescriptorSetLayout textureSetLayout) {
+        _bindless = true;
+        _textureSetLayout = textureSetLayout;
+    }
+    bool isBindless() const { return _bindless; }
     
+
     //erstellt generische Objekte (Keine Beleuchtung, keine sonstigen gimmicks)
+    //format: Vertex-Layout des Meshes (kompakte Formate sparen Speicher/Bandbreite)
     RenderObject createGenericObject(const char* modelPath,
                                          const char* vertShaderPath,
                                          const char* fragShaderPath,
                                          const char* texturePath,
-                                         const glm::mat4& modelMatrix, 
                                          VkRenderPass renderPass,
-                                         PipelineType type, uint32_t subpassIndex);
+                                         PipelineType type, uint32_t subpassIndex,
+                                         VertexFormat format = VertexFormat::FULL);
 
     // Neue Methode für deferred gerenderte Objekte
     DeferredRenderObject createDeferredObject(
         const char* modelPath,
         const char* texturePath,
-        const glm::mat4& modelMatrix,
-        VkRenderPass renderPass);
+        VkRenderPass renderPass,
+        VertexFormat format = VertexFormat::FULL);
 
     //Erstellt die Skybox
     RenderObject createSkybox(VkRenderPass renderPass,const std::array<const char*, 6>& cubemapFaces);
-    //Schnee (Compute-Shader)
+    //Schnee (Compute-Shader), in die Scene mit ObjectKind::Snow
     RenderObject createSnowflake(const char* texturePath,
                                 VkRenderPass renderPass,
                                 VkBuffer particleBuffer,
                                 VkDescriptorSetLayout snowDescriptorSetLayout);
     //Spiegel (Stencil-Buffer)
-    RenderObject createMirror(const glm::mat4& modelMatrix,
-                             VkRenderPass renderPass,
+    RenderObject createMirror(VkRenderPass renderPass,
                              PipelineType pipelineType);
     
                        
@@ -61,16 +169,85 @@ public:
                                        float intensity,
                                        float radius,
                                        VkRenderPass renderPass);
-    //Objekte, die von den Lichtern beleuchtet werden
-    RenderObject createLitObject(const char* modelPath, const char* texturePath, const glm::mat4& modelMatrix, VkRenderPass renderPass);
+    //Objekte, die von den Lichtern beleuchtet werden, in die Scene mit ObjectKind::Lit
+    RenderObject createLitObject(const char* modelPath, const char* texturePath, VkRenderPass renderPass,
+                                 VertexFormat format = VertexFormat::FULL);
 
     // Fullscreen Quad für Lighting Pass
     RenderObject createLightingQuad(VkRenderPass renderPass,
                                    VkDescriptorSetLayout lightingLayout);
 
-    RenderObject createReflectiveObject(const char* modelPath, ReflectionProbe* probe, const glm::mat4& modelMatrix, VkRenderPass renderPass);
+    RenderObject createReflectiveObject(const char* modelPath, ReflectionProbe* probe, VkRenderPass renderPass,
+                                        VertexFormat format = VertexFormat::FULL);
 
 private:
+    // Ergebnis des CPU-Teils beim Laden eines Modells: entweder gemappter Cache oder geparstes OBJ
+    struct LoadedMesh {
+        std::string path;       // normalisiert (+ Format), Schlüssel für die MeshRegistry
+        std::string source;     // Modelldatei, GpuMesh::sourcePath zum Nachladen
+        MeshData mesh;
+        std::shared_ptr<MeshCache> cache;
+        VertexFormat format = VertexFormat::FULL;
+        std::vector<uint8_t> vertices;  // nur bei kompakten Formaten: schon kodierte Vertices
+        VertexQuantization quant;
+        HostMemoryTag memory;           // mesh + vertices im MemoryReport, bis der Upload durch ist
+    };
+
+    // Wartet im Hauptthread auf seinen CPU-Teil und macht dann die Vulkan-Arbeit
+    struct GpuJob {
+        std::function<bool()> ready;
+        std::function<void()> run;
+    };
+
+    // Lädt ein OBJ über den Mesh-Cache (oder den OBJ-Parser, falls der Cache fehlt/veraltet ist).
+    // Kein Vulkan - läuft auf den Worker-Threads
+    // Bei kompakten Formaten wird auch gleich auf dem Worker kodiert
+    static LoadedMesh loadMeshData(const std::string& modelPath, VertexFormat format);
+    std::shared_future<LoadedMesh> loadMeshAsync(const char* modelPath, VertexFormat format = VertexFormat::FULL);
+    // Registry-Schlüssel: normalisierter Pfad, bei kompakten Formaten mit "#format"
+    static std::string meshKey(const std::string& modelPath, VertexFormat format);
+    std::shared_future<ImageData> loadImageAsync(const char* texturePath);
+
+    template<typename T>
+    AssetHandle<T> enqueueGpuJob(std::function<bool()> ready, std::function<T()> build);
+
+    // GPU-Teil der Skybox: Würfel-Mesh, Pipeline und CubeMap aus den fertigen Faces
+    RenderObject buildSkybox(VkRenderPass renderPass, const std::array<ImageData, 6>& faces);
+
+    // Lädt Vertex- und Index-Buffer eines Meshes hoch (oder nimmt sie aus der
+    // MeshRegistry) und trägt sie in obj ein
+    void uploadMesh(const MeshData& mesh, RenderObject& obj, const std::string& path = "");
+    void uploadMesh(const LoadedMesh& mesh, RenderObject& obj);
+    // Sucht das Mesh per Inhalts-Hash in der Registry, lädt es sonst hoch.
+    // indexCount == 0 -> nicht indiziert
+    // vertexData liegt schon in format vor
+    // lods/Bounds nur bei Modellen, ohne LODs wird immer der ganze Index-Bereich gezeichnet
+    // meshlets nur bei großen Modellen (MeshletBuilder), beziehen sich auf LOD 0
+    std::shared_ptr<GpuMesh> acquireMesh(const std::string& path,
+                                         const void* vertexData, uint32_t vertexCount,
+                                         VertexFormat format, const VertexQuantization& quant,
+                                         const void* indexData, uint32_t indexCount,
+                                         VkIndexType indexType,
+                                         const std::vector<MeshLod>& lods = {},
+                                         const glm::vec3& boundsMin = glm::vec3(0.0f),
+                                         const glm::vec3& boundsMax = glm::vec3(0.0f),
+                                         const std::vector<Meshlet>& meshlets = {});
+    // Variante mit 32 Bit Indices, wählt selbst 16 Bit wenn möglich
+    std::shared_ptr<GpuMesh> acquireMesh(const std::string& path,
+                                         const void* vertexData, uint32_t vertexCount,
+                                         VertexFormat format, const VertexQuantization& quant,
+                                         const std::vector<uint32_t>& indices,
+                                         const std::vector<MeshLod>& lods = {},
+                                         const glm::vec3& boundsMin = glm::vec3(0.0f),
+                                         const glm::vec3& boundsMax = glm::vec3(0.0f),
+                                         const std::vector<Meshlet>& meshlets = {});
+    static void assignMesh(const std::shared_ptr<GpuMesh>& mesh, RenderObject& obj);
+    // Shaderpfad passend zum Modus (siehe bindlessShaderPath)
+    std::string shaderPath(const std::string& path) const;
+    // Textur aus dem TextureManager, lädt image nur hoch wenn path noch fehlt
+    std::shared_ptr<Texture> acquireTexture(const std::string& path,
+                                            const std::shared_future<ImageData>& image);
+
     VkPhysicalDevice _physicalDevice;
     VkDevice _device;
     VkCommandPool _commandPool;
@@ -79,7 +256,45 @@ private:
     VkFormat _depthFormat;
     VkDescriptorSetLayout _descriptorSetLayout;
     VkDescriptorSetLayout _litDescriptorSetLayout;
+    VkDescriptorSetLayout _textureSetLayout = VK_NULL_HANDLE;
+    bool _bindless = false;
 
     InitBuffer _buff;
-    LoadObj _loader;
-};
\ No newline at end of file
+    MeshRegistry _meshRegistry;
+    UploadManager* _uploadManager;
+    TextureManager _textureManager;
+    ThreadPool _pool;
+    std::deque<GpuJob> _gpuJobs;
+    std::unordered_map<std::string, std::shared_future<LoadedMesh>> _pendingMeshLoads;
+    std::unordered_map<std::string, std::shared_future<ImageData>> _pendingImageLoads;
+};
+
+template<typename T>
+AssetHandle<T> ObjectFactory::enqueueGpuJob(std::function<bool()> ready, std::function<T()> build) {
+    auto promise = std::make_shared<std::promise<T>>();
+    AssetHandle<T> handle(this, promise->get_future().share());
+
+    GpuJob job;
+    job.ready = std::move(ready);
+    job.run = [promise, build = std::move(build)]() {
+        // Fehler (auch aus den Worker-Threads) landen beim Aufrufer von get()
+        try {
+            promise->set_value(build());
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    };
+    _gpuJobs.push_back(std::move(job));
+    return handle;
+}
+
+template<typename T>
+T AssetHandle<T>::get() {
+    if (!_future.valid()) {
+        throw std::runtime_error("AssetHandle::get: handle is empty");
+    }
+    while (!ready()) {
+        _factory->processUploads(true);
+    }
+    return _future.get();
+}
\ No newline at end of file
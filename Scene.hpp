@@ -6,9 +6,13 @@
 #include <glm/glm.hpp>
 #include "helper/Rendering/GraphicsPipeline.hpp"
 #include "helper/Texture/Texture.hpp"
+#include "helper/ObjectLoading/MeshRegistry.hpp"
+#include "helper/ObjectLoading/MeshSimplifier.hpp"
+#include "helper/ObjectBitset.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
-#include <unordered_set>
+#include <memory>
+#include <stdexcept>
 
 // Licht-Daten für Shader
 struct PointLight {
@@ -28,21 +32,64 @@ struct LitUniformBufferObject {
 };
 
 struct RenderObject {
+    std::shared_ptr<GpuMesh> mesh;  // geteilt über die MeshRegistry, Handles unten nur Kopien
     VkBuffer vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
     uint32_t vertexCount = 0;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    uint32_t indexCount = 0;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+    VertexFormat vertexFormat = VertexFormat::FULL;
+    VertexQuantization quant;           // landet zusammen mit der Modellmatrix in den Push Constants
+    std::vector<MeshLod> lods;          // Kopie der LOD-Kette des Meshes, leer = nur indexCount
+    glm::vec3 boundsCenter{0.0f};       // Bounding Sphere im Objektraum
+    float boundsRadius = 0.0f;
+    VkBuffer meshletBuffer = VK_NULL_HANDLE;    // nur bei großen Meshes, dann per MeshletCuller
+    uint32_t meshletCount = 0;
     VkImageView textureImageView = VK_NULL_HANDLE;
     VkSampler textureSampler = VK_NULL_HANDLE;
-    Texture* texture = nullptr;
+    std::shared_ptr<Texture> texture;   // geteilt über den TextureManager
     GraphicsPipeline* pipeline = nullptr;
-    glm::mat4 modelMatrix = glm::mat4(1.0f);
     VkBuffer instanceBuffer = VK_NULL_HANDLE;
     uint32_t instanceCount = 1;
-    bool isSnow = false;
-    bool isLit = false;
-    bool isDeferred = false; 
 };
 
+// Was Frame und MeshletCuller pro Draw lesen, gepackt ohne shared_ptr/vector: Scene hält
+// es parallel zu _objects und zieht es bei refreshMesh/refreshTexture nach
+struct DrawItem {
+    static constexpr uint32_t MAX_LODS = 1 + sizeof(MeshSimplifier::LOD_RATIOS) / sizeof(float);
+
+    GraphicsPipeline* pipeline = nullptr;
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;     // VK_NULL_HANDLE = ausgelagert oder Platzhalter
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    VkBuffer meshletBuffer = VK_NULL_HANDLE;
+    VkBuffer instanceBuffer = VK_NULL_HANDLE;
+    VkImageView textureImageView = VK_NULL_HANDLE;
+    VkSampler textureSampler = VK_NULL_HANDLE;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t meshletCount = 0;
+    uint32_t instanceCount = 1;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+    uint32_t lodCount = 0;                      // 0 = nur indexCount
+    VertexQuantization quant;
+    MeshLod lods[MAX_LODS];
+
+    // Indices von LOD 0 (darauf beziehen sich die Meshlets)
+    uint32_t baseIndexCount() const { return lodCount == 0 ? indexCount : lods[0].indexCount; }
+};
+
+// Bounding Sphere in Weltkoordinaten: xyz Mittelpunkt, w Radius (größte Achsen-Skalierung
+// von model), w = 0 ohne Bounds
+inline glm::vec4 worldBoundingSphere(const glm::mat4& model, const glm::vec3& center, float radius) {
+    if (radius <= 0.0f) {
+        return glm::vec4(0.0f);
+    }
+    float scale = std::max(glm::length(glm::vec3(model[0])),
+                  std::max(glm::length(glm::vec3(model[1])),
+                           glm::length(glm::vec3(model[2]))));
+    return glm::vec4(glm::vec3(model * glm::vec4(center, 1.0f)), radius * scale);
+}
+
 // Deferred Render Object - hat 2 Pipelines
 struct DeferredRenderObject {
     RenderObject depthPass;    // Subpass 0
@@ -57,50 +104,114 @@ struct LightSourceObject {
     float intensity;
     float radius;
     RenderObject renderObject; 
+
+    // kleiner Marker an der Lichtposition (sein Objekt in der Szene)
+    static constexpr float MARKER_SCALE = 0.02f;
+    glm::mat4 markerMatrix() const {
+        return glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(MARKER_SCALE));
+    }
 };
 struct DeferredObjectInfo {
     size_t depthPassIndex;
     size_t gbufferPassIndex;
 };
 
+// Art eines Objekts: bestimmt Pass und Liste seines Descriptor Sets
+enum class ObjectKind : uint8_t {
+    Normal,
+    Snow,
+    Lit,
+    Deferred,
+    MirrorMark,
+    MirrorBlend
+};
+
+// Beim Hinzufügen vergebener Platz eines Objekts, damit Frame beim Aufzeichnen nicht
+// für jedes Objekt über alle davor zählen muss
+struct ObjectSlot {
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    ObjectKind kind = ObjectKind::Normal;
+    // Normal/Mirror*: Rang unter den normalen Sets (hinter dem Deferred-Block),
+    // Snow/Lit: Index in deren Sets, Deferred: Index der DeferredObjectInfo
+    uint32_t slot = NO_SLOT;
+    bool gbufferPass = false;   // Deferred: G-Buffer-Pass statt Depth Prepass
+};
+
 class Scene {
 public:
-    void setRenderObject(RenderObject obj) {
-        if (obj.isSnow) {
-            _snowObjectIndices.push_back(_objects.size());
-        }
-        if (obj.isLit) {
-            _litObjectIndices.push_back(_objects.size());
-        }
-        if (obj.isDeferred) {
-            _deferredObjectIndices.push_back(_objects.size());
+    // model: Startwert der Transformation, danach nur noch über updateObject.
+    // kind: Normal, Snow oder Lit, für Deferred/Spiegel gibt es eigene Funktionen
+    void setRenderObject(const RenderObject& obj, const glm::mat4& model = glm::mat4(1.0f),
+                         ObjectKind kind = ObjectKind::Normal) {
+        if (kind != ObjectKind::Normal && kind != ObjectKind::Snow && kind != ObjectKind::Lit) {
+            throw std::runtime_error("Scene::setRenderObject: use setDeferredRenderObject/setMirror*Object");
         }
-        _objects.push_back(obj);
+        pushObject(obj, kind, model);
     }
     
     //Deferred Objekt hinzufügen
-    void setDeferredRenderObject(DeferredRenderObject& deferredObj) {
+    void setDeferredRenderObject(DeferredRenderObject& deferredObj, const glm::mat4& model = glm::mat4(1.0f)) {
     // Depth Pass Object
-    deferredObj.depthPass.isDeferred = true;
-    _objects.push_back(deferredObj.depthPass);
-    size_t depthIndex = _objects.size() - 1;
+    size_t depthIndex = pushObject(deferredObj.depthPass, ObjectKind::Deferred, model);
     
     // G-Buffer Pass Object
-    deferredObj.gbufferPass.isDeferred = true;
-    _objects.push_back(deferredObj.gbufferPass);
-    size_t gbufferIndex = _objects.size() - 1;
+    size_t gbufferIndex = pushObject(deferredObj.gbufferPass, ObjectKind::Deferred, model);
     
     
     // Speichere die Indices
     DeferredObjectInfo info;
     info.depthPassIndex = depthIndex;
     info.gbufferPassIndex = gbufferIndex;
+    const uint32_t infoIndex = static_cast<uint32_t>(_deferredObjectInfos.size());
     _deferredObjectInfos.push_back(info);
     
-    _deferredObjectIndices.push_back(depthIndex);
-    _deferredObjectIndices.push_back(gbufferIndex);
+    _objectSlots[depthIndex].slot = infoIndex;
+    _objectSlots[gbufferIndex].slot = infoIndex;
+    _objectSlots[gbufferIndex].gbufferPass = true;
 }
     
+    // Progressives Laden: Platzhalter reservieren Index und Descriptor Set des Objekts
+    // (die Art steht damit fest), gezeichnet und in Descriptor Sets eingetragen
+    // wird es erst nach resolveObject. Rückgabe: Index des Objekts
+    size_t setPendingRenderObject(const RenderObject& placeholder, ObjectKind kind = ObjectKind::Normal) {
+        setRenderObject(placeholder, glm::mat4(1.0f), kind);
+        markPending(_objects.size() - 1);
+        return _objects.size() - 1;
+    }
+
+    // Rückgabe: Index für getDeferredInfo
+    size_t setPendingDeferredObject(DeferredRenderObject& placeholder) {
+        setDeferredRenderObject(placeholder);
+        const DeferredObjectInfo& info = _deferredObjectInfos.back();
+        markPending(info.depthPassIndex);
+        markPending(info.gbufferPassIndex);
+        return _deferredObjectInfos.size() - 1;
+    }
+
+    // Ersetzt den Platzhalter durch das fertige Objekt an der Stelle model
+    void resolveObject(size_t idx, const RenderObject& obj, const glm::mat4& model) {
+        if (idx >= _objects.size() || !_pending.test(idx)) {
+            throw std::runtime_error("Scene::resolveObject: object is not pending");
+        }
+        _objects[idx] = obj;
+        _draws[idx] = makeDraw(obj);
+        _modelMatrices[idx] = model;
+        _localBounds[idx] = glm::vec4(obj.boundsCenter, obj.boundsRadius);
+        _worldBounds[idx] = worldBoundingSphere(model, obj.boundsCenter, obj.boundsRadius);
+        _pending.reset(idx);
+        _pendingCount--;
+    }
+
+    void resolveDeferredObject(size_t infoIndex, DeferredRenderObject& obj, const glm::mat4& model) {
+        resolveObject(_deferredObjectInfos[infoIndex].depthPassIndex, obj.depthPass, model);
+        resolveObject(_deferredObjectInfos[infoIndex].gbufferPassIndex, obj.gbufferPass, model);
+    }
+
+    bool isPending(size_t idx) const { return _pending.test(idx); }
+    const ObjectBitset& getPendingObjects() const { return _pending; }
+    size_t getPendingCount() const { return _pendingCount; }
+
     void addLightSource(const LightSourceObject& light) {
         if (_lights.size() >= 4) {
             return;
@@ -111,8 +222,6 @@ public:
     void updateLightPosition(size_t index, const glm::vec3& newPos) {
         if (index < _lights.size()) {
             _lights[index].position = newPos;
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), newPos);
-            _lights[index].renderObject.modelMatrix = model;
         }
     }
     
@@ -120,34 +229,17 @@ public:
     size_t getLightCount() const { return _lights.size(); }
     
     size_t getObjectCount() const { return _objects.size(); }
-    size_t getSnowObjectCount() const { return _snowObjectIndices.size(); }
-    size_t getNormalObjectCount() const { 
-        return _objects.size() - _snowObjectIndices.size() - _litObjectIndices.size() 
-               - _deferredObjectIndices.size(); 
-    }
-    size_t getLitObjectCount() const { return _litObjectIndices.size(); }
+    size_t getSnowObjectCount() const { return _snowSlotCount; }
+    // normale Objekte inklusive Spiegel (die haben auch ein normales Set)
+    size_t getNormalObjectCount() const { return _normalSlotCount; }
+    size_t getLitObjectCount() const { return _litSlotCount; }
     size_t getDeferredObjectCount() const { return _deferredObjectInfos.size(); }
     
-    size_t getLitDescriptorSetCount() const {
-        // Lit objects die NICHT deferred sind
-        size_t count = 0;
-        for (size_t idx : _litObjectIndices) {
-            if (!_objects[idx].isDeferred) {
-                count++;
-            }
-        }
-        return count;
-    }
+    // Lit objects die NICHT deferred sind
+    size_t getLitDescriptorSetCount() const { return _litSlotCount; }
 
-    size_t getNormalDescriptorSetCount() const {
-        size_t count = 0;
-        for (size_t i = 0; i < _objects.size(); i++) {
-            if (!_objects[i].isSnow && !_objects[i].isLit && !_objects[i].isDeferred) {
-                count++;
-            }
-        }
-        return count;
-    }
+    // ohne den Deferred-Block (siehe getDeferredDescriptorSetCount)
+    size_t getNormalDescriptorSetCount() const { return _normalSlotCount; }
 
     size_t getDeferredDescriptorSetCount() const {
         // Deferred objects nutzen normale descriptor sets
@@ -156,22 +248,36 @@ public:
     }
 
     const RenderObject& getObject(size_t index) const { return _objects[index]; }
-    RenderObject& getObjectMutable(size_t idx) { return _objects[idx]; }
+    const DrawItem& getDraw(size_t index) const { return _draws[index]; }
     
-    bool isSnowObject(size_t index) const {
-        return std::find(_snowObjectIndices.begin(), _snowObjectIndices.end(), index) 
-               != _snowObjectIndices.end();
-    }
-    
-    bool isLitObject(size_t index) const {
-        return std::find(_litObjectIndices.begin(), _litObjectIndices.end(), index) 
-               != _litObjectIndices.end();
-    }
-    
-    bool isDeferredObject(size_t index) const {
-        return std::find(_deferredObjectIndices.begin(), _deferredObjectIndices.end(), index) 
-               != _deferredObjectIndices.end();
+    const ObjectSlot& getObjectSlot(size_t index) const { return _objectSlots[index]; }
+
+    // Index des Descriptor Sets von Objekt index in der Liste seiner Art: Frame::_descriptorSets
+    // für Deferred (erst die Depth-/G-Buffer-Paare) und Normal/Mirror (danach), sonst die
+    // Snow- bzw. Lit-Sets. SIZE_MAX = kein Set (Deferred ohne DeferredObjectInfo)
+    size_t getDescriptorSetIndex(size_t index) const {
+        const ObjectSlot& slot = _objectSlots[index];
+        switch (slot.kind) {
+            case ObjectKind::Deferred:
+                if (slot.slot == ObjectSlot::NO_SLOT) {
+                    return SIZE_MAX;
+                }
+                return static_cast<size_t>(slot.slot) * 2 + (slot.gbufferPass ? 1 : 0);
+            case ObjectKind::Snow:
+            case ObjectKind::Lit:
+                return slot.slot;
+            default:
+                return getDeferredDescriptorSetCount() + slot.slot;
+        }
     }
+
+    bool isSnowObject(size_t index) const { return _snowObjects.test(index); }
+    bool isLitObject(size_t index) const { return _litObjects.test(index); }
+    bool isDeferredObject(size_t index) const { return _deferredObjects.test(index); }
+    const ObjectBitset& getSnowObjects() const { return _snowObjects; }
+    const ObjectBitset& getLitObjects() const { return _litObjects; }
+    const ObjectBitset& getDeferredObjects() const { return _deferredObjects; }
+    const ObjectBitset& getMirrorObjects() const { return _mirrorObjects; }
     
     // NEU: Hilfsmethoden für Deferred Rendering
     const DeferredObjectInfo& getDeferredInfo(size_t infoIndex) const {
@@ -185,22 +291,106 @@ public:
     const RenderObject& getGBufferPassObject(size_t infoIndex) const {
         return _objects[_deferredObjectInfos[infoIndex].gbufferPassIndex];
     }
+
+    const DrawItem& getDepthPassDraw(size_t infoIndex) const {
+        return _draws[_deferredObjectInfos[infoIndex].depthPassIndex];
+    }
+
+    const DrawItem& getGBufferPassDraw(size_t infoIndex) const {
+        return _draws[_deferredObjectInfos[infoIndex].gbufferPassIndex];
+    }
     
+    // Nach einem Austausch durch den TextureStreamer: neue View und Sampler der Textur
+    // in alle Objekte übernehmen, die sie benutzen (Descriptor Sets werden pro Frame geschrieben)
+    void refreshTexture(const Texture* texture) {
+        auto refresh = [texture](RenderObject& obj, DrawItem* draw) {
+            if (obj.texture.get() == texture) {
+                obj.textureImageView = obj.texture->getImageView();
+                obj.textureSampler = obj.texture->getSampler();
+                if (draw) {
+                    draw->textureImageView = obj.textureImageView;
+                    draw->textureSampler = obj.textureSampler;
+                }
+            }
+        };
+        for (size_t i = 0; i < _objects.size(); i++) {
+            refresh(_objects[i], &_draws[i]);
+        }
+        for (size_t i = 0; i < _reflectedObjects.size(); i++) {
+            refresh(_reflectedObjects[i], &_reflectedDraws[i]);
+        }
+        for (LightSourceObject& light : _lights) {
+            refresh(light.renderObject, nullptr);
+        }
+        refresh(_lightingQuad, &_lightingQuadDraw);
+    }
+
+    // Nach Auslagern/Nachladen durch den ResidencyManager: Buffer-Handles des Meshes in alle
+    // Objekte übernehmen (VK_NULL_HANDLE = ausgelagert, Frame überspringt das Objekt)
+    void refreshMesh(const GpuMesh* mesh) {
+        auto refresh = [mesh](RenderObject& obj, DrawItem* draw) {
+            if (obj.mesh.get() == mesh) {
+                obj.vertexBuffer = mesh->vertexBuffer;
+                obj.indexBuffer = mesh->indexBuffer;
+                obj.meshletBuffer = mesh->meshletBuffer;
+                if (draw) {
+                    draw->vertexBuffer = obj.vertexBuffer;
+                    draw->indexBuffer = obj.indexBuffer;
+                    draw->meshletBuffer = obj.meshletBuffer;
+                }
+            }
+        };
+        for (size_t i = 0; i < _objects.size(); i++) {
+            refresh(_objects[i], &_draws[i]);
+        }
+        for (size_t i = 0; i < _reflectedObjects.size(); i++) {
+            refresh(_reflectedObjects[i], &_reflectedDraws[i]);
+        }
+        for (LightSourceObject& light : _lights) {
+            refresh(light.renderObject, nullptr);
+        }
+        refresh(_lightingQuad, &_lightingQuadDraw);
+    }
+
+    // Transformationen: nur die Matrix setzen und das Objekt als geändert markieren,
+    // die Weltraum-Bounds rechnet flushTransforms einmal pro Frame für alle geänderten nach
     void updateObject(size_t idx, const glm::mat4& newModel) {
         if (idx < _objects.size()) {
-            _objects[idx].modelMatrix = newModel;
+            _modelMatrices[idx] = newModel;
+            _dirtyTransforms.set(idx);
+        }
+    }
+
+    // Mehrere Objekte auf einmal (z.B. alle Animationen eines Frames)
+    void updateObjects(const size_t* indices, const glm::mat4* models, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            updateObject(indices[i], models[i]);
         }
     }
     
     //Update deferred object (beide Passes gleichzeitig)
     void updateDeferredObject(size_t infoIndex, const glm::mat4& newModel) {
         if (infoIndex < _deferredObjectInfos.size()) {
-            size_t depthIdx = _deferredObjectInfos[infoIndex].depthPassIndex;
-            size_t gbufferIdx = _deferredObjectInfos[infoIndex].gbufferPassIndex;
-            _objects[depthIdx].modelMatrix = newModel;
-            _objects[gbufferIdx].modelMatrix = newModel;
+            updateObject(_deferredObjectInfos[infoIndex].depthPassIndex, newModel);
+            updateObject(_deferredObjectInfos[infoIndex].gbufferPassIndex, newModel);
         }
     }
+
+    // Weltraum-Bounds aller seit dem letzten Aufruf geänderten Objekte neu berechnen,
+    // vor allem, was getWorldBounds liest (Residency, Streaming, LOD-Auswahl)
+    void flushTransforms() {
+        _dirtyTransforms.forEach([this](size_t idx) {
+            const glm::vec4& local = _localBounds[idx];
+            _worldBounds[idx] = worldBoundingSphere(_modelMatrices[idx], glm::vec3(local), local.w);
+        });
+        _dirtyTransforms.clear();
+    }
+
+    // Heiße Daten pro Draw, parallel zu _objects
+    const glm::mat4& getModelMatrix(size_t idx) const { return _modelMatrices[idx]; }
+    const glm::vec4& getWorldBounds(size_t idx) const { return _worldBounds[idx]; }
+    const std::vector<glm::vec4>& getWorldBounds() const { return _worldBounds; }
+    bool hasDirtyTransforms() const { return _dirtyTransforms.any(); }
     
     VkRenderPass getRenderPass() const {
         if (_objects.empty() || !_objects[0].pipeline) return VK_NULL_HANDLE;
@@ -225,31 +415,54 @@ public:
         return _descriptorSetLayout;
     }
 
+    // Bindless-Modus: Pipelines mit den .bindless-Shadervarianten erstellen (z.B. Spiegelungen),
+    // textureSetLayout ist dann Set 1 ihrer Pipeline Layouts
+    void setBindless(bool bindless, VkDescriptorSetLayout textureSetLayout = VK_NULL_HANDLE) {
+        _bindless = bindless;
+        _textureSetLayout = textureSetLayout;
+    }
+    bool isBindless() const { return _bindless; }
+    VkDescriptorSetLayout getTextureSetLayout() const { return _textureSetLayout; }
+
     //Lighting Quad für deferred
     void setLightingQuad(const RenderObject& quad) {
         _lightingQuad = quad;
+        _lightingQuadDraw = makeDraw(quad);
         _hasLightingQuad = true;
     }
     
     bool hasLightingQuad() const { return _hasLightingQuad; }
     const RenderObject& getLightingQuad() const { return _lightingQuad; }
+    const DrawItem& getLightingQuadDraw() const { return _lightingQuadDraw; }
 
     // Mirror-spezifische Methoden
-    void setMirrorMarkObject(const RenderObject& obj) {
-        _mirrorMarkIndices.push_back(_objects.size());
-        _objects.push_back(obj);
+    void setMirrorMarkObject(const RenderObject& obj, const glm::mat4& model) {
+        _mirrorMarkIndices.push_back(pushObject(obj, ObjectKind::MirrorMark, model));
     }
 
-    void setMirrorBlendObject(const RenderObject& obj) {
-        _mirrorBlendIndices.push_back(_objects.size());
-        _objects.push_back(obj);
+    void setMirrorBlendObject(const RenderObject& obj, const glm::mat4& model) {
+        _mirrorBlendIndices.push_back(pushObject(obj, ObjectKind::MirrorBlend, model));
     }
 
-    void addReflectedObject(const RenderObject& obj, size_t originalIndex) {
+    // Spiegelungen liegen nicht in den SoA-Daten der Szene, ihre Matrizen setzt das MirrorSystem
+    void addReflectedObject(const RenderObject& obj, size_t originalIndex, const glm::mat4& model = glm::mat4(1.0f)) {
         _reflectedObjects.push_back(obj);
+        _reflectedDraws.push_back(makeDraw(obj));
+        _reflectedModelMatrices.push_back(model);
+        _reflectedWorldBounds.push_back(worldBoundingSphere(model, obj.boundsCenter, obj.boundsRadius));
         _reflectedDescriptorIndices.push_back(originalIndex);
     }
 
+    // Ersetzt den leeren Eintrag einer noch ladenden Spiegelung
+    void setReflectedObject(size_t idx, const RenderObject& obj, const glm::mat4& model) {
+        if (idx < _reflectedObjects.size()) {
+            _reflectedObjects[idx] = obj;
+            _reflectedDraws[idx] = makeDraw(obj);
+            _reflectedModelMatrices[idx] = model;
+            _reflectedWorldBounds[idx] = worldBoundingSphere(model, obj.boundsCenter, obj.boundsRadius);
+        }
+    }
+
     const std::vector<size_t>& getMirrorMarkIndices() const { 
         return _mirrorMarkIndices; 
     }
@@ -273,8 +486,17 @@ public:
     const RenderObject& getReflectedObject(size_t idx) const { 
         return _reflectedObjects[idx]; 
     }
-    RenderObject& getReflectedObject(size_t idx){
-        return _reflectedObjects[idx];
+
+    const DrawItem& getReflectedDraw(size_t idx) const {
+        return _reflectedDraws[idx];
+    }
+
+    const glm::mat4& getReflectedModelMatrix(size_t idx) const {
+        return _reflectedModelMatrices[idx];
+    }
+
+    const glm::vec4& getReflectedWorldBounds(size_t idx) const {
+        return _reflectedWorldBounds[idx];
     }
 
     size_t getReflectedDescriptorIndex(size_t idx) const {
@@ -282,42 +504,38 @@ public:
     }
 
     bool isMirrorObject(size_t idx) const {
-        for (size_t markIdx : _mirrorMarkIndices) {
-            if (idx == markIdx) return true;
-        }
-        for (size_t blendIdx : _mirrorBlendIndices) {
-            if (idx == blendIdx) return true;
-        }
-        return false;
+        return _mirrorObjects.test(idx);
     }
 
     bool isReflectedObject(size_t idx) const {
-        return _reflectableObjectIndices.find(idx) != _reflectableObjectIndices.end();
+        return _reflectable.test(idx);
     }
 
     void markObjectAsReflectable(size_t idx) {
-        _reflectableObjectIndices.insert(idx);
+        _reflectable.set(idx);
     }
 
     //Updatet reflektierte Objekte im Spiegel
     void updateReflectedObject(size_t index, const glm::mat4& newModel) {
         if (index < _reflectedObjects.size()) {
-            _reflectedObjects[index].modelMatrix = newModel;
+            const RenderObject& obj = _reflectedObjects[index];
+            _reflectedModelMatrices[index] = newModel;
+            _reflectedWorldBounds[index] = worldBoundingSphere(newModel, obj.boundsCenter, obj.boundsRadius);
         }
     }
 
     //Render To Texture
     // Markiert ein Objekt als reflektierend (es selbst wird nicht in der Cubemap gerendert)
     void markObjectAsReflective(size_t index) {
-        _reflectiveObjectIndices.insert(index);
+        _reflective.set(index);
     }
 
     bool isReflectiveObject(size_t index) const {
-        return _reflectiveObjectIndices.find(index) != _reflectiveObjectIndices.end();
+        return _reflective.test(index);
     }
 
-    const std::unordered_set<size_t>& getReflectiveObjectIndices() const {
-        return _reflectiveObjectIndices;
+    const ObjectBitset& getReflectiveObjects() const {
+        return _reflective;
     }
 
     // Update-Frequenz für Reflexionen (nicht jeden Frame)
@@ -330,29 +548,111 @@ public:
     }
 
 private:
-   
+    static DrawItem makeDraw(const RenderObject& obj) {
+        DrawItem draw;
+        draw.pipeline = obj.pipeline;
+        draw.vertexBuffer = obj.vertexBuffer;
+        draw.indexBuffer = obj.indexBuffer;
+        draw.meshletBuffer = obj.meshletBuffer;
+        draw.instanceBuffer = obj.instanceBuffer;
+        draw.textureImageView = obj.textureImageView;
+        draw.textureSampler = obj.textureSampler;
+        draw.vertexCount = obj.vertexCount;
+        draw.indexCount = obj.indexCount;
+        draw.meshletCount = obj.meshletCount;
+        draw.instanceCount = obj.instanceCount;
+        draw.indexType = obj.indexType;
+        draw.quant = obj.quant;
+        // längere Ketten (fremder Mesh-Cache) verlieren nur ihre gröbsten Stufen
+        draw.lodCount = static_cast<uint32_t>(std::min<size_t>(obj.lods.size(), DrawItem::MAX_LODS));
+        std::copy(obj.lods.begin(), obj.lods.begin() + draw.lodCount, draw.lods);
+        return draw;
+    }
 
+    // Hängt obj an und vergibt seinen Platz in der Slot-Tabelle (Deferred: setzt der Aufrufer)
+    size_t pushObject(const RenderObject& obj, ObjectKind kind, const glm::mat4& model) {
+        const size_t idx = _objects.size();
+        ObjectSlot slot;
+        slot.kind = kind;
+        switch (slot.kind) {
+            case ObjectKind::Snow:
+                slot.slot = static_cast<uint32_t>(_snowSlotCount++);
+                _snowObjects.set(idx);
+                break;
+            case ObjectKind::Lit:
+                slot.slot = static_cast<uint32_t>(_litSlotCount++);
+                _litObjects.set(idx);
+                break;
+            case ObjectKind::Deferred:
+                _deferredObjects.set(idx);
+                break;
+            case ObjectKind::MirrorMark:
+            case ObjectKind::MirrorBlend:
+                slot.slot = static_cast<uint32_t>(_normalSlotCount++);
+                _mirrorObjects.set(idx);
+                break;
+            default:
+                slot.slot = static_cast<uint32_t>(_normalSlotCount++);
+                break;
+        }
+        _objects.push_back(obj);
+        _draws.push_back(makeDraw(obj));
+        _objectSlots.push_back(slot);
+        _modelMatrices.push_back(model);
+        _localBounds.emplace_back(obj.boundsCenter, obj.boundsRadius);
+        _worldBounds.push_back(worldBoundingSphere(model, obj.boundsCenter, obj.boundsRadius));
+        // Bitsets wachsen beim Setzen mit, ungesetzte Objekte dahinter lesen sich als 0
+        return idx;
+    }
+
+    void markPending(size_t idx) {
+        _pending.set(idx);
+        _pendingCount++;
+    }
+
+    // Kalte Einrichtungsdaten (geteilte Meshes/Texturen, Bounds), für Residency und Streaming
     std::vector<RenderObject> _objects;
+    std::vector<DrawItem> _draws;           // parallel zu _objects, das Einzige, was Frame pro Draw liest
+    std::vector<ObjectSlot> _objectSlots;   // parallel zu _objects, beim Hinzufügen vergeben
+
+    // SoA, parallel zu _objects: was sich pro Frame ändert bzw. pro Objekt gelesen wird
+    std::vector<glm::mat4> _modelMatrices;
+    std::vector<glm::vec4> _localBounds;    // Bounding Sphere im Objektraum (xyz, w Radius)
+    std::vector<glm::vec4> _worldBounds;    // siehe worldBoundingSphere, aktuell nach flushTransforms
+    ObjectBitset _dirtyTransforms;          // Matrix geändert, Weltraum-Bounds veraltet
+    ObjectBitset _pending;                  // Platzhalter
+    // Art der Objekte (siehe ObjectKind), Normal = in keiner der Mengen
+    ObjectBitset _snowObjects;
+    ObjectBitset _litObjects;
+    ObjectBitset _deferredObjects;
+    ObjectBitset _mirrorObjects;
+    size_t _pendingCount = 0;
     std::vector<LightSourceObject> _lights;
-    std::vector<size_t> _snowObjectIndices;
-    std::vector<size_t> _litObjectIndices;
-    std::vector<size_t> _deferredObjectIndices;
+    size_t _normalSlotCount = 0;
+    size_t _snowSlotCount = 0;
+    size_t _litSlotCount = 0;
     std::vector<DeferredObjectInfo> _deferredObjectInfos;
     
     // Lighting Quad
     RenderObject _lightingQuad;
+    DrawItem _lightingQuadDraw;
     bool _hasLightingQuad = false;
     
     // Mirror data
     std::vector<RenderObject> _reflectedObjects;
+    std::vector<DrawItem> _reflectedDraws;              // parallel zu _reflectedObjects
+    std::vector<glm::mat4> _reflectedModelMatrices;     // parallel zu _reflectedObjects
+    std::vector<glm::vec4> _reflectedWorldBounds;       // parallel zu _reflectedObjects
     std::vector<size_t> _reflectedDescriptorIndices;
     std::vector<size_t> _mirrorMarkIndices;
     std::vector<size_t> _mirrorBlendIndices;
-    std::unordered_set<size_t> _reflectableObjectIndices;
+    ObjectBitset _reflectable;
 
     //Render to texture
-    std::unordered_set<size_t> _reflectiveObjectIndices;
+    ObjectBitset _reflective;
     uint32_t _reflectionUpdateInterval = 10; // Alle 10 Frames updaten
     
     VkDescriptorSetLayout _descriptorSetLayout = VK_NULL_HANDLE;
+    bool _bindless = false;
+    VkDescriptorSetLayout _textureSetLayout = VK_NULL_HANDLE;
 };
\ No newline at end of file
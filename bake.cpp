@@ -0,0 +1,172 @@
+//bake.cpp
+// Offline-Tool (make bake, ausführen mit make bake-assets): backt alle Modelle und Texturen in GPU-fertige Binärdateien,
+// die ObjectFactory/Texture/CubeMap beim Start bevorzugt laden
+//  - models/*.obj          -> .obj.bmesh (indiziert, optimiert, LODs, Meshlets, Bounds; siehe MeshCache)
+//  - textures/**/*.jpg|png -> .btex (komplette Mip-Kette, blockkomprimiert; siehe BakedTexture)
+// Gebacken wird nur, was fehlt oder nicht mehr zum Inhalt der Quelle passt (Hash),
+// --force backt alles neu. --compress=none|auto|bc1|bc3|bc7 wählt das Texturformat
+// (auto: BC1 für opake Texturen, sonst BC7).
+#include <cstdlib>
+#include <cctype>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <future>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+
+#include "helper/ObjectLoading/loadObj.hpp"
+#include "helper/ObjectLoading/MeshCache.hpp"
+#include "helper/Texture/BakedTexture.hpp"
+#include "helper/Texture/BlockCompression.hpp"
+#include "helper/Threading/ThreadPool.hpp"
+
+namespace {
+    enum class BakeResult { UP_TO_DATE, BAKED, FAILED };
+
+    struct BakeOutcome {
+        BakeResult result;
+        std::string detail;     // z.B. Format und Ersparnis einer Textur
+    };
+
+    struct BakeJob {
+        std::string path;
+        std::future<BakeOutcome> outcome;
+    };
+
+    bool hasExtension(const std::filesystem::path& path, std::initializer_list<const char*> extensions) {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        for (const char* candidate : extensions) {
+            if (ext == candidate) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    BakeResult bakeMesh(const std::string& path, bool force) {
+        if (!force) {
+            MeshCache cache;
+            if (cache.open(path)) {
+                return BakeResult::UP_TO_DATE;
+            }
+        }
+        LoadObj loader;
+        MeshData mesh;
+        auto start = std::chrono::high_resolution_clock::now();
+        if (!loader.objLoader(path, mesh)) {
+            return BakeResult::FAILED;
+        }
+        float coldMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        return MeshCache::write(path, mesh, coldMs) ? BakeResult::BAKED : BakeResult::FAILED;
+    }
+
+    // "BC1, 2.7 MB statt 21.3 MB (8.0x)" relativ zur unkomprimierten RGBA8-Mip-Kette
+    std::string describeTexture(const std::string& path) {
+        ImageData baked;
+        if (!BakedTexture::load(path, baked)) {
+            return "";
+        }
+        if (!BlockCompression::isCompressed(baked.format)) {
+            return BlockCompression::formatName(baked.format);
+        }
+        ImageData rgba = baked;
+        rgba.format = VK_FORMAT_R8G8B8A8_SRGB;
+        std::ostringstream detail;
+        detail << std::fixed << std::setprecision(1) << BlockCompression::formatName(baked.format) << ", "
+               << baked.byteSize() / (1024.0 * 1024.0) << " MB statt "
+               << rgba.byteSize() / (1024.0 * 1024.0) << " MB ("
+               << double(rgba.byteSize()) / double(baked.byteSize()) << "x)";
+        return detail.str();
+    }
+
+    BakeOutcome bakeTexture(const std::string& path, bool force, TextureCompression compression) {
+        if (!force && BakedTexture::isUpToDate(path, compression)) {
+            return {BakeResult::UP_TO_DATE, describeTexture(path)};
+        }
+        try {
+            if (!BakedTexture::bake(path, compression)) {
+                return {BakeResult::FAILED, ""};
+            }
+            return {BakeResult::BAKED, describeTexture(path)};
+        } catch (const std::exception& e) {
+            std::cerr << "  " << e.what() << std::endl;
+            return {BakeResult::FAILED, ""};
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bool force = false;
+    TextureCompression compression = TextureCompression::AUTO;
+    const std::string compressFlag = "--compress=";
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        bool valid = true;
+        if (arg == "--force") {
+            force = true;
+        } else if (arg.rfind(compressFlag, 0) == 0) {
+            valid = BlockCompression::parseMode(arg.substr(compressFlag.size()), compression);
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << "Usage: " << argv[0] << " [--force] [--compress=none|auto|bc1|bc3|bc7]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::string> meshes;
+    std::vector<std::string> textures;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("models", ec)) {
+        if (entry.is_regular_file() && hasExtension(entry.path(), {".obj"})) {
+            meshes.push_back(entry.path().string());
+        }
+    }
+    for (const auto& entry : std::filesystem::recursive_directory_iterator("textures", ec)) {
+        if (entry.is_regular_file() && hasExtension(entry.path(), {".jpg", ".jpeg", ".png"})) {
+            textures.push_back(entry.path().string());
+        }
+    }
+    std::sort(meshes.begin(), meshes.end());
+    std::sort(textures.begin(), textures.end());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    ThreadPool pool;
+    std::vector<BakeJob> jobs;
+    for (const std::string& path : meshes) {
+        jobs.push_back({path, pool.submit([path, force]() { return BakeOutcome{bakeMesh(path, force), ""}; })});
+    }
+    for (const std::string& path : textures) {
+        jobs.push_back({path, pool.submit([path, force, compression]() {
+            return bakeTexture(path, force, compression);
+        })});
+    }
+
+    size_t baked = 0;
+    size_t upToDate = 0;
+    size_t failed = 0;
+    for (BakeJob& job : jobs) {
+        BakeOutcome outcome = job.outcome.get();
+        const BakeResult result = outcome.result;
+        const char* label = result == BakeResult::BAKED ? "gebacken"
+                          : result == BakeResult::UP_TO_DATE ? "aktuell" : "FEHLER";
+        std::cout << "  " << std::left << std::setw(48) << job.path << std::setw(10) << label
+                  << outcome.detail << std::endl;
+        if (result == BakeResult::BAKED) baked++;
+        else if (result == BakeResult::UP_TO_DATE) upToDate++;
+        else failed++;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Bake: " << meshes.size() << " Modelle, " << textures.size() << " Texturen -> "
+              << baked << " gebacken, " << upToDate << " aktuell, " << failed << " Fehler ("
+              << std::fixed << std::setprecision(0) << ms << " ms, " << pool.size() << " Threads)" << std::endl;
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,408 @@
+//bench.cpp
+// Benchmark-Tool (make bench), ohne Fenster/Vulkan:
+//  - obj:   tinyobj gegen FastObjParser auf allen models/*.obj (ms und MB/s)
+//  - scene: Descriptor-Slot-Tabelle der Scene gegen die früheren Zählschleifen,
+//           Weltraum-Bounds aus SoA-Daten mit Dirty-Bits gegen ein Array voller Structs
+//  - budget: Selbsttest der Budget-Belegung des ResidencyManagers (Exit-Code 1 bei Fehler)
+// Ohne Argument laufen alle, sonst nur die genannten.
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+#include "Scene.hpp"
+#include "helper/Benchmark.hpp"
+#include "helper/ResidencyManager.hpp"
+#include "helper/ObjectLoading/loadObj.hpp"
+#include "helper/ObjectLoading/FastObjParser.hpp"
+
+namespace {
+    void printParserBenchmark(const std::string& modelDir) {
+        std::vector<std::string> objFiles;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(modelDir, ec)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".obj") {
+                objFiles.push_back(entry.path().string());
+            }
+        }
+        std::sort(objFiles.begin(), objFiles.end());
+
+        std::cout << "OBJ-Parser Vergleich (" << modelDir << ", Median aus " << Benchmark::RUNS << " Läufen):" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+
+        double totalMB = 0.0;
+        double totalTiny = 0.0;
+        double totalFast = 0.0;
+        for (const std::string& path : objFiles) {
+            const double sizeMB = static_cast<double>(std::filesystem::file_size(path, ec)) / (1024.0 * 1024.0);
+
+            MeshData tinyMesh;
+            MeshData fastMesh;
+            FastObjParser::Stats stats;
+            bool ok = true;
+            const double tinyMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+                ok = ok && LoadObj::tinyObjParse(path, tinyMesh);
+            });
+            const double fastMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+                ok = ok && FastObjParser::parse(path, fastMesh, &stats);
+            });
+            if (!ok) {
+                std::cout << "  " << path << ": konnte nicht geladen werden" << std::endl;
+                continue;
+            }
+
+            // Polygone mit > 4 Ecken triangulieren beide Parser unterschiedlich, daher nur die Anzahlen
+            const bool same = tinyMesh.vertices.size() == fastMesh.vertices.size()
+                           && tinyMesh.indices.size() == fastMesh.indices.size();
+            totalMB += sizeMB;
+            totalTiny += tinyMs;
+            totalFast += fastMs;
+            std::cout << "  " << path << " (" << sizeMB << " MB): tinyobj " << tinyMs << " ms ("
+                      << sizeMB / (tinyMs / 1000.0) << " MB/s) | fast " << fastMs << " ms ("
+                      << sizeMB / (fastMs / 1000.0) << " MB/s, " << stats.threads << " Threads) | x"
+                      << Benchmark::speedup(tinyMs, fastMs)
+                      << (same ? "" : " | ABWEICHUNG") << std::endl;
+        }
+
+        if (totalTiny > 0.0 && totalFast > 0.0) {
+            std::cout << "  Gesamt: tinyobj " << totalMB / (totalTiny / 1000.0) << " MB/s | fast "
+                      << totalMB / (totalFast / 1000.0) << " MB/s" << std::endl;
+        }
+        std::cout << std::defaultfloat;
+    }
+
+    // Die Index-Listen, über die Scene und Frame vor der Slot-Tabelle gesucht bzw. gezählt haben
+    struct LinearLookup {
+        std::vector<size_t> snow;
+        std::vector<size_t> lit;
+        std::vector<size_t> deferred;
+        std::vector<size_t> mirrorMark;
+        std::vector<size_t> mirrorBlend;
+        std::vector<DeferredObjectInfo> deferredInfos;
+
+        static bool contains(const std::vector<size_t>& list, size_t idx) {
+            return std::find(list.begin(), list.end(), idx) != list.end();
+        }
+        bool isSnow(size_t idx) const { return contains(snow, idx); }
+        bool isLit(size_t idx) const { return contains(lit, idx); }
+        bool isDeferred(size_t idx) const { return contains(deferred, idx); }
+        bool isMirror(size_t idx) const { return contains(mirrorMark, idx) || contains(mirrorBlend, idx); }
+
+        // Set-Index von Objekt idx wie im früheren Spiegelungs-Pass: über alle Objekte davor zählen
+        size_t setIndex(size_t idx) const {
+            size_t count = 0;
+            if (isSnow(idx)) {
+                for (size_t j = 0; j < idx; j++) {
+                    if (isSnow(j)) count++;
+                }
+                return count;
+            }
+            if (isLit(idx)) {
+                for (size_t j = 0; j < idx; j++) {
+                    if (isLit(j)) count++;
+                }
+                return count;
+            }
+            if (isDeferred(idx)) {
+                for (size_t d = 0; d < deferredInfos.size(); d++) {
+                    if (deferredInfos[d].depthPassIndex == idx) return d * 2;
+                    if (deferredInfos[d].gbufferPassIndex == idx) return d * 2 + 1;
+                }
+                return SIZE_MAX;
+            }
+            for (size_t j = 0; j < idx; j++) {
+                if (!isSnow(j) && !isLit(j) && !isMirror(j) && !isDeferred(j)) count++;
+            }
+            return deferredInfos.size() * 2 + count;
+        }
+    };
+
+    void printSlotBenchmark(size_t objectCount, size_t reflectionCount) {
+        constexpr size_t MIRROR_COUNT = 4;
+
+        // Gemischte Szene ohne Vulkan-Ressourcen, Spiegel am Ende (wie in main.cpp), damit
+        // die alte Zählung, die Spiegel nicht mitzählt, dieselben Indizes liefert
+        Scene scene;
+        LinearLookup linear;
+        for (size_t i = 0; i < objectCount; i++) {
+            RenderObject obj;
+            switch (i % 8) {
+                case 1:
+                    linear.snow.push_back(scene.getObjectCount());
+                    scene.setRenderObject(obj, glm::mat4(1.0f), ObjectKind::Snow);
+                    break;
+                case 2:
+                case 5:
+                    linear.lit.push_back(scene.getObjectCount());
+                    scene.setRenderObject(obj, glm::mat4(1.0f), ObjectKind::Lit);
+                    break;
+                case 3: {
+                    DeferredRenderObject deferred;
+                    scene.setDeferredRenderObject(deferred);
+                    linear.deferredInfos.push_back(scene.getDeferredInfo(scene.getDeferredObjectCount() - 1));
+                    linear.deferred.push_back(linear.deferredInfos.back().depthPassIndex);
+                    linear.deferred.push_back(linear.deferredInfos.back().gbufferPassIndex);
+                    break;
+                }
+                default:
+                    scene.setRenderObject(obj);
+                    break;
+            }
+        }
+        for (size_t i = 0; i < MIRROR_COUNT; i++) {
+            RenderObject mirror;
+            linear.mirrorMark.push_back(scene.getObjectCount());
+            scene.setMirrorMarkObject(mirror, glm::mat4(1.0f));
+            linear.mirrorBlend.push_back(scene.getObjectCount());
+            scene.setMirrorBlendObject(mirror, glm::mat4(1.0f));
+        }
+        const size_t sceneObjects = scene.getObjectCount() - MIRROR_COUNT * 2;
+        for (size_t i = 0; i < reflectionCount; i++) {
+            // über die ganze Szene verteilt, die hinteren Objekte sind für die Zählung die teuren
+            scene.addReflectedObject(RenderObject{}, Benchmark::spreadIndex(i, sceneObjects));
+        }
+
+        // Ein Frame: Set jedes Objekts (Forward, Spiegel) und jeder Spiegelung nachschlagen
+        std::vector<size_t> linearResult;
+        std::vector<size_t> tableResult;
+        linearResult.reserve(scene.getObjectCount() + reflectionCount);
+        tableResult.reserve(scene.getObjectCount() + reflectionCount);
+
+        const double linearMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+            linearResult.clear();
+            // Forward-Pass: laufende Zähler, aber die Art jedes Objekts per Suche in den Listen
+            size_t normalIdx = 0, snowIdx = 0, litIdx = 0;
+            for (size_t i = 0; i < scene.getObjectCount(); i++) {
+                if (linear.isDeferred(i)) {
+                    linearResult.push_back(linear.setIndex(i));
+                } else if (linear.isSnow(i)) {
+                    linearResult.push_back(snowIdx++);
+                } else if (linear.isLit(i)) {
+                    linearResult.push_back(litIdx++);
+                } else {
+                    linearResult.push_back(linear.deferredInfos.size() * 2 + normalIdx++);
+                }
+            }
+            for (size_t r = 0; r < reflectionCount; r++) {
+                linearResult.push_back(linear.setIndex(scene.getReflectedDescriptorIndex(r)));
+            }
+        });
+        const double tableMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+            tableResult.clear();
+            for (size_t i = 0; i < scene.getObjectCount(); i++) {
+                tableResult.push_back(scene.getDescriptorSetIndex(i));
+            }
+            for (size_t r = 0; r < reflectionCount; r++) {
+                tableResult.push_back(scene.getDescriptorSetIndex(scene.getReflectedDescriptorIndex(r)));
+            }
+        });
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < linearResult.size(); i++) {
+            if (linearResult[i] != tableResult[i]) mismatches++;
+        }
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Descriptor-Slot-Lookup (" << scene.getObjectCount() << " Objekte, "
+                  << scene.getDeferredObjectCount() << " deferred, " << reflectionCount
+                  << " Spiegelungen, Median aus " << Benchmark::RUNS << " Läufen):" << std::endl
+                  << "  lineare Suche: " << linearMs << " ms pro Frame" << std::endl
+                  << "  Slot-Tabelle:  " << tableMs << " ms pro Frame | x"
+                  << Benchmark::speedup(linearMs, tableMs) << std::endl
+                  << "  Abweichungen:  " << mismatches << std::defaultfloat << std::endl;
+    }
+    void printTransformBenchmark(size_t objectCount, size_t animatedCount) {
+        // Residency, Texture-Streaming und LOD-Auswahl lesen die Bounds jedes Objekts pro Frame
+        constexpr int READERS = 3;
+
+        Scene scene;
+        // gleiche Objekte als Array der vollen Structs mit eigener Matrix, wie vor den SoA-Daten
+        struct FatObject {
+            RenderObject object;
+            glm::mat4 modelMatrix;
+        };
+        std::vector<FatObject> objects;
+        for (size_t i = 0; i < objectCount; i++) {
+            RenderObject obj;
+            obj.boundsCenter = glm::vec3(0.0f, 0.5f, 0.0f);
+            obj.boundsRadius = 1.0f;
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(float(i % 100), 0.0f, float(i / 100)));
+            scene.setRenderObject(obj, model);
+            objects.push_back({obj, model});
+        }
+
+        std::vector<size_t> animated;
+        for (size_t i = 0; i < animatedCount; i++) {
+            animated.push_back(Benchmark::spreadIndex(i, objectCount));
+        }
+
+        // jeder Lauf dreht die animierten Objekte weiter, damit nichts wegoptimiert wird
+        int aosRun = 0;
+        float aosSum = 0.0f;
+        const double aosMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+            // vorher: Matrix im Struct setzen, jeder Leser rechnet die Bounding Sphere selbst
+            const glm::mat4 model = glm::rotate(glm::mat4(1.0f), 0.1f * float(++aosRun), glm::vec3(0.0f, 1.0f, 0.0f));
+            for (size_t idx : animated) {
+                objects[idx].modelMatrix = model;
+            }
+            aosSum = 0.0f;
+            for (int reader = 0; reader < READERS; reader++) {
+                for (const FatObject& fat : objects) {
+                    aosSum += worldBoundingSphere(fat.modelMatrix, fat.object.boundsCenter, fat.object.boundsRadius).w;
+                }
+            }
+        });
+
+        int soaRun = 0;
+        float soaSum = 0.0f;
+        const double soaMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+            // jetzt: gesammelt setzen, nur die geänderten neu rechnen, Leser laufen über ein vec4-Array
+            const glm::mat4 model = glm::rotate(glm::mat4(1.0f), 0.1f * float(++soaRun), glm::vec3(0.0f, 1.0f, 0.0f));
+            for (size_t idx : animated) {
+                scene.updateObject(idx, model);
+            }
+            scene.flushTransforms();
+            soaSum = 0.0f;
+            const std::vector<glm::vec4>& bounds = scene.getWorldBounds();
+            for (int reader = 0; reader < READERS; reader++) {
+                for (const glm::vec4& sphere : bounds) {
+                    soaSum += sphere.w;
+                }
+            }
+        });
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Transformationen (" << objectCount << " Objekte, " << animatedCount
+                  << " animiert, " << READERS << " Leser, Median aus " << Benchmark::RUNS << " Läufen):" << std::endl
+                  << "  RenderObject-Array: " << aosMs << " ms pro Frame" << std::endl
+                  << "  SoA + Dirty-Bits:   " << soaMs << " ms pro Frame | x"
+                  << Benchmark::speedup(aosMs, soaMs) << std::endl
+                  << "  Summe der Radien:   " << aosSum << " / " << soaSum << std::defaultfloat << std::endl;
+    }
+    void printDrawBenchmark(size_t objectCount) {
+        // wie Frame::selectLod: gröbste Stufe, deren Fehler aus der Entfernung unter der Schwelle bleibt
+        constexpr float PIXELS_PER_UNIT = 800.0f;
+        constexpr float MAX_PIXEL_ERROR = 1.0f;
+        const glm::vec3 eye(0.0f, 2.0f, -10.0f);
+        auto pickLod = [&](const MeshLod* lods, size_t lodCount, const glm::vec4& bounds) {
+            float distance = std::max(glm::length(glm::vec3(bounds) - eye) - bounds.w, 0.001f);
+            float pixelsPerError = bounds.w * PIXELS_PER_UNIT / distance;
+            size_t lod = 0;
+            for (size_t i = 1; i < lodCount && lods[i].error * pixelsPerError <= MAX_PIXEL_ERROR; i++) {
+                lod = i;
+            }
+            return lods[lod].indexCount;
+        };
+
+        Scene scene;
+        for (size_t i = 0; i < objectCount; i++) {
+            RenderObject obj;
+            obj.vertexBuffer = reinterpret_cast<VkBuffer>(uintptr_t(i + 1));
+            obj.indexBuffer = reinterpret_cast<VkBuffer>(uintptr_t(i + 1));
+            obj.vertexCount = 1000;
+            obj.indexCount = 6000;
+            obj.boundsRadius = 1.0f;
+            // eigene LOD-Kette pro Objekt, wie die Kopie aus der MeshRegistry
+            for (uint32_t lod = 0; lod < DrawItem::MAX_LODS; lod++) {
+                obj.lods.push_back({ 0, 6000u >> lod, 0.001f * float(1u << lod) });
+            }
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(float(i % 100), 0.0f, float(i / 100)));
+            scene.setRenderObject(obj, model, i % 8 == 2 ? ObjectKind::Lit : ObjectKind::Normal);
+        }
+
+        // ein Forward-Pass ohne Vulkan: Handles und Zähler lesen, LOD wählen
+        uint64_t fatSum = 0;
+        const double fatMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+            fatSum = 0;
+            for (size_t i = 0; i < scene.getObjectCount(); i++) {
+                const RenderObject& obj = scene.getObject(i);
+                if (obj.vertexCount == 0 || obj.vertexBuffer == VK_NULL_HANDLE) continue;
+                fatSum += reinterpret_cast<uintptr_t>(obj.indexBuffer) & 1;
+                fatSum += pickLod(obj.lods.data(), obj.lods.size(), scene.getWorldBounds(i));
+            }
+        });
+        uint64_t drawSum = 0;
+        const double drawMs = Benchmark::medianMillis(Benchmark::RUNS, [&]() {
+            drawSum = 0;
+            for (size_t i = 0; i < scene.getObjectCount(); i++) {
+                const DrawItem& draw = scene.getDraw(i);
+                if (draw.vertexCount == 0 || draw.vertexBuffer == VK_NULL_HANDLE) continue;
+                drawSum += reinterpret_cast<uintptr_t>(draw.indexBuffer) & 1;
+                drawSum += pickLod(draw.lods, draw.lodCount, scene.getWorldBounds(i));
+            }
+        });
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Draw-Daten (" << objectCount << " Objekte, " << DrawItem::MAX_LODS
+                  << " LODs, Median aus " << Benchmark::RUNS << " Läufen):" << std::endl
+                  << "  RenderObject: " << fatMs << " ms pro Frame (" << sizeof(RenderObject) << " Bytes + LOD-Vektor)" << std::endl
+                  << "  DrawItem:     " << drawMs << " ms pro Frame (" << sizeof(DrawItem) << " Bytes) | x"
+                  << Benchmark::speedup(fatMs, drawMs) << std::endl
+                  << "  Indices:      " << fatSum << " / " << drawSum << std::defaultfloat << std::endl;
+    }
+    // Auslagern eines Meshes aus einem Block des MemoryAllocators gibt den Block nicht an den
+    // Treiber zurück: heapUsage bleibt gleich, nur der freie Platz im Block wächst. Die
+    // Belegung fürs Budget muss trotzdem unter das Budget fallen, sonst lagert der
+    // ResidencyManager jeden Frame weiter aus
+    bool checkBudgetUsage() {
+        constexpr VkDeviceSize MB = 1024 * 1024;
+        const VkDeviceSize budget = 300 * MB;
+        const VkDeviceSize heapUsage = 256 * MB + 64 * MB;     // ein Block + fremde Belegung
+        const VkDeviceSize meshBytes = 100 * MB;
+        const VkDeviceSize unusedBefore = 16 * MB;
+
+        struct Case {
+            const char* name;
+            VkDeviceSize usage;
+            bool overBudget;
+        };
+        const Case cases[] = {
+            { "vor dem Auslagern", ResidencyManager::effectiveUsage(heapUsage, unusedBefore, 0), true },
+            // Buffer schon zerstört, der Platz liegt frei im Block
+            { "nach dem Auslagern", ResidencyManager::effectiveUsage(heapUsage, unusedBefore + meshBytes, 0), false },
+            // Buffer wartet noch auf das Ende der Frames in flight
+            { "Freigabe ausstehend", ResidencyManager::effectiveUsage(heapUsage, unusedBefore, meshBytes), false },
+            // mehr frei als belegt (z.B. veraltete heapUsage) darf nicht unter 0 laufen
+            { "Guthaben > heapUsage", ResidencyManager::effectiveUsage(heapUsage, heapUsage + meshBytes, 0), false },
+        };
+
+        bool ok = true;
+        std::cout << "Residency-Budget (" << budget / MB << " MB, heapUsage " << heapUsage / MB << " MB):" << std::endl;
+        for (const Case& c : cases) {
+            const bool pass = (c.usage > budget) == c.overBudget && c.usage <= heapUsage;
+            ok = ok && pass;
+            std::cout << "  " << std::left << std::setw(24) << c.name << std::right << c.usage / MB << " MB "
+                      << (c.usage > budget ? "über" : "unter") << " Budget" << (pass ? "" : " | FEHLER") << std::endl;
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> selected(argv + 1, argv + argc);
+    for (const std::string& name : selected) {
+        if (name != "obj" && name != "scene" && name != "budget") {
+            std::cerr << "Usage: " << argv[0] << " [obj] [scene] [budget]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    auto wanted = [&selected](const char* name) {
+        return selected.empty() || std::find(selected.begin(), selected.end(), name) != selected.end();
+    };
+
+    if (wanted("obj")) {
+        printParserBenchmark("models");
+    }
+    if (wanted("scene")) {
+        printSlotBenchmark(5000, 2000);
+        printTransformBenchmark(20000, 500);
+        printDrawBenchmark(20000);
+    }
+    if (wanted("budget") && !checkBudgetUsage()) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
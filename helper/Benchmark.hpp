@@ -0,0 +1,39 @@
+// Benchmark.hpp
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// Zeitmessung für bench.cpp: Median aus RUNS Läufen
+class Benchmark {
+public:
+    static constexpr int RUNS = 5;
+
+    // fn() runs-mal ausführen, Rückgabe: Median der Laufzeiten in ms
+    template <typename Fn>
+    static double medianMillis(int runs, Fn&& fn) {
+        std::vector<double> times;
+        times.reserve(runs);
+        for (int run = 0; run < runs; run++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            fn();
+            times.push_back(std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    // i-ter über [0, count) gestreuter Index (Schrittweite prim), damit nicht nur
+    // die vorderen, billig gezählten Objekte getroffen werden
+    static size_t spreadIndex(size_t i, size_t count) {
+        return (i * 7919) % count;
+    }
+
+    // Verhältnis alt/neu für die Ausgabe "| x...", 0 wenn neu nicht messbar war
+    static double speedup(double oldMs, double newMs) {
+        return newMs > 0.0 ? oldMs / newMs : 0.0;
+    }
+};
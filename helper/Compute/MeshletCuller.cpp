@@ -0,0 +1,393 @@
+#include "MeshletCuller.hpp"
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include "../initBuffer.hpp"
+
+// Helper: Datei (compute Shader) einlesen
+static std::vector<char> readFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::ate | std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("failed to open file: " + filename);
+    size_t fileSize = (size_t) file.tellg();
+    std::vector<char> buffer(fileSize);
+    file.seekg(0);
+    file.read(buffer.data(), fileSize);
+    file.close();
+    return buffer;
+}
+
+// Helper: Buffer erstellen & Speicher allokieren
+static void createBuffer(VkDevice device, VkDeviceSize size,
+                         VkBufferUsageFlags usage, VkMemoryPropertyFlags memProps,
+                         VkBuffer &buffer, MemoryAllocation &bufferMemory) {
+    VkBufferCreateInfo bci{};
+    bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bci.size = size;
+    bci.usage = usage;
+    bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bci, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletCuller: failed to create buffer");
+    }
+
+    try {
+        bufferMemory = MemoryAllocator::of(device).allocateBuffer(buffer, memProps, MemoryCategory::Mesh);
+    } catch (const std::exception&) {
+        vkDestroyBuffer(device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
+        throw std::runtime_error("MeshletCuller: failed to allocate buffer memory");
+    }
+}
+
+MeshletCuller::MeshletCuller(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t framesInFlight)
+    : _physicalDevice(physicalDevice)
+    , _device(device) {
+    createDescriptorSetLayout();
+    createPipelineLayout();
+    createPipeline();
+    createDescriptorPool(framesInFlight);
+    createFrameResources(framesInFlight);
+}
+
+//Layout: Meshlets, Quell-Indices, Ziel-Indices, Draw-Daten, Frustum
+void MeshletCuller::createDescriptorSetLayout() {
+    std::array<VkDescriptorSetLayoutBinding, 5> bindings{};
+    for (uint32_t i = 0; i < bindings.size(); i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = i == 4 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(_device, &layoutInfo, nullptr, &_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletCuller: failed to create descriptor set layout");
+    }
+}
+
+void MeshletCuller::createPipelineLayout() {
+    VkPushConstantRange range{};
+    range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    range.offset = 0;
+    range.size = sizeof(CullPushConstants);
+
+    VkPipelineLayoutCreateInfo pli{};
+    pli.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pli.setLayoutCount = 1;
+    pli.pSetLayouts = &_descriptorSetLayout;
+    pli.pushConstantRangeCount = 1;
+    pli.pPushConstantRanges = &range;
+
+    if (vkCreatePipelineLayout(_device, &pli, nullptr, &_pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletCuller: failed to create pipeline layout");
+    }
+}
+
+void MeshletCuller::createPipeline() {
+    auto code = readFile("shaders/meshlet_cull.comp.spv");
+
+    VkShaderModuleCreateInfo smci{};
+    smci.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    smci.codeSize = code.size();
+    smci.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+    VkShaderModule shaderModule;
+    if (vkCreateShaderModule(_device, &smci, nullptr, &shaderModule) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletCuller: failed to create shader module");
+    }
+
+    VkPipelineShaderStageCreateInfo stageInfo{};
+    stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module = shaderModule;
+    stageInfo.pName = "main";
+
+    VkComputePipelineCreateInfo pci{};
+    pci.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pci.stage = stageInfo;
+    pci.layout = _pipelineLayout;
+
+    if (vkCreateComputePipelines(_device, VK_NULL_HANDLE, 1, &pci, nullptr, &_computePipeline) != VK_SUCCESS) {
+        vkDestroyShaderModule(_device, shaderModule, nullptr);
+        throw std::runtime_error("MeshletCuller: failed to create compute pipeline");
+    }
+
+    vkDestroyShaderModule(_device, shaderModule, nullptr);
+}
+
+void MeshletCuller::createDescriptorPool(uint32_t framesInFlight) {
+    const uint32_t maxSets = MAX_TARGETS * framesInFlight;
+
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[0].descriptorCount = maxSets * 4;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[1].descriptorCount = maxSets;
+
+    VkDescriptorPoolCreateInfo dpci{};
+    dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    dpci.maxSets = maxSets;
+    dpci.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    dpci.pPoolSizes = poolSizes.data();
+
+    if (vkCreateDescriptorPool(_device, &dpci, nullptr, &_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("MeshletCuller: failed to create descriptor pool");
+    }
+}
+
+void MeshletCuller::createFrameResources(uint32_t framesInFlight) {
+    _frames.resize(framesInFlight);
+    for (FrameResources& frame : _frames) {
+        createBuffer(_device, sizeof(CullUniforms),
+                     VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     frame.uniformBuffer, frame.uniformBufferMemory);
+
+        frame.uniformMapped = static_cast<CullUniforms*>(frame.uniformBufferMemory.mapped);
+    }
+}
+
+void MeshletCuller::beginFrame(uint32_t frameIndex, const glm::mat4& viewProj, const glm::vec3& eye) {
+    FrameResources& frame = _frames.at(frameIndex);
+
+    //Statistik des letzten Durchlaufs dieses Frames (die Fence ist schon durch)
+    if (frame.epoch > 0) {
+        MeshletStats stats;
+        for (const auto& [key, target] : frame.targets) {
+            if (target.culledEpoch != frame.epoch) {
+                continue;
+            }
+            stats.meshletsTotal += target.meshletCount;
+            stats.meshletsVisible += target.drawMapped->visibleMeshlets;
+            stats.trianglesTotal += target.indexCount / 3;
+            stats.trianglesVisible += target.drawMapped->indexCount / 3;
+        }
+        _stats = stats;
+    }
+    frame.epoch++;
+
+    //Frustum-Ebenen aus der View-Projection-Matrix (Gribb/Hartmann), Normalen zeigen nach innen
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+        rows[i] = glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+    }
+    CullUniforms uniforms{};
+    uniforms.frustumPlanes[0] = rows[3] + rows[0];  // links
+    uniforms.frustumPlanes[1] = rows[3] - rows[0];  // rechts
+    uniforms.frustumPlanes[2] = rows[3] + rows[1];  // unten
+    uniforms.frustumPlanes[3] = rows[3] - rows[1];  // oben
+    uniforms.frustumPlanes[4] = rows[3] + rows[2];  // nah (OpenGL-Tiefenbereich, schließt den Vulkan-Bereich ein)
+    uniforms.frustumPlanes[5] = rows[3] - rows[2];  // fern
+    for (glm::vec4& plane : uniforms.frustumPlanes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    uniforms.cameraPos = glm::vec4(eye, 1.0f);
+    *frame.uniformMapped = uniforms;
+}
+
+bool MeshletCuller::prepareTarget(FrameResources& frame, Target& target, const DrawItem& obj) {
+    const uint32_t indexCount = obj.baseIndexCount();
+    if (target.meshletBuffer == obj.meshletBuffer && target.descriptorSet != VK_NULL_HANDLE) {
+        return true;
+    }
+
+    //neues Objekt oder anderes Mesh: Ausgabe-Buffer passend neu anlegen
+    if (target.capacity < indexCount) {
+        destroyTargetBuffers(target);
+    }
+    if (target.indexBuffer == VK_NULL_HANDLE) {
+        createBuffer(_device, sizeof(uint32_t) * static_cast<VkDeviceSize>(indexCount),
+                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                     target.indexBuffer, target.indexBufferMemory);
+        createBuffer(_device, sizeof(DrawData),
+                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     target.drawBuffer, target.drawBufferMemory);
+
+        target.drawMapped = static_cast<DrawData*>(target.drawBufferMemory.mapped);
+        *target.drawMapped = DrawData{};
+        target.capacity = indexCount;
+    }
+
+    if (target.descriptorSet == VK_NULL_HANDLE) {
+        VkDescriptorSetAllocateInfo dsai{};
+        dsai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        dsai.descriptorPool = _descriptorPool;
+        dsai.descriptorSetCount = 1;
+        dsai.pSetLayouts = &_descriptorSetLayout;
+
+        if (vkAllocateDescriptorSets(_device, &dsai, &target.descriptorSet) != VK_SUCCESS) {
+            std::cerr << "MeshletCuller: no descriptor set left, drawing without culling" << std::endl;
+            return false;
+        }
+    }
+
+    std::array<VkDescriptorBufferInfo, 5> infos{};
+    infos[0] = { obj.meshletBuffer, 0, VK_WHOLE_SIZE };
+    infos[1] = { obj.indexBuffer, 0, VK_WHOLE_SIZE };
+    infos[2] = { target.indexBuffer, 0, VK_WHOLE_SIZE };
+    infos[3] = { target.drawBuffer, 0, sizeof(DrawData) };
+    infos[4] = { frame.uniformBuffer, 0, sizeof(CullUniforms) };
+
+    std::array<VkWriteDescriptorSet, 5> writes{};
+    for (uint32_t i = 0; i < writes.size(); i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = target.descriptorSet;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = i == 4 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[i].pBufferInfo = &infos[i];
+    }
+    vkUpdateDescriptorSets(_device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+    target.meshletBuffer = obj.meshletBuffer;
+    target.meshletCount = obj.meshletCount;
+    target.indexCount = indexCount;
+    return true;
+}
+
+bool MeshletCuller::cull(VkCommandBuffer cmd, uint32_t frameIndex, size_t key, const DrawItem& obj,
+                         const glm::mat4& model) {
+    if (obj.meshletBuffer == VK_NULL_HANDLE || obj.meshletCount == 0 || obj.indexBuffer == VK_NULL_HANDLE) {
+        return false;
+    }
+    FrameResources& frame = _frames.at(frameIndex);
+    auto it = frame.targets.find(key);
+    if (it == frame.targets.end()) {
+        if (frame.targets.size() >= MAX_TARGETS) {
+            return false;
+        }
+        it = frame.targets.emplace(key, Target{}).first;
+    }
+    Target& target = it->second;
+    if (!prepareTarget(frame, target, obj)) {
+        return false;
+    }
+
+    //Draw-Daten zurücksetzen: 0 Indices, 1 Instanz
+    const DrawData reset{ 0, 1, 0, 0, 0, 0, { 0, 0 } };
+    vkCmdUpdateBuffer(cmd, target.drawBuffer, 0, sizeof(DrawData), &reset);
+
+    VkMemoryBarrier resetBarrier{};
+    resetBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    resetBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    resetBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0, 1, &resetBarrier, 0, nullptr, 0, nullptr);
+
+    //Kegeltest nur bei (nahezu) uniformer Skalierung, sonst stimmt der Öffnungswinkel nicht mehr
+    const float scaleX = glm::length(glm::vec3(model[0]));
+    const float scaleY = glm::length(glm::vec3(model[1]));
+    const float scaleZ = glm::length(glm::vec3(model[2]));
+    const float maxScale = std::max(scaleX, std::max(scaleY, scaleZ));
+    const float minScale = std::min(scaleX, std::min(scaleY, scaleZ));
+
+    CullPushConstants push{};
+    push.model = model;
+    push.meshletCount = obj.meshletCount;
+    push.indexType16 = obj.indexType == VK_INDEX_TYPE_UINT16 ? 1u : 0u;
+    push.maxScale = maxScale;
+    push.coneCulling = minScale > 0.0f && maxScale / minScale < 1.01f ? 1u : 0u;
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, _computePipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout,
+                            0, 1, &target.descriptorSet, 0, nullptr);
+    vkCmdPushConstants(cmd, _pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &push);
+    //eine Workgroup pro Meshlet
+    vkCmdDispatch(cmd, obj.meshletCount, 1, 1);
+
+    target.culledEpoch = frame.epoch;
+    return true;
+}
+
+void MeshletCuller::finishCulling(VkCommandBuffer cmd) {
+    //Ergebnisse für Indirect Draw, Index Input und die Statistik (Host) sichtbar machen
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+bool MeshletCuller::drawCulled(VkCommandBuffer cmd, uint32_t frameIndex, size_t key, const DrawItem& obj) {
+    FrameResources& frame = _frames.at(frameIndex);
+    auto it = frame.targets.find(key);
+    if (it == frame.targets.end() || it->second.culledEpoch != frame.epoch
+        || it->second.meshletBuffer != obj.meshletBuffer) {
+        return false;
+    }
+
+    VkBuffer vb[] = {obj.vertexBuffer};
+    VkDeviceSize off[] = {0};
+    vkCmdBindVertexBuffers(cmd, 0, 1, vb, off);
+    vkCmdBindIndexBuffer(cmd, it->second.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    vkCmdDrawIndexedIndirect(cmd, it->second.drawBuffer, 0, 1, sizeof(DrawData));
+    return true;
+}
+
+void MeshletCuller::destroyTargetBuffers(Target& target) {
+    if (target.indexBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(_device, target.indexBuffer, nullptr);
+        target.indexBuffer = VK_NULL_HANDLE;
+    }
+    if (target.indexBufferMemory) {
+        MemoryAllocator::of(_device).free(target.indexBufferMemory);
+    }
+    if (target.drawBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(_device, target.drawBuffer, nullptr);
+        target.drawBuffer = VK_NULL_HANDLE;
+    }
+    if (target.drawBufferMemory) {
+        MemoryAllocator::of(_device).free(target.drawBufferMemory);
+    }
+    target.drawMapped = nullptr;
+    target.capacity = 0;
+}
+
+void MeshletCuller::destroy() {
+    vkDeviceWaitIdle(_device);
+    for (FrameResources& frame : _frames) {
+        for (auto& [key, target] : frame.targets) {
+            destroyTargetBuffers(target);
+        }
+        frame.targets.clear();
+        if (frame.uniformBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(_device, frame.uniformBuffer, nullptr);
+            frame.uniformBuffer = VK_NULL_HANDLE;
+        }
+        if (frame.uniformBufferMemory) {
+            MemoryAllocator::of(_device).free(frame.uniformBufferMemory);
+        }
+    }
+    _frames.clear();
+    if (_descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(_device, _descriptorPool, nullptr);
+        _descriptorPool = VK_NULL_HANDLE;
+    }
+    if (_descriptorSetLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(_device, _descriptorSetLayout, nullptr);
+        _descriptorSetLayout = VK_NULL_HANDLE;
+    }
+    if (_computePipeline != VK_NULL_HANDLE) {
+        vkDestroyPipeline(_device, _computePipeline, nullptr);
+        _computePipeline = VK_NULL_HANDLE;
+    }
+    if (_pipelineLayout != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(_device, _pipelineLayout, nullptr);
+        _pipelineLayout = VK_NULL_HANDLE;
+    }
+}
@@ -0,0 +1,111 @@
+// MeshletCuller.hpp
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include "../../Scene.hpp"
+#include "../MemoryAllocator.hpp"
+
+// Ergebnis des Cullings (vom letzten abgeschlossenen Frame)
+struct MeshletStats {
+    uint32_t meshletsTotal = 0;
+    uint32_t meshletsVisible = 0;
+    uint64_t trianglesTotal = 0;
+    uint64_t trianglesVisible = 0;
+};
+
+// Cluster-Culling per Compute Shader, sichtbare Meshlets per vkCmdDrawIndexedIndirect
+class MeshletCuller {
+public:
+    // Objekte mit Meshlets pro Frame, weitere werden normal gezeichnet
+    static constexpr uint32_t MAX_TARGETS = 32;
+
+    MeshletCuller(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t framesInFlight);
+
+    // Frustum-Ebenen und Kameraposition für diesen Frame setzen, liest nebenbei
+    // die Statistik des letzten Durchlaufs dieses Frames (Fence muss durch sein)
+    void beginFrame(uint32_t frameIndex, const glm::mat4& viewProj, const glm::vec3& eye);
+    // Zeichnet Reset + Dispatch für obj auf (außerhalb des Render Pass).
+    // key identifiziert das Objekt innerhalb des Frames, model ist seine aktuelle
+    // Transformation (Scene::getModelMatrix). false = nicht gecullt
+    bool cull(VkCommandBuffer cmd, uint32_t frameIndex, size_t key, const DrawItem& obj,
+              const glm::mat4& model);
+    // Barrier Compute -> Indirect Draw / Index Input, einmal nach allen cull()
+    void finishCulling(VkCommandBuffer cmd);
+    // Zeichnet die sichtbaren Meshlets von obj. false = in diesem Frame nicht gecullt
+    bool drawCulled(VkCommandBuffer cmd, uint32_t frameIndex, size_t key, const DrawItem& obj);
+
+    const MeshletStats& getStats() const { return _stats; }
+    void destroy();
+
+private:
+    // Entspricht VkDrawIndexedIndirectCommand + Zähler für die Statistik
+    struct DrawData {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+        uint32_t visibleMeshlets;
+        uint32_t padding[2];
+    };
+
+    struct CullUniforms {
+        glm::vec4 frustumPlanes[6];
+        glm::vec4 cameraPos;
+    };
+
+    struct CullPushConstants {
+        glm::mat4 model;
+        uint32_t meshletCount;
+        uint32_t indexType16;
+        float maxScale;
+        uint32_t coneCulling;   // 0 bei nicht-uniformer Skalierung
+    };
+
+    struct Target {
+        VkBuffer meshletBuffer = VK_NULL_HANDLE;     // nur zum Erkennen eines Mesh-Wechsels
+        uint32_t meshletCount = 0;
+        uint32_t indexCount = 0;                     // Indices von LOD 0 (alle Meshlets)
+        uint32_t capacity = 0;                       // Indices, die in den Ausgabe-Buffer passen
+        VkBuffer indexBuffer = VK_NULL_HANDLE;       // kompaktierte Indices (32 Bit)
+        MemoryAllocation indexBufferMemory;
+        VkBuffer drawBuffer = VK_NULL_HANDLE;        // DrawData, host visible für die Statistik
+        MemoryAllocation drawBufferMemory;
+        DrawData* drawMapped = nullptr;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        uint64_t culledEpoch = 0;
+    };
+
+    struct FrameResources {
+        VkBuffer uniformBuffer = VK_NULL_HANDLE;
+        MemoryAllocation uniformBufferMemory;
+        CullUniforms* uniformMapped = nullptr;
+        std::unordered_map<size_t, Target> targets;
+        uint64_t epoch = 0;     // zählt die Frames dieses Slots, 0 = noch nie gecullt
+    };
+
+    void createDescriptorSetLayout();
+    void createPipelineLayout();
+    void createPipeline();
+    void createDescriptorPool(uint32_t framesInFlight);
+    void createFrameResources(uint32_t framesInFlight);
+    // Legt Buffer/Descriptor Set für obj an oder passt sie an ein neues Mesh an
+    bool prepareTarget(FrameResources& frame, Target& target, const DrawItem& obj);
+    void destroyTargetBuffers(Target& target);
+
+    VkPhysicalDevice _physicalDevice = VK_NULL_HANDLE;
+    VkDevice _device = VK_NULL_HANDLE;
+
+    VkPipeline _computePipeline = VK_NULL_HANDLE;
+    VkPipelineLayout _pipelineLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout _descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool _descriptorPool = VK_NULL_HANDLE;
+
+    std::vector<FrameResources> _frames;
+    MeshletStats _stats;
+};
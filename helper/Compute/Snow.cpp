@@ -22,9 +22,9 @@ static std::vector<char> readFile(const std::string& filename) {
 }
 
 // Helper: Buffer erstellen & Speicher allokieren
-static void createBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize size, 
+static void createBuffer(VkDevice device, VkDeviceSize size,
                          VkBufferUsageFlags usage, VkMemoryPropertyFlags memProps,
-                         VkBuffer &buffer, VkDeviceMemory &bufferMemory) {
+                         VkBuffer &buffer, MemoryAllocation &bufferMemory) {
     VkBufferCreateInfo bci{};
     bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bci.size = size;
@@ -35,20 +35,13 @@ static void createBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkDev
         throw std::runtime_error("failed to create buffer");
     }
 
-    VkMemoryRequirements memReq;
-    vkGetBufferMemoryRequirements(device, buffer, &memReq);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memReq.size;
-    InitBuffer buff;
-    allocInfo.memoryTypeIndex = buff.findMemoryType(memReq.memoryTypeBits, memProps, physicalDevice);
-
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+    try {
+        bufferMemory = MemoryAllocator::of(device).allocateBuffer(buffer, memProps, MemoryCategory::Snow);
+    } catch (const std::exception&) {
+        vkDestroyBuffer(device, buffer, nullptr);
+        buffer = VK_NULL_HANDLE;
         throw std::runtime_error("failed to allocate buffer memory");
     }
-
-    vkBindBufferMemory(device, buffer, bufferMemory, 0);
 }
 
 Snow::Snow(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueIndex) 
@@ -180,25 +173,20 @@ void Snow::createStorageBuffers() {
     VkDeviceSize bufSize = sizeof(Particle) * NUMBER_PARTICLES;
 
     //Buffer mit Initialdaten der Schneeflocken
-    createBuffer(_physicalDevice, _device, bufSize,
+    createBuffer(_device, bufSize,
                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  _initBuffer, _initBufferMemory);
 
-    void* data;
-    vkMapMemory(_device, _initBufferMemory, 0, bufSize, 0, &data);
-    std::memcpy(data, particles.data(), static_cast<size_t>(bufSize));
-    vkUnmapMemory(_device, _initBufferMemory);
+    std::memcpy(_initBufferMemory.mapped, particles.data(), static_cast<size_t>(bufSize));
 
     //Buffer mit aktuellen Daten
-    createBuffer(_physicalDevice, _device, bufSize,
+    createBuffer(_device, bufSize,
                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  _currBuffer, _currBufferMemory);
 
-    vkMapMemory(_device, _currBufferMemory, 0, bufSize, 0, &data);
-    std::memcpy(data, particles.data(), static_cast<size_t>(bufSize));
-    vkUnmapMemory(_device, _currBufferMemory);
+    std::memcpy(_currBufferMemory.mapped, particles.data(), static_cast<size_t>(bufSize));
 }
 
 void Snow::createDescriptorPool() {
@@ -335,16 +323,14 @@ void Snow::destroy() {
         vkDestroyBuffer(_device, _initBuffer, nullptr);
         _initBuffer = VK_NULL_HANDLE;
     }
-    if (_initBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _initBufferMemory, nullptr);
-        _initBufferMemory = VK_NULL_HANDLE;
+    if (_initBufferMemory) {
+        MemoryAllocator::of(_device).free(_initBufferMemory);
     }
     if (_currBuffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(_device, _currBuffer, nullptr);
         _currBuffer = VK_NULL_HANDLE;
     }
-    if (_currBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _currBufferMemory, nullptr);
-        _currBufferMemory = VK_NULL_HANDLE;
+    if (_currBufferMemory) {
+        MemoryAllocator::of(_device).free(_currBufferMemory);
     }
 }
@@ -9,6 +9,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <vulkan/vulkan.h>
+#include "../MemoryAllocator.hpp"
 
 struct alignas(32) Particle {
     alignas(16) glm::vec3 position;
@@ -37,10 +38,10 @@ private:
     VkPipelineLayout _pipelineLayout = VK_NULL_HANDLE;
 
     VkBuffer _initBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _initBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation _initBufferMemory;
 
     VkBuffer _currBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _currBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation _currBufferMemory;
 
     VkDescriptorPool _descriptorPool = VK_NULL_HANDLE;
     VkDescriptorSet _descriptorSet = VK_NULL_HANDLE;
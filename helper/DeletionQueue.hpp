@@ -0,0 +1,33 @@
+// DeletionQueue.hpp
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Zerstört Vulkan-Ressourcen erst, wenn kein Frame in Flight sie mehr benutzt (siehe Frame::retire)
+class DeletionQueue {
+public:
+    DeletionQueue() = default;
+    ~DeletionQueue() { flush(); }
+
+    DeletionQueue(const DeletionQueue&) = delete;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+    void push(std::function<void()> deleter) {
+        _deleters.push_back(std::move(deleter));
+    }
+
+    void flush() {
+        for (auto it = _deleters.rbegin(); it != _deleters.rend(); ++it) {
+            (*it)();
+        }
+        _deleters.clear();
+    }
+
+    bool empty() const { return _deleters.empty(); }
+    size_t size() const { return _deleters.size(); }
+
+private:
+    std::vector<std::function<void()>> _deleters;
+};
@@ -3,110 +3,14 @@
 #include <stdexcept>
 #include <array>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
 #include <iostream>
 
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 #include "../Compute/Snow.hpp"
-
-void Frame::createUniformBuffer() {
-    VkDeviceSize bufferSize = sizeof(UniformBufferObject);
-
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = bufferSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(_device, &bufferInfo, nullptr, &_uniformBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create uniform buffer!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(_device, _uniformBuffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = _buff.findMemoryType(memRequirements.memoryTypeBits,
-                                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, _physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_uniformBufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate uniform buffer memory!");
-    }
-
-    vkBindBufferMemory(_device, _uniformBuffer, _uniformBufferMemory, 0);
-
-    void* data = nullptr;
-    vkMapMemory(_device, _uniformBufferMemory, 0, bufferSize, 0, &data);
-    _uniformBufferMapped = static_cast<UniformBufferObject*>(data);
-}
-
-void Frame::createLitUniformBuffer() {
-    VkDeviceSize bufferSize = sizeof(LitUniformBufferObject);
-
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = bufferSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(_device, &bufferInfo, nullptr, &_litUniformBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create lit uniform buffer!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(_device, _litUniformBuffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = _buff.findMemoryType(memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, _physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_litUniformBufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate lit uniform buffer memory!");
-    }
-
-    vkBindBufferMemory(_device, _litUniformBuffer, _litUniformBufferMemory, 0);
-
-    void* data = nullptr;
-    vkMapMemory(_device, _litUniformBufferMemory, 0, bufferSize, 0, &data);
-    _litUniformBufferMapped = static_cast<LitUniformBufferObject*>(data);
-}
-
-void Frame::createLightingUniformBuffer() {
-    VkDeviceSize bufferSize = sizeof(LightingUniformBufferObject);
-
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = bufferSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(_device, &bufferInfo, nullptr, &_lightingUniformBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create lighting uniform buffer!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(_device, _lightingUniformBuffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = _buff.findMemoryType(memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, _physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_lightingUniformBufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate lighting uniform buffer memory!");
-    }
-
-    vkBindBufferMemory(_device, _lightingUniformBuffer, _lightingUniformBufferMemory, 0);
-
-    void* data = nullptr;
-    vkMapMemory(_device, _lightingUniformBufferMemory, 0, bufferSize, 0, &data);
-    _lightingUniformBufferMapped = static_cast<LightingUniformBufferObject*>(data);
-}
+#include "../Compute/MeshletCuller.hpp"
 
 void Frame::submitCommandBuffer(uint32_t imageIndex) {
     
@@ -127,13 +31,15 @@ void Frame::submitCommandBuffer(uint32_t imageIndex) {
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &_commandBuffer;
 
+    // erst hier zurücksetzen: bricht render() vorher ab, bleibt der Fence signalisiert
+    vkResetFences(_device, 1, &_inFlightFence);
     if (vkQueueSubmit(_graphicsQueue, 1, &submitInfo, _inFlightFence) != VK_SUCCESS) {
         throw std::runtime_error("failed to submit draw command buffer!");
     }
 }
 
 
-void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex) {
+void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex, ReflectionProbe* probe) {
     vkResetCommandBuffer(_commandBuffer, 0);
 
     VkCommandBufferBeginInfo beginInfo{};
@@ -142,6 +48,16 @@ void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex) {
     if (vkBeginCommandBuffer(_commandBuffer, &beginInfo) != VK_SUCCESS) {
         throw std::runtime_error("failed to begin recording command buffer!");
     }
+    resetBindlessTextures();
+    _view = _mainView;
+
+    // Cubemap-Seiten vor dem Haupt-Render-Pass, der sie sampelt
+    if (probe) {
+        renderCubemap(scene, probe);
+    }
+
+    // Compute-Dispatches dürfen nicht im Render Pass liegen
+    cullMeshlets(scene);
 
     VkRenderPass rp = scene->getRenderPass();
     VkFramebuffer fb = _framebuffers->getFramebuffer(imageIndex);
@@ -181,35 +97,24 @@ void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex) {
     // ============================================
     // SUBPASS 0: DEPTH PREPASS
     // ============================================    
-    size_t deferredDescriptorIdx = 0;  // Zähler für deferred descriptor sets
-    
     for (size_t i = 0; i < scene->getDeferredObjectCount(); ++i) {
-        const auto& obj = scene->getDepthPassObject(i);
+        const DrawItem& draw = scene->getDepthPassDraw(i);
+        const size_t objectIndex = scene->getDeferredInfo(i).depthPassIndex;
         
-        if (obj.vertexCount == 0 || obj.vertexBuffer == VK_NULL_HANDLE) {
-            deferredDescriptorIdx++;  // Auch bei skip hochzählen!
+        if (scene->isPending(objectIndex) ||
+            draw.vertexCount == 0 || draw.vertexBuffer == VK_NULL_HANDLE) {
             continue;
         }
 
-        VkPipeline pipeline = obj.pipeline->getPipeline();
+        VkPipeline pipeline = draw.pipeline->getPipeline();
         vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-        VkPipelineLayout layout = obj.pipeline->getPipelineLayout();
+        VkPipelineLayout layout = draw.pipeline->getPipelineLayout();
 
-        // Descriptor set binden (Index = deferredDescriptorIdx * 2 + 0)
-        size_t setIndex = deferredDescriptorIdx * 2;
-        if (setIndex < _descriptorSets.size()) {
-            vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                   layout, 0, 1, &_descriptorSets[setIndex], 0, nullptr);
-        }
+        // Descriptor set binden (Index = Info * 2 + 0)
+        bindObjectSet(_commandBuffer, layout, _descriptorSets, scene->getDescriptorSetIndex(objectIndex), _view.camera);
 
-        VkBuffer vb[] = {obj.vertexBuffer};
-        VkDeviceSize off[] = {0};
-        vkCmdBindVertexBuffers(_commandBuffer, 0, 1, vb, off);
-        vkCmdPushConstants(_commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 
-                          0, sizeof(glm::mat4), &obj.modelMatrix);
-        vkCmdDraw(_commandBuffer, obj.vertexCount, 1, 0, 0);
-        
-        deferredDescriptorIdx++;
+        pushMeshConstants(_commandBuffer, layout, draw, scene->getModelMatrix(objectIndex));
+        drawMeshCulled(_commandBuffer, draw, scene->getWorldBounds(objectIndex), objectIndex);
     }
 
     // ============================================
@@ -219,43 +124,37 @@ void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex) {
     vkCmdSetViewport(_commandBuffer, 0, 1, &viewport);
     vkCmdSetScissor(_commandBuffer, 0, 1, &scissor);
 
-    deferredDescriptorIdx = 0;
-
     for (size_t i = 0; i < scene->getDeferredObjectCount(); ++i) {
-        const auto& obj = scene->getGBufferPassObject(i);
+        const DrawItem& draw = scene->getGBufferPassDraw(i);
+        const size_t objectIndex = scene->getDeferredInfo(i).gbufferPassIndex;
         
-        if (obj.vertexCount == 0 || obj.vertexBuffer == VK_NULL_HANDLE) {
+        // noch ladend: kein Fehler, einfach überspringen
+        if (scene->isPending(objectIndex)) {
+            continue;
+        }
+        // vom ResidencyManager ausgelagert (refreshMesh setzt die Handles auf VK_NULL_HANDLE):
+        // kommt zurück, sobald es wieder sichtbar wird
+        if (draw.vertexBuffer == VK_NULL_HANDLE) {
+            continue;
+        }
+        if (draw.vertexCount == 0) {
             std::cout << "  [GBUFFER] Skipping object " << i << " (invalid)" << std::endl;
-            deferredDescriptorIdx++;
             continue;
         }    
         
 
-        VkPipeline pipeline = obj.pipeline->getPipeline();
+        VkPipeline pipeline = draw.pipeline->getPipeline();
         vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-        VkPipelineLayout layout = obj.pipeline->getPipelineLayout();
+        VkPipelineLayout layout = draw.pipeline->getPipelineLayout();
 
-        // Descriptor set binden
-        size_t setIndex = deferredDescriptorIdx * 2 + 1;
-        
-        if (setIndex < _descriptorSets.size()) {
-            vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                layout, 0, 1, &_descriptorSets[setIndex], 0, nullptr);
-        } else {
+        // Descriptor set binden (Index = Info * 2 + 1)
+        if (!bindObjectSet(_commandBuffer, layout, _descriptorSets, scene->getDescriptorSetIndex(objectIndex), _view.camera)) {
             std::cout << "    ERROR: Descriptor set index out of range!" << std::endl;
         }
 
-        VkBuffer vb[] = {obj.vertexBuffer};
-        VkDeviceSize off[] = {0};
-        vkCmdBindVertexBuffers(_commandBuffer, 0, 1, vb, off);
-        vkCmdPushConstants(_commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 
-                        0, sizeof(glm::mat4), &obj.modelMatrix);
-        
-      
-        vkCmdDraw(_commandBuffer, obj.vertexCount, 1, 0, 0);
-
-        
-        deferredDescriptorIdx++;
+        pushMeshConstants(_commandBuffer, layout, draw, scene->getModelMatrix(objectIndex));
+        // gleiche Geometrie wie im Depth Prepass -> gleiches Culling-Ergebnis
+        drawMeshCulled(_commandBuffer, draw, scene->getWorldBounds(objectIndex), scene->getDeferredInfo(i).depthPassIndex);
     }
     // ============================================
     // SUBPASS 2: LIGHTING + FORWARD RENDERING
@@ -266,15 +165,14 @@ void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex) {
     // 1. LIGHTING QUAD
     if (scene->hasLightingQuad() && !_lightingDescriptorSets.empty()) {
         
-        const auto& lightingQuad = scene->getLightingQuad();
+        const DrawItem& lightingQuad = scene->getLightingQuadDraw();
         
         if (lightingQuad.vertexCount > 0 && lightingQuad.vertexBuffer != VK_NULL_HANDLE) {
             VkPipeline pipeline = lightingQuad.pipeline->getPipeline();
             vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
             VkPipelineLayout layout = lightingQuad.pipeline->getPipelineLayout();
             
-            vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                layout, 0, 1, &_lightingDescriptorSets[0], 0, nullptr);
+            bindSet(_commandBuffer, layout, _lightingDescriptorSets[0], _view.lighting);
             
             VkBuffer vb[] = {lightingQuad.vertexBuffer};
             VkDeviceSize off[] = {0};
@@ -288,132 +186,53 @@ void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex) {
     vkCmdSetViewport(_commandBuffer, 0, 1, &viewport);
     vkCmdSetScissor(_commandBuffer, 0, 1, &scissor);
  
-    // Zähler für jede Descriptor Set Kategorie
-    size_t normalForwardIdx = 0;  // Normale forward objects (NACH deferred)
-    size_t snowIdx = 0;
-    size_t litIdx = 0;
-    
-    // Berechne Offset für normale forward objects (nach deferred sets)
-    size_t normalForwardOffset = scene->getDeferredObjectCount() * 2;
-    
     for (size_t i = 0; i < scene->getObjectCount(); i++) {
-        const auto& obj = scene->getObject(i);
-        
-        // Skip deferred objects - die wurden schon gerendert
-        if (obj.isDeferred) {
+        // Skip deferred objects - die wurden schon gerendert, Spiegel kommen unten
+        if (scene->isDeferredObject(i) || scene->isMirrorObject(i)) {
             continue;
         }
-        
-        // Skip mirror objects erstmal
-        if (scene->isMirrorObject(i)) {
-            if (!obj.isSnow && !obj.isLit) normalForwardIdx++;
-            continue;
-        }
-        
-        if (obj.vertexCount == 0 || obj.vertexBuffer == VK_NULL_HANDLE) {
-            if (obj.isSnow) snowIdx++;
-            else if (obj.isLit) litIdx++;
-            else normalForwardIdx++;
+
+        const DrawItem& draw = scene->getDraw(i);
+        if (scene->isPending(i) || draw.vertexCount == 0 || draw.vertexBuffer == VK_NULL_HANDLE) {
             continue;
         }
 
-        VkPipeline pipeline = obj.pipeline->getPipeline();
+        VkPipeline pipeline = draw.pipeline->getPipeline();
         vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-        VkPipelineLayout layout = obj.pipeline->getPipelineLayout();
+        VkPipelineLayout layout = draw.pipeline->getPipelineLayout();
 
         // Descriptor Set binden basierend auf Typ
-        if (obj.isSnow) {
+        bindSceneObjectSet(_commandBuffer, layout, scene, i);
 
-            if (snowIdx < _snowDescriptorSets.size()) {
-                vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                       layout, 0, 1, &_snowDescriptorSets[snowIdx], 0, nullptr);
-            }
-            snowIdx++;
-        } else if (obj.isLit) {
+        pushMeshConstants(_commandBuffer, layout, draw, scene->getModelMatrix(i));
 
-            if (litIdx < _litDescriptorSets.size()) {
-                vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                       layout, 0, 1, &_litDescriptorSets[litIdx], 0, nullptr);
-            }
-            litIdx++;
+        if (draw.instanceCount > 1 && draw.instanceBuffer != VK_NULL_HANDLE) {
+            drawMesh(_commandBuffer, draw, scene->getWorldBounds(i), draw.instanceCount);
         } else {
-            // Normale forward object
-            size_t setIndex = normalForwardOffset + normalForwardIdx;
-            if (setIndex < _descriptorSets.size()) {
-                vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                       layout, 0, 1, &_descriptorSets[setIndex], 0, nullptr);
-            }
-            normalForwardIdx++;
-        }
-
-        VkBuffer vb[] = {obj.vertexBuffer};
-        VkDeviceSize off[] = {0};
-        vkCmdBindVertexBuffers(_commandBuffer, 0, 1, vb, off);
-        vkCmdPushConstants(_commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 
-                          0, sizeof(glm::mat4), &obj.modelMatrix);
-
-        if (obj.instanceCount > 1 && obj.instanceBuffer != VK_NULL_HANDLE) {
-            vkCmdDraw(_commandBuffer, obj.vertexCount, obj.instanceCount, 0, 0);
-        } else {
-            vkCmdDraw(_commandBuffer, obj.vertexCount, 1, 0, 0);
+            drawMeshCulled(_commandBuffer, draw, scene->getWorldBounds(i), i);
         }
     }
 
-    // 3. MIRROR SYSTEM (bleibt vorerst auskommentiert bis Basics funktionieren)
-    normalForwardIdx = 0;
-    const auto& mirrorMarkIndices = scene->getMirrorMarkIndices();
-    const auto& mirrorBlendIndices = scene->getMirrorBlendIndices();
-    for (size_t i = 0; i < scene->getObjectCount(); i++) {
-        if (!scene->isMirrorObject(i) || scene->isLitObject(i) || scene->isSnowObject(i)) {
-            if (!scene->isMirrorObject(i) && !scene->isLitObject(i) && !scene->isSnowObject(i)) {
-                normalForwardIdx++;
-            }
-            continue;
-        }
-        
-        // Nur Mirror-Mark Objekte in diesem Pass
-        bool isMirrorMark = false;
-        for (size_t markIdx : mirrorMarkIndices) {
-            if (i == markIdx) {
-                isMirrorMark = true;
-                break;
-            }
-        }
-        
-        if (!isMirrorMark) {
-            normalForwardIdx++;
-            continue;
-        }
+    // 3. MIRROR SYSTEM: Spiegelflächen in den Stencil markieren
+    for (size_t i : scene->getMirrorMarkIndices()) {
+        const DrawItem& draw = scene->getDraw(i);
         
-        const auto& obj = scene->getObject(i);
-        
-        if (obj.vertexCount == 0 || obj.vertexBuffer == VK_NULL_HANDLE) {
-            normalForwardIdx++;
+        if (draw.vertexCount == 0 || draw.vertexBuffer == VK_NULL_HANDLE) {
             continue;
         }
 
-        VkPipeline pipelineHandle = obj.pipeline->getPipeline();
+        VkPipeline pipelineHandle = draw.pipeline->getPipeline();
         vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineHandle);
-        VkPipelineLayout pipelineLayout = obj.pipeline->getPipelineLayout();
+        VkPipelineLayout pipelineLayout = draw.pipeline->getPipelineLayout();
 
-        if (normalForwardIdx >= _descriptorSets.size()) {
+        if (!bindSceneObjectSet(_commandBuffer, pipelineLayout, scene, i)) {
             std::cerr << "ERROR: Mirror mark descriptor set index out of range!\n";
-            normalForwardIdx++;
             continue;
         }
-        
-        vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                               pipelineLayout, 0, 1, &_descriptorSets[normalForwardIdx], 0, nullptr);
-        normalForwardIdx++;
 
-        VkBuffer vertexBuffers[] = { obj.vertexBuffer };
-        VkDeviceSize offsets[] = { 0 };
-        vkCmdBindVertexBuffers(_commandBuffer, 0, 1, vertexBuffers, offsets);
+        pushMeshConstants(_commandBuffer, pipelineLayout, draw, scene->getModelMatrix(i));
 
-        vkCmdPushConstants(_commandBuffer, pipelineLayout, 
-                          VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &obj.modelMatrix);
-
-        vkCmdDraw(_commandBuffer, obj.vertexCount, 1, 0, 0);
+        drawMesh(_commandBuffer, draw, scene->getWorldBounds(i), 1);
     }
 
     // ========================================
@@ -421,161 +240,85 @@ void Frame::recordCommandBuffer(Scene* scene, uint32_t imageIndex) {
     // Diese werden "hinter" der Spiegelebene gerendert
     // ========================================
     for (size_t i = 0; i < scene->getReflectedObjectCount(); i++) {
-    const auto& reflObj = scene->getReflectedObject(i);
+    const DrawItem& reflDraw = scene->getReflectedDraw(i);
     
-    if (reflObj.vertexCount == 0 || reflObj.vertexBuffer == VK_NULL_HANDLE) {
+    if (scene->isPending(scene->getReflectedDescriptorIndex(i)) ||
+        reflDraw.vertexCount == 0 || reflDraw.vertexBuffer == VK_NULL_HANDLE) {
         continue;
     }
 
-    VkPipeline pipelineHandle = reflObj.pipeline->getPipeline();
+    VkPipeline pipelineHandle = reflDraw.pipeline->getPipeline();
     vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineHandle);
-    VkPipelineLayout pipelineLayout = reflObj.pipeline->getPipelineLayout();
+    VkPipelineLayout pipelineLayout = reflDraw.pipeline->getPipelineLayout();
 
     // WICHTIG: Stencil Reference auf 1 setzen
     vkCmdSetStencilReference(_commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, 1);
 
-    //DescriptorSet vom Original-Objekt mit korrektem Offset
+    //DescriptorSet vom Original-Objekt aus der Slot-Tabelle
     size_t originalIdx = scene->getReflectedDescriptorIndex(i);
-    const auto& originalObj = scene->getObject(originalIdx);
+    const ObjectSlot& originalSlot = scene->getObjectSlot(originalIdx);
+    size_t setIndex = scene->getDescriptorSetIndex(originalIdx);
     
-    if (originalObj.isSnow) {
-        size_t snowIdx = 0;
-        for (size_t j = 0; j < originalIdx; j++) {
-            if (scene->isSnowObject(j)) snowIdx++;
-        }
-        if (snowIdx < _snowDescriptorSets.size()) {
-            vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                   pipelineLayout, 0, 1, &_snowDescriptorSets[snowIdx], 0, nullptr);
+    if (isBindless()) {
+        // Gespiegelte Pipelines haben immer das globale Layout, die Textur kommt über den Index
+        bindObjectSet(_commandBuffer, pipelineLayout, _descriptorSets, 0, _view.camera);
+    } else if (originalSlot.kind == ObjectKind::Snow) {
+        if (setIndex < _snowDescriptorSets.size()) {
+            bindSet(_commandBuffer, pipelineLayout, _snowDescriptorSets[setIndex], _view.camera);
         }
-    } else if (originalObj.isLit) {
-        size_t litIdx = 0;
-        for (size_t j = 0; j < originalIdx; j++) {
-            if (scene->isLitObject(j)) litIdx++;
+    } else if (originalSlot.kind == ObjectKind::Lit) {
+        if (setIndex < _litDescriptorSets.size()) {
+            bindSet(_commandBuffer, pipelineLayout, _litDescriptorSets[setIndex], _view.lit);
         }
-        if (litIdx < _litDescriptorSets.size()) {
-            vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                   pipelineLayout, 0, 1, &_litDescriptorSets[litIdx], 0, nullptr);
-        }
-    } else if(originalObj.isDeferred){
-        // Finde DeferredInfo für Objekt
-        size_t deferredInfoIdx = SIZE_MAX;
-        for (size_t d = 0; d < scene->getDeferredObjectCount(); d++) {
-            const auto& info = scene->getDeferredInfo(d);
-            // Prüfe ob originalIdx zu diesem deferredObject gehört
-            if (info.depthPassIndex == originalIdx || info.gbufferPassIndex == originalIdx) {
-                deferredInfoIdx = d;
-                break;
-            }
-        }
-        
-        if (deferredInfoIdx != SIZE_MAX) {
-            //GBuffer Pass Descriptor nutzen(Index = deferredInfoIdx * 2 + 1)
-            size_t descriptorIdx = deferredInfoIdx * 2 + 1;
-            
-            if (descriptorIdx < _descriptorSets.size()) {
-                vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                       pipelineLayout, 0, 1, &_descriptorSets[descriptorIdx], 0, nullptr);
-            } else {
-                std::cerr << "ERROR: Deferred descriptor index out of range!" << std::endl;
-            }
-        } else {
-            std::cerr << "ERROR: Could not find deferred info for object " << originalIdx << std::endl;
-        }
-    
-    }else {
-        //Deferred Objects Offset berücksichtigen
-        size_t deferredOffset = scene->getDeferredObjectCount() * 2;
-        size_t normIdx = 0;
-        
-        for (size_t j = 0; j < originalIdx; j++) {
-            if (!scene->isSnowObject(j) && !scene->isLitObject(j) && 
-                !scene->isMirrorObject(j) && !scene->isDeferredObject(j)) {
-                normIdx++;
-            }
+    } else {
+        //Deferred: immer das Set des G-Buffer Pass (Index = Info * 2 + 1)
+        if (originalSlot.kind == ObjectKind::Deferred && setIndex != SIZE_MAX && !originalSlot.gbufferPass) {
+            setIndex++;
         }
         
-        size_t finalIdx = deferredOffset + normIdx;
-
-        
-        if (finalIdx < _descriptorSets.size()) {
-            vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                   pipelineLayout, 0, 1, &_descriptorSets[finalIdx], 0, nullptr);
+        if (setIndex < _descriptorSets.size()) {
+            bindSet(_commandBuffer, pipelineLayout, _descriptorSets[setIndex], _view.camera);
         } else {
-            std::cerr << "  ERROR: Descriptor set index " << finalIdx 
+            std::cerr << "  ERROR: Descriptor set index " << setIndex 
                       << " out of range (size: " << _descriptorSets.size() << ")" << std::endl;
         }
     }
 
-    VkBuffer vertexBuffers[] = { reflObj.vertexBuffer };
-    VkDeviceSize offsets[] = { 0 };
-    vkCmdBindVertexBuffers(_commandBuffer, 0, 1, vertexBuffers, offsets);
-
-    vkCmdPushConstants(_commandBuffer, pipelineLayout, 
-                      VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &reflObj.modelMatrix);
+    // Spiegelungen haben eigene Matrizen und Bounds, die setzt das MirrorSystem
+    pushMeshConstants(_commandBuffer, pipelineLayout, reflDraw, scene->getReflectedModelMatrix(i));
 
-    vkCmdDraw(_commandBuffer, reflObj.vertexCount, 1, 0, 0);
+    drawMesh(_commandBuffer, reflDraw, scene->getReflectedWorldBounds(i), 1, LOD_BIAS_MIRROR);
     }
 
     // ========================================
     // PASS 4: Transparenten Spiegel rendern (MIRROR_BLEND)
     // Dieser wird über die Reflexionen gerendert
     // ========================================
-    normalForwardIdx = 0;
-    for (size_t i = 0; i < scene->getObjectCount(); i++) {
-        if (!scene->isMirrorObject(i) || scene->isLitObject(i) || scene->isSnowObject(i)) {
-            if (!scene->isMirrorObject(i) && !scene->isLitObject(i) && !scene->isSnowObject(i)) {
-                normalForwardIdx++;
-            }
-            continue;
-        }
-        
-        // Nur Mirror-Blend Objekte in diesem Pass
-        bool isMirrorBlend = false;
-        for (size_t blendIdx : mirrorBlendIndices) {
-            if (i == blendIdx) {
-                isMirrorBlend = true;
-                break;
-            }
-        }
-        
-        if (!isMirrorBlend) {
-            normalForwardIdx++;
-            continue;
-        }
-        
-        const auto& obj = scene->getObject(i);
+    for (size_t i : scene->getMirrorBlendIndices()) {
+        const DrawItem& draw = scene->getDraw(i);
         
-        if (obj.vertexCount == 0 || obj.vertexBuffer == VK_NULL_HANDLE) {
-            normalForwardIdx++;
+        if (draw.vertexCount == 0 || draw.vertexBuffer == VK_NULL_HANDLE) {
             continue;
         }
 
-        VkPipeline pipelineHandle = obj.pipeline->getPipeline();
+        VkPipeline pipelineHandle = draw.pipeline->getPipeline();
         vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineHandle);
-        VkPipelineLayout pipelineLayout = obj.pipeline->getPipelineLayout();
+        VkPipelineLayout pipelineLayout = draw.pipeline->getPipelineLayout();
 
-        if (normalForwardIdx >= _descriptorSets.size()) {
+        if (!bindSceneObjectSet(_commandBuffer, pipelineLayout, scene, i)) {
             std::cerr << "ERROR: Mirror blend descriptor set index out of range!\n";
-            normalForwardIdx++;
             continue;
         }
-        
-        vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                               pipelineLayout, 0, 1, &_descriptorSets[normalForwardIdx], 0, nullptr);
-        normalForwardIdx++;
-
-        VkBuffer vertexBuffers[] = { obj.vertexBuffer };
-        VkDeviceSize offsets[] = { 0 };
-        vkCmdBindVertexBuffers(_commandBuffer, 0, 1, vertexBuffers, offsets);
 
-        vkCmdPushConstants(_commandBuffer, pipelineLayout, 
-                          VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &obj.modelMatrix);
+        pushMeshConstants(_commandBuffer, pipelineLayout, draw, scene->getModelMatrix(i));
 
-        vkCmdDraw(_commandBuffer, obj.vertexCount, 1, 0, 0);
+        drawMesh(_commandBuffer, draw, scene->getWorldBounds(i), 1);
     }
 
     vkCmdEndRenderPass(_commandBuffer);
 
+    writeBindlessTextures();
+
     if (vkEndCommandBuffer(_commandBuffer) != VK_SUCCESS) {
         throw std::runtime_error("failed to record command buffer!");
     }
@@ -596,8 +339,14 @@ void Frame::allocateDescriptorSets(VkDescriptorPool descriptorPool, VkDescriptor
 }
 
 void Frame::updateDescriptorSet(Scene* scene) {
+    // Bindless: Texturen kommen beim Aufnehmen ins globale Array (textureSlot)
+    if (isBindless()) {
+        return;
+    }
+
+    // Dynamic UBO: das Stück der Ansicht kommt beim Binden als Offset dazu
     VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = _uniformBuffer;
+    bufferInfo.buffer = _uniforms.getBuffer();
     bufferInfo.offset = 0;
     bufferInfo.range = sizeof(UniformBufferObject);
 
@@ -605,8 +354,14 @@ void Frame::updateDescriptorSet(Scene* scene) {
     
     // 1. DEFERRED OBJECTS (2 descriptor sets pro object)
     for (size_t i = 0; i < scene->getDeferredObjectCount(); ++i) {
-        const auto& depthObj = scene->getDepthPassObject(i);
-        const auto& gbufferObj = scene->getGBufferPassObject(i);
+        const DrawItem& depthObj = scene->getDepthPassDraw(i);
+        const DrawItem& gbufferObj = scene->getGBufferPassDraw(i);
+
+        // Platzhalter haben noch keine Textur, ihre Sets werden erst nach dem Laden geschrieben
+        if (scene->isPending(scene->getDeferredInfo(i).depthPassIndex)) {
+            descriptorSetIndex += 2;
+            continue;
+        }
         
         // Depth Pass Descriptor
         VkDescriptorImageInfo depthImageInfo{};
@@ -618,7 +373,7 @@ void Frame::updateDescriptorSet(Scene* scene) {
         depthWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         depthWrites[0].dstSet = _descriptorSets[descriptorSetIndex];
         depthWrites[0].dstBinding = 0;
-        depthWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        depthWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         depthWrites[0].descriptorCount = 1;
         depthWrites[0].pBufferInfo = &bufferInfo;
 
@@ -642,7 +397,7 @@ void Frame::updateDescriptorSet(Scene* scene) {
         gbufferWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         gbufferWrites[0].dstSet = _descriptorSets[descriptorSetIndex];
         gbufferWrites[0].dstBinding = 0;
-        gbufferWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        gbufferWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         gbufferWrites[0].descriptorCount = 1;
         gbufferWrites[0].pBufferInfo = &bufferInfo;
 
@@ -657,20 +412,22 @@ void Frame::updateDescriptorSet(Scene* scene) {
         descriptorSetIndex++;
     }
     
-    // 2. NORMAL FORWARD OBJECTS
+    // 2. NORMAL FORWARD OBJECTS (inklusive Spiegel)
     for (size_t i = 0; i < scene->getObjectCount(); ++i) {
-        const auto& obj = scene->getObject(i);
-        
         // Skip deferred, snow, lit
-        if (obj.isDeferred || obj.isSnow || obj.isLit) {
+        if (scene->isDeferredObject(i) || scene->isSnowObject(i) || scene->isLitObject(i)) {
             continue;
         }
+        const DrawItem& obj = scene->getDraw(i);
         
-        
+        descriptorSetIndex = scene->getDescriptorSetIndex(i);
         if (descriptorSetIndex >= _descriptorSets.size()) {
             std::cerr << "ERROR: Descriptor set index out of range!" << std::endl;
             break;
         }
+        if (scene->isPending(i)) {
+            continue;
+        }
 
         VkDescriptorImageInfo imageInfo{};
         imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
@@ -681,7 +438,7 @@ void Frame::updateDescriptorSet(Scene* scene) {
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrites[0].dstSet = _descriptorSets[descriptorSetIndex];
         descriptorWrites[0].dstBinding = 0;
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[0].descriptorCount = 1;
         descriptorWrites[0].pBufferInfo = &bufferInfo;
 
@@ -693,8 +450,6 @@ void Frame::updateDescriptorSet(Scene* scene) {
         descriptorWrites[1].pImageInfo = &imageInfo;
 
         vkUpdateDescriptorSets(_device, 2, descriptorWrites.data(), 0, nullptr);
-        
-        descriptorSetIndex++;
     }
     
 
@@ -703,8 +458,9 @@ void Frame::updateDescriptorSet(Scene* scene) {
 void Frame::updateSnowDescriptorSet(size_t index, VkBuffer particleBuffer,
                                    VkImageView imageView, VkSampler sampler) {
     // UBO
+    // Dynamic UBO: das Stück der Ansicht kommt beim Binden als Offset dazu
     VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = _uniformBuffer;
+    bufferInfo.buffer = _uniforms.getBuffer();
     bufferInfo.offset = 0;
     bufferInfo.range = sizeof(UniformBufferObject);
 
@@ -727,7 +483,7 @@ void Frame::updateSnowDescriptorSet(size_t index, VkBuffer particleBuffer,
     descriptorWrites[0].dstSet = _snowDescriptorSets[index];
     descriptorWrites[0].dstBinding = 0;
     descriptorWrites[0].dstArrayElement = 0;
-    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrites[0].descriptorCount = 1;
     descriptorWrites[0].pBufferInfo = &bufferInfo;
     // Binding 1: Storage Buffer
@@ -754,16 +510,22 @@ void Frame::updateSnowDescriptorSet(size_t index, VkBuffer particleBuffer,
 }
 
 void Frame::updateLitDescriptorSet(Scene* scene) {
+    if (isBindless()) {
+        return;
+    }
+
     VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = _litUniformBuffer;
+    bufferInfo.buffer = _uniforms.getBuffer();
     bufferInfo.offset = 0;
     bufferInfo.range = sizeof(LitUniformBufferObject);
 
-    size_t litIndex = 0;
-    for (size_t i = 0; i < scene->getObjectCount(); ++i) {
-        if (!scene->isLitObject(i)) continue;
+    scene->getLitObjects().forEach([&](size_t i) {
+        const size_t litIndex = scene->getDescriptorSetIndex(i);
+        if (scene->isPending(i) || litIndex >= _litDescriptorSets.size()) {
+            return;
+        }
         
-        const auto& obj = scene->getObject(i);
+        const DrawItem& obj = scene->getDraw(i);
 
         VkDescriptorImageInfo imageInfo{};
         imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
@@ -775,7 +537,7 @@ void Frame::updateLitDescriptorSet(Scene* scene) {
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrites[0].dstSet = _litDescriptorSets[litIndex];
         descriptorWrites[0].dstBinding = 0;
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[0].descriptorCount = 1;
         descriptorWrites[0].pBufferInfo = &bufferInfo;
         descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -786,9 +548,57 @@ void Frame::updateLitDescriptorSet(Scene* scene) {
         descriptorWrites[1].pImageInfo = &imageInfo;
 
         vkUpdateDescriptorSets(_device, 2, descriptorWrites.data(), 0, nullptr);
-        
-        litIndex++;
+    });
+}
+
+void Frame::allocateBindlessDescriptorSet(VkDescriptorPool descriptorPool,
+                                          VkDescriptorSetLayout descriptorSetLayout,
+                                          VkDescriptorSetLayout textureSetLayout,
+                                          uint32_t textureCapacity) {
+    std::array<VkDescriptorSetLayout, 2> layouts = { descriptorSetLayout, textureSetLayout };
+    std::array<VkDescriptorSet, 2> sets{};
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    allocInfo.pSetLayouts = layouts.data();
+
+    if (vkAllocateDescriptorSets(_device, &allocInfo, sets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate bindless descriptor set for frame!");
     }
+    _bindlessSet = sets[0];
+    _bindlessTextureSet = sets[1];
+    _bindlessCapacity = textureCapacity;
+
+    // Der Buffer des UniformAllocators ändert sich nicht, nur einmal schreiben
+    // (die Ansicht kommt beim Binden über die Dynamic Offsets)
+    VkDescriptorBufferInfo uboInfo{};
+    uboInfo.buffer = _uniforms.getBuffer();
+    uboInfo.offset = 0;
+    uboInfo.range = sizeof(UniformBufferObject);
+
+    VkDescriptorBufferInfo litInfo{};
+    litInfo.buffer = _uniforms.getBuffer();
+    litInfo.offset = 0;
+    litInfo.range = sizeof(LitUniformBufferObject);
+
+    std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[0].dstSet = _bindlessSet;
+    descriptorWrites[0].dstBinding = 0;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].pBufferInfo = &uboInfo;
+
+    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[1].dstSet = _bindlessSet;
+    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrites[1].descriptorCount = 1;
+    descriptorWrites[1].pBufferInfo = &litInfo;
+
+    vkUpdateDescriptorSets(_device, static_cast<uint32_t>(descriptorWrites.size()),
+                           descriptorWrites.data(), 0, nullptr);
 }
 
 void Frame::allocateSnowDescriptorSets(VkDescriptorPool descriptorPool, 
@@ -881,7 +691,7 @@ void Frame::updateLightingDescriptorSet(VkImageView gBufferNormalView,VkImageVie
 
     //Binding 2: Lighting UBO
     VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = _lightingUniformBuffer;
+    bufferInfo.buffer = _uniforms.getBuffer();
     bufferInfo.offset = 0;
     bufferInfo.range = sizeof(LightingUniformBufferObject);
 
@@ -918,7 +728,7 @@ void Frame::updateLightingDescriptorSet(VkImageView gBufferNormalView,VkImageVie
     descriptorWrites[3].dstSet = _lightingDescriptorSets[0];
     descriptorWrites[3].dstBinding = 3;
     descriptorWrites[3].dstArrayElement = 0;
-    descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrites[3].descriptorCount = 1;
     descriptorWrites[3].pBufferInfo = &bufferInfo;
 
@@ -958,30 +768,8 @@ void Frame::createSyncObjects() {
 }
 
 void Frame::cleanup() {
-    if (_uniformBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(_device, _uniformBuffer, nullptr);
-        _uniformBuffer = VK_NULL_HANDLE;
-    }
-    if (_uniformBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _uniformBufferMemory, nullptr);
-        _uniformBufferMemory = VK_NULL_HANDLE;
-    }
-    if (_litUniformBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(_device, _litUniformBuffer, nullptr);
-        _litUniformBuffer = VK_NULL_HANDLE;
-    }
-    if (_litUniformBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _litUniformBufferMemory, nullptr);
-        _litUniformBufferMemory = VK_NULL_HANDLE;
-    }
-    if(_lightingUniformBuffer != VK_NULL_HANDLE){
-        vkDestroyBuffer(_device, _lightingUniformBuffer, nullptr);
-        _lightingUniformBuffer = VK_NULL_HANDLE;
-    }
-    if(_lightingUniformBufferMemory != VK_NULL_HANDLE){
-        vkFreeMemory(_device, _lightingUniformBufferMemory,nullptr);
-        _lightingUniformBufferMemory = VK_NULL_HANDLE;
-    }
+    _retired.clear();
+    _uniforms.destroy();
     if (_renderSemaphore != VK_NULL_HANDLE) {
         vkDestroySemaphore(_device, _renderSemaphore, nullptr);
         _renderSemaphore = VK_NULL_HANDLE;
@@ -995,13 +783,19 @@ void Frame::cleanup() {
 void Frame::waitForFence() {
     if (_inFlightFence != VK_NULL_HANDLE) {
         vkWaitForFences(_device, 1, &_inFlightFence, VK_TRUE, UINT64_MAX);
-        vkResetFences(_device, 1, &_inFlightFence);
     }
 }
 
-void Frame::updateUniformBuffer(Camera* camera) {
-    if (!_uniformBufferMapped) return;
+void Frame::beginFrame() {
+    waitForFence();
+    // Die GPU ist mit allen Ansichten des letzten Submits fertig
+    _uniforms.reset();
+    // und mit allem, was davor auf der Queue lag (Fence deckt frühere Submits mit ab)
+    _retired.clear();
+    _frameBegun = true;
+}
 
+void Frame::updateUniformBuffer(Camera* camera) {
     UniformBufferObject ubo{};
     ubo.view = camera->getViewMatrix();
 
@@ -1017,12 +811,15 @@ void Frame::updateUniformBuffer(Camera* camera) {
     ubo.proj[1][1] *= -1.0f;
     ubo.cameraPos = camera->getPosition();
 
-    std::memcpy(_uniformBufferMapped, &ubo, sizeof(ubo));
+    _mainView.camera = _uniforms.push(ubo);
+    _viewProj = ubo.proj * ubo.view;
+
+    //Hauptansicht für die LOD-Auswahl
+    _lodView.eye = ubo.cameraPos;
+    _lodView.pixelsPerUnit = height * 0.5f * std::fabs(ubo.proj[1][1]);
 }
 
 void Frame::updateLitUniformBuffer(Camera* camera, Scene* scene) {
-    if (!_litUniformBufferMapped) return;
-
     LitUniformBufferObject ubo{};
     ubo.view = camera->getViewMatrix();
     
@@ -1045,12 +842,11 @@ void Frame::updateLitUniformBuffer(Camera* camera, Scene* scene) {
         ubo.lights[i].radius = lights[i].radius;
     }
     
-    std::memcpy(_litUniformBufferMapped, &ubo, sizeof(ubo));
+    _mainLitUbo = ubo;
+    _mainView.lit = _uniforms.push(ubo);
 }
 
 void Frame::updateLightingUniformBuffer(Camera* camera, Scene* scene) {
-    if (!_lightingUniformBufferMapped) return;
-
     LightingUniformBufferObject ubo{};
     
     //view und proj Matrizen
@@ -1080,47 +876,40 @@ void Frame::updateLightingUniformBuffer(Camera* camera, Scene* scene) {
         ubo.lights[i].radius = lights[i].radius;
     }
     
-    std::memcpy(_lightingUniformBufferMapped, &ubo, sizeof(ubo));
+    _mainView.lighting = _uniforms.push(ubo);
 }
 
 void Frame::renderCubemap(Scene* scene, ReflectionProbe* probe) {
-    VkCommandBuffer cmd = probe->getCommandBuffer();
+    VkCommandBuffer cmd = _commandBuffer;
     uint32_t resolution = probe->getResolution();
     
     auto views = probe->getCubeFaceViews();
     auto proj = probe->getProjection();
 
     // Finde reflektierende Objekte (die nicht in Cubemap gerendert werden)
-    size_t reflectiveObjectIndex = SIZE_MAX;
-    for (size_t i = 0; i < scene->getObjectCount(); i++) {
-        if (scene->isReflectiveObject(i)) {
-            reflectiveObjectIndex = i;
-            break;
-        }
-    }
-    //origina UBO sichern
-    UniformBufferObject originalUBO;
-    std::memcpy(&originalUBO, _uniformBufferMapped, sizeof(UniformBufferObject));
+    size_t reflectiveObjectIndex = scene->getReflectiveObjects().findFirst();
+    ViewUniforms originalView = _view;
+    LodView originalLodView = _lodView;
+    _lodView.eye = probe->getPosition();
+    _lodView.pixelsPerUnit = static_cast<float>(resolution) * 0.5f * std::fabs(proj[1][1]);
 
-    // eigenen Command Buffer für alle 6 Faces  (wahrscheinlich mies ineffizient, vielleicht fällt uns noch was schlaueres ein)
-    for (uint32_t face = 0; face < 6; face++) {
-        //beginInfo
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        
-        if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to begin command buffer for cubemap face!");
-        }
+    // Lichter wie in der Hauptansicht, nur Kamera und Projektion der Seite
+    LitUniformBufferObject litUbo = _mainLitUbo;
 
-        //UBO für aktuelles face updaten
+    // alle 6 Faces im Command Buffer des Frames, jede mit eigenen UBO-Stücken
+    for (uint32_t face = 0; face < 6; face++) {
         UniformBufferObject ubo{};
         ubo.view = views[face];
         ubo.proj = proj;
         ubo.cameraPos = probe->getPosition();
-        
-        std::memcpy(_uniformBufferMapped, &ubo, sizeof(ubo));
-        
+        _view.camera = _uniforms.push(ubo);
+
+        litUbo.view = views[face];
+        litUbo.proj = proj;
+        litUbo.viewPos = probe->getPosition();
+        _view.lit = _uniforms.push(litUbo);
+        // neue Offsets -> globale Sets neu binden
+        _bindlessBound = false;
 
         // RenderPass für Face
         VkRenderPassBeginInfo rpInfo{};
@@ -1158,101 +947,252 @@ void Frame::renderCubemap(Scene* scene, ReflectionProbe* probe) {
         renderObjectsForCubemap(cmd, scene, reflectiveObjectIndex);
 
         vkCmdEndRenderPass(cmd);
-        
-        //Command Buffer beenden
-        if (vkEndCommandBuffer(cmd) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to end command buffer for cubemap face!");
-        }
-
-        // submitten und warten
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &cmd;
-
-        if (vkQueueSubmit(_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to submit cubemap face!");
-        }
-        
-        //warten bis Face fertig ist
-        vkQueueWaitIdle(_graphicsQueue);
     }
 
-    // UBO wiederherstellen
-    std::memcpy(_uniformBufferMapped, &originalUBO, sizeof(UniformBufferObject));
+    // zurück zur Hauptansicht
+    _view = originalView;
+    _bindlessBound = false;
+    _lodView = originalLodView;
 }
 
 void Frame::renderObjectsForCubemap(VkCommandBuffer cmd, Scene* scene, 
                                     size_t reflectiveObjectIndex) {
-    // Zähler für Descriptor Sets
-    size_t normalForwardIdx = 0;
-    size_t snowIdx = 0;
-    size_t litIdx = 0;
-    size_t deferredDescriptorIdx = 0;
-    
-    size_t normalForwardOffset = scene->getDeferredObjectCount() * 2;
-
     // Rendere alle normalen Forward Objects
     for (size_t i = 0; i < scene->getObjectCount(); i++) {
         // Skip: Reflektierendes Objekt, Deferred, Mirrors
-        if (i == reflectiveObjectIndex || 
-            scene->isDeferredObject(i) || 
-            scene->isMirrorObject(i)) {
-            if (!scene->isSnowObject(i) && !scene->isLitObject(i) && !scene->isDeferredObject(i)) {
-                normalForwardIdx++;
-            }
+        if (i == reflectiveObjectIndex || scene->isDeferredObject(i) || scene->isMirrorObject(i)) {
             continue;
         }
 
-        const auto& obj = scene->getObject(i);
+        const DrawItem& draw = scene->getDraw(i);
         
-        if (obj.vertexCount == 0 || obj.vertexBuffer == VK_NULL_HANDLE) {
-            if (obj.isSnow) snowIdx++;
-            else if (obj.isLit) litIdx++;
-            else normalForwardIdx++;
+        if (scene->isPending(i) || draw.vertexCount == 0 || draw.vertexBuffer == VK_NULL_HANDLE) {
             continue;
         }
 
-        VkPipeline pipeline = obj.pipeline->getPipeline();
+        VkPipeline pipeline = draw.pipeline->getPipeline();
         vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-        VkPipelineLayout layout = obj.pipeline->getPipelineLayout();
+        VkPipelineLayout layout = draw.pipeline->getPipelineLayout();
 
         // Descriptor Set binden
-        if (obj.isSnow) {
-            if (snowIdx < _snowDescriptorSets.size()) {
-                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                       layout, 0, 1, &_snowDescriptorSets[snowIdx], 0, nullptr);
-            }
-            snowIdx++;
-        } else if (obj.isLit) {
-            if (litIdx < _litDescriptorSets.size()) {
-                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                       layout, 0, 1, &_litDescriptorSets[litIdx], 0, nullptr);
-            }
-            litIdx++;
+        bindSceneObjectSet(cmd, layout, scene, i);
+
+        // Push Constants
+        pushMeshConstants(cmd, layout, draw, scene->getModelMatrix(i));
+
+        // Draw (Cubemap-Seiten mit gröberen LODs)
+        if (draw.instanceCount > 1 && draw.instanceBuffer != VK_NULL_HANDLE) {
+            drawMesh(cmd, draw, scene->getWorldBounds(i), draw.instanceCount, LOD_BIAS_CUBEMAP);
         } else {
-            size_t setIndex = normalForwardOffset + normalForwardIdx;
-            if (setIndex < _descriptorSets.size()) {
-                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                       layout, 0, 1, &_descriptorSets[setIndex], 0, nullptr);
+            drawMesh(cmd, draw, scene->getWorldBounds(i), 1, LOD_BIAS_CUBEMAP);
+        }
+    }
+}
+
+void Frame::pushMeshConstants(VkCommandBuffer cmd, VkPipelineLayout layout, const DrawItem& obj,
+                              const glm::mat4& model) {
+    MeshPushConstants push{};
+    push.model = model;
+    push.posScale = obj.quant.posScale;
+    push.posOffset = obj.quant.posOffset;
+    push.textureIndex = textureSlot(obj.textureImageView, obj.textureSampler);
+    vkCmdPushConstants(cmd, layout, MESH_PUSH_CONSTANT_STAGES, 0, sizeof(MeshPushConstants), &push);
+}
+
+bool Frame::bindObjectSet(VkCommandBuffer cmd, VkPipelineLayout layout,
+                          const std::vector<VkDescriptorSet>& sets, size_t index, uint32_t dynamicOffset) {
+    if (isBindless()) {
+        // Alle Mesh-Pipelines haben kompatible Layouts, die Sets bleiben über Pipeline-Wechsel gebunden
+        if (!_bindlessBound) {
+            std::array<VkDescriptorSet, 2> bindlessSets = { _bindlessSet, _bindlessTextureSet };
+            // Binding 0 UBO, Binding 1 LitUBO
+            std::array<uint32_t, 2> offsets = { _view.camera, _view.lit };
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0,
+                                    static_cast<uint32_t>(bindlessSets.size()), bindlessSets.data(),
+                                    static_cast<uint32_t>(offsets.size()), offsets.data());
+            _bindlessBound = true;
+        }
+        return true;
+    }
+    if (index >= sets.size()) {
+        return false;
+    }
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            layout, 0, 1, &sets[index], 1, &dynamicOffset);
+    return true;
+}
+
+bool Frame::bindSceneObjectSet(VkCommandBuffer cmd, VkPipelineLayout layout, Scene* scene, size_t index) {
+    const size_t setIndex = scene->getDescriptorSetIndex(index);
+    switch (scene->getObjectSlot(index).kind) {
+        case ObjectKind::Snow:
+            // Snow hat auch im Bindless-Modus eigene Sets
+            if (setIndex >= _snowDescriptorSets.size()) {
+                return false;
             }
-            normalForwardIdx++;
+            bindSet(cmd, layout, _snowDescriptorSets[setIndex], _view.camera);
+            return true;
+        case ObjectKind::Lit:
+            return bindObjectSet(cmd, layout, _litDescriptorSets, setIndex, _view.lit);
+        default:
+            return bindObjectSet(cmd, layout, _descriptorSets, setIndex, _view.camera);
+    }
+}
+
+void Frame::bindSet(VkCommandBuffer cmd, VkPipelineLayout layout, VkDescriptorSet set, uint32_t dynamicOffset) {
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            layout, 0, 1, &set, 1, &dynamicOffset);
+    // Set 0 ist jetzt ein anderes, die globalen Sets müssen wieder gebunden werden
+    _bindlessBound = false;
+}
+
+uint32_t Frame::textureSlot(VkImageView view, VkSampler sampler) {
+    if (!isBindless() || view == VK_NULL_HANDLE) {
+        return 0;
+    }
+    auto key = std::make_pair(view, sampler);
+    auto it = _bindlessSlots.find(key);
+    if (it != _bindlessSlots.end()) {
+        return it->second;
+    }
+    if (_bindlessImages.size() >= _bindlessCapacity) {
+        if (!_bindlessFullWarned) {
+            std::cerr << "WARNING: Bindless-Textur-Array voll (" << _bindlessCapacity
+                      << "), weitere Texturen nutzen Eintrag 0" << std::endl;
+            _bindlessFullWarned = true;
         }
+        return 0;
+    }
 
-        // Vertex Buffer binden
-        VkBuffer vb[] = {obj.vertexBuffer};
-        VkDeviceSize off[] = {0};
-        vkCmdBindVertexBuffers(cmd, 0, 1, vb, off);
+    VkDescriptorImageInfo imageInfo{};
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfo.imageView = view;
+    imageInfo.sampler = sampler;
 
-        // Push Constants
-        vkCmdPushConstants(cmd, layout, VK_SHADER_STAGE_VERTEX_BIT, 
-                          0, sizeof(glm::mat4), &obj.modelMatrix);
+    uint32_t slot = static_cast<uint32_t>(_bindlessImages.size());
+    _bindlessImages.push_back(imageInfo);
+    _bindlessSlots.emplace(key, slot);
+    return slot;
+}
 
-        // Draw
-        if (obj.instanceCount > 1 && obj.instanceBuffer != VK_NULL_HANDLE) {
-            vkCmdDraw(cmd, obj.vertexCount, obj.instanceCount, 0, 0);
-        } else {
-            vkCmdDraw(cmd, obj.vertexCount, 1, 0, 0);
+void Frame::writeBindlessTextures() {
+    if (!isBindless() || _bindlessWritten == _bindlessImages.size()) {
+        return;
+    }
+    // Ein Write für alle neuen, aufeinanderfolgenden Einträge
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = _bindlessTextureSet;
+    write.dstBinding = 0;
+    write.dstArrayElement = static_cast<uint32_t>(_bindlessWritten);
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.descriptorCount = static_cast<uint32_t>(_bindlessImages.size() - _bindlessWritten);
+    write.pImageInfo = _bindlessImages.data() + _bindlessWritten;
+
+    vkUpdateDescriptorSets(_device, 1, &write, 0, nullptr);
+    _bindlessWritten = _bindlessImages.size();
+}
+
+void Frame::resetBindlessTextures() {
+    // Views wechseln beim Streaming und Handles können nach dem Zerstören wiederverwendet
+    // werden, deshalb wird das Array pro Command Buffer neu aufgebaut statt gecacht
+    _bindlessBound = false;
+    _bindlessSlots.clear();
+    _bindlessImages.clear();
+    _bindlessWritten = 0;
+}
+
+uint32_t Frame::selectLod(const DrawItem& obj, const glm::vec4& worldBounds, float lodBias) const {
+    if (obj.lodCount < 2 || worldBounds.w <= 0.0f || _lodView.pixelsPerUnit <= 0.0f) {
+        return 0;
+    }
+
+    float radius = worldBounds.w;
+    float distance = glm::length(glm::vec3(worldBounds) - _lodView.eye) - radius;
+    if (distance <= 0.0f) {
+        return 0;   // Kamera in der Bounding Sphere
+    }
+
+    // lod.error ist relativ zum Radius -> Pixel auf dem Bildschirm
+    float pixelsPerError = radius * _lodView.pixelsPerUnit / distance;
+    float maxPixelError = LOD_PIXEL_ERROR * lodBias;
+    uint32_t lod = 0;
+    for (uint32_t i = 1; i < obj.lodCount; i++) {
+        if (obj.lods[i].error * pixelsPerError > maxPixelError) {
+            break;
+        }
+        lod = i;
+    }
+    return lod;
+}
+
+void Frame::drawMesh(VkCommandBuffer cmd, const DrawItem& obj, const glm::vec4& worldBounds,
+                     uint32_t instanceCount, float lodBias) {
+    VkBuffer vb[] = {obj.vertexBuffer};
+    VkDeviceSize off[] = {0};
+    vkCmdBindVertexBuffers(cmd, 0, 1, vb, off);
+
+    if (obj.indexBuffer != VK_NULL_HANDLE) {
+        vkCmdBindIndexBuffer(cmd, obj.indexBuffer, 0, obj.indexType);
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = obj.indexCount;
+        if (obj.lodCount > 0) {
+            // Instanzen haben eigene Transformationen, da sagen Scene::getModelMatrix und
+            // die Weltraum-Bounds nichts über ihren Abstand
+            const MeshLod& lod = obj.lods[instanceCount > 1 ? 0 : selectLod(obj, worldBounds, lodBias)];
+            firstIndex = lod.firstIndex;
+            indexCount = lod.indexCount;
+            _lodStats.trianglesSaved += uint64_t(obj.lods[0].indexCount - lod.indexCount) / 3 * instanceCount;
+        }
+        _lodStats.trianglesDrawn += uint64_t(indexCount) / 3 * instanceCount;
+        vkCmdDrawIndexed(cmd, indexCount, instanceCount, firstIndex, 0, 0);
+    } else {
+        _lodStats.trianglesDrawn += uint64_t(obj.vertexCount) / 3 * instanceCount;
+        vkCmdDraw(cmd, obj.vertexCount, instanceCount, 0, 0);
+    }
+}
+
+void Frame::cullMeshlets(Scene* scene) {
+    if (!_meshletCuller) {
+        return;
+    }
+    _meshletCuller->beginFrame(_frameIndex, _viewProj, _lodView.eye);
+
+    // nur wo LOD 0 gezeichnet wird, die Meshlets gibt es nur für LOD 0
+    bool culled = false;
+    for (size_t i = 0; i < scene->getDeferredObjectCount(); ++i) {
+        const DrawItem& obj = scene->getDepthPassDraw(i);
+        const size_t objectIndex = scene->getDeferredInfo(i).depthPassIndex;
+        if (scene->isPending(objectIndex)) {
+            continue;
+        }
+        if (obj.meshletCount > 0 && selectLod(obj, scene->getWorldBounds(objectIndex), 1.0f) == 0) {
+            culled |= _meshletCuller->cull(_commandBuffer, _frameIndex, objectIndex, obj,
+                                           scene->getModelMatrix(objectIndex));
         }
     }
-}
\ No newline at end of file
+    for (size_t i = 0; i < scene->getObjectCount(); i++) {
+        if (scene->isPending(i) || scene->isDeferredObject(i) || scene->isSnowObject(i) || scene->isMirrorObject(i)) {
+            continue;
+        }
+        const DrawItem& obj = scene->getDraw(i);
+        if (obj.instanceCount > 1) {
+            continue;
+        }
+        if (obj.meshletCount > 0 && selectLod(obj, scene->getWorldBounds(i), 1.0f) == 0) {
+            culled |= _meshletCuller->cull(_commandBuffer, _frameIndex, i, obj, scene->getModelMatrix(i));
+        }
+    }
+    if (culled) {
+        _meshletCuller->finishCulling(_commandBuffer);
+    }
+}
+
+void Frame::drawMeshCulled(VkCommandBuffer cmd, const DrawItem& obj, const glm::vec4& worldBounds, size_t cullKey) {
+    if (_meshletCuller && _meshletCuller->drawCulled(cmd, _frameIndex, cullKey, obj)) {
+        // wie viele Dreiecke sichtbar sind, weiß nur die GPU (siehe MeshletStats)
+        _lodStats.trianglesDrawn += uint64_t(obj.baseIndexCount()) / 3;
+        return;
+    }
+    drawMesh(cmd, obj, worldBounds, 1);
+}
@@ -3,13 +3,20 @@
 
 #include <vulkan/vulkan_core.h>
 #include <vector>
+#include <map>
+#include <memory>
+#include <utility>
 #include <glm/glm.hpp>
 #include "../Rendering/Swapchain.hpp"
 #include "../Rendering/Framebuffers.hpp"
+#include "../DeletionQueue.hpp"
 #include "../../Scene.hpp"
 #include "Camera.hpp"
 #include "../initBuffer.hpp"
 #include "../renderToTexture/ReflectionProbe.hpp"
+#include "UniformAllocator.hpp"
+
+class MeshletCuller;
 
 struct UniformBufferObject {
     alignas(16) glm::mat4 view;
@@ -34,15 +41,39 @@ struct LightingUniformBufferObject {
     } lights[4];
 };
 
+// Offsets der Uniform-Daten einer Ansicht im UniformAllocator des Frames,
+// gehen beim Binden als Dynamic Offsets mit
+struct ViewUniforms {
+    uint32_t camera = 0;    // UniformBufferObject
+    uint32_t lit = 0;       // LitUniformBufferObject
+    uint32_t lighting = 0;  // LightingUniformBufferObject
+};
+
+// Blickpunkt des gerade aufgezeichneten Passes für die LOD-Auswahl
+struct LodView {
+    glm::vec3 eye{0.0f};
+    float pixelsPerUnit = 0.0f;     // Pixel je Einheit in Abstand 1: Höhe / (2 * tan(fov/2))
+};
+
+// Dreiecke des letzten Frames (Hauptansicht, Cubemap, Spiegel zusammen)
+struct LodStats {
+    uint64_t trianglesDrawn = 0;
+    uint64_t trianglesSaved = 0;    // Differenz zu LOD 0
+};
+
 class Frame {
 public:
+    // Erlaubter geometrischer Fehler einer LOD-Stufe in Pixeln,
+    // für Cubemap-Seiten und Spiegelungen entsprechend gröber
+    static constexpr float LOD_PIXEL_ERROR = 1.0f;
+    static constexpr float LOD_BIAS_MIRROR = 2.0f;
+    static constexpr float LOD_BIAS_CUBEMAP = 4.0f;
+
     Frame(VkPhysicalDevice physicalDevice, VkDevice device, SwapChain* swapChain,
           Framebuffers* framebuffers, VkQueue graphicsQueue, VkCommandPool commandPool)
         : _physicalDevice(physicalDevice), _device(device), _swapChain(swapChain),
-          _framebuffers(framebuffers), _graphicsQueue(graphicsQueue) {
-        createUniformBuffer();
-        createLitUniformBuffer();
-        createLightingUniformBuffer();
+          _framebuffers(framebuffers), _graphicsQueue(graphicsQueue),
+          _uniforms(physicalDevice, device) {
         allocateCommandBuffer(commandPool);
         createSyncObjects();
     }
@@ -51,10 +82,8 @@ public:
         cleanup();
     }
 
-    // Uniform Buffers
-    void createUniformBuffer();
-    void createLitUniformBuffer();
-    void createLightingUniformBuffer();
+    // Uniform-Daten der Hauptansicht, je ein neues Stück im UniformAllocator
+    // (nach beginFrame aufrufen)
     void updateUniformBuffer(Camera* camera);
     void updateLitUniformBuffer(Camera* camera, Scene* scene);
     void updateLightingUniformBuffer(Camera* camera, Scene* scene);
@@ -72,6 +101,14 @@ public:
     void allocateLightingDescriptorSets(VkDescriptorPool descriptorPool, 
                                           VkDescriptorSetLayout descriptorSetLayout, 
                                           size_t count);
+    // Bindless-Modus: zwei globale Sets statt der Sets pro Objekt, Set 0 mit den UBOs
+    // (Dynamic Offsets), Set 1 mit dem Textur-Array (Update After Bind, dafür braucht
+    // pool VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT). Snow und Lighting behalten ihre eigenen Sets
+    void allocateBindlessDescriptorSet(VkDescriptorPool descriptorPool,
+                                       VkDescriptorSetLayout descriptorSetLayout,
+                                       VkDescriptorSetLayout textureSetLayout,
+                                       uint32_t textureCapacity);
+    bool isBindless() const { return _bindlessSet != VK_NULL_HANDLE; }
 
     void updateDescriptorSet(Scene* scene);
     void updateLitDescriptorSet(Scene* scene);
@@ -81,7 +118,8 @@ public:
 
     // Command Buffer
     void allocateCommandBuffer(VkCommandPool commandPool);
-    void recordCommandBuffer(Scene* scene, uint32_t imageIndex);
+    // probe != nullptr: vorher die Cubemap-Seiten in denselben Command Buffer aufzeichnen
+    void recordCommandBuffer(Scene* scene, uint32_t imageIndex, ReflectionProbe* probe = nullptr);
 
     // Deferred Rendering Passes
     void renderDeferredDepthPass(Scene* scene);
@@ -89,7 +127,8 @@ public:
     void renderDeferredLightingPass(Scene* scene);
 
     void renderForwardObjects(Scene* scene);
-    //rendert die Cubemap (render-to-texture)
+    //rendert die Cubemap (render-to-texture) in den Command Buffer des Frames,
+    //jede Seite mit eigenen UBO-Stücken, ohne auf die GPU zu warten
     void renderCubemap(Scene* scene, ReflectionProbe* probe);
     //Rendert Objekte in den Cubemap Faces
     void renderObjectsForCubemap(VkCommandBuffer cmd, Scene* scene, 
@@ -99,15 +138,24 @@ public:
     void createSyncObjects();
     void waitForFence();
     void submitCommandBuffer(uint32_t imageIndex);
+    // Wartet auf den letzten Submit dieses Frames und gibt den UniformAllocator frei.
+    // Vor den update*UniformBuffer-Aufrufen, render() holt es sonst selbst nach
+    void beginFrame();
+    // Ressourcen, die der letzte Submit dieses Frames noch benutzen kann (z.B. nach einem
+    // Swapchain-Resize). Jeder Frame hält batch bis zu seinem nächsten beginFrame; wenn alle
+    // Frames losgelassen haben, zerstört der Destruktor der DeletionQueue die Ressourcen
+    void retire(const std::shared_ptr<DeletionQueue>& batch) { _retired.push_back(batch); }
 
     // Rendering
     bool render(Scene* scene, ReflectionProbe* probe = nullptr) {
-        waitForFence();
+        if (!_frameBegun) {
+            beginFrame();
+        }
+        _frameBegun = false;
+        _lodStats = LodStats{};
 
         static uint32_t frameCounter = 0;
-        if (probe&& (frameCounter % scene->getReflectionUpdateInterval() == 0)) {
-            renderCubemap(scene, probe);
-        }
+        bool updateProbe = probe && (frameCounter % scene->getReflectionUpdateInterval() == 0);
         frameCounter++;
 
         uint32_t imageIndex;
@@ -120,7 +168,7 @@ public:
             throw std::runtime_error("failed to acquire swap chain image!");
         }
 
-        recordCommandBuffer(scene, imageIndex);
+        recordCommandBuffer(scene, imageIndex, updateProbe ? probe : nullptr);
         submitCommandBuffer(imageIndex);
 
         VkPresentInfoKHR presentInfo{};
@@ -146,32 +194,80 @@ public:
 
     void cleanup();
 
+    const LodStats& getLodStats() const { return _lodStats; }
+    const UniformAllocator& getUniformAllocator() const { return _uniforms; }
+
+    // Cluster-Culling für Objekte mit Meshlets (nullptr = alles normal zeichnen)
+    void setMeshletCuller(MeshletCuller* culler, uint32_t frameIndex) {
+        _meshletCuller = culler;
+        _frameIndex = frameIndex;
+    }
+
 private:
+    // model + Dekodier-Parameter des Vertex-Formats als Push Constants
+    // (model aus Scene::getModelMatrix, bei Spiegelungen Scene::getReflectedModelMatrix)
+    void pushMeshConstants(VkCommandBuffer cmd, VkPipelineLayout layout, const DrawItem& obj,
+                           const glm::mat4& model);
+    // Set eines Objekts binden (Index in sets), dynamicOffset = Stück des UBOs der aktuellen
+    // Ansicht (_view). Im Bindless-Modus stattdessen die globalen Sets, und nur wenn seitdem
+    // ein anderes Set oder eine andere Ansicht gebunden wurde.
+    // false = index außerhalb von sets (nichts gebunden)
+    bool bindObjectSet(VkCommandBuffer cmd, VkPipelineLayout layout,
+                       const std::vector<VkDescriptorSet>& sets, size_t index, uint32_t dynamicOffset);
+    // Set von Objekt index der Szene nach seiner Slot-Tabelle (Snow, Lit oder normal/deferred)
+    bool bindSceneObjectSet(VkCommandBuffer cmd, VkPipelineLayout layout, Scene* scene, size_t index);
+    // Set mit genau einem Dynamic UBO binden (Snow, Lighting, Spiegelungen ohne Bindless)
+    void bindSet(VkCommandBuffer cmd, VkPipelineLayout layout, VkDescriptorSet set, uint32_t dynamicOffset);
+    // Eintrag von view/sampler im Textur-Array, legt ihn beim ersten Draw des Frames an
+    uint32_t textureSlot(VkImageView view, VkSampler sampler);
+    // Neue Einträge ins Textur-Array schreiben (vor dem Submit, Update After Bind)
+    void writeBindlessTextures();
+    // Textur-Array für einen neuen Command Buffer leeren
+    void resetBindlessTextures();
+    // Bindet Vertex- (und falls vorhanden Index-) Buffer und zeichnet das Objekt
+    // in der zur Entfernung passenden LOD-Stufe (lodBias > 1 = gröber),
+    // worldBounds siehe worldBoundingSphere
+    void drawMesh(VkCommandBuffer cmd, const DrawItem& obj, const glm::vec4& worldBounds,
+                  uint32_t instanceCount, float lodBias = 1.0f);
+    // Gröbste Stufe, deren Fehler projiziert unter LOD_PIXEL_ERROR * lodBias bleibt
+    uint32_t selectLod(const DrawItem& obj, const glm::vec4& worldBounds, float lodBias) const;
+    // Compute-Dispatches des MeshletCullers für die Hauptansicht (vor dem Render Pass)
+    void cullMeshlets(Scene* scene);
+    // Sichtbare Meshlets per Indirect Draw, sonst wie drawMesh
+    void drawMeshCulled(VkCommandBuffer cmd, const DrawItem& obj, const glm::vec4& worldBounds, size_t cullKey);
+
     VkPhysicalDevice _physicalDevice;
     VkDevice _device;
     SwapChain* _swapChain;
     Framebuffers* _framebuffers;
     VkQueue _graphicsQueue;
 
-    // Uniform Buffers
-    VkBuffer _uniformBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _uniformBufferMemory = VK_NULL_HANDLE;
-    UniformBufferObject* _uniformBufferMapped = nullptr;
-
-    VkBuffer _litUniformBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _litUniformBufferMemory = VK_NULL_HANDLE;
-    LitUniformBufferObject* _litUniformBufferMapped = nullptr;
-
-    //Uniform Buffers für deferred
-    VkBuffer _lightingUniformBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _lightingUniformBufferMemory = VK_NULL_HANDLE;
-    LightingUniformBufferObject* _lightingUniformBufferMapped = nullptr;
+    // Uniform-Daten aller Ansichten, wird in beginFrame zurückgesetzt
+    UniformAllocator _uniforms;
+    ViewUniforms _mainView;     // aus den update*UniformBuffer-Aufrufen
+    // CPU-Kopie des Lit-UBOs der Hauptansicht für die Cubemap-Seiten; aus dem gemappten
+    // (oft write-combined) Speicher zurückzulesen wäre sehr langsam
+    LitUniformBufferObject _mainLitUbo{};
+    ViewUniforms _view;         // gerade aufgezeichnete Ansicht
+    bool _frameBegun = false;
+    // noch nicht freigegebene Ressourcen aus der Zeit vor dem letzten Submit (siehe retire)
+    std::vector<std::shared_ptr<DeletionQueue>> _retired;
 
     // Descriptor Sets
     std::vector<VkDescriptorSet> _descriptorSets;
     std::vector<VkDescriptorSet> _snowDescriptorSets;
     std::vector<VkDescriptorSet> _litDescriptorSets;
     std::vector<VkDescriptorSet> _lightingDescriptorSets;
+
+    // Bindless: Einträge werden pro Command Buffer in Draw-Reihenfolge vergeben
+    VkDescriptorSet _bindlessSet = VK_NULL_HANDLE;
+    VkDescriptorSet _bindlessTextureSet = VK_NULL_HANDLE;
+    uint32_t _bindlessCapacity = 0;
+    bool _bindlessBound = false;
+    std::map<std::pair<VkImageView, VkSampler>, uint32_t> _bindlessSlots;
+    std::vector<VkDescriptorImageInfo> _bindlessImages;
+    size_t _bindlessWritten = 0;
+    bool _bindlessFullWarned = false;
     // Command Buffer
     VkCommandBuffer _commandBuffer = VK_NULL_HANDLE;
 
@@ -179,6 +275,15 @@ private:
     VkSemaphore _renderSemaphore = VK_NULL_HANDLE;
     VkFence _inFlightFence = VK_NULL_HANDLE;
 
+    // LOD-Auswahl
+    LodView _lodView;
+    LodStats _lodStats;
+
+    // Meshlet-Culling
+    MeshletCuller* _meshletCuller = nullptr;
+    uint32_t _frameIndex = 0;
+    glm::mat4 _viewProj{1.0f};
+
     // Helper
     InitBuffer _buff;
 };
\ No newline at end of file
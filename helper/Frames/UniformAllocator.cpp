@@ -0,0 +1,64 @@
+#include "UniformAllocator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+UniformAllocator::UniformAllocator(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize capacity)
+    : _device(device), _capacity(capacity) {
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    _alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = _capacity;
+    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(_device, &bufferInfo, nullptr, &_buffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create uniform allocator buffer!");
+    }
+
+    try {
+        _memory = MemoryAllocator::of(_device).allocateBuffer(
+            _buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Uniforms);
+    } catch (const std::exception&) {
+        vkDestroyBuffer(_device, _buffer, nullptr);
+        _buffer = VK_NULL_HANDLE;
+        throw std::runtime_error("failed to allocate uniform allocator memory!");
+    }
+}
+
+UniformAllocator::~UniformAllocator() {
+    destroy();
+}
+
+UniformAllocator::Slice UniformAllocator::allocate(VkDeviceSize size) {
+    VkDeviceSize offset = (_head + _alignment - 1) / _alignment * _alignment;
+    if (offset + size > _capacity) {
+        throw std::runtime_error("uniform allocator full (" + std::to_string(_capacity)
+                                 + " bytes), increase UniformAllocator capacity!");
+    }
+    _head = offset + size;
+    _peak = std::max(_peak, _head);
+
+    Slice slice;
+    slice.offset = static_cast<uint32_t>(offset);
+    slice.mapped = static_cast<char*>(_memory.mapped) + offset;
+    return slice;
+}
+
+void UniformAllocator::reset() {
+    _head = 0;
+}
+
+void UniformAllocator::destroy() {
+    if (_buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(_device, _buffer, nullptr);
+        _buffer = VK_NULL_HANDLE;
+    }
+    if (_memory) {
+        MemoryAllocator::of(_device).free(_memory);
+    }
+}
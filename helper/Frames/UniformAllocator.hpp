@@ -0,0 +1,57 @@
+// UniformAllocator.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstring>
+#include "../MemoryAllocator.hpp"
+
+// Linearer Allocator für Uniform-Daten eines Frames, ein Stück pro Ansicht (Dynamic UBO)
+class UniformAllocator {
+public:
+    static constexpr VkDeviceSize DEFAULT_CAPACITY = 64 * 1024;
+
+    // Ein ausgeteiltes Stück: offset geht als Dynamic Offset an vkCmdBindDescriptorSets
+    struct Slice {
+        uint32_t offset = 0;
+        void* mapped = nullptr;
+    };
+
+    UniformAllocator(VkPhysicalDevice physicalDevice, VkDevice device,
+                     VkDeviceSize capacity = DEFAULT_CAPACITY);
+    ~UniformAllocator();
+
+    UniformAllocator(const UniformAllocator&) = delete;
+    UniformAllocator& operator=(const UniformAllocator&) = delete;
+
+    // size Bytes, ausgerichtet auf minUniformBufferOffsetAlignment (wirft, wenn der Buffer voll ist)
+    Slice allocate(VkDeviceSize size);
+
+    // Kopiert data in ein neues Stück und liefert dessen Offset
+    template <typename T>
+    uint32_t push(const T& data) {
+        Slice slice = allocate(sizeof(T));
+        std::memcpy(slice.mapped, &data, sizeof(T));
+        return slice.offset;
+    }
+
+    // Alles wieder frei; erst aufrufen, wenn die GPU mit dem Frame fertig ist
+    void reset();
+
+    VkBuffer getBuffer() const { return _buffer; }
+    VkDeviceSize getCapacity() const { return _capacity; }
+    VkDeviceSize getUsed() const { return _head; }
+    // Höchster Füllstand seit dem Anlegen
+    VkDeviceSize getPeak() const { return _peak; }
+
+    void destroy();
+
+private:
+    VkDevice _device;
+    VkDeviceSize _capacity;
+    VkDeviceSize _alignment = 1;
+    VkBuffer _buffer = VK_NULL_HANDLE;
+    MemoryAllocation _memory;
+    VkDeviceSize _head = 0;
+    VkDeviceSize _peak = 0;
+};
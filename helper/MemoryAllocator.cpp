@@ -0,0 +1,360 @@
+#include "MemoryAllocator.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    std::unordered_map<VkDevice, MemoryAllocator*>& allocators() {
+        static std::unordered_map<VkDevice, MemoryAllocator*> registry;
+        return registry;
+    }
+}
+
+MemoryAllocator::MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device)
+    : _physicalDevice(physicalDevice), _device(device) {
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &_memoryProperties);
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    _bufferImageGranularity = std::max<VkDeviceSize>(props.limits.bufferImageGranularity, 1);
+    _stats.maxDeviceAllocations = props.limits.maxMemoryAllocationCount;
+
+    if (!allocators().emplace(device, this).second) {
+        throw std::runtime_error("MemoryAllocator: device already has an allocator");
+    }
+}
+
+MemoryAllocator::~MemoryAllocator() {
+    allocators().erase(_device);
+}
+
+MemoryAllocator& MemoryAllocator::of(VkDevice device) {
+    auto it = allocators().find(device);
+    if (it == allocators().end()) {
+        throw std::runtime_error("MemoryAllocator::of: no allocator for this device");
+    }
+    return *it->second;
+}
+
+MemoryAllocation MemoryAllocator::allocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties,
+                                                 MemoryCategory category) {
+    VkMemoryDedicatedRequirements dedicated{};
+    dedicated.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicated;
+    VkBufferMemoryRequirementsInfo2 info{};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+    info.buffer = buffer;
+    vkGetBufferMemoryRequirements2(_device, &info, &requirements);
+
+    MemoryAllocation allocation = allocate(requirements.memoryRequirements, properties, false,
+                                           dedicated.prefersDedicatedAllocation || dedicated.requiresDedicatedAllocation,
+                                           buffer, VK_NULL_HANDLE, category);
+    if (vkBindBufferMemory(_device, buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        free(allocation);
+        throw std::runtime_error("failed to bind buffer memory");
+    }
+    return allocation;
+}
+
+MemoryAllocation MemoryAllocator::allocateImage(VkImage image, VkMemoryPropertyFlags properties,
+                                                MemoryCategory category) {
+    VkMemoryDedicatedRequirements dedicated{};
+    dedicated.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+    VkMemoryRequirements2 requirements{};
+    requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    requirements.pNext = &dedicated;
+    VkImageMemoryRequirementsInfo2 info{};
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+    info.image = image;
+    vkGetImageMemoryRequirements2(_device, &info, &requirements);
+
+    MemoryAllocation allocation = allocate(requirements.memoryRequirements, properties, true,
+                                           dedicated.prefersDedicatedAllocation || dedicated.requiresDedicatedAllocation,
+                                           VK_NULL_HANDLE, image, category);
+    if (vkBindImageMemory(_device, image, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        free(allocation);
+        throw std::runtime_error("failed to bind image memory");
+    }
+    return allocation;
+}
+
+MemoryAllocation MemoryAllocator::allocate(const VkMemoryRequirements& requirements,
+                                           VkMemoryPropertyFlags properties,
+                                           bool optimal, bool dedicated, VkBuffer buffer, VkImage image,
+                                           MemoryCategory category) {
+    const uint32_t memoryType = findMemoryType(requirements.memoryTypeBits, properties);
+    const uint32_t poolIndex = poolFor(memoryType, optimal);
+    Pool& pool = _pools[poolIndex];
+
+    MemoryAllocation allocation;
+    allocation.size = requirements.size;
+    allocation.category = category;
+
+    // eigene Allokation: vom Treiber gewünscht oder zu groß für einen Block
+    if (dedicated || requirements.size > pool.blockSize / DEDICATED_FRACTION) {
+        allocation.memory = allocateMemory(requirements.size, memoryType, buffer, image, &allocation.mapped);
+        _stats.dedicatedCount++;
+        _stats.dedicatedBytes += requirements.size;
+        MemoryReport::addDevice(category, requirements.size);
+        return allocation;
+    }
+
+    const uint32_t order = orderFor(requirements.size, requirements.alignment);
+    VkDeviceSize offset = 0;
+    uint32_t blockIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+        if (pool.blocks[i] && allocateInBlock(*pool.blocks[i], order, offset)) {
+            blockIndex = i;
+            break;
+        }
+    }
+
+    // alle Blöcke voll: neuen anlegen (in einen freigegebenen Platz, falls vorhanden)
+    if (blockIndex == UINT32_MAX) {
+        auto block = std::make_unique<Block>();
+        block->size = pool.blockSize;
+        block->memory = allocateMemory(pool.blockSize, memoryType, VK_NULL_HANDLE, VK_NULL_HANDLE, &block->mapped);
+        uint32_t maxOrder = orderFor(pool.blockSize, 1);
+        block->freeLists.resize(maxOrder + 1);
+        block->freeLists[maxOrder].insert(0);
+        _stats.blockCount++;
+        _stats.blockBytes += pool.blockSize;
+
+        auto empty = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+        blockIndex = static_cast<uint32_t>(empty - pool.blocks.begin());
+        if (empty == pool.blocks.end()) {
+            pool.blocks.push_back(std::move(block));
+        } else {
+            *empty = std::move(block);
+        }
+        allocateInBlock(*pool.blocks[blockIndex], order, offset);
+    }
+
+    Block& block = *pool.blocks[blockIndex];
+    const VkDeviceSize chunk = MIN_ALLOCATION << order;
+    block.used += chunk;
+    allocation.memory = block.memory;
+    allocation.offset = offset;
+    allocation.pool = poolIndex;
+    allocation.block = blockIndex;
+    if (block.mapped) {
+        allocation.mapped = static_cast<char*>(block.mapped) + offset;
+    }
+    _stats.subAllocations++;
+    _stats.usedBytes += requirements.size;
+    _stats.paddingBytes += chunk - requirements.size;
+    MemoryReport::addDevice(category, requirements.size);
+    return allocation;
+}
+
+void MemoryAllocator::free(MemoryAllocation& allocation) {
+    if (!allocation) {
+        return;
+    }
+    MemoryReport::removeDevice(allocation.category, allocation.size);
+    if (allocation.pool == UINT32_MAX) {
+        freeMemory(allocation.memory);
+        _stats.dedicatedCount--;
+        _stats.dedicatedBytes -= allocation.size;
+        allocation = MemoryAllocation{};
+        return;
+    }
+
+    Pool& pool = _pools.at(allocation.pool);
+    Block& block = *pool.blocks.at(allocation.block);
+    const VkDeviceSize chunk = MIN_ALLOCATION << block.allocated.at(allocation.offset);
+    freeInBlock(block, allocation.offset);
+    block.used -= chunk;
+    _stats.subAllocations--;
+    _stats.usedBytes -= allocation.size;
+    _stats.paddingBytes -= chunk - allocation.size;
+
+    // leere Blöcke zurückgeben, einen pro Pool als Reserve behalten
+    if (block.used == 0) {
+        bool otherEmpty = false;
+        for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+            if (i != allocation.block && pool.blocks[i] && pool.blocks[i]->used == 0) {
+                otherEmpty = true;
+            }
+        }
+        if (otherEmpty) {
+            freeMemory(block.memory);
+            _stats.blockCount--;
+            _stats.blockBytes -= block.size;
+            pool.blocks[allocation.block].reset();
+        }
+    }
+    allocation = MemoryAllocation{};
+}
+
+VkDeviceSize MemoryAllocator::unusedBlockBytes(VkMemoryHeapFlags heapFlags) const {
+    VkDeviceSize unused = 0;
+    for (const Pool& pool : _pools) {
+        const uint32_t heap = _memoryProperties.memoryTypes[pool.memoryType].heapIndex;
+        if ((_memoryProperties.memoryHeaps[heap].flags & heapFlags) != heapFlags) {
+            continue;
+        }
+        for (const auto& block : pool.blocks) {
+            if (block) {
+                unused += block->size - block->used;
+            }
+        }
+    }
+    return unused;
+}
+
+void MemoryAllocator::destroy() {
+    for (Pool& pool : _pools) {
+        for (auto& block : pool.blocks) {
+            if (!block) {
+                continue;
+            }
+            if (!block->allocated.empty()) {
+                std::cerr << "MemoryAllocator: " << block->allocated.size()
+                          << " Allokationen beim Zerstören noch belegt" << std::endl;
+            }
+            freeMemory(block->memory);
+        }
+        pool.blocks.clear();
+    }
+    _pools.clear();
+    _stats.blockCount = 0;
+    _stats.blockBytes = 0;
+    _stats.subAllocations = 0;
+    _stats.usedBytes = 0;
+    _stats.paddingBytes = 0;
+}
+
+uint32_t MemoryAllocator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+    for (uint32_t i = 0; i < _memoryProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1u << i)) &&
+            (_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    throw std::runtime_error("failed to find suitable memory type!");
+}
+
+uint32_t MemoryAllocator::poolFor(uint32_t memoryType, bool optimal) {
+    // Stücke sind mindestens MIN_ALLOCATION groß und so ausgerichtet - bei kleiner Granularität
+    // liegen Buffer und Image also nie auf derselben Seite
+    if (_bufferImageGranularity <= MIN_ALLOCATION) {
+        optimal = false;
+    }
+    for (uint32_t i = 0; i < _pools.size(); i++) {
+        if (_pools[i].memoryType == memoryType && _pools[i].optimal == optimal) {
+            return i;
+        }
+    }
+
+    Pool pool;
+    pool.memoryType = memoryType;
+    pool.optimal = optimal;
+    const VkDeviceSize heapSize = _memoryProperties.memoryHeaps[_memoryProperties.memoryTypes[memoryType].heapIndex].size;
+    pool.blockSize = BLOCK_SIZE;
+    while (pool.blockSize > MIN_ALLOCATION && pool.blockSize > heapSize / 8) {
+        pool.blockSize /= 2;
+    }
+    _pools.push_back(std::move(pool));
+    return static_cast<uint32_t>(_pools.size() - 1);
+}
+
+VkDeviceMemory MemoryAllocator::allocateMemory(VkDeviceSize size, uint32_t memoryType,
+                                               VkBuffer buffer, VkImage image, void** mapped) {
+    VkMemoryDedicatedAllocateInfo dedicatedInfo{};
+    dedicatedInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicatedInfo.buffer = buffer;
+    dedicatedInfo.image = image;
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.pNext = (buffer != VK_NULL_HANDLE || image != VK_NULL_HANDLE) ? &dedicatedInfo : nullptr;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = memoryType;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(_device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+        throw std::runtime_error("MemoryAllocator: failed to allocate device memory");
+    }
+    _stats.deviceAllocations++;
+    _stats.totalDeviceAllocations++;
+
+    *mapped = nullptr;
+    if (_memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        if (vkMapMemory(_device, memory, 0, VK_WHOLE_SIZE, 0, mapped) != VK_SUCCESS) {
+            vkFreeMemory(_device, memory, nullptr);
+            throw std::runtime_error("MemoryAllocator: failed to map memory");
+        }
+    }
+    return memory;
+}
+
+void MemoryAllocator::freeMemory(VkDeviceMemory memory) {
+    // gemappter Speicher wird von vkFreeMemory mit entmappt
+    vkFreeMemory(_device, memory, nullptr);
+    _stats.deviceAllocations--;
+}
+
+uint32_t MemoryAllocator::orderFor(VkDeviceSize size, VkDeviceSize alignment) {
+    const VkDeviceSize needed = std::max(size, alignment);
+    uint32_t order = 0;
+    while ((MIN_ALLOCATION << order) < needed) {
+        order++;
+    }
+    return order;
+}
+
+bool MemoryAllocator::allocateInBlock(Block& block, uint32_t order, VkDeviceSize& offset) {
+    // kleinstes freies Stück, das groß genug ist
+    uint32_t found = order;
+    while (found < block.freeLists.size() && block.freeLists[found].empty()) {
+        found++;
+    }
+    if (found >= block.freeLists.size()) {
+        return false;
+    }
+
+    offset = *block.freeLists[found].begin();
+    block.freeLists[found].erase(block.freeLists[found].begin());
+    // halbieren, die obere Hälfte bleibt jeweils frei
+    while (found > order) {
+        found--;
+        block.freeLists[found].insert(offset + (MIN_ALLOCATION << found));
+    }
+    block.allocated[offset] = order;
+    return true;
+}
+
+void MemoryAllocator::freeInBlock(Block& block, VkDeviceSize offset) {
+    auto it = block.allocated.find(offset);
+    uint32_t order = it->second;
+    block.allocated.erase(it);
+
+    // mit dem Buddy verschmelzen, solange der auch frei ist
+    while (order + 1 < block.freeLists.size()) {
+        const VkDeviceSize buddy = offset ^ (MIN_ALLOCATION << order);
+        auto free = block.freeLists[order].find(buddy);
+        if (free == block.freeLists[order].end()) {
+            break;
+        }
+        block.freeLists[order].erase(free);
+        offset = std::min(offset, buddy);
+        order++;
+    }
+    block.freeLists[order].insert(offset);
+}
+
+void MemoryAllocator::printStats() const {
+    std::cout << std::fixed << std::setprecision(2)
+              << "MemoryAllocator: " << _stats.deviceAllocations << " vkAllocateMemory belegt (max "
+              << _stats.maxDeviceAllocations << ", insgesamt " << _stats.totalDeviceAllocations << "), "
+              << _stats.blockCount << " Blöcke mit " << _stats.blockBytes / (1024.0 * 1024.0) << " MB, "
+              << _stats.subAllocations << " Stücke mit " << _stats.usedBytes / (1024.0 * 1024.0) << " MB ("
+              << _stats.paddingBytes / (1024.0 * 1024.0) << " MB Aufrundung), "
+              << _stats.dedicatedCount << " eigene Allokationen mit "
+              << _stats.dedicatedBytes / (1024.0 * 1024.0) << " MB"
+              << std::defaultfloat << std::endl;
+}
@@ -0,0 +1,111 @@
+// MemoryAllocator.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "MemoryReport.hpp"
+
+// Ein Stück Gerätespeicher; an vkBind*Memory gehen memory und offset
+struct MemoryAllocation {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;              // angefordert (ohne Aufrundung)
+    void* mapped = nullptr;             // nur HOST_VISIBLE, zeigt schon auf offset
+    uint32_t pool = UINT32_MAX;         // UINT32_MAX = eigene Allokation
+    uint32_t block = 0;
+    MemoryCategory category = MemoryCategory::Mesh;
+
+    explicit operator bool() const { return memory != VK_NULL_HANDLE; }
+};
+
+// Buddy-Allocator für Gerätespeicher, ein Allocator pro Device (of). Nur vom Hauptthread benutzen
+class MemoryAllocator {
+public:
+    // Blockgröße für große Heaps, kleine Heaps bekommen ein Achtel ihrer Größe
+    static constexpr VkDeviceSize BLOCK_SIZE = 64ull * 1024 * 1024;
+    static constexpr VkDeviceSize MIN_ALLOCATION = 256;
+    // Ressourcen über blockSize / DEDICATED_FRACTION bekommen eine eigene Allokation
+    static constexpr VkDeviceSize DEDICATED_FRACTION = 2;
+
+    struct Stats {
+        uint64_t deviceAllocations = 0;     // lebende vkAllocateMemory (Blöcke + eigene)
+        uint64_t totalDeviceAllocations = 0;
+        uint32_t maxDeviceAllocations = 0;  // maxMemoryAllocationCount des Geräts
+        size_t blockCount = 0;
+        size_t dedicatedCount = 0;
+        size_t subAllocations = 0;          // lebende Stücke in Blöcken
+        VkDeviceSize blockBytes = 0;        // in Blöcken reserviert
+        VkDeviceSize dedicatedBytes = 0;
+        VkDeviceSize usedBytes = 0;         // von den Stücken angefordert
+        VkDeviceSize paddingBytes = 0;      // Aufrundung auf Zweierpotenzen
+    };
+
+    MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device);
+    ~MemoryAllocator();
+
+    MemoryAllocator(const MemoryAllocator&) = delete;
+    MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+    // Allocator zu device (wirft, wenn keiner angelegt wurde)
+    static MemoryAllocator& of(VkDevice device);
+
+    // Speicher passend zu buffer/image anfordern und binden. Images: VK_IMAGE_TILING_OPTIMAL.
+    // category: unter welcher Kategorie der MemoryReport die Bytes führt
+    MemoryAllocation allocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties, MemoryCategory category);
+    MemoryAllocation allocateImage(VkImage image, VkMemoryPropertyFlags properties, MemoryCategory category);
+    // Gibt das Stück frei und setzt allocation zurück (leere Allokation: nichts zu tun).
+    // Die Ressource darauf muss vorher zerstört bzw. von keinem Frame mehr benutzt werden
+    void free(MemoryAllocation& allocation);
+
+    // Gibt alle Blöcke frei (vor vkDestroyDevice, alle Ressourcen müssen weg sein)
+    void destroy();
+
+    const Stats& getStats() const { return _stats; }
+    void printStats() const;
+    // Freier Platz in den Blöcken der Memory Types, deren Heap heapFlags hat: beim Treiber
+    // belegt (VK_EXT_memory_budget zählt ihn mit), für neue Ressourcen aber verfügbar
+    VkDeviceSize unusedBlockBytes(VkMemoryHeapFlags heapFlags) const;
+
+private:
+    struct Block {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        void* mapped = nullptr;
+        std::vector<std::set<VkDeviceSize>> freeLists;          // pro Ordnung freie Offsets
+        std::unordered_map<VkDeviceSize, uint32_t> allocated;   // Offset -> Ordnung
+        VkDeviceSize used = 0;
+    };
+
+    struct Pool {
+        uint32_t memoryType = 0;
+        bool optimal = false;           // nur bei großer bufferImageGranularity getrennt
+        VkDeviceSize blockSize = 0;
+        std::vector<std::unique_ptr<Block>> blocks;     // nullptr = freigegebener Platz
+    };
+
+    MemoryAllocation allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                              bool optimal, bool dedicated, VkBuffer buffer, VkImage image,
+                              MemoryCategory category);
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+    // Pool für memoryType/optimal, legt ihn bei Bedarf an
+    uint32_t poolFor(uint32_t memoryType, bool optimal);
+    VkDeviceMemory allocateMemory(VkDeviceSize size, uint32_t memoryType, VkBuffer buffer, VkImage image,
+                                  void** mapped);
+    void freeMemory(VkDeviceMemory memory);
+    // Kleinste Ordnung, deren Stück size Bytes mit alignment fasst
+    static uint32_t orderFor(VkDeviceSize size, VkDeviceSize alignment);
+    // Buddy-Suche in block, false = kein passendes Stück frei
+    static bool allocateInBlock(Block& block, uint32_t order, VkDeviceSize& offset);
+    static void freeInBlock(Block& block, VkDeviceSize offset);
+
+    VkPhysicalDevice _physicalDevice;
+    VkDevice _device;
+    VkPhysicalDeviceMemoryProperties _memoryProperties{};
+    VkDeviceSize _bufferImageGranularity = 1;
+    std::vector<Pool> _pools;
+    Stats _stats;
+};
@@ -0,0 +1,188 @@
+#include "MemoryReport.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    std::mutex& reportMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::array<MemoryReport::Entry, MemoryReport::CATEGORY_COUNT>& entries() {
+        static std::array<MemoryReport::Entry, MemoryReport::CATEGORY_COUNT> table{};
+        return table;
+    }
+
+    void add(MemoryReport::Usage& usage, uint64_t bytes) {
+        usage.currentBytes += bytes;
+        usage.allocations++;
+        usage.peakBytes = std::max(usage.peakBytes, usage.currentBytes);
+    }
+
+    void remove(MemoryReport::Usage& usage, uint64_t bytes) {
+        usage.currentBytes -= std::min(usage.currentBytes, bytes);
+        if (usage.allocations > 0) {
+            usage.allocations--;
+        }
+    }
+
+    double toMB(uint64_t bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+}
+
+const char* MemoryReport::name(MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::Mesh:            return "mesh";
+        case MemoryCategory::Texture:         return "texture";
+        case MemoryCategory::Cubemap:         return "cubemap";
+        case MemoryCategory::GBuffer:         return "gbuffer";
+        case MemoryCategory::Depth:           return "depth";
+        case MemoryCategory::ReflectionProbe: return "reflection_probe";
+        case MemoryCategory::Snow:            return "snow";
+        case MemoryCategory::Uniforms:        return "uniforms";
+        case MemoryCategory::Staging:         return "staging";
+        default:                              return "unknown";
+    }
+}
+
+void MemoryReport::addDevice(MemoryCategory category, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(reportMutex());
+    add(entries().at(static_cast<size_t>(category)).device, bytes);
+}
+
+void MemoryReport::removeDevice(MemoryCategory category, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(reportMutex());
+    remove(entries().at(static_cast<size_t>(category)).device, bytes);
+}
+
+void MemoryReport::addHost(MemoryCategory category, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(reportMutex());
+    add(entries().at(static_cast<size_t>(category)).host, bytes);
+}
+
+void MemoryReport::removeHost(MemoryCategory category, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(reportMutex());
+    remove(entries().at(static_cast<size_t>(category)).host, bytes);
+}
+
+MemoryReport::Entry MemoryReport::get(MemoryCategory category) {
+    std::lock_guard<std::mutex> lock(reportMutex());
+    return entries().at(static_cast<size_t>(category));
+}
+
+void MemoryReport::print() {
+    std::array<Entry, CATEGORY_COUNT> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(reportMutex());
+        snapshot = entries();
+    }
+
+    Entry total;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Speicher nach Kategorie (MB, aktuell / höchstens):" << std::endl;
+    for (size_t i = 0; i < CATEGORY_COUNT; i++) {
+        const Entry& e = snapshot[i];
+        std::cout << "  " << std::left << std::setw(18) << name(static_cast<MemoryCategory>(i)) << std::right
+                  << " Gerät " << std::setw(9) << toMB(e.device.currentBytes)
+                  << " / " << std::setw(9) << toMB(e.device.peakBytes)
+                  << " (" << e.device.allocations << " Allokationen)"
+                  << "   Host " << std::setw(9) << toMB(e.host.currentBytes)
+                  << " / " << std::setw(9) << toMB(e.host.peakBytes) << std::endl;
+        total.device.currentBytes += e.device.currentBytes;
+        total.device.peakBytes += e.device.peakBytes;
+        total.host.currentBytes += e.host.currentBytes;
+        total.host.peakBytes += e.host.peakBytes;
+    }
+    // Summe der Einzel-Höchstwerte: obere Schranke, die Kategorien erreichen ihr Maximum nicht gleichzeitig
+    std::cout << "  " << std::left << std::setw(18) << "gesamt" << std::right
+              << " Gerät " << std::setw(9) << toMB(total.device.currentBytes)
+              << " / " << std::setw(9) << toMB(total.device.peakBytes)
+              << "   Host " << std::setw(9) << toMB(total.host.currentBytes)
+              << " / " << std::setw(9) << toMB(total.host.peakBytes)
+              << std::defaultfloat << std::endl;
+}
+
+bool MemoryReport::writeJson(const std::string& path) {
+    std::array<Entry, CATEGORY_COUNT> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(reportMutex());
+        snapshot = entries();
+    }
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "MemoryReport: konnte " << path << " nicht schreiben" << std::endl;
+        return false;
+    }
+
+    auto writeUsage = [&out](const Usage& usage) {
+        out << "{ \"current_bytes\": " << usage.currentBytes
+            << ", \"peak_bytes\": " << usage.peakBytes
+            << ", \"allocations\": " << usage.allocations << " }";
+    };
+
+    out << "{\n  \"categories\": {\n";
+    for (size_t i = 0; i < CATEGORY_COUNT; i++) {
+        out << "    \"" << name(static_cast<MemoryCategory>(i)) << "\": {\n      \"device\": ";
+        writeUsage(snapshot[i].device);
+        out << ",\n      \"host\": ";
+        writeUsage(snapshot[i].host);
+        out << "\n    }" << (i + 1 < CATEGORY_COUNT ? "," : "") << "\n";
+    }
+    out << "  }\n}\n";
+    return static_cast<bool>(out);
+}
+
+HostMemoryTag::HostMemoryTag(MemoryCategory category, uint64_t bytes)
+    : _category(category), _bytes(bytes) {
+    if (_bytes > 0) {
+        MemoryReport::addHost(_category, _bytes);
+    }
+}
+
+HostMemoryTag::~HostMemoryTag() {
+    release();
+}
+
+HostMemoryTag::HostMemoryTag(const HostMemoryTag& other)
+    : HostMemoryTag(other._category, other._bytes) {}
+
+HostMemoryTag& HostMemoryTag::operator=(const HostMemoryTag& other) {
+    if (this != &other) {
+        release();
+        _category = other._category;
+        _bytes = other._bytes;
+        if (_bytes > 0) {
+            MemoryReport::addHost(_category, _bytes);
+        }
+    }
+    return *this;
+}
+
+HostMemoryTag::HostMemoryTag(HostMemoryTag&& other) noexcept
+    : _category(other._category), _bytes(other._bytes) {
+    other._bytes = 0;
+}
+
+HostMemoryTag& HostMemoryTag::operator=(HostMemoryTag&& other) noexcept {
+    if (this != &other) {
+        release();
+        _category = other._category;
+        _bytes = other._bytes;
+        other._bytes = 0;
+    }
+    return *this;
+}
+
+void HostMemoryTag::release() {
+    if (_bytes > 0) {
+        MemoryReport::removeHost(_category, _bytes);
+        _bytes = 0;
+    }
+}
@@ -0,0 +1,84 @@
+// MemoryReport.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+enum class MemoryCategory : uint32_t {
+    Mesh,               // Vertex-/Index-/Meshlet-Buffer und die Sichtbarkeitslisten des Meshlet-Cullers
+    Texture,
+    Cubemap,            // Skybox
+    GBuffer,            // Attachments des Deferred-Pfads
+    Depth,              // Depth Buffer der Hauptansicht
+    ReflectionProbe,    // Cubemap + Depth des Render-to-Texture
+    Snow,               // Partikel- und Uniform-Buffer des Schnees
+    Uniforms,           // UniformAllocator der Frames
+    Staging,
+    Count
+};
+
+// Speicherbuchhaltung nach Kategorien (Gerät und Hauptspeicher), thread-sicher
+class MemoryReport {
+public:
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(MemoryCategory::Count);
+
+    struct Usage {
+        uint64_t currentBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t allocations = 0;       // lebende Allokationen
+    };
+
+    struct Entry {
+        Usage device;
+        Usage host;
+    };
+
+    static const char* name(MemoryCategory category);
+
+    static void addDevice(MemoryCategory category, uint64_t bytes);
+    static void removeDevice(MemoryCategory category, uint64_t bytes);
+    static void addHost(MemoryCategory category, uint64_t bytes);
+    static void removeHost(MemoryCategory category, uint64_t bytes);
+
+    // Wie shared_ptr(data, deleter), zählt bytes aber als Hauptspeicher in category,
+    // bis der letzte shared_ptr weg ist
+    template <typename T, typename Deleter>
+    static std::shared_ptr<T> trackHost(T* data, MemoryCategory category, uint64_t bytes, Deleter deleter) {
+        addHost(category, bytes);
+        return std::shared_ptr<T>(data, [category, bytes, deleter](T* p) {
+            deleter(p);
+            removeHost(category, bytes);
+        });
+    }
+
+    // Momentaufnahme aller Kategorien
+    static Entry get(MemoryCategory category);
+
+    static void print();
+    // Schreibt die Tabelle als JSON, false wenn die Datei nicht geschrieben werden konnte
+    static bool writeJson(const std::string& path);
+};
+
+// Hält bytes in category gezählt, solange das Objekt lebt (Member für Strukturen aus std::vectors,
+// z.B. geladene Meshes). Kopieren zählt noch einmal, Verschieben gibt die Zählung weiter
+class HostMemoryTag {
+public:
+    HostMemoryTag() = default;
+    HostMemoryTag(MemoryCategory category, uint64_t bytes);
+    ~HostMemoryTag();
+
+    HostMemoryTag(const HostMemoryTag& other);
+    HostMemoryTag& operator=(const HostMemoryTag& other);
+    HostMemoryTag(HostMemoryTag&& other) noexcept;
+    HostMemoryTag& operator=(HostMemoryTag&& other) noexcept;
+
+    uint64_t getBytes() const { return _bytes; }
+
+private:
+    void release();
+
+    MemoryCategory _category = MemoryCategory::Mesh;
+    uint64_t _bytes = 0;
+};
@@ -89,15 +89,13 @@ void MirrorSystem::addMirror(Scene* scene, const MirrorConfig& config) {
 
 void MirrorSystem::createMirrorObjects(Scene* scene, MirrorData& mirror) {
     // PASS 1: Spiegel-Markierung (schreibt in Stencil)
-    RenderObject mirrorMark = _factory->createMirror(
-        mirror.transform, _renderPass, PipelineType::MIRROR_MARK);
-    scene->setMirrorMarkObject(mirrorMark);
+    RenderObject mirrorMark = _factory->createMirror(_renderPass, PipelineType::MIRROR_MARK);
+    scene->setMirrorMarkObject(mirrorMark, mirror.transform);
     mirror.markIndex = scene->getMirrorMarkIndex();
     
     // PASS 3: Spiegel mit Transparenz
-    RenderObject mirrorBlend = _factory->createMirror(
-        mirror.transform, _renderPass, PipelineType::MIRROR_BLEND);
-    scene->setMirrorBlendObject(mirrorBlend);
+    RenderObject mirrorBlend = _factory->createMirror(_renderPass, PipelineType::MIRROR_BLEND);
+    scene->setMirrorBlendObject(mirrorBlend, mirror.transform);
     mirror.blendIndex = scene->getMirrorBlendIndex();
 }
 
@@ -122,40 +120,72 @@ void MirrorSystem::createReflections(Scene* scene) {
 
 void MirrorSystem::createReflectedObject(Scene* scene, size_t objectIndex, 
                                          const MirrorData& mirror) {
+    // Original lädt noch: leerer Eintrag hält den Index frei (wird nicht gezeichnet),
+    // onObjectReady füllt ihn später
+    if (scene->isPending(objectIndex)) {
+        scene->addReflectedObject(RenderObject{}, objectIndex);
+        return;
+    }
+    scene->addReflectedObject(buildReflectedObject(scene, objectIndex), objectIndex,
+                              reflectedModel(scene, objectIndex, mirror));
+}
+
+RenderObject MirrorSystem::buildReflectedObject(Scene* scene, size_t objectIndex) {
     const auto& originalObj = scene->getObject(objectIndex);
     
-    // Reflexionsmatrix berechnen
-    glm::mat4 reflectionMatrix = calculateReflectionMatrix(
-        mirror.position, mirror.normal);
-    
-    // Gespiegelte Transformationsmatrix
-    glm::mat4 reflectedMatrix = reflectionMatrix * originalObj.modelMatrix;
-    
     // Neues gespiegeltes RenderObject erstellen
     // Hier müssen wir die Original-Parameter des Objekts kennen
     // Das ist eine Limitierung - in einer vollständigen Implementierung
     // würde man diese Informationen im RenderObject speichern
     
-    // Für jetzt: Erstelle eine Kopie und ändere nur die Matrix
+    // Für jetzt: Erstelle eine Kopie, die Matrix kommt aus reflectedModel
     RenderObject reflectedObj = originalObj;
-    reflectedObj.modelMatrix = reflectedMatrix;
     
     // Pipeline für gespiegelte Objekte verwenden
+    std::string vertShader = "shaders/testapp.vert.spv";
+    std::string fragShader = "shaders/testapp.frag.spv";
+    if (scene->isBindless()) {
+        vertShader = bindlessShaderPath(vertShader);
+        fragShader = bindlessShaderPath(fragShader);
+    }
     GraphicsPipeline* reflectedPipeline = new GraphicsPipeline(
         _device,
         originalObj.pipeline->getColorFormat(),
         originalObj.pipeline->getDepthFormat(),
-        "shaders/testapp.vert.spv",
-        "shaders/testapp.frag.spv",
+        vertShader.c_str(),
+        fragShader.c_str(),
         _renderPass,
         scene->getDescriptorSetLayout(),
         PipelineType::MIRROR_REFLECT,
-        2
+        2,
+        originalObj.pipeline->getVertexFormat(),
+        scene->getTextureSetLayout()
     );
     
     reflectedObj.pipeline = reflectedPipeline;
-    
-    scene->addReflectedObject(reflectedObj, objectIndex);
+    return reflectedObj;
+}
+
+glm::mat4 MirrorSystem::reflectedModel(const Scene* scene, size_t objectIndex,
+                                       const MirrorData& mirror) {
+    return calculateReflectionMatrix(mirror.position, mirror.normal) * scene->getModelMatrix(objectIndex);
+}
+
+void MirrorSystem::onObjectReady(Scene* scene, size_t objectIndex) {
+    auto it = std::find(_reflectableObjects.begin(), _reflectableObjects.end(), objectIndex);
+    if (it == _reflectableObjects.end()) {
+        return;
+    }
+    size_t objPositionInList = std::distance(_reflectableObjects.begin(), it);
+
+    // gleiche Indexrechnung wie in updateReflections
+    for (size_t mirrorIdx = 0; mirrorIdx < _mirrors.size(); mirrorIdx++) {
+        size_t reflectionIdx = mirrorIdx * _reflectableObjects.size() + objPositionInList;
+        if (reflectionIdx < scene->getReflectedObjectCount()) {
+            scene->setReflectedObject(reflectionIdx, buildReflectedObject(scene, objectIndex),
+                                      reflectedModel(scene, objectIndex, _mirrors[mirrorIdx]));
+        }
+    }
 }
 
 
@@ -169,25 +199,15 @@ void MirrorSystem::updateReflections(Scene* scene, size_t objectIndex) {
     // Finde die Position des Objekts in der reflectableObjects-Liste
     size_t objPositionInList = std::distance(_reflectableObjects.begin(), it);
     
-    const auto& originalObj = scene->getObject(objectIndex);
-    
     // Für jeden Spiegel
     for (size_t mirrorIdx = 0; mirrorIdx < _mirrors.size(); mirrorIdx++) {
-        const auto& mirror = _mirrors[mirrorIdx];
-        
-        glm::mat4 reflectionMatrix = calculateReflectionMatrix(
-            mirror.position, mirror.normal);
-        
-        glm::mat4 reflectedMatrix = reflectionMatrix * originalObj.modelMatrix;
-        
         // Berechne den Index in der reflectedObjects-Liste:
         // (Spiegel-Index * Anzahl reflektierbare Objekte) + Position des Objekts
         size_t reflectionIdx = mirrorIdx * _reflectableObjects.size() + objPositionInList;
         
         // Update nur dieses eine gespiegelte Objekt
         if (reflectionIdx < scene->getReflectedObjectCount()) {
-            RenderObject& reflectedObj = scene->getReflectedObject(reflectionIdx);
-            reflectedObj.modelMatrix = reflectedMatrix;
+            scene->updateReflectedObject(reflectionIdx, reflectedModel(scene, objectIndex, _mirrors[mirrorIdx]));
         }
     }
 }
\ No newline at end of file
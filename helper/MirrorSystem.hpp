@@ -30,6 +30,9 @@ public:
     //Resettet Spiegel und erschafft neue Reflexion, nötig für bewegende Objekte
     void updateReflections(Scene* scene, size_t objectIndex);
 
+    // Objekt ist fertig geladen (SceneLoader): ersetzt die Platzhalter seiner Spiegelungen
+    void onObjectReady(Scene* scene, size_t objectIndex);
+
     // Berechnet die Reflexionsmatrix für eine Ebene
     static glm::mat4 calculateReflectionMatrix(const glm::vec3& planePoint, 
                                                const glm::vec3& planeNormal);
@@ -51,4 +54,8 @@ private:
 
     void createMirrorObjects(Scene* scene,  MirrorData& mirror);
     void createReflectedObject(Scene* scene, size_t objectIndex, const MirrorData& mirror);
+    // Gespiegelte Kopie mit eigener Pipeline (Original darf kein Platzhalter mehr sein)
+    RenderObject buildReflectedObject(Scene* scene, size_t objectIndex);
+    // Modellmatrix der Spiegelung: Reflexionsmatrix * aktuelle Modellmatrix des Originals
+    static glm::mat4 reflectedModel(const Scene* scene, size_t objectIndex, const MirrorData& mirror);
 };
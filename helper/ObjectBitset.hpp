@@ -0,0 +1,110 @@
+// ObjectBitset.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bitmenge über Objekt-Indizes der Szene, ein Bit pro Objekt
+class ObjectBitset {
+public:
+    static constexpr size_t NPOS = SIZE_MAX;
+
+    // Wächst mit, Bits hinter dem bisherigen Ende sind 0
+    void resize(size_t size) {
+        _size = size;
+        _words.resize((size + 63) / 64, 0);
+        trimLastWord();
+    }
+    size_t size() const { return _size; }
+
+    bool test(size_t index) const {
+        return index < _size && (_words[index >> 6] >> (index & 63)) & 1;
+    }
+    void set(size_t index) {
+        if (index >= _size) {
+            resize(index + 1);
+        }
+        _words[index >> 6] |= uint64_t(1) << (index & 63);
+    }
+    void reset(size_t index) {
+        if (index < _size) {
+            _words[index >> 6] &= ~(uint64_t(1) << (index & 63));
+        }
+    }
+    void clear() {
+        for (uint64_t& word : _words) {
+            word = 0;
+        }
+    }
+
+    bool any() const {
+        for (uint64_t word : _words) {
+            if (word != 0) return true;
+        }
+        return false;
+    }
+    size_t count() const {
+        size_t n = 0;
+        for (uint64_t word : _words) {
+            n += popcount(word);
+        }
+        return n;
+    }
+
+    // Kleinster gesetzter Index, NPOS wenn leer
+    size_t findFirst() const {
+        for (size_t w = 0; w < _words.size(); w++) {
+            if (_words[w] != 0) {
+                return w * 64 + countTrailingZeros(_words[w]);
+            }
+        }
+        return NPOS;
+    }
+
+    // fn(index) für jedes gesetzte Bit in aufsteigender Reihenfolge
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w = 0; w < _words.size(); w++) {
+            uint64_t word = _words[w];
+            while (word != 0) {
+                fn(w * 64 + countTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    static unsigned countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+        unsigned n = 0;
+        while ((word & 1) == 0) {
+            word >>= 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+
+    static unsigned popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+        unsigned n = 0;
+        for (; word != 0; word &= word - 1) n++;
+        return n;
+#endif
+    }
+
+    // Bits hinter _size nach einem Verkleinern löschen, damit count/forEach sie nicht sehen
+    void trimLastWord() {
+        if (_size % 64 != 0 && !_words.empty()) {
+            _words.back() &= (uint64_t(1) << (_size % 64)) - 1;
+        }
+    }
+
+    std::vector<uint64_t> _words;
+    size_t _size = 0;
+};
@@ -0,0 +1,581 @@
+#include "FastObjParser.hpp"
+#include "MeshCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define FAST_OBJ_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    constexpr int32_t NO_INDEX = -1;
+
+    // Index-Tripel einer Polygon-Ecke, 0-basiert und schon global (-1 = fehlt)
+    struct Corner {
+        int32_t v;
+        int32_t vt;
+        int32_t vn;
+    };
+
+    // Negativer (relativer) Index, wird erst beim Zusammenführen aufgelöst,
+    // weil der globale Zählerstand beim Parsen eines Blocks noch unbekannt ist
+    struct RelativeRef {
+        size_t corner;          // Position in Chunk::corners
+        int component;          // 0 = v, 1 = vt, 2 = vn
+        int32_t local;          // Index relativ zum Anfang des Blocks (kann negativ sein)
+    };
+
+    struct Chunk {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> texcoords;
+        std::vector<glm::vec3> normals;
+        std::vector<Corner> corners;
+        std::vector<uint32_t> faceSizes;
+        std::vector<RelativeRef> relative;
+        // nach dem Zusammenführen: Dreiecksecken und Anzahl verworfener Polygone
+        std::vector<Corner> triangles;
+        size_t skippedFaces = 0;
+        size_t positionBase = 0;
+        size_t texcoordBase = 0;
+        size_t normalBase = 0;
+    };
+
+    inline int countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    // Nächstes '\n' ab p (oder end), 16 Bytes pro Schritt
+    const char* findLineEnd(const char* p, const char* end) {
+#ifdef FAST_OBJ_SSE2
+        const __m128i newline = _mm_set1_epi8('\n');
+        while (end - p >= 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+            if (mask != 0) {
+                return p + countTrailingZeros(static_cast<uint32_t>(mask));
+            }
+            p += 16;
+        }
+#endif
+        const void* found = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        return found ? static_cast<const char*>(found) : end;
+    }
+
+    inline bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline const char* skipBlank(const char* p, const char* end) {
+        while (p < end && isBlank(*p)) {
+            p++;
+        }
+        return p;
+    }
+
+    inline bool isDigit(char c) {
+        return static_cast<unsigned>(c - '0') < 10u;
+    }
+
+    // Exakte Zehnerpotenzen in double (bis 1e22 ohne Rundung darstellbar)
+    constexpr double POW10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    // Float im Stil von from_chars: Mantisse als Ganzzahl sammeln, dann eine
+    // Multiplikation/Division (Clinger Fast Path). Sonderfälle über strtod
+    bool parseFloat(const char*& p, const char* end, float& out) {
+        const char* start = p;
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            p++;
+        }
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool any = false;
+        for (; p < end && isDigit(*p); p++) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                digits += mantissa != 0 ? 1 : 0;
+            } else {
+                exponent++;
+            }
+        }
+        if (p < end && *p == '.') {
+            p++;
+            for (; p < end && isDigit(*p); p++) {
+                any = true;
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    digits += mantissa != 0 ? 1 : 0;
+                    exponent--;
+                }
+            }
+        }
+        if (!any) {
+            p = start;
+            return false;
+        }
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* expStart = p;
+            p++;
+            bool expNegative = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                expNegative = *p == '-';
+                p++;
+            }
+            if (p < end && isDigit(*p)) {
+                int value = 0;
+                for (; p < end && isDigit(*p); p++) {
+                    value = std::min(value * 10 + (*p - '0'), 10000);
+                }
+                exponent += expNegative ? -value : value;
+            } else {
+                p = expStart;   // "1e" -> nur die 1
+            }
+        }
+
+        double value;
+        if (mantissa == 0) {
+            value = 0.0;
+        } else if (exponent >= -22 && exponent <= 22 && mantissa <= (uint64_t(1) << 53)) {
+            value = static_cast<double>(mantissa);
+            value = exponent < 0 ? value / POW10[-exponent] : value * POW10[exponent];
+        } else {
+            std::string text(start, p);
+            value = std::strtod(text.c_str(), nullptr);
+            out = static_cast<float>(value);
+            return true;
+        }
+        out = static_cast<float>(negative ? -value : value);
+        return true;
+    }
+
+    bool parseInt(const char*& p, const char* end, int32_t& out) {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            p++;
+        }
+        if (p >= end || !isDigit(*p)) {
+            return false;
+        }
+        int64_t value = 0;
+        for (; p < end && isDigit(*p); p++) {
+            value = std::min<int64_t>(value * 10 + (*p - '0'), std::numeric_limits<int32_t>::max());
+        }
+        out = static_cast<int32_t>(negative ? -value : value);
+        return true;
+    }
+
+    template<size_t N>
+    void parseFloats(const char* p, const char* end, float (&values)[N]) {
+        for (size_t i = 0; i < N; i++) {
+            p = skipBlank(p, end);
+            if (!parseFloat(p, end, values[i])) {
+                values[i] = 0.0f;
+            }
+        }
+    }
+
+    // OBJ-Index (1-basiert oder negativ) -> 0-basiert; negative kommen in chunk.relative
+    inline int32_t resolveIndex(int32_t raw, size_t count, Chunk& chunk, int component) {
+        if (raw > 0) {
+            return raw - 1;
+        }
+        if (raw < 0) {
+            chunk.relative.push_back({ chunk.corners.size(), component,
+                                       static_cast<int32_t>(count) + raw });
+            return 0;
+        }
+        return std::numeric_limits<int32_t>::min();     // 0 ist kein gültiger OBJ-Index
+    }
+
+    void parseFace(const char* p, const char* end, Chunk& chunk) {
+        uint32_t count = 0;
+        while (true) {
+            p = skipBlank(p, end);
+            int32_t v = 0;
+            if (!parseInt(p, end, v)) {
+                break;
+            }
+            int32_t vt = 0;
+            int32_t vn = 0;
+            if (p < end && *p == '/') {
+                p++;
+                if (p < end && *p != '/') {
+                    parseInt(p, end, vt);
+                }
+                if (p < end && *p == '/') {
+                    p++;
+                    parseInt(p, end, vn);
+                }
+            }
+
+            Corner corner;
+            corner.v = resolveIndex(v, chunk.positions.size(), chunk, 0);
+            corner.vt = vt == 0 ? NO_INDEX : resolveIndex(vt, chunk.texcoords.size(), chunk, 1);
+            corner.vn = vn == 0 ? NO_INDEX : resolveIndex(vn, chunk.normals.size(), chunk, 2);
+            chunk.corners.push_back(corner);
+            count++;
+
+            // bis zum nächsten Leerzeichen springen (z.B. Reste wie "1/2/3/4")
+            while (p < end && !isBlank(*p)) {
+                p++;
+            }
+        }
+        chunk.faceSizes.push_back(count);
+    }
+
+    void parseChunk(const char* p, const char* end, Chunk& chunk) {
+        // grobe Schätzung: ~30 Byte pro Zeile
+        const size_t lineEstimate = static_cast<size_t>(end - p) / 30;
+        chunk.positions.reserve(lineEstimate / 4);
+        chunk.corners.reserve(lineEstimate);
+        chunk.faceSizes.reserve(lineEstimate / 3);
+
+        while (p < end) {
+            const char* lineEnd = findLineEnd(p, end);
+            const char* s = skipBlank(p, lineEnd);
+            if (lineEnd - s >= 2) {
+                if (s[0] == 'v') {
+                    if (isBlank(s[1])) {
+                        float xyz[3];
+                        parseFloats(s + 2, lineEnd, xyz);
+                        chunk.positions.emplace_back(xyz[0], xyz[1], xyz[2]);
+                    } else if (s[1] == 't' && lineEnd - s >= 3 && isBlank(s[2])) {
+                        float uv[2];
+                        parseFloats(s + 3, lineEnd, uv);
+                        chunk.texcoords.emplace_back(uv[0], uv[1]);
+                    } else if (s[1] == 'n' && lineEnd - s >= 3 && isBlank(s[2])) {
+                        float xyz[3];
+                        parseFloats(s + 3, lineEnd, xyz);
+                        chunk.normals.emplace_back(xyz[0], xyz[1], xyz[2]);
+                    }
+                } else if (s[0] == 'f' && isBlank(s[1])) {
+                    parseFace(s + 2, lineEnd, chunk);
+                }
+            }
+            p = lineEnd + 1;
+        }
+    }
+
+    inline bool validCorner(const Corner& c, size_t positions, size_t texcoords, size_t normals) {
+        return c.v >= 0 && static_cast<size_t>(c.v) < positions
+            && (c.vt == NO_INDEX || (c.vt >= 0 && static_cast<size_t>(c.vt) < texcoords))
+            && (c.vn == NO_INDEX || (c.vn >= 0 && static_cast<size_t>(c.vn) < normals));
+    }
+
+    // Ear Clipping für Polygone mit mehr als 4 Ecken (in der Ebene der Newell-Normale)
+    void triangulatePolygon(const std::vector<glm::vec3>& positions, const Corner* corners, uint32_t count,
+                            std::vector<Corner>& out) {
+        glm::vec3 normal(0.0f);
+        for (uint32_t i = 0; i < count; i++) {
+            const glm::vec3& a = positions[corners[i].v];
+            const glm::vec3& b = positions[corners[(i + 1) % count].v];
+            normal.x += (a.y - b.y) * (a.z + b.z);
+            normal.y += (a.z - b.z) * (a.x + b.x);
+            normal.z += (a.x - b.x) * (a.y + b.y);
+        }
+        // auf die Ebene mit der größten Normalen-Komponente projizieren
+        int axis = std::fabs(normal.x) > std::fabs(normal.y)
+                 ? (std::fabs(normal.x) > std::fabs(normal.z) ? 0 : 2)
+                 : (std::fabs(normal.y) > std::fabs(normal.z) ? 1 : 2);
+        const int u = (axis + 1) % 3;
+        const int v = (axis + 2) % 3;
+        const float orientation = normal[axis] >= 0.0f ? 1.0f : -1.0f;
+
+        std::vector<glm::vec2> points(count);
+        for (uint32_t i = 0; i < count; i++) {
+            const glm::vec3& p = positions[corners[i].v];
+            points[i] = glm::vec2(p[u], p[v]);
+        }
+        auto cross2 = [&](uint32_t a, uint32_t b, uint32_t c) {
+            glm::vec2 ab = points[b] - points[a];
+            glm::vec2 ac = points[c] - points[a];
+            return (ab.x * ac.y - ab.y * ac.x) * orientation;
+        };
+
+        std::vector<uint32_t> remaining(count);
+        for (uint32_t i = 0; i < count; i++) {
+            remaining[i] = i;
+        }
+        while (remaining.size() > 3) {
+            const size_t n = remaining.size();
+            bool clipped = false;
+            for (size_t i = 0; i < n && !clipped; i++) {
+                uint32_t a = remaining[(i + n - 1) % n];
+                uint32_t b = remaining[i];
+                uint32_t c = remaining[(i + 1) % n];
+                if (cross2(a, b, c) <= 0.0f) {
+                    continue;   // reflexe Ecke
+                }
+                bool inside = false;
+                for (uint32_t other : remaining) {
+                    if (other == a || other == b || other == c) {
+                        continue;
+                    }
+                    if (cross2(a, b, other) >= 0.0f && cross2(b, c, other) >= 0.0f && cross2(c, a, other) >= 0.0f) {
+                        inside = true;
+                        break;
+                    }
+                }
+                if (!inside) {
+                    out.push_back(corners[a]);
+                    out.push_back(corners[b]);
+                    out.push_back(corners[c]);
+                    remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(i));
+                    clipped = true;
+                }
+            }
+            if (!clipped) {
+                break;  // entartet (z.B. selbstüberschneidend) -> Rest als Fächer
+            }
+        }
+        for (size_t i = 1; i + 1 < remaining.size(); i++) {
+            out.push_back(corners[remaining[0]]);
+            out.push_back(corners[remaining[i]]);
+            out.push_back(corners[remaining[i + 1]]);
+        }
+    }
+
+    // Relative Indices auflösen, prüfen und triangulieren (Vierecke wie tinyobj
+    // über die kürzere Diagonale, damit beide Parser dieselben Dreiecke liefern)
+    void triangulateChunk(Chunk& chunk, const std::vector<glm::vec3>& positions,
+                          size_t texcoordCount, size_t normalCount) {
+        for (const RelativeRef& ref : chunk.relative) {
+            Corner& corner = chunk.corners[ref.corner];
+            int32_t* target = ref.component == 0 ? &corner.v : ref.component == 1 ? &corner.vt : &corner.vn;
+            size_t base = ref.component == 0 ? chunk.positionBase
+                        : ref.component == 1 ? chunk.texcoordBase : chunk.normalBase;
+            *target = static_cast<int32_t>(static_cast<int64_t>(base) + ref.local);
+        }
+
+        chunk.triangles.reserve(chunk.corners.size() * 3 / 2);
+        size_t offset = 0;
+        for (uint32_t count : chunk.faceSizes) {
+            const Corner* face = chunk.corners.data() + offset;
+            offset += count;
+
+            bool valid = count >= 3;
+            for (uint32_t i = 0; i < count && valid; i++) {
+                valid = validCorner(face[i], positions.size(), texcoordCount, normalCount);
+            }
+            if (!valid) {
+                chunk.skippedFaces++;
+                continue;
+            }
+
+            if (count == 3) {
+                chunk.triangles.insert(chunk.triangles.end(), face, face + 3);
+            } else if (count == 4) {
+                glm::vec3 d02 = positions[face[2].v] - positions[face[0].v];
+                glm::vec3 d13 = positions[face[3].v] - positions[face[1].v];
+                if (glm::dot(d02, d02) < glm::dot(d13, d13)) {
+                    const Corner quad[6] = { face[0], face[1], face[2], face[0], face[2], face[3] };
+                    chunk.triangles.insert(chunk.triangles.end(), quad, quad + 6);
+                } else {
+                    const Corner quad[6] = { face[0], face[1], face[3], face[1], face[2], face[3] };
+                    chunk.triangles.insert(chunk.triangles.end(), quad, quad + 6);
+                }
+            } else {
+                triangulatePolygon(positions, face, count, chunk.triangles);
+            }
+        }
+        // Rohdaten werden nicht mehr gebraucht
+        chunk.corners = std::vector<Corner>();
+        chunk.faceSizes = std::vector<uint32_t>();
+    }
+
+    template<typename Task>
+    void runParallel(size_t count, Task task) {
+        if (count == 1) {
+            task(0);
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(count - 1);
+        for (size_t i = 1; i < count; i++) {
+            threads.emplace_back(task, i);
+        }
+        task(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    inline size_t hashCorner(const Corner& c) {
+        uint64_t h = static_cast<uint32_t>(c.v) * 0x9E3779B97F4A7C15ull;
+        h ^= (static_cast<uint32_t>(c.vt) + 0x632BE59BD9B4E019ull) * 0xC2B2AE3D27D4EB4Full;
+        h ^= (static_cast<uint32_t>(c.vn) + 0x85EBCA77C2B2AE63ull) * 0x165667B19E3779F9ull;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+}
+
+bool FastObjParser::parse(const std::string& filename, MeshData& outMesh, Stats* stats, unsigned maxThreads) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "[FastObjParser] Datei nicht lesbar: " << filename << "\n";
+        return false;
+    }
+    return parse(reinterpret_cast<const char*>(file.data()), file.size(), outMesh, stats, maxThreads);
+}
+
+bool FastObjParser::parse(const char* data, size_t size, MeshData& outMesh, Stats* stats, unsigned maxThreads) {
+    auto start = std::chrono::high_resolution_clock::now();
+    outMesh = MeshData{};
+
+    // 1. An Zeilengrenzen in Blöcke teilen
+    size_t threadCount = maxThreads > 0 ? maxThreads : std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::max<size_t>(1, std::min(threadCount, size / MIN_CHUNK_BYTES));
+    std::vector<const char*> bounds;
+    bounds.push_back(data);
+    for (size_t i = 1; i < threadCount; i++) {
+        const char* split = std::max(bounds.back(), data + size * i / threadCount);
+        split = findLineEnd(split, data + size);
+        bounds.push_back(split < data + size ? split + 1 : data + size);
+    }
+    bounds.push_back(data + size);
+    std::vector<Chunk> chunks(threadCount);
+
+    // 2. Blöcke parallel parsen
+    runParallel(threadCount, [&](size_t i) {
+        parseChunk(bounds[i], bounds[i + 1], chunks[i]);
+    });
+
+    // 3. Attribute zusammenführen
+    size_t positionCount = 0;
+    size_t texcoordCount = 0;
+    size_t normalCount = 0;
+    for (Chunk& chunk : chunks) {
+        chunk.positionBase = positionCount;
+        chunk.texcoordBase = texcoordCount;
+        chunk.normalBase = normalCount;
+        positionCount += chunk.positions.size();
+        texcoordCount += chunk.texcoords.size();
+        normalCount += chunk.normals.size();
+    }
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texcoords;
+    std::vector<glm::vec3> normals;
+    positions.reserve(positionCount);
+    texcoords.reserve(texcoordCount);
+    normals.reserve(normalCount);
+    size_t faceCount = 0;
+    for (Chunk& chunk : chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        chunk.positions = std::vector<glm::vec3>();
+        chunk.texcoords = std::vector<glm::vec2>();
+        chunk.normals = std::vector<glm::vec3>();
+        faceCount += chunk.faceSizes.size();
+    }
+
+    // 4. Polygone parallel triangulieren
+    runParallel(threadCount, [&](size_t i) {
+        triangulateChunk(chunks[i], positions, texcoordCount, normalCount);
+    });
+
+    size_t cornerCount = 0;
+    size_t skippedFaces = 0;
+    for (const Chunk& chunk : chunks) {
+        cornerCount += chunk.triangles.size();
+        skippedFaces += chunk.skippedFaces;
+    }
+    if (cornerCount == 0) {
+        std::cerr << "[FastObjParser] keine Dreiecke gefunden\n";
+        return false;
+    }
+
+    // 5. Ecken über ihr Index-Tripel deduplizieren (offene Adressierung)
+    size_t capacity = 1;
+    while (capacity < cornerCount * 2) {
+        capacity <<= 1;
+    }
+    const uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> slots(capacity, EMPTY);
+    std::vector<Corner> uniqueCorners;
+    uniqueCorners.reserve(cornerCount / 2);
+    std::vector<uint32_t> cornerIndices;
+    cornerIndices.reserve(cornerCount);
+    for (const Chunk& chunk : chunks) {
+        for (const Corner& corner : chunk.triangles) {
+            size_t slot = hashCorner(corner) & (capacity - 1);
+            while (true) {
+                uint32_t candidate = slots[slot];
+                if (candidate == EMPTY) {
+                    candidate = static_cast<uint32_t>(uniqueCorners.size());
+                    slots[slot] = candidate;
+                    uniqueCorners.push_back(corner);
+                    cornerIndices.push_back(candidate);
+                    break;
+                }
+                const Corner& existing = uniqueCorners[candidate];
+                if (existing.v == corner.v && existing.vt == corner.vt && existing.vn == corner.vn) {
+                    cornerIndices.push_back(candidate);
+                    break;
+                }
+                slot = (slot + 1) & (capacity - 1);
+            }
+        }
+    }
+
+    // 6. Vertices bauen und gleiche Werte (z.B. doppelte vn-Zeilen) zusammenfassen,
+    //    die Reihenfolge entspricht dabei genau der von LoadObj::indexVertices
+    std::vector<Vertex> candidates(uniqueCorners.size());
+    for (size_t i = 0; i < uniqueCorners.size(); i++) {
+        const Corner& corner = uniqueCorners[i];
+        Vertex& vertex = candidates[i];
+        vertex = Vertex{};
+        vertex.pos = positions[corner.v];
+        if (corner.vn != NO_INDEX) {
+            vertex.normal = normals[corner.vn];
+        }
+        if (corner.vt != NO_INDEX) {
+            vertex.tex = glm::vec2(texcoords[corner.vt].x, 1.0f - texcoords[corner.vt].y);   // Flip Y
+        }
+    }
+    LoadObj::indexVertices(candidates, outMesh);
+    const std::vector<uint32_t> remap = std::move(outMesh.indices);
+    outMesh.indices.resize(cornerCount);
+    for (size_t i = 0; i < cornerCount; i++) {
+        outMesh.indices[i] = remap[cornerIndices[i]];
+    }
+
+    if (stats) {
+        stats->bytes = size;
+        stats->threads = threadCount;
+        stats->faces = faceCount;
+        stats->corners = cornerCount;
+        stats->skippedFaces = skippedFaces;
+        stats->parseMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+    }
+    if (skippedFaces > 0) {
+        std::cerr << "[FastObjParser] " << skippedFaces << " ungültige Polygone übersprungen\n";
+    }
+    return true;
+}
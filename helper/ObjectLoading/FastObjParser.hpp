@@ -0,0 +1,31 @@
+// FastObjParser.hpp
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "loadObj.hpp"
+
+// OBJ-Parser für den Ladepfad (mmap, parallel), v/vt/vn/f
+class FastObjParser {
+public:
+    struct Stats {
+        size_t bytes = 0;
+        size_t threads = 0;
+        size_t faces = 0;           // Polygone in der Datei
+        size_t corners = 0;         // Dreiecksecken nach der Triangulierung
+        size_t skippedFaces = 0;    // ungültige Indices oder < 3 Ecken
+        double parseMs = 0.0;
+    };
+
+    // Blöcke kleiner als das lohnen keinen eigenen Thread
+    static constexpr size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+    // Parst filename nach outMesh (Vertices dedupliziert, Indices, Bounds).
+    // maxThreads = 0 -> Anzahl der Kerne
+    static bool parse(const std::string& filename, MeshData& outMesh,
+                      Stats* stats = nullptr, unsigned maxThreads = 0);
+    // Variante auf einem Speicherbereich (z.B. für Tests oder schon gelesene Dateien)
+    static bool parse(const char* data, size_t size, MeshData& outMesh,
+                      Stats* stats = nullptr, unsigned maxThreads = 0);
+};
@@ -0,0 +1,387 @@
+#include "MeshCache.hpp"
+#include "../initBuffer.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <functional>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MESH_CACHE_MAGIC[4] = { 'B', 'M', 'S', 'H' };
+
+    // Vertex-/Index-Daten beginnen auf 16-Byte Grenzen
+    uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    double millisSince(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+// ------------------------------------------------------------
+// MappedFile
+// ------------------------------------------------------------
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    _file = file;
+    _mapping = mapping;
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // Mapping bleibt auch nach close(fd) gültig
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!_data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(static_cast<HANDLE>(_mapping));
+    CloseHandle(static_cast<HANDLE>(_file));
+    _mapping = nullptr;
+    _file = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+}
+
+// ------------------------------------------------------------
+// MeshCache
+// ------------------------------------------------------------
+
+// FNV-1a über 8-Byte Wörter (+ Rest byteweise), reicht zum Erkennen von Änderungen
+uint64_t MeshCache::hashBytes(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const uint64_t prime = 1099511628211ull;
+    uint64_t hash = seed;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * prime;
+    }
+    return hash;
+}
+
+std::string MeshCache::cachePathFor(const std::string& objPath) {
+    return objPath + ".bmesh";
+}
+
+bool MeshCache::querySource(const std::string& objPath, SourceInfo& out, bool withHash) {
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(objPath, ec);
+    if (ec) {
+        return false;
+    }
+    auto size = std::filesystem::file_size(objPath, ec);
+    if (ec) {
+        return false;
+    }
+    out.mtime = static_cast<uint64_t>(mtime.time_since_epoch().count());
+    out.size = static_cast<uint64_t>(size);
+    out.hash = 0;
+    if (!withHash) {
+        return true;
+    }
+
+    MappedFile source;
+    if (!source.open(objPath)) {
+        return false;
+    }
+    out.size = source.size();
+    out.hash = hashBytes(source.data(), source.size());
+    return true;
+}
+
+void MeshCache::updateSourceMtime(const std::string& objPath, uint64_t mtime) {
+    std::fstream file(cachePathFor(objPath), std::ios::in | std::ios::out | std::ios::binary);
+    if (!file) {
+        return;
+    }
+    file.seekp(offsetof(MeshCacheHeader, sourceMtime));
+    file.write(reinterpret_cast<const char*>(&mtime), sizeof(mtime));
+}
+
+bool MeshCache::open(const std::string& objPath) {
+    _header = nullptr;
+    if (!_file.open(cachePathFor(objPath))) {
+        return false;
+    }
+    if (_file.size() < sizeof(MeshCacheHeader)) {
+        _file.close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const MeshCacheHeader*>(_file.data());
+    bool valid = std::memcmp(header->magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) == 0
+              && header->version == MESH_CACHE_VERSION
+              && header->vertexStride == sizeof(Vertex)
+              && header->vertexCount > 0 && header->indexCount > 0;
+
+    if (valid) {
+        uint64_t indexSize = header->indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+        valid = header->vertexOffset + uint64_t(header->vertexCount) * header->vertexStride <= _file.size()
+             && header->indexOffset + uint64_t(header->indexCount) * indexSize <= _file.size()
+             && header->lodOffset + uint64_t(header->lodCount) * sizeof(MeshLod) <= _file.size()
+             && header->meshletOffset + uint64_t(header->meshletCount) * sizeof(Meshlet) <= _file.size();
+    }
+    // jede Stufe muss innerhalb der Index-Liste liegen
+    if (valid) {
+        const auto* lods = reinterpret_cast<const MeshLod*>(_file.data() + header->lodOffset);
+        for (uint32_t i = 0; i < header->lodCount && valid; i++) {
+            valid = uint64_t(lods[i].firstIndex) + lods[i].indexCount <= header->indexCount;
+        }
+    }
+    if (valid) {
+        const auto* meshlets = reinterpret_cast<const Meshlet*>(_file.data() + header->meshletOffset);
+        for (uint32_t i = 0; i < header->meshletCount && valid; i++) {
+            valid = uint64_t(meshlets[i].firstIndex) + meshlets[i].indexCount <= header->indexCount;
+        }
+    }
+
+    // OBJ geändert? Gleiche Größe und mtime: unverändert, ohne die OBJ zu lesen.
+    // Andere mtime (Auschecken, Kopieren) entscheidet der Hash über den Inhalt
+    SourceInfo source;
+    bool mtimeChanged = false;
+    if (valid) {
+        valid = querySource(objPath, source, false) && source.size == header->sourceSize;
+    }
+    if (valid && source.mtime != header->sourceMtime) {
+        valid = querySource(objPath, source, true)
+             && source.size == header->sourceSize
+             && source.hash == header->sourceHash;
+        mtimeChanged = valid;
+    }
+
+    if (!valid) {
+        _file.close();
+        return false;
+    }
+    if (mtimeChanged) {
+        // beim nächsten Start wieder ohne Hash
+        updateSourceMtime(objPath, source.mtime);
+    }
+
+    _header = header;
+    return true;
+}
+
+std::vector<MeshLod> MeshCache::lods() const {
+    std::vector<MeshLod> out(_header->lodCount);
+    if (!out.empty()) {
+        std::memcpy(out.data(), _file.data() + _header->lodOffset, out.size() * sizeof(MeshLod));
+    }
+    return out;
+}
+
+std::vector<Meshlet> MeshCache::meshlets() const {
+    std::vector<Meshlet> out(_header->meshletCount);
+    if (!out.empty()) {
+        std::memcpy(out.data(), _file.data() + _header->meshletOffset, out.size() * sizeof(Meshlet));
+    }
+    return out;
+}
+
+bool MeshCache::write(const std::string& objPath, const MeshData& mesh, float coldLoadMs) {
+    if (mesh.vertices.empty() || mesh.indices.empty()) {
+        return false;
+    }
+
+    SourceInfo source;
+    if (!querySource(objPath, source, true)) {
+        return false;
+    }
+
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    const VkIndexType indexType = InitBuffer::chooseIndexType(vertexCount);
+    const uint64_t indexSize = indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    MeshCacheHeader header{};
+    std::memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+    header.version = MESH_CACHE_VERSION;
+    header.sourceMtime = source.mtime;
+    header.sourceSize = source.size;
+    header.sourceHash = source.hash;
+    header.vertexCount = vertexCount;
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.vertexStride = sizeof(Vertex);
+    header.indexType = static_cast<uint32_t>(indexType);
+    header.vertexOffset = alignUp(sizeof(MeshCacheHeader), 16);
+    header.indexOffset = alignUp(header.vertexOffset + uint64_t(vertexCount) * sizeof(Vertex), 16);
+    header.lodCount = static_cast<uint32_t>(mesh.lods.size());
+    header.lodOffset = alignUp(header.indexOffset + uint64_t(header.indexCount) * indexSize, 16);
+    header.meshletCount = static_cast<uint32_t>(mesh.meshlets.size());
+    header.meshletOffset = alignUp(header.lodOffset + uint64_t(header.lodCount) * sizeof(MeshLod), 16);
+    for (int i = 0; i < 3; ++i) {
+        header.boundsMin[i] = mesh.boundsMin[i];
+        header.boundsMax[i] = mesh.boundsMax[i];
+    }
+    header.coldLoadMs = coldLoadMs;
+
+    // Indices schon im Zielformat ablegen, damit beim Laden nur noch kopiert wird
+    std::vector<uint16_t> shortIndices;
+    const void* indexBytes = mesh.indices.data();
+    if (indexType == VK_INDEX_TYPE_UINT16) {
+        shortIndices.assign(mesh.indices.begin(), mesh.indices.end());
+        indexBytes = shortIndices.data();
+    }
+
+    const std::string finalPath = cachePathFor(objPath);
+    // Eindeutiger tmp-Name, falls zwei Worker dasselbe Modell gleichzeitig schreiben
+    const std::string tmpPath = finalPath + ".tmp" +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "MeshCache: kann " << tmpPath << " nicht schreiben" << std::endl;
+            return false;
+        }
+        const char padding[16] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(padding, static_cast<std::streamsize>(header.vertexOffset - sizeof(header)));
+        out.write(reinterpret_cast<const char*>(mesh.vertices.data()),
+                  static_cast<std::streamsize>(uint64_t(vertexCount) * sizeof(Vertex)));
+        out.write(padding, static_cast<std::streamsize>(
+            header.indexOffset - (header.vertexOffset + uint64_t(vertexCount) * sizeof(Vertex))));
+        out.write(static_cast<const char*>(indexBytes),
+                  static_cast<std::streamsize>(header.indexCount * indexSize));
+        out.write(padding, static_cast<std::streamsize>(
+            header.lodOffset - (header.indexOffset + header.indexCount * indexSize)));
+        out.write(reinterpret_cast<const char*>(mesh.lods.data()),
+                  static_cast<std::streamsize>(mesh.lods.size() * sizeof(MeshLod)));
+        out.write(padding, static_cast<std::streamsize>(
+            header.meshletOffset - (header.lodOffset + header.lodCount * sizeof(MeshLod))));
+        out.write(reinterpret_cast<const char*>(mesh.meshlets.data()),
+                  static_cast<std::streamsize>(mesh.meshlets.size() * sizeof(Meshlet)));
+        if (!out) {
+            std::cerr << "MeshCache: Schreibfehler in " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+void MeshCache::printStartupReport(const std::string& modelDir) {
+    std::vector<std::string> objFiles;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(modelDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".obj") {
+            objFiles.push_back(entry.path().string());
+        }
+    }
+    std::sort(objFiles.begin(), objFiles.end());
+
+    std::cout << "Mesh-Cache Startup-Vergleich (" << modelDir << "):" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    double totalCached = 0.0;
+    double totalCold = 0.0;
+    for (const std::string& path : objFiles) {
+        MeshCache cache;
+        auto start = std::chrono::high_resolution_clock::now();
+        bool hit = cache.open(path);
+        double cachedMs = millisSince(start);
+
+        if (!hit) {
+            // Cache fehlt oder ist veraltet -> einmal kalt laden und ablegen
+            LoadObj loader;
+            MeshData mesh;
+            start = std::chrono::high_resolution_clock::now();
+            if (!loader.objLoader(path, mesh)) {
+                std::cout << "  " << path << ": konnte nicht geladen werden" << std::endl;
+                continue;
+            }
+            float coldMs = static_cast<float>(millisSince(start));
+            write(path, mesh, coldMs);
+
+            start = std::chrono::high_resolution_clock::now();
+            if (!cache.open(path)) {
+                std::cout << "  " << path << ": Cache konnte nicht erstellt werden" << std::endl;
+                continue;
+            }
+            cachedMs = millisSince(start);
+        }
+
+        double coldMs = cache.coldLoadMs();
+        totalCached += cachedMs;
+        totalCold += coldMs;
+        std::cout << "  " << path << ": Cache " << cachedMs << " ms | OBJ " << coldMs
+                  << " ms | x" << (cachedMs > 0.0 ? coldMs / cachedMs : 0.0)
+                  << (hit ? "" : " (neu erstellt)") << std::endl;
+    }
+
+    std::cout << "  Gesamt: Cache " << totalCached << " ms | OBJ " << totalCold << " ms" << std::endl;
+    std::cout << std::defaultfloat;
+}
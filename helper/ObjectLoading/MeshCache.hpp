@@ -0,0 +1,111 @@
+// MeshCache.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "loadObj.hpp"
+
+// Read-only mmap einer Datei (POSIX mmap bzw. MapViewOfFile unter Windows)
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+#ifdef _WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#endif
+};
+
+// Dateikopf der .bmesh Datei. Ändert sich das Layout (oder Vertex),
+// muss MESH_CACHE_VERSION hochgezählt werden - alte Caches werden dann neu gebaut.
+struct MeshCacheHeader {
+    char magic[4];              // "BMSH"
+    uint32_t version;
+    uint64_t sourceMtime;       // last_write_time der OBJ: gleiche Größe + mtime = kein Hash nötig
+    uint64_t sourceSize;        // Dateigröße der OBJ in Bytes
+    uint64_t sourceHash;        // Hash über den kompletten OBJ-Inhalt
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t vertexStride;      // sizeof(Vertex) beim Schreiben
+    uint32_t indexType;         // VkIndexType (16 oder 32 Bit)
+    uint64_t vertexOffset;      // Byte-Offset der Vertex-Daten ab Dateianfang
+    uint64_t indexOffset;       // Byte-Offset der Index-Daten ab Dateianfang
+    float boundsMin[3];
+    float boundsMax[3];
+    float coldLoadMs;           // Dauer des OBJ-Pfads beim Erstellen (für den Vergleich)
+    uint32_t lodCount;          // Einträge der MeshLod-Tabelle
+    uint64_t lodOffset;         // Byte-Offset der MeshLod-Tabelle ab Dateianfang
+    uint32_t meshletCount;      // 0 = Mesh ohne Meshlets
+    uint32_t reserved;
+    uint64_t meshletOffset;     // Byte-Offset der Meshlet-Tabelle ab Dateianfang
+};
+
+// Binärer Mesh-Cache (.bmesh neben der OBJ-Datei), wird per mmap gelesen
+class MeshCache {
+public:
+    // 2: Geometrie ist vom MeshOptimizer umsortiert
+    // 3: LOD-Kette (MeshSimplifier) hinter den Indices
+    // 4: Meshlets (MeshletBuilder) hinter der LOD-Kette
+    static constexpr uint32_t MESH_CACHE_VERSION = 4;
+
+    // Schneller 64-Bit Hash über beliebige Bytes (mit seed verkettbar)
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+    // models/foo.obj -> models/foo.obj.bmesh
+    static std::string cachePathFor(const std::string& objPath);
+
+    // Blendet den Cache zu objPath ein. false wenn es keinen gibt oder er
+    // nicht mehr zur OBJ passt (Größe, Version, Vertex-Layout, bei anderer mtime der Hash)
+    bool open(const std::string& objPath);
+
+    // Schreibt den Cache für objPath (erst .tmp, dann rename). Thread-safe
+    static bool write(const std::string& objPath, const MeshData& mesh, float coldLoadMs);
+
+    // Zeitvergleich Cache vs. OBJ-Parser für jede OBJ in modelDir; fehlende
+    // oder veraltete Caches werden dabei gleich erzeugt
+    static void printStartupReport(const std::string& modelDir);
+
+    const void* vertexData() const { return _file.data() + _header->vertexOffset; }
+    const void* indexData() const { return _file.data() + _header->indexOffset; }
+    uint32_t vertexCount() const { return _header->vertexCount; }
+    uint32_t indexCount() const { return _header->indexCount; }
+    VkIndexType indexType() const { return static_cast<VkIndexType>(_header->indexType); }
+    glm::vec3 boundsMin() const { return glm::vec3(_header->boundsMin[0], _header->boundsMin[1], _header->boundsMin[2]); }
+    glm::vec3 boundsMax() const { return glm::vec3(_header->boundsMax[0], _header->boundsMax[1], _header->boundsMax[2]); }
+    float coldLoadMs() const { return _header->coldLoadMs; }
+    uint32_t lodCount() const { return _header->lodCount; }
+    std::vector<MeshLod> lods() const;
+    uint32_t meshletCount() const { return _header->meshletCount; }
+    std::vector<Meshlet> meshlets() const;
+
+private:
+    struct SourceInfo {
+        uint64_t mtime = 0;
+        uint64_t size = 0;
+        uint64_t hash = 0;
+    };
+    // mtime und Größe per stat, den Hash (OBJ komplett einblenden) nur mit withHash
+    static bool querySource(const std::string& objPath, SourceInfo& out, bool withHash);
+    // Trägt nach einem passenden Hash die neue mtime in den Cache ein (Fehler egal)
+    static void updateSourceMtime(const std::string& objPath, uint64_t mtime);
+
+    MappedFile _file;
+    const MeshCacheHeader* _header = nullptr;
+};
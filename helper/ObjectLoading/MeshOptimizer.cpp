@@ -0,0 +1,341 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+    // Forsyth rechnet mit einem LRU-Cache dieser Größe (größer als der echte, damit
+    // die Sortierung auf verschiedenen GPUs gut funktioniert)
+    constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRI_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    float forsythVertexScore(int cachePosition, uint32_t remainingTriangles) {
+        if (remainingTriangles == 0) {
+            return -1.0f;   // Vertex wird nicht mehr gebraucht
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // gerade benutzt - bewusst etwas niedriger, damit nicht immer dieselbe Kante gewinnt
+                score = LAST_TRI_SCORE;
+            } else {
+                const float scaler = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+
+        // Vertices mit wenigen offenen Dreiecken bevorzugen, damit keine "Inseln" übrig bleiben
+        score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+        return score;
+    }
+
+    // FIFO-Cache-Simulation: Anzahl Cache Misses je Dreieck (0..3) über eine Dreiecksfolge
+    class FifoCache {
+    public:
+        FifoCache(size_t vertexCount, uint32_t cacheSize)
+            : _stamps(vertexCount, 0), _time(cacheSize + 1), _cacheSize(cacheSize) {}
+
+        uint32_t triangleMisses(const uint32_t* tri) {
+            uint32_t misses = 0;
+            for (int k = 0; k < 3; k++) {
+                uint32_t v = tri[k];
+                if (_time - _stamps[v] > _cacheSize) {
+                    _stamps[v] = _time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+
+        // Cache leeren (z.B. an einer Cluster-Grenze)
+        void reset() { _time += _cacheSize + 1; }
+
+    private:
+        std::vector<uint32_t> _stamps;
+        uint32_t _time;
+        uint32_t _cacheSize;
+    };
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                                   uint32_t cacheSize) {
+    VertexCacheStats stats;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return stats;
+    }
+
+    FifoCache cache(vertexCount, cacheSize);
+    size_t misses = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        misses += cache.triangleMisses(&indices[t * 3]);
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+    return stats;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Dreiecke je Vertex (CSR: adjacencyOffset[v] .. + remaining[v])
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) {
+        remaining[index]++;
+    }
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) {
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (size_t t = 0; t < triangleCount; t++) {
+            for (int k = 0; k < 3; k++) {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        vertexScore[v] = forsythVertexScore(-1, remaining[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; t++) {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]]
+                         + vertexScore[indices[t * 3 + 2]];
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    size_t bestTriangle = static_cast<size_t>(
+        std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+    size_t cursor = 0;  // für den Fall, dass kein Dreieck im Cache mehr offen ist
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+        if (bestTriangle == std::numeric_limits<size_t>::max()) {
+            while (emitted[cursor]) {
+                cursor++;
+            }
+            bestTriangle = cursor;
+        }
+
+        const uint32_t* tri = &indices[bestTriangle * 3];
+        result.insert(result.end(), tri, tri + 3);
+        emitted[bestTriangle] = true;
+
+        // Dreieck aus den Adjazenzlisten seiner Vertices entfernen
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = tri[k];
+            uint32_t* begin = &adjacency[adjacencyOffset[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* it = std::find(begin, end, static_cast<uint32_t>(bestTriangle));
+            if (it != end) {
+                std::swap(*it, *(end - 1));
+                remaining[v]--;
+            }
+        }
+
+        // LRU: Vertices des Dreiecks nach vorne, Rest dahinter
+        newCache.assign(tri, tri + 3);
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                newCache.push_back(v);
+            }
+        }
+
+        // Scores aller betroffenen Vertices (auch der herausgefallenen) neu berechnen
+        for (size_t i = 0; i < newCache.size(); i++) {
+            uint32_t v = newCache[i];
+            cachePosition[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+            vertexScore[v] = forsythVertexScore(cachePosition[v], remaining[v]);
+        }
+        if (newCache.size() > FORSYTH_CACHE_SIZE) {
+            newCache.resize(FORSYTH_CACHE_SIZE);
+        }
+        cache.swap(newCache);
+
+        // bestes offenes Dreieck unter den Nachbarn der Cache-Vertices suchen
+        bestTriangle = std::numeric_limits<size_t>::max();
+        float bestScore = -std::numeric_limits<float>::max();
+        for (uint32_t v : cache) {
+            const uint32_t* begin = &adjacency[adjacencyOffset[v]];
+            for (uint32_t a = 0; a < remaining[v]; a++) {
+                uint32_t t = begin[a];
+                float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]]
+                            + vertexScore[indices[t * 3 + 2]];
+                triangleScore[t] = score;
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = t;
+                }
+            }
+        }
+    }
+
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+                                     float threshold) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // 1. harte Grenzen: Dreieck, bei dem alle drei Vertices nicht im Cache sind
+    std::vector<size_t> clusterStarts;
+    {
+        FifoCache cache(vertices.size(), SIMULATED_CACHE_SIZE);
+        for (size_t t = 0; t < triangleCount; t++) {
+            if (cache.triangleMisses(&indices[t * 3]) == 3) {
+                clusterStarts.push_back(t);
+            }
+        }
+        if (clusterStarts.empty() || clusterStarts[0] != 0) {
+            clusterStarts.insert(clusterStarts.begin(), 0);
+        }
+    }
+
+    // 2. weiche Grenzen: große Cluster weiter teilen, solange die ACMR innerhalb
+    //    des Clusters höchstens um threshold schlechter wird
+    std::vector<size_t> splitStarts;
+    for (size_t c = 0; c < clusterStarts.size(); c++) {
+        size_t begin = clusterStarts[c];
+        size_t end = c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : triangleCount;
+
+        FifoCache cache(vertices.size(), SIMULATED_CACHE_SIZE);
+        size_t clusterMisses = 0;
+        for (size_t t = begin; t < end; t++) {
+            clusterMisses += cache.triangleMisses(&indices[t * 3]);
+        }
+        const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+        cache.reset();
+        splitStarts.push_back(begin);
+        size_t runningMisses = 0;
+        size_t runningStart = begin;
+        for (size_t t = begin; t < end; t++) {
+            runningMisses += cache.triangleMisses(&indices[t * 3]);
+            float runningAcmr = static_cast<float>(runningMisses) / static_cast<float>(t - runningStart + 1);
+            if (t + 1 < end && runningAcmr <= clusterThreshold) {
+                splitStarts.push_back(t + 1);
+                runningStart = t + 1;
+                runningMisses = 0;
+                cache.reset();
+            }
+        }
+    }
+
+    // 3. Sortierschlüssel je Cluster: wie weit zeigt der Cluster nach außen?
+    //    (Schwerpunkt relativ zur Mesh-Mitte, projiziert auf die mittlere Normale)
+    struct Cluster {
+        size_t begin = 0;
+        size_t end = 0;
+        glm::vec3 centroid{0.0f};
+        glm::vec3 normal{0.0f};
+        float area = 0.0f;
+        float sortKey = 0.0f;
+    };
+    std::vector<Cluster> clusters(splitStarts.size());
+
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < splitStarts.size(); c++) {
+        Cluster& cluster = clusters[c];
+        cluster.begin = splitStarts[c];
+        cluster.end = c + 1 < splitStarts.size() ? splitStarts[c + 1] : triangleCount;
+
+        for (size_t t = cluster.begin; t < cluster.end; t++) {
+            const glm::vec3& p0 = vertices[indices[t * 3]].pos;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].pos;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].pos;
+            glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);   // Länge = 2 * Fläche
+            float area = glm::length(faceNormal) * 0.5f;
+
+            cluster.centroid += (p0 + p1 + p2) * (area / 3.0f);
+            cluster.normal += faceNormal;
+            cluster.area += area;
+        }
+        meshCentroid += cluster.centroid;
+        meshArea += cluster.area;
+        if (cluster.area > 0.0f) {
+            cluster.centroid /= cluster.area;
+        }
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    for (Cluster& cluster : clusters) {
+        float normalLength = glm::length(cluster.normal);
+        glm::vec3 normal = normalLength > 0.0f ? cluster.normal / normalLength : glm::vec3(0.0f);
+        cluster.sortKey = glm::dot(cluster.centroid - meshCentroid, normal);
+    }
+
+    // nach außen zeigende Cluster zuerst: verdecken meist die inneren
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (const Cluster& cluster : clusters) {
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    }
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& mesh) {
+    const uint32_t unused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(mesh.vertices.size(), unused);
+
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == unused) {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    // nicht referenzierte Vertices fallen weg (Bounds bleiben gültig, höchstens etwas zu groß)
+    mesh.vertices.swap(vertices);
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(MeshData& mesh) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Report report;
+    report.before = analyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+    optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    optimizeOverdraw(mesh.indices, mesh.vertices);
+    optimizeVertexFetch(mesh);
+
+    report.after = analyzeVertexCache(mesh.indices, mesh.vertices.size());
+    report.durationMs = std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+    return report;
+}
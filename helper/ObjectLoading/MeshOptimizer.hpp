@@ -0,0 +1,43 @@
+// MeshOptimizer.hpp
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "loadObj.hpp"
+
+// Ergebnis einer FIFO-Cache-Simulation
+struct VertexCacheStats {
+    float acmr = 0.0f;      // Average Cache Miss Ratio: Vertex-Shader-Aufrufe pro Dreieck (0.5 ... 3)
+    float atvr = 0.0f;      // Average Transformed Vertex Ratio: Aufrufe pro Vertex (1 = optimal)
+};
+
+// Sortiert Dreiecke/Vertices für Vertex Cache, Overdraw und Vertex Fetch
+class MeshOptimizer {
+public:
+    struct Report {
+        VertexCacheStats before;
+        VertexCacheStats after;
+        float durationMs = 0.0f;
+    };
+
+    // Größe des simulierten FIFO-Caches für ACMR/ATVR (typische Hardware-Größe)
+    static constexpr uint32_t SIMULATED_CACHE_SIZE = 16;
+
+    // Alle drei Schritte hintereinander, Indices und Vertices werden umsortiert
+    static Report optimize(MeshData& mesh);
+
+    // Forsyth: Dreiecke mit hohem Score (Vertices im Cache, wenige offene Dreiecke) zuerst
+    static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    // Teilt die (cache-optimierte) Dreiecksliste an Cache-Grenzen in Cluster und sortiert
+    // diese nach außen zeigend zuerst. threshold: erlaubte ACMR-Verschlechterung (1.05 = 5%)
+    static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+                                 float threshold = 1.05f);
+
+    // Vertices in der Reihenfolge ablegen, in der sie zuerst referenziert werden
+    static void optimizeVertexFetch(MeshData& mesh);
+
+    static VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                               uint32_t cacheSize = SIMULATED_CACHE_SIZE);
+};
@@ -0,0 +1,198 @@
+#include "MeshRegistry.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+
+std::string MeshRegistry::normalizePath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+std::shared_ptr<GpuMesh> MeshRegistry::findByPath(const std::string& path) {
+    if (path.empty()) {
+        return nullptr;
+    }
+    auto it = _byPath.find(normalizePath(path));
+    if (it == _byPath.end() || !it->second->resident) {
+        return nullptr;
+    }
+    _stats.hits++;
+    _stats.savedBytes += it->second->byteSize;
+    return it->second;
+}
+
+std::shared_ptr<GpuMesh> MeshRegistry::findByContent(uint64_t contentHash) {
+    auto it = _byContent.find(contentHash);
+    if (it == _byContent.end() || !it->second->resident) {
+        return nullptr;
+    }
+    _stats.hits++;
+    _stats.savedBytes += it->second->byteSize;
+    return it->second;
+}
+
+void MeshRegistry::addPathAlias(const std::string& path, const std::shared_ptr<GpuMesh>& mesh) {
+    if (!path.empty()) {
+        _byPath[normalizePath(path)] = mesh;
+    }
+}
+
+std::shared_ptr<GpuMesh> MeshRegistry::insert(const std::string& path, uint64_t contentHash, const GpuMesh& mesh) {
+    auto shared = std::make_shared<GpuMesh>(mesh);
+    _byContent[contentHash] = shared;
+    addPathAlias(path, shared);
+
+    _stats.misses++;
+    _stats.residentBytes += mesh.byteSize;
+    _stats.meshCount = _byContent.size();
+    return shared;
+}
+
+std::shared_ptr<GpuMesh> MeshRegistry::findEvicted(uint64_t contentHash) {
+    auto it = _byContent.find(contentHash);
+    if (it == _byContent.end() || it->second->resident) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+VkDeviceSize MeshRegistry::evict(GpuMesh& mesh) {
+    if (!mesh.resident) {
+        return 0;
+    }
+    Retired retired;
+    retired.buffers.vertexBuffer = mesh.vertexBuffer;
+    retired.buffers.vertexBufferMemory = mesh.vertexBufferMemory;
+    retired.buffers.indexBuffer = mesh.indexBuffer;
+    retired.buffers.indexBufferMemory = mesh.indexBufferMemory;
+    retired.buffers.meshletBuffer = mesh.meshletBuffer;
+    retired.buffers.meshletBufferMemory = mesh.meshletBufferMemory;
+    retired.frame = _frame;
+    _retired.push_back(retired);
+
+    mesh.vertexBuffer = VK_NULL_HANDLE;
+    mesh.vertexBufferMemory = MemoryAllocation{};
+    mesh.indexBuffer = VK_NULL_HANDLE;
+    mesh.indexBufferMemory = MemoryAllocation{};
+    mesh.meshletBuffer = VK_NULL_HANDLE;
+    mesh.meshletBufferMemory = MemoryAllocation{};
+    mesh.uploadTicket = 0;
+    mesh.resident = false;
+
+    _stats.residentBytes -= mesh.byteSize;
+    _stats.evictedCount++;
+    _stats.evictions++;
+    return mesh.byteSize;
+}
+
+void MeshRegistry::restore(GpuMesh& mesh, const GpuMesh& uploaded) {
+    if (mesh.resident) {
+        return;
+    }
+    mesh.vertexBuffer = uploaded.vertexBuffer;
+    mesh.vertexBufferMemory = uploaded.vertexBufferMemory;
+    mesh.indexBuffer = uploaded.indexBuffer;
+    mesh.indexBufferMemory = uploaded.indexBufferMemory;
+    mesh.meshletBuffer = uploaded.meshletBuffer;
+    mesh.meshletBufferMemory = uploaded.meshletBufferMemory;
+    mesh.uploadTicket = uploaded.uploadTicket;
+    mesh.resident = true;
+
+    _stats.residentBytes += mesh.byteSize;
+    _stats.evictedCount--;
+    _stats.restores++;
+}
+
+void MeshRegistry::destroyRetired(bool all) {
+    _frame++;
+    while (!_retired.empty() && (all || _frame - _retired.front().frame >= RETIRE_FRAMES)) {
+        destroyMesh(_retired.front().buffers);
+        _retired.pop_front();
+    }
+}
+
+size_t MeshRegistry::releaseUnused() {
+    // Referenzen aus der Registry selbst: 1x _byContent + n Pfad-Aliase
+    std::unordered_map<const GpuMesh*, long> ownRefs;
+    for (const auto& [hash, mesh] : _byContent) {
+        ownRefs[mesh.get()] = 1;
+    }
+    for (const auto& [path, mesh] : _byPath) {
+        ownRefs[mesh.get()]++;
+    }
+
+    for (auto it = _byPath.begin(); it != _byPath.end();) {
+        long& refs = ownRefs[it->second.get()];
+        if (it->second.use_count() == refs) {
+            refs--;
+            it = _byPath.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    size_t released = 0;
+    for (auto it = _byContent.begin(); it != _byContent.end();) {
+        if (it->second.use_count() == 1) {
+            if (it->second->resident) {
+                _stats.residentBytes -= it->second->byteSize;
+            } else {
+                _stats.evictedCount--;
+            }
+            destroyMesh(*it->second);
+            it = _byContent.erase(it);
+            released++;
+        } else {
+            ++it;
+        }
+    }
+    _stats.meshCount = _byContent.size();
+    return released;
+}
+
+void MeshRegistry::destroyAll() {
+    destroyRetired(true);
+    for (auto& [hash, mesh] : _byContent) {
+        destroyMesh(*mesh);
+    }
+    _byContent.clear();
+    _byPath.clear();
+    _stats.residentBytes = 0;
+    _stats.meshCount = 0;
+    _stats.evictedCount = 0;
+}
+
+void MeshRegistry::destroyMesh(GpuMesh& mesh) {
+    if (mesh.vertexBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(_device, mesh.vertexBuffer, nullptr);
+        mesh.vertexBuffer = VK_NULL_HANDLE;
+    }
+    if (mesh.vertexBufferMemory) {
+        MemoryAllocator::of(_device).free(mesh.vertexBufferMemory);
+    }
+    if (mesh.indexBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(_device, mesh.indexBuffer, nullptr);
+        mesh.indexBuffer = VK_NULL_HANDLE;
+    }
+    if (mesh.indexBufferMemory) {
+        MemoryAllocator::of(_device).free(mesh.indexBufferMemory);
+    }
+    if (mesh.meshletBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(_device, mesh.meshletBuffer, nullptr);
+        mesh.meshletBuffer = VK_NULL_HANDLE;
+    }
+    if (mesh.meshletBufferMemory) {
+        MemoryAllocator::of(_device).free(mesh.meshletBufferMemory);
+    }
+}
+
+void MeshRegistry::printStats() const {
+    std::cout << std::fixed << std::setprecision(2)
+              << "MeshRegistry: " << _stats.meshCount << " Meshes, "
+              << _stats.hits << " Treffer / " << _stats.misses << " Uploads, "
+              << _stats.residentBytes / (1024.0 * 1024.0) << " MB belegt, "
+              << _stats.savedBytes / (1024.0 * 1024.0) << " MB eingespart, "
+              << _stats.evictedCount << " ausgelagert (" << _stats.evictions << "x ausgelagert, "
+              << _stats.restores << "x nachgeladen)"
+              << std::defaultfloat << std::endl;
+}
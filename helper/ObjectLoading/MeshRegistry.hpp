@@ -0,0 +1,111 @@
+// MeshRegistry.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "VertexCompression.hpp"
+#include "loadObj.hpp"
+#include "../MemoryAllocator.hpp"
+
+// Vertex-/Index-Buffer eines Meshes auf der GPU (gehört der MeshRegistry)
+struct GpuMesh {
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;
+    MemoryAllocation vertexBufferMemory;
+    uint32_t vertexCount = 0;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;      // VK_NULL_HANDLE = nicht indiziert
+    MemoryAllocation indexBufferMemory;
+    uint32_t indexCount = 0;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+    VkDeviceSize byteSize = 0;                  // Vertex- + Index- (+ Meshlet-) Daten
+    VertexFormat format = VertexFormat::FULL;
+    VertexQuantization quant;                   // Dekodier-Parameter für die Push Constants
+    std::vector<MeshLod> lods;                  // leer = eine Stufe über alle Indices
+    glm::vec3 boundsCenter{0.0f};               // Bounding Sphere (Objektraum) für die LOD-Auswahl
+    float boundsRadius = 0.0f;
+    VkBuffer meshletBuffer = VK_NULL_HANDLE;    // Meshlet-Tabelle für den MeshletCuller, sonst leer
+    MemoryAllocation meshletBufferMemory;
+    uint32_t meshletCount = 0;
+    uint64_t uploadTicket = 0;                  // UploadManager-Ticket aller Buffer (0 = synchron)
+    std::string sourcePath;                     // Modelldatei zum Nachladen, leer = Geometrie aus dem Code
+    bool resident = true;                       // false = vom ResidencyManager ausgelagert, Buffer leer
+};
+
+// Gleiche Meshes (Pfad oder Inhalt) liegen nur einmal im VRAM
+class MeshRegistry {
+public:
+    struct Stats {
+        uint64_t hits = 0;              // Mesh war schon da (per Pfad oder Inhalt)
+        uint64_t misses = 0;            // Mesh musste hochgeladen werden
+        VkDeviceSize residentBytes = 0; // aktuell belegter Vertex-/Index-Speicher
+        VkDeviceSize savedBytes = 0;    // durch Treffer eingesparte Uploads
+        size_t meshCount = 0;
+        size_t evictedCount = 0;        // davon gerade ausgelagert
+        uint64_t evictions = 0;
+        uint64_t restores = 0;
+    };
+
+    // Ausgelagerte Buffer leben noch so viele destroyRetired()-Aufrufe (> MAX_FRAMES_IN_FLIGHT)
+    static constexpr uint64_t RETIRE_FRAMES = 3;
+
+    explicit MeshRegistry(VkDevice device) : _device(device) {}
+
+    MeshRegistry(const MeshRegistry&) = delete;
+    MeshRegistry& operator=(const MeshRegistry&) = delete;
+
+    // Pfade werden normalisiert ("./models/a.obj" == "models/a.obj")
+    static std::string normalizePath(const std::string& path);
+
+    // Nur nachsehen, zählt nicht in die Statistik (ausgelagerte Meshes zählen nicht)
+    bool containsPath(const std::string& path) const {
+        auto it = _byPath.find(normalizePath(path));
+        return it != _byPath.end() && it->second->resident;
+    }
+
+    // Treffer zählen als hit; nullptr zählt noch nicht als miss (kommt evtl. per Inhalt)
+    std::shared_ptr<GpuMesh> findByPath(const std::string& path);
+    std::shared_ptr<GpuMesh> findByContent(uint64_t contentHash);
+    // Pfad zusätzlich auf ein schon vorhandenes Mesh zeigen lassen
+    void addPathAlias(const std::string& path, const std::shared_ptr<GpuMesh>& mesh);
+
+    // Neues Mesh übernehmen (zählt als miss). path darf leer sein (Geometrie aus dem Code)
+    std::shared_ptr<GpuMesh> insert(const std::string& path, uint64_t contentHash, const GpuMesh& mesh);
+
+    // Ausgelagertes Mesh mit diesem Inhalt oder nullptr
+    std::shared_ptr<GpuMesh> findEvicted(uint64_t contentHash);
+    // Gibt die Buffer von mesh frei, Anzahl/LODs/Bounds bleiben. Die Handles werden sofort
+    // VK_NULL_HANDLE, zerstört wird erst nach RETIRE_FRAMES (Frames in Flight). Rückgabe: Bytes
+    VkDeviceSize evict(GpuMesh& mesh);
+    // Frisch hochgeladene Buffer (gleicher Inhalt) in das ausgelagerte mesh übernehmen
+    void restore(GpuMesh& mesh, const GpuMesh& uploaded);
+    // Einmal pro Frame: zerstört ausgelagerte Buffer, die kein Frame mehr benutzt
+    void destroyRetired(bool all = false);
+
+    // Zerstört alle Meshes, die nur noch von der Registry referenziert werden
+    size_t releaseUnused();
+    // Zerstört alle Meshes (vor vkDestroyDevice aufrufen)
+    void destroyAll();
+
+    const Stats& getStats() const { return _stats; }
+    void printStats() const;
+
+private:
+    struct Retired {
+        GpuMesh buffers;    // nur die Handles
+        uint64_t frame = 0;
+    };
+
+    void destroyMesh(GpuMesh& mesh);
+
+    VkDevice _device;
+    std::unordered_map<uint64_t, std::shared_ptr<GpuMesh>> _byContent;
+    std::unordered_map<std::string, std::shared_ptr<GpuMesh>> _byPath;
+    std::deque<Retired> _retired;
+    uint64_t _frame = 0;
+    Stats _stats;
+};
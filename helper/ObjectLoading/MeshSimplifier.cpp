@@ -0,0 +1,412 @@
+#include "MeshSimplifier.hpp"
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+    // Rand- und Naht-Kanten bekommen zusätzliche Ebenen senkrecht zum Dreieck,
+    // damit Silhouetten und UV-Nähte nicht wegkollabieren
+    constexpr double BORDER_WEIGHT = 10.0;
+
+    // Symmetrische 4x4 Fehlerquadrik: Q(v) = v^T A v + 2 b^T v + c
+    struct Quadric {
+        double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c = 0;
+        double w = 0;   // Summe der Gewichte (Fläche), zum Normieren des Fehlers
+
+        void addPlane(const glm::vec3& n, float d, double weight) {
+            const double nx = n.x, ny = n.y, nz = n.z, nd = d;
+            a00 += weight * nx * nx; a11 += weight * ny * ny; a22 += weight * nz * nz;
+            a01 += weight * nx * ny; a02 += weight * nx * nz; a12 += weight * ny * nz;
+            b0 += weight * nx * nd; b1 += weight * ny * nd; b2 += weight * nz * nd;
+            c += weight * nd * nd;
+            w += weight;
+        }
+
+        void add(const Quadric& o) {
+            a00 += o.a00; a11 += o.a11; a22 += o.a22;
+            a01 += o.a01; a02 += o.a02; a12 += o.a12;
+            b0 += o.b0; b1 += o.b1; b2 += o.b2;
+            c += o.c;
+            w += o.w;
+        }
+
+        // mittlerer quadratischer Abstand von v zu den Ebenen
+        double error(const glm::vec3& v) const {
+            const double x = v.x, y = v.y, z = v.z;
+            double r = a00 * x * x + a11 * y * y + a22 * z * z
+                     + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                     + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return std::fabs(r) / (w > 0.0 ? w : 1.0);
+        }
+    };
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &p.x, sizeof(float));
+            std::memcpy(bits + 1, &p.y, sizeof(float));
+            std::memcpy(bits + 2, &p.z, sizeof(float));
+            return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+        }
+    };
+
+    struct Collapse {
+        uint32_t from;
+        uint32_t to;
+        double error;
+    };
+
+    uint64_t edgeKey(uint32_t a, uint32_t b) {
+        return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    }
+
+    // Unterschied in Normale/UV, um beim Kollabieren den passenden Vertex an der Zielposition zu finden
+    float attributeDistance(const Vertex& a, const Vertex& b) {
+        glm::vec3 dn = a.normal - b.normal;
+        glm::vec2 dt = a.tex - b.tex;
+        return glm::dot(dn, dn) + glm::dot(dt, dt);
+    }
+}
+
+std::vector<uint32_t> MeshSimplifier::simplify(const std::vector<Vertex>& vertices,
+                                               const std::vector<uint32_t>& indices,
+                                               size_t targetIndexCount, float targetError,
+                                               float* resultError) {
+    if (resultError) {
+        *resultError = 0.0f;
+    }
+    std::vector<uint32_t> result = indices;
+    if (vertices.empty() || result.size() <= targetIndexCount) {
+        return result;
+    }
+
+    // Vertices mit gleicher Position zusammenfassen (UV-Nähte, harte Kanten):
+    // Topologie und Quadriken laufen über Positionen, die Indices zeigen weiter auf Vertices
+    std::vector<uint32_t> posOf(vertices.size());
+    std::vector<glm::vec3> positions;
+    std::vector<std::vector<uint32_t>> wedges;
+    {
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> lookup;
+        lookup.reserve(vertices.size());
+        for (size_t v = 0; v < vertices.size(); v++) {
+            auto it = lookup.emplace(vertices[v].pos, static_cast<uint32_t>(positions.size()));
+            if (it.second) {
+                positions.push_back(vertices[v].pos);
+                wedges.emplace_back();
+            }
+            posOf[v] = it.first->second;
+            wedges[it.first->second].push_back(static_cast<uint32_t>(v));
+        }
+    }
+    const size_t positionCount = positions.size();
+
+    glm::vec3 boundsMin = positions[0];
+    glm::vec3 boundsMax = positions[0];
+    for (const glm::vec3& p : positions) {
+        boundsMin = glm::min(boundsMin, p);
+        boundsMax = glm::max(boundsMax, p);
+    }
+    const float radius = glm::length(boundsMax - boundsMin) * 0.5f;
+    if (radius <= 0.0f) {
+        return result;
+    }
+    const double errorLimit = double(targetError) * radius * double(targetError) * radius;
+
+    // Quadriken aus den Dreiecksebenen (flächengewichtet)
+    std::vector<Quadric> quadrics(positionCount);
+    struct EdgeInfo {
+        uint32_t count = 0;
+        uint32_t v0 = 0, v1 = 0;    // Vertices der ersten Seite (für die Naht-Erkennung)
+        bool seam = false;
+        glm::vec3 normal{0.0f};
+    };
+    std::unordered_map<uint64_t, EdgeInfo> edges;
+    edges.reserve(result.size());
+
+    for (size_t t = 0; t + 2 < result.size(); t += 3) {
+        const uint32_t* tri = &result[t];
+        const glm::vec3& p0 = positions[posOf[tri[0]]];
+        const glm::vec3& p1 = positions[posOf[tri[1]]];
+        const glm::vec3& p2 = positions[posOf[tri[2]]];
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float area2 = glm::length(n);
+        if (area2 <= 0.0f) {
+            continue;
+        }
+        n /= area2;
+        for (int k = 0; k < 3; k++) {
+            quadrics[posOf[tri[k]]].addPlane(n, -glm::dot(n, p0), area2 * 0.5);
+        }
+
+        for (int k = 0; k < 3; k++) {
+            uint32_t va = tri[k];
+            uint32_t vb = tri[(k + 1) % 3];
+            EdgeInfo& edge = edges[edgeKey(posOf[va], posOf[vb])];
+            if (edge.count == 0) {
+                edge.v0 = va;
+                edge.v1 = vb;
+                edge.normal = n;
+            } else if (!((edge.v0 == vb && edge.v1 == va) || (edge.v0 == va && edge.v1 == vb))) {
+                edge.seam = true;
+            }
+            edge.count++;
+        }
+    }
+
+    // Offene Ränder und Attribut-Nähte festhalten
+    for (const auto& entry : edges) {
+        const EdgeInfo& edge = entry.second;
+        if (edge.count != 1 && !edge.seam) {
+            continue;
+        }
+        uint32_t pa = posOf[edge.v0];
+        uint32_t pb = posOf[edge.v1];
+        glm::vec3 dir = positions[pb] - positions[pa];
+        float length = glm::length(dir);
+        if (length <= 0.0f) {
+            continue;
+        }
+        glm::vec3 perp = glm::cross(dir / length, edge.normal);
+        float perpLength = glm::length(perp);
+        if (perpLength <= 0.0f) {
+            continue;
+        }
+        perp /= perpLength;
+        double weight = BORDER_WEIGHT * double(length) * double(length);
+        quadrics[pa].addPlane(perp, -glm::dot(perp, positions[pa]), weight);
+        quadrics[pb].addPlane(perp, -glm::dot(perp, positions[pb]), weight);
+    }
+
+    double maxError = 0.0;
+    std::vector<uint32_t> adjacencyOffsets(positionCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<uint8_t> locked(positionCount);
+    std::vector<uint32_t> collapseTo(positionCount);
+    std::vector<uint32_t> vertexRemap(vertices.size());
+
+    // In Durchgängen kollabieren: jede Position höchstens einmal pro Durchgang,
+    // danach Indices neu schreiben und Kanten neu bewerten
+    while (result.size() > targetIndexCount) {
+        const size_t triangleCount = result.size() / 3;
+
+        // Dreiecke je Position (CSR)
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+        for (uint32_t index : result) {
+            adjacencyOffsets[posOf[index] + 1]++;
+        }
+        for (size_t p = 0; p < positionCount; p++) {
+            adjacencyOffsets[p + 1] += adjacencyOffsets[p];
+        }
+        adjacency.resize(result.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t t = 0; t < triangleCount; t++) {
+                for (int k = 0; k < 3; k++) {
+                    adjacency[fill[posOf[result[t * 3 + k]]]++] = static_cast<uint32_t>(t);
+                }
+            }
+        }
+
+        // Kanten-Kandidaten, jeweils die günstigere Richtung
+        collapses.clear();
+        for (size_t t = 0; t < triangleCount; t++) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t a = posOf[result[t * 3 + k]];
+                uint32_t b = posOf[result[t * 3 + (k + 1) % 3]];
+                if (a >= b) {
+                    continue;   // jede Kante nur einmal (die Gegenseite hat b < a)
+                }
+                Quadric q = quadrics[a];
+                q.add(quadrics[b]);
+                double toB = q.error(positions[b]);
+                double toA = q.error(positions[a]);
+                collapses.push_back(toB <= toA ? Collapse{a, b, toB} : Collapse{b, a, toA});
+            }
+        }
+        if (collapses.empty()) {
+            break;
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& l, const Collapse& r) { return l.error < r.error; });
+
+        // ein Kollaps entfernt meist 2 Dreiecke
+        const size_t collapseGoal = std::max<size_t>(1, (triangleCount - targetIndexCount / 3) / 2);
+        // pro Durchgang nur die günstigsten Kanten, damit die Reihenfolge stimmt
+        double passLimit = errorLimit;
+        if (collapseGoal < collapses.size()) {
+            passLimit = std::min(errorLimit, collapses[collapseGoal].error * 1.5 + 1e-20);
+        }
+
+        std::fill(locked.begin(), locked.end(), 0);
+        for (size_t p = 0; p < positionCount; p++) {
+            collapseTo[p] = static_cast<uint32_t>(p);
+        }
+
+        size_t applied = 0;
+        size_t removedTriangles = 0;
+        for (const Collapse& c : collapses) {
+            if (c.error > passLimit || removedTriangles >= (triangleCount - targetIndexCount / 3)) {
+                break;
+            }
+            if (locked[c.from] || locked[c.to]) {
+                continue;
+            }
+
+            // Umklappende Dreiecke verhindern
+            bool flips = false;
+            size_t degenerate = 0;
+            for (uint32_t a = adjacencyOffsets[c.from]; a < adjacencyOffsets[c.from + 1] && !flips; a++) {
+                const uint32_t* tri = &result[adjacency[a] * 3];
+                uint32_t p[3] = { posOf[tri[0]], posOf[tri[1]], posOf[tri[2]] };
+                if (p[0] == c.to || p[1] == c.to || p[2] == c.to) {
+                    degenerate++;
+                    continue;
+                }
+                glm::vec3 before = glm::cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+                for (uint32_t& q : p) {
+                    if (q == c.from) {
+                        q = c.to;
+                    }
+                }
+                glm::vec3 after = glm::cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+                flips = glm::dot(before, after) <= 0.0f;
+            }
+            if (flips) {
+                continue;
+            }
+
+            collapseTo[c.from] = c.to;
+            quadrics[c.to].add(quadrics[c.from]);
+            // Nachbarschaft sperren, damit die Adjazenz für diesen Durchgang gültig bleibt
+            for (uint32_t a = adjacencyOffsets[c.from]; a < adjacencyOffsets[c.from + 1]; a++) {
+                const uint32_t* tri = &result[adjacency[a] * 3];
+                for (int k = 0; k < 3; k++) {
+                    locked[posOf[tri[k]]] = 1;
+                }
+            }
+            locked[c.to] = 1;
+            maxError = std::max(maxError, c.error);
+            removedTriangles += degenerate;
+            applied++;
+        }
+        if (applied == 0) {
+            break;
+        }
+
+        // Vertices der kollabierten Positionen auf Vertices der Zielposition umhängen:
+        // bevorzugt der Nachbar über die kollabierte Kante, sonst der mit den ähnlichsten Attributen
+        for (size_t v = 0; v < vertices.size(); v++) {
+            vertexRemap[v] = static_cast<uint32_t>(v);
+        }
+        for (size_t t = 0; t < triangleCount; t++) {
+            const uint32_t* tri = &result[t * 3];
+            for (int k = 0; k < 3; k++) {
+                uint32_t from = posOf[tri[k]];
+                if (collapseTo[from] == from || vertexRemap[tri[k]] != tri[k]) {
+                    continue;
+                }
+                for (int j = 0; j < 3; j++) {
+                    if (posOf[tri[j]] == collapseTo[from]) {
+                        vertexRemap[tri[k]] = tri[j];
+                        break;
+                    }
+                }
+            }
+        }
+        for (size_t p = 0; p < positionCount; p++) {
+            if (collapseTo[p] == p) {
+                continue;
+            }
+            for (uint32_t v : wedges[p]) {
+                if (vertexRemap[v] != v) {
+                    continue;
+                }
+                const std::vector<uint32_t>& targets = wedges[collapseTo[p]];
+                uint32_t best = targets[0];
+                float bestDistance = attributeDistance(vertices[v], vertices[best]);
+                for (uint32_t candidate : targets) {
+                    float distance = attributeDistance(vertices[v], vertices[candidate]);
+                    if (distance < bestDistance) {
+                        best = candidate;
+                        bestDistance = distance;
+                    }
+                }
+                vertexRemap[v] = best;
+            }
+        }
+
+        // Indices umschreiben, degenerierte Dreiecke fallen weg
+        size_t write = 0;
+        for (size_t t = 0; t < triangleCount; t++) {
+            uint32_t i0 = vertexRemap[result[t * 3 + 0]];
+            uint32_t i1 = vertexRemap[result[t * 3 + 1]];
+            uint32_t i2 = vertexRemap[result[t * 3 + 2]];
+            if (posOf[i0] == posOf[i1] || posOf[i1] == posOf[i2] || posOf[i0] == posOf[i2]) {
+                continue;
+            }
+            result[write++] = i0;
+            result[write++] = i1;
+            result[write++] = i2;
+        }
+        result.resize(write);
+    }
+
+    if (resultError) {
+        *resultError = static_cast<float>(std::sqrt(maxError) / radius);
+    }
+    return result;
+}
+
+size_t MeshSimplifier::buildLods(MeshData& mesh) {
+    mesh.lods.clear();
+    if (mesh.indices.empty()) {
+        return 0;
+    }
+
+    const size_t triangleCount = mesh.indices.size() / 3;
+    std::vector<std::vector<uint32_t>> levels;
+    std::vector<float> errors;
+    levels.push_back(mesh.indices);
+    errors.push_back(0.0f);
+
+    for (float ratio : LOD_RATIOS) {
+        const std::vector<uint32_t>& previous = levels.back();
+        if (previous.size() / 3 < MIN_LOD_TRIANGLES) {
+            break;
+        }
+        const size_t target = static_cast<size_t>(static_cast<float>(triangleCount) * ratio) * 3;
+        // jede Stufe aus der vorherigen: schneller, der Fehler addiert sich dabei auf
+        float error = 0.0f;
+        std::vector<uint32_t> lod = simplify(mesh.vertices, previous, target, MAX_LOD_ERROR, &error);
+        // bringt kaum noch etwas (Fehlergrenze erreicht) -> Kette hier beenden
+        if (lod.empty() || lod.size() * 10 > previous.size() * 9) {
+            break;
+        }
+        MeshOptimizer::optimizeVertexCache(lod, mesh.vertices.size());
+        levels.push_back(std::move(lod));
+        errors.push_back(errors.back() + error);
+    }
+
+    // alle Stufen hintereinander in einen Index Buffer
+    size_t totalIndices = 0;
+    for (const auto& level : levels) {
+        totalIndices += level.size();
+    }
+    mesh.indices.clear();
+    mesh.indices.reserve(totalIndices);
+    for (size_t i = 0; i < levels.size(); i++) {
+        MeshLod lod;
+        lod.firstIndex = static_cast<uint32_t>(mesh.indices.size());
+        lod.indexCount = static_cast<uint32_t>(levels[i].size());
+        lod.error = errors[i];
+        mesh.lods.push_back(lod);
+        mesh.indices.insert(mesh.indices.end(), levels[i].begin(), levels[i].end());
+    }
+    return mesh.lods.size();
+}
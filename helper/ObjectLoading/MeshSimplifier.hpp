@@ -0,0 +1,29 @@
+// MeshSimplifier.hpp
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "loadObj.hpp"
+
+// LOD-Kette per Quadric Error Metric, alle Stufen teilen sich den Vertex Buffer
+class MeshSimplifier {
+public:
+    // Zielgrößen der Stufen 1..n relativ zu LOD 0 (LOD 0 ist immer das volle Mesh)
+    static constexpr float LOD_RATIOS[] = { 0.5f, 0.25f, 0.125f, 0.0625f };
+    // Meshes unterhalb dieser Dreiecksanzahl werden nicht weiter vereinfacht
+    static constexpr size_t MIN_LOD_TRIANGLES = 64;
+    // Maximaler Fehler einer Stufe relativ zum Radius der Bounding Sphere
+    static constexpr float MAX_LOD_ERROR = 0.1f;
+
+    // Baut die LOD-Kette: mesh.indices enthält danach alle Stufen hintereinander,
+    // mesh.lods die Ausschnitte. Gibt die Anzahl der Stufen zurück (inkl. LOD 0)
+    static size_t buildLods(MeshData& mesh);
+
+    // Vereinfacht indices auf höchstens targetIndexCount Indices, solange der Fehler
+    // (relativ zum Radius) unter targetError bleibt. resultError: tatsächlicher Fehler
+    static std::vector<uint32_t> simplify(const std::vector<Vertex>& vertices,
+                                          const std::vector<uint32_t>& indices,
+                                          size_t targetIndexCount, float targetError,
+                                          float* resultError = nullptr);
+};
@@ -0,0 +1,218 @@
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Kegel mit mehr als ~84° Öffnung kann nie komplett wegzeigen
+    constexpr float MIN_CONE_DOT = 0.1f;
+    // Gewicht der Normalen-Abweichung beim Wachsen eines Meshlets (0 = nur Abstand)
+    constexpr float CONE_WEIGHT = 16.0f;
+
+    glm::vec3 positionOf(const std::vector<Vertex>& vertices, uint32_t index) {
+        return vertices[index].pos;
+    }
+}
+
+Meshlet MeshletBuilder::computeBounds(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                      uint32_t firstIndex, uint32_t indexCount) {
+    Meshlet meshlet{};
+    meshlet.firstIndex = firstIndex;
+    meshlet.indexCount = indexCount;
+    meshlet.coneCutoff = 1.0f;
+    meshlet.coneAxis[2] = 1.0f;
+    if (indexCount == 0) {
+        return meshlet;
+    }
+
+    // Bounding Sphere um die AABB-Mitte
+    glm::vec3 boundsMin = positionOf(vertices, indices[firstIndex]);
+    glm::vec3 boundsMax = boundsMin;
+    for (uint32_t i = firstIndex; i < firstIndex + indexCount; i++) {
+        boundsMin = glm::min(boundsMin, positionOf(vertices, indices[i]));
+        boundsMax = glm::max(boundsMax, positionOf(vertices, indices[i]));
+    }
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    float radius = 0.0f;
+    for (uint32_t i = firstIndex; i < firstIndex + indexCount; i++) {
+        radius = std::max(radius, glm::length(positionOf(vertices, indices[i]) - center));
+    }
+    for (int k = 0; k < 3; k++) {
+        meshlet.center[k] = center[k];
+    }
+    meshlet.radius = radius;
+
+    // Normalen-Kegel: Achse = mittlere Normale, Öffnung = größte Abweichung davon
+    std::vector<glm::vec3> normals;
+    normals.reserve(indexCount / 3);
+    glm::vec3 axis(0.0f);
+    for (uint32_t i = firstIndex; i + 2 < firstIndex + indexCount; i += 3) {
+        glm::vec3 p0 = positionOf(vertices, indices[i]);
+        glm::vec3 n = glm::cross(positionOf(vertices, indices[i + 1]) - p0,
+                                 positionOf(vertices, indices[i + 2]) - p0);
+        float length = glm::length(n);
+        if (length <= 0.0f) {
+            continue;
+        }
+        normals.push_back(n / length);
+        axis += normals.back();
+    }
+    float axisLength = glm::length(axis);
+    if (axisLength < 1e-6f) {
+        return meshlet;
+    }
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3& n : normals) {
+        minDot = std::min(minDot, glm::dot(n, axis));
+    }
+    for (int k = 0; k < 3; k++) {
+        meshlet.coneAxis[k] = axis[k];
+    }
+    meshlet.coneCutoff = minDot <= MIN_CONE_DOT ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+    return meshlet;
+}
+
+size_t MeshletBuilder::build(MeshData& mesh) {
+    mesh.meshlets.clear();
+    const size_t triangleCount = mesh.indices.size() / 3;
+    const size_t vertexCount = mesh.vertices.size();
+    if (triangleCount == 0 || vertexCount == 0) {
+        return 0;
+    }
+
+    // Dreiecke je Vertex (CSR) und Schwerpunkte
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t index : mesh.indices) {
+        offsets[index + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<uint32_t> adjacency(mesh.indices.size());
+    std::vector<glm::vec3> centroids(triangleCount);
+    std::vector<glm::vec3> normals(triangleCount);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; t++) {
+            const uint32_t* tri = &mesh.indices[t * 3];
+            for (int k = 0; k < 3; k++) {
+                adjacency[fill[tri[k]]++] = static_cast<uint32_t>(t);
+            }
+            const glm::vec3& p0 = mesh.vertices[tri[0]].pos;
+            centroids[t] = (p0 + mesh.vertices[tri[1]].pos + mesh.vertices[tri[2]].pos) / 3.0f;
+            glm::vec3 n = glm::cross(mesh.vertices[tri[1]].pos - p0, mesh.vertices[tri[2]].pos - p0);
+            float length = glm::length(n);
+            normals[t] = length > 0.0f ? n / length : glm::vec3(0.0f);
+        }
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    // Meshlet, in dem der Vertex zuletzt gelandet ist
+    std::vector<uint32_t> vertexMeshlet(vertexCount, std::numeric_limits<uint32_t>::max());
+    std::vector<uint32_t> meshletVertices;
+    meshletVertices.reserve(MAX_VERTICES);
+    glm::vec3 vertexSum(0.0f);
+    glm::vec3 normalSum(0.0f);
+    uint32_t meshletId = 0;
+    uint32_t meshletTriangles = 0;
+    uint32_t meshletStart = 0;
+
+    std::vector<uint32_t> out;
+    out.reserve(mesh.indices.size());
+
+    auto newVertices = [&](size_t t) {
+        uint32_t count = 0;
+        for (int k = 0; k < 3; k++) {
+            if (vertexMeshlet[mesh.indices[t * 3 + k]] != meshletId) {
+                count++;
+            }
+        }
+        return count;
+    };
+
+    auto finish = [&]() {
+        if (meshletTriangles == 0) {
+            return;
+        }
+        mesh.meshlets.push_back(computeBounds(mesh.vertices, out, meshletStart,
+                                              static_cast<uint32_t>(out.size()) - meshletStart));
+        meshletId++;
+        meshletTriangles = 0;
+        meshletStart = static_cast<uint32_t>(out.size());
+        meshletVertices.clear();
+        vertexSum = glm::vec3(0.0f);
+        normalSum = glm::vec3(0.0f);
+    };
+
+    size_t emittedCount = 0;
+    size_t scan = 0;
+    while (emittedCount < triangleCount) {
+        // Nachbar-Dreieck mit den wenigsten neuen Vertices, bei Gleichstand das mit
+        // dem besten Score aus Abstand zur Mitte und Abweichung von der mittleren Normale
+        int64_t best = -1;
+        uint32_t bestNew = 4;
+        float bestScore = std::numeric_limits<float>::max();
+        if (!meshletVertices.empty()) {
+            glm::vec3 center = vertexSum / static_cast<float>(meshletVertices.size());
+            float axisLength = glm::length(normalSum);
+            glm::vec3 axis = axisLength > 0.0f ? normalSum / axisLength : glm::vec3(0.0f);
+            for (uint32_t v : meshletVertices) {
+                for (uint32_t a = offsets[v]; a < offsets[v + 1]; a++) {
+                    uint32_t t = adjacency[a];
+                    if (emitted[t]) {
+                        continue;
+                    }
+                    uint32_t added = newVertices(t);
+                    if (meshletVertices.size() + added > MAX_VERTICES) {
+                        continue;
+                    }
+                    glm::vec3 d = centroids[t] - center;
+                    float score = std::sqrt(glm::dot(d, d))
+                                * (1.0f + CONE_WEIGHT * (1.0f - glm::dot(normals[t], axis)));
+                    if (added < bestNew || (added == bestNew && score < bestScore)) {
+                        best = t;
+                        bestNew = added;
+                        bestScore = score;
+                    }
+                }
+            }
+        }
+
+        if (best < 0) {
+            // keine passenden Nachbarn mehr: neues Meshlet am nächsten freien Dreieck
+            if (meshletTriangles > 0) {
+                finish();
+                continue;
+            }
+            while (emitted[scan]) {
+                scan++;
+            }
+            best = static_cast<int64_t>(scan);
+        }
+
+        const uint32_t* tri = &mesh.indices[static_cast<size_t>(best) * 3];
+        for (int k = 0; k < 3; k++) {
+            if (vertexMeshlet[tri[k]] != meshletId) {
+                vertexMeshlet[tri[k]] = meshletId;
+                meshletVertices.push_back(tri[k]);
+                vertexSum += mesh.vertices[tri[k]].pos;
+            }
+            out.push_back(tri[k]);
+        }
+        normalSum += normals[static_cast<size_t>(best)];
+        emitted[static_cast<size_t>(best)] = 1;
+        emittedCount++;
+        meshletTriangles++;
+
+        if (meshletTriangles == MAX_TRIANGLES) {
+            finish();
+        }
+    }
+    finish();
+
+    mesh.indices = std::move(out);
+    return mesh.meshlets.size();
+}
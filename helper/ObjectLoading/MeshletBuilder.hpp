@@ -0,0 +1,24 @@
+// MeshletBuilder.hpp
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "loadObj.hpp"
+
+// Zerlegt große Meshes in Meshlets mit Bounding Sphere und Normalen-Kegel
+class MeshletBuilder {
+public:
+    static constexpr uint32_t MAX_VERTICES = 64;
+    static constexpr uint32_t MAX_TRIANGLES = 124;
+    // kleinere Meshes werden nicht zerlegt, da lohnt der Compute-Dispatch nicht
+    static constexpr size_t MIN_TRIANGLES = 20000;
+
+    // Sortiert die Dreiecke von mesh.indices (muss noch genau LOD 0 sein) nach Meshlets
+    // um und füllt mesh.meshlets. Gibt die Anzahl der Meshlets zurück
+    static size_t build(MeshData& mesh);
+
+    // Bounding Sphere + Normalen-Kegel für die Dreiecke [firstIndex, firstIndex + indexCount)
+    static Meshlet computeBounds(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                                 uint32_t firstIndex, uint32_t indexCount);
+};
@@ -0,0 +1,83 @@
+#include "SceneLoader.hpp"
+
+size_t SceneLoader::addObject(AssetHandle<RenderObject> handle, const glm::mat4& model, ObjectKind kind) {
+    size_t index = _scene->setPendingRenderObject(RenderObject{}, kind);
+
+    PendingAsset asset;
+    asset.ready = [handle]() { return handle.ready(); };
+    asset.resolve = [this, handle, index, model]() mutable {
+        _scene->resolveObject(index, handle.get(), model);
+        notifyReady(index);
+    };
+    _pending.push_back(std::move(asset));
+    return index;
+}
+
+size_t SceneLoader::addDeferredObject(AssetHandle<DeferredRenderObject> handle, const glm::mat4& model) {
+    DeferredRenderObject placeholder{};
+    size_t infoIndex = _scene->setPendingDeferredObject(placeholder);
+
+    PendingAsset asset;
+    asset.ready = [handle]() { return handle.ready(); };
+    asset.resolve = [this, handle, infoIndex, model]() mutable {
+        DeferredRenderObject obj = handle.get();
+        _scene->resolveDeferredObject(infoIndex, obj, model);
+        const DeferredObjectInfo& info = _scene->getDeferredInfo(infoIndex);
+        notifyReady(info.depthPassIndex);
+        notifyReady(info.gbufferPassIndex);
+    };
+    _pending.push_back(std::move(asset));
+    return _scene->getDeferredInfo(infoIndex).gbufferPassIndex;
+}
+
+size_t SceneLoader::addLightSource(AssetHandle<LightSourceObject> handle) {
+    size_t index = _scene->setPendingRenderObject(RenderObject{});
+
+    PendingAsset asset;
+    asset.ready = [handle]() { return handle.ready(); };
+    asset.resolve = [this, handle, index]() mutable {
+        LightSourceObject light = handle.get();
+        _scene->addLightSource(light);
+        _scene->resolveObject(index, light.renderObject, light.markerMatrix());
+        notifyReady(index);
+    };
+    _pending.push_back(std::move(asset));
+    return index;
+}
+
+size_t SceneLoader::poll() {
+    if (_pending.empty()) {
+        return 0;
+    }
+    _factory->processUploads(false, UPLOADS_PER_FRAME);
+    return resolveReady();
+}
+
+void SceneLoader::finish() {
+    while (!_pending.empty()) {
+        if (resolveReady() == 0) {
+            _factory->processUploads(true);
+        }
+    }
+}
+
+size_t SceneLoader::resolveReady() {
+    size_t resolved = 0;
+    for (auto it = _pending.begin(); it != _pending.end();) {
+        if (it->ready()) {
+            PendingAsset asset = std::move(*it);
+            it = _pending.erase(it);
+            asset.resolve();
+            resolved++;
+        } else {
+            ++it;
+        }
+    }
+    return resolved;
+}
+
+void SceneLoader::notifyReady(size_t index) {
+    if (_onReady) {
+        _onReady(index);
+    }
+}
@@ -0,0 +1,54 @@
+// SceneLoader.hpp
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "../../ObjectFactory.hpp"
+#include "../../Scene.hpp"
+
+// Progressives Laden: Platzhalter in der Scene, ersetzt sobald das Asset fertig ist
+class SceneLoader {
+public:
+    // GPU-Jobs (Uploads, Pipelines) pro poll()
+    static constexpr size_t UPLOADS_PER_FRAME = 2;
+
+    SceneLoader(ObjectFactory* factory, Scene* scene)
+        : _factory(factory), _scene(scene) {}
+
+    // Rückgabe jeweils: Index des (späteren) Objekts in der Scene, model: seine Startposition,
+    // kind: Normal, Snow oder Lit
+    size_t addObject(AssetHandle<RenderObject> handle, const glm::mat4& model = glm::mat4(1.0f),
+                     ObjectKind kind = ObjectKind::Normal);
+    // Index des G-Buffer-Objekts (wie bisher getObjectCount() - 1 nach setDeferredRenderObject)
+    size_t addDeferredObject(AssetHandle<DeferredRenderObject> handle, const glm::mat4& model);
+    // Das Licht selbst kommt erst mit dem fertigen Objekt in die Scene
+    size_t addLightSource(AssetHandle<LightSourceObject> handle);
+
+    // Wird für jedes fertig gewordene Objekt mit seinem Scene-Index aufgerufen
+    // (bei Deferred-Objekten für beide Passes)
+    void setReadyCallback(std::function<void(size_t)> callback) { _onReady = std::move(callback); }
+
+    // Nicht blockierend: führt bis zu UPLOADS_PER_FRAME GPU-Jobs aus und übernimmt
+    // alle fertigen Objekte in die Scene. Rückgabe: Anzahl übernommener Objekte
+    size_t poll();
+    // Blockiert, bis alle Objekte in der Scene sind (alter Lademodus)
+    void finish();
+
+    bool isDone() const { return _pending.empty(); }
+    size_t getPendingCount() const { return _pending.size(); }
+
+private:
+    struct PendingAsset {
+        std::function<bool()> ready;
+        std::function<void()> resolve;
+    };
+
+    size_t resolveReady();
+    void notifyReady(size_t index);
+
+    ObjectFactory* _factory;
+    Scene* _scene;
+    std::vector<PendingAsset> _pending;
+    std::function<void(size_t)> _onReady;
+};
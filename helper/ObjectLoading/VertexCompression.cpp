@@ -0,0 +1,145 @@
+#include "VertexCompression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+uint32_t VertexCompression::strideOf(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::COMPACT:           return sizeof(CompactVertex);
+    case VertexFormat::COMPACT_QUANTIZED: return sizeof(QuantizedVertex);
+    case VertexFormat::FULL:
+    default:                              return sizeof(Vertex);
+    }
+}
+
+const char* VertexCompression::nameOf(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::COMPACT:           return "compact";
+    case VertexFormat::COMPACT_QUANTIZED: return "quantized";
+    case VertexFormat::FULL:
+    default:                              return "full";
+    }
+}
+
+glm::vec2 VertexCompression::octEncode(const glm::vec3& normal) {
+    float sum = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (sum <= 0.0f) {
+        return glm::vec2(0.0f);     // OBJ ohne Normalen -> dekodiert zu (0,0,1)
+    }
+    glm::vec3 n = normal / sum;
+    if (n.z < 0.0f) {
+        // untere Hälfte nach außen klappen
+        float x = (1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+        float y = (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+        return glm::vec2(x, y);
+    }
+    return glm::vec2(n.x, n.y);
+}
+
+glm::vec3 VertexCompression::octDecode(const glm::vec2& encoded) {
+    // gleiche Rechnung wie octDecode() in vertex_decode.glsl
+    glm::vec3 n(encoded.x, encoded.y, 1.0f - std::fabs(encoded.x) - std::fabs(encoded.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+int16_t VertexCompression::toSnorm16(float value) {
+    float clamped = std::min(std::max(value, -1.0f), 1.0f);
+    return static_cast<int16_t>(std::lround(clamped * 32767.0f));
+}
+
+uint16_t VertexCompression::toHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (((bits >> 23) & 0xFFu) == 0xFFu) {
+        // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u);          // zu groß -> Inf
+    }
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return static_cast<uint16_t>(sign);                 // zu klein -> 0
+        }
+        // denormalisiert
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFFu;
+    // round to nearest even; Überlauf in den Exponenten ist dabei gewollt
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) {
+        half++;
+    }
+    return static_cast<uint16_t>(half);
+}
+
+std::vector<uint8_t> VertexCompression::encode(const Vertex* vertices, size_t vertexCount, VertexFormat format,
+                                               const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                                               VertexQuantization& quant) {
+    quant = VertexQuantization{};
+    std::vector<uint8_t> out(vertexCount * strideOf(format));
+
+    if (format == VertexFormat::FULL) {
+        std::memcpy(out.data(), vertices, out.size());
+        return out;
+    }
+
+    // w = 1: Shader dekodiert die Normale aus der Oktaeder-Darstellung
+    quant.posScale.w = 1.0f;
+
+    if (format == VertexFormat::COMPACT) {
+        CompactVertex* dst = reinterpret_cast<CompactVertex*>(out.data());
+        for (size_t i = 0; i < vertexCount; i++) {
+            const Vertex& v = vertices[i];
+            glm::vec2 oct = octEncode(v.normal);
+            dst[i].pos[0] = v.pos.x;
+            dst[i].pos[1] = v.pos.y;
+            dst[i].pos[2] = v.pos.z;
+            dst[i].normal[0] = toSnorm16(oct.x);
+            dst[i].normal[1] = toSnorm16(oct.y);
+            dst[i].tex[0] = toHalf(v.tex.x);
+            dst[i].tex[1] = toHalf(v.tex.y);
+        }
+        return out;
+    }
+
+    // COMPACT_QUANTIZED: Position = snorm * halbe Ausdehnung + Mittelpunkt
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    glm::vec3 halfExtent = glm::max((boundsMax - boundsMin) * 0.5f, glm::vec3(1e-6f));
+    quant.posScale = glm::vec4(halfExtent, 1.0f);
+    quant.posOffset = glm::vec4(center, 0.0f);
+
+    QuantizedVertex* dst = reinterpret_cast<QuantizedVertex*>(out.data());
+    for (size_t i = 0; i < vertexCount; i++) {
+        const Vertex& v = vertices[i];
+        glm::vec3 local = (v.pos - center) / halfExtent;
+        glm::vec2 oct = octEncode(v.normal);
+        dst[i].pos[0] = toSnorm16(local.x);
+        dst[i].pos[1] = toSnorm16(local.y);
+        dst[i].pos[2] = toSnorm16(local.z);
+        dst[i].pos[3] = 0;
+        dst[i].normal[0] = toSnorm16(oct.x);
+        dst[i].normal[1] = toSnorm16(oct.y);
+        dst[i].tex[0] = toHalf(v.tex.x);
+        dst[i].tex[1] = toHalf(v.tex.y);
+    }
+    return out;
+}
@@ -0,0 +1,33 @@
+// VertexCompression.hpp
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "../Rendering/GraphicsPipeline.hpp"
+
+// Parameter zum Dekodieren, landen in den Push Constants (MeshPushConstants)
+struct VertexQuantization {
+    glm::vec4 posScale = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+    glm::vec4 posOffset = glm::vec4(0.0f);
+};
+
+// Wandelt volle Vertices in CompactVertex/QuantizedVertex um (Dekodieren in vertex_decode.glsl)
+class VertexCompression {
+public:
+    static uint32_t strideOf(VertexFormat format);
+    static const char* nameOf(VertexFormat format);
+
+    // Kodiert vertexCount Vertices in format. Bounds werden für die
+    // Positions-Quantisierung gebraucht; quant bekommt die Dekodier-Parameter
+    static std::vector<uint8_t> encode(const Vertex* vertices, size_t vertexCount, VertexFormat format,
+                                       const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                                       VertexQuantization& quant);
+
+    // Einzelne Kodierungen (auch für Tests/Debug-Ausgaben)
+    static glm::vec2 octEncode(const glm::vec3& normal);
+    static glm::vec3 octDecode(const glm::vec2& encoded);
+    static int16_t toSnorm16(float value);
+    static uint16_t toHalf(float value);
+};
@@ -2,10 +2,65 @@
 #include "tiny_obj_loader.h"
 
 #include "loadObj.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "MeshletBuilder.hpp"
+#include "FastObjParser.hpp"
 #include <iostream>
+#include <unordered_map>
+#include <cstring>
+#include <functional>
+#include <chrono>
+
+namespace {
+    // Hash über alle 8 Floats eines Vertex (bitweise, passend zu operator==)
+    struct VertexHash {
+        size_t operator()(const Vertex& v) const {
+            const float values[8] = { v.pos.x, v.pos.y, v.pos.z,
+                                      v.normal.x, v.normal.y, v.normal.z,
+                                      v.tex.x, v.tex.y };
+            size_t seed = 0;
+            for (float f : values) {
+                uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                seed ^= std::hash<uint32_t>()(bits) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+}
+
+void LoadObj::indexVertices(const std::vector<Vertex>& unrolled, MeshData& outMesh) {
+    outMesh.vertices.clear();
+    outMesh.indices.clear();
+    outMesh.indices.reserve(unrolled.size());
+
+    std::unordered_map<Vertex, uint32_t, VertexHash> uniqueVertices;
+    uniqueVertices.reserve(unrolled.size());
+
+    for (const Vertex& vertex : unrolled) {
+        auto it = uniqueVertices.find(vertex);
+        if (it == uniqueVertices.end()) {
+            uint32_t index = static_cast<uint32_t>(outMesh.vertices.size());
+            uniqueVertices.emplace(vertex, index);
+            outMesh.vertices.push_back(vertex);
+            outMesh.indices.push_back(index);
+        } else {
+            outMesh.indices.push_back(it->second);
+        }
+    }
+
+    if (!outMesh.vertices.empty()) {
+        outMesh.boundsMin = outMesh.boundsMax = outMesh.vertices[0].pos;
+        for (const Vertex& vertex : outMesh.vertices) {
+            outMesh.boundsMin = glm::min(outMesh.boundsMin, vertex.pos);
+            outMesh.boundsMax = glm::max(outMesh.boundsMax, vertex.pos);
+        }
+    }
+}
 
 //Konfiguriert den tinyObjLoader
-bool LoadObj::objLoader(const std::string& filename, std::vector<Vertex>& outVertices) {
+bool LoadObj::tinyObjParse(const std::string& filename, MeshData& outMesh, size_t* cornerCount) {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
@@ -28,6 +83,8 @@ bool LoadObj::objLoader(const std::string& filename, std::vector<Vertex>& outVer
     if (!ret) 
         return false;
 
+    std::vector<Vertex> unrolled;
+
     //alle Shapes
     for (const auto& shape : shapes) 
     {
@@ -61,9 +118,62 @@ bool LoadObj::objLoader(const std::string& filename, std::vector<Vertex>& outVer
                     1.0f - attrib.texcoords[2 * index.texcoord_index + 1] // Flip Y
                 };
             }
-            outVertices.push_back(vertex);
+            unrolled.push_back(vertex);
         }
     }
-    std::cout << "OBJ geladen: " << filename <<" :)"<< "\n";
+
+    //gleiche Ecken zusammenfassen
+    indexVertices(unrolled, outMesh);
+    if (cornerCount) {
+        *cornerCount = unrolled.size();
+    }
+    return true;
+}
+
+bool LoadObj::objLoader(const std::string& filename, MeshData& outMesh) {
+    FastObjParser::Stats stats;
+    size_t cornerCount = 0;
+    if (FastObjParser::parse(filename, outMesh, &stats)) {
+        cornerCount = stats.corners;
+    } else {
+        std::cerr << "[LoadObj] FastObjParser fehlgeschlagen, versuche tinyobj: " << filename << "\n";
+        auto start = std::chrono::high_resolution_clock::now();
+        if (!tinyObjParse(filename, outMesh, &cornerCount)) {
+            return false;
+        }
+        stats.parseMs = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    float reduction = cornerCount == 0 ? 0.0f
+        : 100.0f * (1.0f - static_cast<float>(outMesh.vertices.size()) / static_cast<float>(cornerCount));
+    std::cout << "OBJ geladen: " << filename << " (" << cornerCount << " -> "
+              << outMesh.vertices.size() << " Vertices, -" << reduction << "%, "
+              << stats.parseMs << " ms) :)" << "\n";
+
+    //Dreiecke/Vertices für Vertex Cache, Overdraw und Vertex Fetch umsortieren
+    MeshOptimizer::Report report = MeshOptimizer::optimize(outMesh);
+    std::cout << "  MeshOptimizer: ACMR " << report.before.acmr << " -> " << report.after.acmr
+              << ", ATVR " << report.before.atvr << " -> " << report.after.atvr
+              << " (" << report.durationMs << " ms)" << "\n";
+
+    //große Meshes in Meshlets für das Cluster-Culling zerlegen (sortiert LOD 0 um)
+    if (outMesh.indices.size() / 3 >= MeshletBuilder::MIN_TRIANGLES) {
+        size_t meshletCount = MeshletBuilder::build(outMesh);
+        std::cout << "  Meshlets: " << meshletCount;
+        if (meshletCount > 0) {
+            std::cout << " (durchschnittlich " << outMesh.indices.size() / 3 / meshletCount << " Dreiecke)";
+        }
+        std::cout << "\n";
+    }
+
+    //LOD-Kette per Quadric Error Metric, teilt sich den Vertex Buffer mit LOD 0
+    size_t fullTriangles = outMesh.indices.size() / 3;
+    MeshSimplifier::buildLods(outMesh);
+    std::cout << "  LODs:";
+    for (const MeshLod& lod : outMesh.lods) {
+        std::cout << " " << lod.indexCount / 3;
+    }
+    std::cout << " Dreiecke (von " << fullTriangles << ")" << "\n";
     return true;
 }
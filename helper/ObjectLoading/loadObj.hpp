@@ -2,11 +2,54 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include "../Rendering/GraphicsPipeline.hpp"
 
+// Eine Detailstufe: Ausschnitt aus der gemeinsamen Index-Liste
+struct MeshLod {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;         // geometrischer Fehler relativ zum Radius der Bounding Sphere
+};
+
+// Cluster aus max. 64 Vertices / 124 Dreiecken für das Culling im Compute Shader.
+// Layout = std430 struct in shaders/meshlet_cull.comp (48 Byte)
+struct Meshlet {
+    float center[3];            // Bounding Sphere im Objektraum
+    float radius;
+    float coneAxis[3];          // mittlere Dreiecksnormale
+    float coneCutoff;           // sin des Öffnungswinkels, 1 = nie per Backface wegcullen
+    uint32_t firstIndex;        // Dreiecke liegen zusammenhängend in LOD 0
+    uint32_t indexCount;
+    uint32_t padding[2];
+};
+
+// Indizierte Geometrie: jeder Vertex kommt nur einmal vor, die Dreiecke
+// referenzieren ihn über die Index-Liste
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    // Achsenparallele Bounding Box über alle Positionen
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+    // LOD-Kette (LOD 0 = volles Mesh), alle Stufen liegen hintereinander in indices.
+    // Leer = nur eine Stufe über alle Indices
+    std::vector<MeshLod> lods;
+    // Meshlets über LOD 0, nur bei großen Meshes (siehe MeshletBuilder)
+    std::vector<Meshlet> meshlets;
+};
+
 // Führt das Laden eines OBJ-Files aus
 class LoadObj {
 public:
-    bool objLoader(const std::string& filename, std::vector<Vertex>& outVertices);
+    // Parst per FastObjParser (tinyobj nur noch als Rückfallebene) und optimiert das Mesh
+    bool objLoader(const std::string& filename, MeshData& outMesh);
+
+    // Alter Pfad: tinyobj + indexVertices, ohne Nachbearbeitung (für Vergleich/Fallback)
+    static bool tinyObjParse(const std::string& filename, MeshData& outMesh, size_t* cornerCount = nullptr);
+
+    // Dedupliziert eine "ausgerollte" Vertex-Liste (ein Vertex pro Dreiecksecke)
+    // per Hash zu Vertex- + Index-Buffer
+    static void indexVertices(const std::vector<Vertex>& unrolled, MeshData& outMesh);
 };
@@ -53,24 +53,12 @@ void DepthBuffer::createDepthImage(VkExtent2D extent)
         throw std::runtime_error("Failed to create depth image!");
     }
 
-    VkMemoryRequirements memReq{};
-    vkGetImageMemoryRequirements(_device, _depthImage, &memReq);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memReq.size;
-    //MemoryType finden
-    InitBuffer initB;
-    allocInfo.memoryTypeIndex =
-        initB.findMemoryType(memReq.memoryTypeBits,
-                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                       _physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_depthImageMemory) != VK_SUCCESS) {
+    try {
+        _depthImageMemory = MemoryAllocator::of(_device).allocateImage(_depthImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                      MemoryCategory::Depth);
+    } catch (const std::exception&) {
         throw std::runtime_error("Failed to allocate depth image memory!");
     }
-
-    vkBindImageMemory(_device, _depthImage, _depthImageMemory, 0);
 }
 
 void DepthBuffer::createDepthImageView()
@@ -100,6 +88,24 @@ void DepthBuffer::createDepthImageView()
     }
 }
 
+void DepthBuffer::recreate(VkExtent2D extent, DeletionQueue& retired) {
+    VkDevice device = _device;
+    VkImageView view = _depthImageView;
+    VkImage image = _depthImage;
+    MemoryAllocation memory = _depthImageMemory;
+    retired.push([device, view, image, memory]() mutable {
+        vkDestroyImageView(device, view, nullptr);
+        vkDestroyImage(device, image, nullptr);
+        MemoryAllocator::of(device).free(memory);
+    });
+    _depthImageView = VK_NULL_HANDLE;
+    _depthImage = VK_NULL_HANDLE;
+    _depthImageMemory = MemoryAllocation{};
+
+    createDepthImage(extent);
+    createDepthImageView();
+}
+
 // depth buffer resources zerstören
 void DepthBuffer::cleanupDepthRessources()
 {
@@ -113,8 +119,7 @@ void DepthBuffer::cleanupDepthRessources()
         _depthImage = VK_NULL_HANDLE;
     }
 
-    if (_depthImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _depthImageMemory, nullptr);
-        _depthImageMemory = VK_NULL_HANDLE;
+    if (_depthImageMemory) {
+        MemoryAllocator::of(_device).free(_depthImageMemory);
     }
 }
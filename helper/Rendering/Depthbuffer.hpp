@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vulkan/vulkan_core.h>
+#include "../MemoryAllocator.hpp"
+#include "../DeletionQueue.hpp"
 
 class DepthBuffer {
 public:
@@ -23,11 +25,9 @@ public:
         return _depthImageView;
     }
 
-    void recreate(VkExtent2D extent) {
-        cleanupDepthRessources();
-        createDepthImage(extent);
-        createDepthImageView();
-    }
+    // neues Depth Image in extent, das alte wird über retired zerstört,
+    // sobald kein Frame in Flight es mehr benutzt
+    void recreate(VkExtent2D extent, DeletionQueue& retired);
 
 private:
     VkPhysicalDevice _physicalDevice = VK_NULL_HANDLE;
@@ -35,7 +35,7 @@ private:
         
     VkFormat _depthImageFormat = VK_FORMAT_UNDEFINED;
     VkImage _depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory _depthImageMemory = VK_NULL_HANDLE;
+    MemoryAllocation _depthImageMemory;
     VkImageView _depthImageView = VK_NULL_HANDLE;
 
 
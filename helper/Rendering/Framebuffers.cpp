@@ -19,7 +19,7 @@
 
     // Helper zum Erstellen eines G-Buffers
     void Framebuffers::createSingleGBuffer(VkExtent2D extent, VkFormat format,
-                            VkImage& image, VkDeviceMemory& memory, VkImageView& view) {
+                            VkImage& image, MemoryAllocation& memory, VkImageView& view) {
         VkImageCreateInfo imageInfo{};
         imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -39,23 +39,13 @@
             throw std::runtime_error("Failed to create G-Buffer image!");
         }
 
-        VkMemoryRequirements memRequirements;
-        vkGetImageMemoryRequirements(_device, image, &memRequirements);
-        
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(
-            memRequirements.memoryTypeBits,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-        );
-
-        if (vkAllocateMemory(_device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+        try {
+            memory = MemoryAllocator::of(_device).allocateImage(image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                MemoryCategory::GBuffer);
+        } catch (const std::exception&) {
             throw std::runtime_error("Failed to allocate G-Buffer memory!");
         }
 
-        vkBindImageMemory(_device, image, memory, 0);
-
         VkImageViewCreateInfo viewInfo{};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         viewInfo.image = image;
@@ -82,9 +72,8 @@ void Framebuffers::cleanupGBufferResources() {
         vkDestroyImage(_device, _gBufferNormalImage, nullptr);
         _gBufferNormalImage = VK_NULL_HANDLE;
     }
-    if (_gBufferNormalMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _gBufferNormalMemory, nullptr);
-        _gBufferNormalMemory = VK_NULL_HANDLE;
+    if (_gBufferNormalMemory) {
+        MemoryAllocator::of(_device).free(_gBufferNormalMemory);
     }
      //Albedo G-Buffer
     if (_gBufferAlbedoView != VK_NULL_HANDLE) {
@@ -95,13 +84,43 @@ void Framebuffers::cleanupGBufferResources() {
         vkDestroyImage(_device, _gBufferAlbedoImage, nullptr);
         _gBufferAlbedoImage = VK_NULL_HANDLE;
     }
-    if (_gBufferAlbedoMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _gBufferAlbedoMemory, nullptr);
-         _gBufferAlbedoMemory = VK_NULL_HANDLE;
+    if (_gBufferAlbedoMemory) {
+        MemoryAllocator::of(_device).free(_gBufferAlbedoMemory);
     }
 }
 
 
+void Framebuffers::recreate(DeletionQueue& retired) {
+    VkDevice device = _device;
+    std::vector<VkFramebuffer> oldFramebuffers = std::move(_framebuffers);
+    _framebuffers.clear();
+    std::array<VkImageView, 2> oldViews = { _gBufferNormalView, _gBufferAlbedoView };
+    std::array<VkImage, 2> oldImages = { _gBufferNormalImage, _gBufferAlbedoImage };
+    std::array<MemoryAllocation, 2> oldMemory = { _gBufferNormalMemory, _gBufferAlbedoMemory };
+    retired.push([device, oldFramebuffers, oldViews, oldImages, oldMemory]() mutable {
+        for (VkFramebuffer fb : oldFramebuffers) {
+            vkDestroyFramebuffer(device, fb, nullptr);
+        }
+        for (size_t i = 0; i < oldImages.size(); i++) {
+            vkDestroyImageView(device, oldViews[i], nullptr);
+            vkDestroyImage(device, oldImages[i], nullptr);
+            if (oldMemory[i]) {
+                MemoryAllocator::of(device).free(oldMemory[i]);
+            }
+        }
+    });
+    _gBufferNormalView = VK_NULL_HANDLE;
+    _gBufferNormalImage = VK_NULL_HANDLE;
+    _gBufferNormalMemory = MemoryAllocation{};
+    _gBufferAlbedoView = VK_NULL_HANDLE;
+    _gBufferAlbedoImage = VK_NULL_HANDLE;
+    _gBufferAlbedoMemory = MemoryAllocation{};
+
+    createGBufferResources();
+    create();
+}
+
+
 void Framebuffers::create() {
 
     const auto& swapViews = _swapChain->getImageViews();
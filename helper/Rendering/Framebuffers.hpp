@@ -6,6 +6,7 @@
 #include <array>
 #include "Swapchain.hpp"
 #include "Depthbuffer.hpp"
+#include "../DeletionQueue.hpp"
 
 class Framebuffers {
 public:
@@ -22,12 +23,9 @@ public:
         cleanupGBufferResources();
     }
 
-    void recreate() {
-        cleanup();
-        cleanupGBufferResources();
-        createGBufferResources();
-        create();
-    }
+    // G-Buffer und Framebuffers für die neue Swapchain-Größe (Swapchain und Depth Buffer
+    // müssen schon neu sein). Die alten werden über retired zerstört
+    void recreate(DeletionQueue& retired);
 
     VkFramebuffer getFramebuffer(size_t index) const {
         if (index >= _framebuffers.size()) return VK_NULL_HANDLE;
@@ -50,31 +48,19 @@ private:
     
     // G-Buffer resources
     VkImage _gBufferNormalImage = VK_NULL_HANDLE;
-    VkDeviceMemory _gBufferNormalMemory = VK_NULL_HANDLE;
+    MemoryAllocation _gBufferNormalMemory;
     VkImageView _gBufferNormalView = VK_NULL_HANDLE;
     //albedo G-Buffer
     VkImage _gBufferAlbedoImage = VK_NULL_HANDLE;
-    VkDeviceMemory _gBufferAlbedoMemory = VK_NULL_HANDLE;
+    MemoryAllocation _gBufferAlbedoMemory;
     VkImageView _gBufferAlbedoView = VK_NULL_HANDLE;
 
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-        VkPhysicalDeviceMemoryProperties memProperties;
-        vkGetPhysicalDeviceMemoryProperties(_physicalDevice, &memProperties);
-
-        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-            if ((typeFilter & (1 << i)) && 
-                (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-                return i;
-            }
-        }
-        throw std::runtime_error("Failed to find suitable memory type!");
-    }
     //ruft createSingleGBuffer() für beide GBuffers auf
     void createGBufferResources();
 
     // Helper zum Erstellen eines G-Buffers
     void createSingleGBuffer(VkExtent2D extent, VkFormat format,
-                            VkImage& image, VkDeviceMemory& memory, VkImageView& view);
+                            VkImage& image, MemoryAllocation& memory, VkImageView& view);
 
     void cleanupGBufferResources();
 
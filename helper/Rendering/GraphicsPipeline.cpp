@@ -5,6 +5,7 @@
 #include <vector>
 #include <fstream>
 #include <array>
+#include <cstddef>
 
 // Helper: SPIR-V file lesen
 static std::vector<char> readFile(const std::string& filename) {
@@ -19,6 +20,15 @@ static std::vector<char> readFile(const std::string& filename) {
     return buffer;
 }
 
+std::string bindlessShaderPath(const std::string& path) {
+    // Stage-Endung (.vert.spv / .frag.spv) bleibt hinten, damit die Makefile-Regeln passen
+    size_t stage = path.rfind('.', path.size() - std::string(".spv").size() - 1);
+    if (stage == std::string::npos) {
+        return path;
+    }
+    return path.substr(0, stage) + ".bindless" + path.substr(stage);
+}
+
 // Helper:  shader-Modul erstellen
 VkShaderModule createShaderModule(VkDevice device, const std::vector<char>& code) {
     VkShaderModuleCreateInfo info{};
@@ -41,14 +51,16 @@ void GraphicsPipeline::createPipelineLayout() {
         throw std::runtime_error("Device is NULL!");
     }
     VkPushConstantRange pushRange{};
-    pushRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushRange.stageFlags = MESH_PUSH_CONSTANT_STAGES;
     pushRange.offset = 0;
-    pushRange.size = sizeof(glm::mat4); // model matrix
+    pushRange.size = sizeof(MeshPushConstants); // model matrix + Dekodier-Parameter + Textur-Index
+
+    VkDescriptorSetLayout setLayouts[] = { _descriptorSetLayout, _textureSetLayout };
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 1;
-    pipelineLayoutInfo.pSetLayouts = &_descriptorSetLayout;
+    pipelineLayoutInfo.setLayoutCount = _textureSetLayout != VK_NULL_HANDLE ? 2 : 1;
+    pipelineLayoutInfo.pSetLayouts = setLayouts;
     pipelineLayoutInfo.pushConstantRangeCount = 1;
     pipelineLayoutInfo.pPushConstantRanges = &pushRange;
 
@@ -81,27 +93,47 @@ void GraphicsPipeline::createPipeline() {
 
     VkPipelineShaderStageCreateInfo stages[] = { vertStage, fragStage };
 
-    //Vertex Input
+    //Vertex Input - Position (0), Normale (1), UV (2) je nach VertexFormat des Meshes
     VkVertexInputBindingDescription binding{};
     binding.binding = 0;
-    binding.stride = sizeof(Vertex);
     binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
     std::array<VkVertexInputAttributeDescription, 3> attributes{};
-    attributes[0].binding = 0;
-    attributes[0].location = 0;
-    attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributes[0].offset = offsetof(Vertex, pos);
-
-    attributes[1].binding = 0;
-    attributes[1].location = 1;
-    attributes[1].format = VK_FORMAT_R32G32_SFLOAT;
-    attributes[1].offset = offsetof(Vertex, tex);
-
-    attributes[2].binding =0;
-    attributes[2].location = 2;
-    attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
-    attributes[2].offset = offsetof(Vertex, tex);
+    for (uint32_t i = 0; i < attributes.size(); i++) {
+        attributes[i].binding = 0;
+        attributes[i].location = i;
+    }
+
+    switch (_vertexFormat) {
+    case VertexFormat::COMPACT:
+        binding.stride = sizeof(CompactVertex);
+        attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributes[0].offset = offsetof(CompactVertex, pos);
+        attributes[1].format = VK_FORMAT_R16G16_SNORM;
+        attributes[1].offset = offsetof(CompactVertex, normal);
+        attributes[2].format = VK_FORMAT_R16G16_SFLOAT;
+        attributes[2].offset = offsetof(CompactVertex, tex);
+        break;
+    case VertexFormat::COMPACT_QUANTIZED:
+        binding.stride = sizeof(QuantizedVertex);
+        attributes[0].format = VK_FORMAT_R16G16B16A16_SNORM;
+        attributes[0].offset = offsetof(QuantizedVertex, pos);
+        attributes[1].format = VK_FORMAT_R16G16_SNORM;
+        attributes[1].offset = offsetof(QuantizedVertex, normal);
+        attributes[2].format = VK_FORMAT_R16G16_SFLOAT;
+        attributes[2].offset = offsetof(QuantizedVertex, tex);
+        break;
+    case VertexFormat::FULL:
+    default:
+        binding.stride = sizeof(Vertex);
+        attributes[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributes[0].offset = offsetof(Vertex, pos);
+        attributes[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributes[1].offset = offsetof(Vertex, normal);
+        attributes[2].format = VK_FORMAT_R32G32_SFLOAT;
+        attributes[2].offset = offsetof(Vertex, tex);
+        break;
+    }
 
     VkPipelineVertexInputStateCreateInfo vertexInput{};
     vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -2,13 +2,64 @@
 #include <vulkan/vulkan_core.h>
 #include <glm/glm.hpp>
 #include <string>
+#include <cstddef>
+#include <cstdint>
 
 struct Vertex {
     glm::vec3 pos;
     glm::vec3 normal;
     glm::vec2 tex;
+
+    // Wird für die Deduplizierung beim Laden gebraucht
+    bool operator==(const Vertex& other) const {
+        return pos == other.pos && normal == other.normal && tex == other.tex;
+    }
+};
+
+// Vertex-Layout im Vertex Buffer, wird pro Mesh beim Laden gewählt
+// (siehe VertexCompression). Die Shader dekodieren alle Varianten über
+// shaders/vertex_decode.glsl
+enum class VertexFormat : uint32_t {
+    FULL,               // Vertex wie oben, 32 Byte
+    COMPACT,            // float Position, Oktaeder-Normale 2x snorm16, UV 2x half -> 20 Byte
+    COMPACT_QUANTIZED   // wie COMPACT, Position 4x snorm16 relativ zur AABB -> 16 Byte
+};
+
+// Vertex für VertexFormat::COMPACT
+struct CompactVertex {
+    float pos[3];
+    int16_t normal[2];      // Oktaeder-Kodierung, snorm16
+    uint16_t tex[2];        // half float
+};
+
+// Vertex für VertexFormat::COMPACT_QUANTIZED
+struct QuantizedVertex {
+    int16_t pos[4];         // snorm16 in der AABB des Meshes, w ungenutzt (Alignment)
+    int16_t normal[2];
+    uint16_t tex[2];
+};
+
+static_assert(sizeof(Vertex) == 32, "Vertex Layout geändert - MESH_CACHE_VERSION hochzählen");
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex muss 20 Byte groß sein");
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex muss 16 Byte groß sein");
+
+// Push Constants aller Mesh-Pipelines (muss zu vertex_decode.glsl und bindless.glsl passen)
+struct MeshPushConstants {
+    glm::mat4 model;
+    glm::vec4 posScale;     // xyz: Skalierung der Position, w = 1 -> Normale oktaeder-kodiert
+    glm::vec4 posOffset;    // xyz: Verschiebung der Position
+    uint32_t textureIndex;  // Bindless-Modus: Eintrag im globalen Textur-Array (Fragment Shader)
 };
 
+static_assert(offsetof(MeshPushConstants, textureIndex) == 96, "textureIndex liegt in bindless.glsl bei Offset 96");
+
+// Alle Mesh-Pipelines teilen sich eine Push-Constant-Range, damit ihre Layouts kompatibel
+// bleiben und das globale Descriptor Set beim Pipeline-Wechsel gebunden bleibt
+constexpr VkShaderStageFlags MESH_PUSH_CONSTANT_STAGES = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+// "shaders/x.frag.spv" -> "shaders/x.bindless.frag.spv" (mit -DBINDLESS kompiliert, siehe Makefile)
+std::string bindlessShaderPath(const std::string& path);
+
 enum class PipelineType {
     STANDARD,          // Normales forward rendering
     MIRROR_MARK,       // Stencil marking pass
@@ -36,7 +87,9 @@ public:
                      VkRenderPass renderPass,
                      VkDescriptorSetLayout descriptorSetLayout,
                      PipelineType pipelineType = PipelineType::STANDARD,
-                     uint32_t subpassIndex = 0)
+                     uint32_t subpassIndex = 0,
+                     VertexFormat vertexFormat = VertexFormat::FULL,
+                     VkDescriptorSetLayout textureSetLayout = VK_NULL_HANDLE)
         : _device(device),
           _colorFormat(colorFormat),
           _depthFormat(depthFormat),
@@ -45,7 +98,9 @@ public:
           _renderPass(renderPass),
           _descriptorSetLayout(descriptorSetLayout),
           _pipelineType(pipelineType),
-          _subpassIndex(subpassIndex) {
+          _subpassIndex(subpassIndex),
+          _vertexFormat(vertexFormat),
+          _textureSetLayout(textureSetLayout) {
         createPipelineLayout();
         createPipeline();
     }
@@ -64,17 +119,21 @@ public:
     VkDevice getDevice() const { return _device; }
     VkFormat getColorFormat() const { return _colorFormat; }
     VkFormat getDepthFormat() const { return _depthFormat; }
+    VertexFormat getVertexFormat() const { return _vertexFormat; }
 
 private:
     VkDevice _device;
     VkFormat _colorFormat;
     VkFormat _depthFormat;
-    const char* _vertexShaderPath;
-    const char* _fragmentShaderPath;
+    std::string _vertexShaderPath;
+    std::string _fragmentShaderPath;
     VkRenderPass _renderPass;
     VkDescriptorSetLayout _descriptorSetLayout;
     PipelineType _pipelineType;
     uint32_t _subpassIndex;
+    VertexFormat _vertexFormat;
+    // Bindless-Modus: Textur-Array als Set 1 (VK_NULL_HANDLE = nur ein Set)
+    VkDescriptorSetLayout _textureSetLayout;
 
     VkPipelineLayout _pipelineLayout = VK_NULL_HANDLE;
     VkPipeline _graphicsPipeline = VK_NULL_HANDLE;
@@ -5,7 +5,7 @@
 #include <stdexcept>
 #include <iostream>
 
-void SwapChain::create() {
+void SwapChain::create(VkSwapchainKHR oldSwapChain) {
     //Query Surface Information
     auto formats       = _surface->queryFormats(_physicalDevice);
     auto presentModes  = _surface->queryPresentModes(_physicalDevice);
@@ -103,7 +103,7 @@ void SwapChain::create() {
     info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     info.presentMode    = selectedPresentMode;
     info.clipped        = VK_TRUE;
-    info.oldSwapchain   = VK_NULL_HANDLE;
+    info.oldSwapchain   = oldSwapChain;
 
     //SwapChain erstellen
     if (vkCreateSwapchainKHR(_device, &info, nullptr, &_swapChain) != VK_SUCCESS) {
@@ -125,6 +125,34 @@ void SwapChain::create() {
 }
 
 
+void SwapChain::recreate(DeletionQueue& retired) {
+    // alte Handles übernehmen, laufende Frames präsentieren evtl. noch in die alte Swapchain
+    VkDevice device = _device;
+    VkSwapchainKHR oldSwapChain = _swapChain;
+    std::vector<VkImageView> oldViews = std::move(_swapChainImageViews);
+    std::vector<VkSemaphore> oldSemaphores = std::move(_presentationSemaphores);
+    _swapChainImageViews.clear();
+    _presentationSemaphores.clear();
+    _swapChain = VK_NULL_HANDLE;
+    _images.clear();
+
+    retired.push([device, oldSwapChain, oldViews, oldSemaphores]() {
+        for (VkImageView view : oldViews) {
+            vkDestroyImageView(device, view, nullptr);
+        }
+        for (VkSemaphore sem : oldSemaphores) {
+            vkDestroySemaphore(device, sem, nullptr);
+        }
+        vkDestroySwapchainKHR(device, oldSwapChain, nullptr);
+    });
+
+    create(oldSwapChain);
+    createImageViews();
+    // Anzahl der Images kann sich geändert haben
+    createSemaphores();
+}
+
+
 // Destroy
 void SwapChain::cleanup() {
     if (_swapChain != VK_NULL_HANDLE) {
@@ -5,6 +5,7 @@
 #include <vulkan/vulkan_core.h>
 
 #include "Surface.hpp"
+#include "../DeletionQueue.hpp"
 
 class SwapChain {
 public:
@@ -46,12 +47,9 @@ public:
         return _extent;
     }
 
-    void recreate() {
-        cleanupImageViews();
-        cleanup();
-        create();
-        createImageViews();
-    }
+    // neue Swapchain mit der alten als oldSwapchain, ohne auf die GPU zu warten.
+    // Alte Swapchain, Image Views und Semaphoren landen in retired, bis kein Frame sie mehr benutzt
+    void recreate(DeletionQueue& retired);
 
     // acquire the next image of the swap chain
     // call vkAcquireNextImageKHR
@@ -116,8 +114,9 @@ private:
     //   - otherwise the sharing mode has to be "concurrent" and the queue
     //     queue family indices have to be set in the create info
     // - create the swap chain and save it to member variable _swapChain
+    //   (oldSwapChain: bisherige Swapchain, wird vom Treiber in die neue übergeben)
     // - get all swap chain images and save them to _images
-    void create();
+    void create(VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE);
 
     // create image views for all swapchain images
     void createImageViews();
@@ -81,6 +81,10 @@ void Window::pollEvents() {
     glfwPollEvents();
 }
 
+void Window::waitEvents() {
+    glfwWaitEvents();
+}
+
 VkSurfaceKHR Window::createSurface(VkInstance instance) {
     if (!_window) {
         throw std::runtime_error("Window is not created");
@@ -35,6 +35,9 @@ public:
 
     // poll GLFW events
     void pollEvents();
+
+    // block until at least one GLFW event arrives (e.g. while minimized)
+    void waitEvents();
     
     // create a surface for this window
     VkSurfaceKHR createSurface(VkInstance instance);
@@ -0,0 +1,302 @@
+#include "ResidencyManager.hpp"
+#include "../Scene.hpp"
+#include "renderToTexture/ReflectionProbe.hpp"
+#include "MemoryAllocator.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+ResidencyManager::ResidencyManager(VkPhysicalDevice physicalDevice, ObjectFactory& factory,
+                                   bool memoryBudget, VkDeviceSize budgetOverride)
+    : _physicalDevice(physicalDevice), _factory(factory),
+      _memoryBudget(memoryBudget), _budgetOverride(budgetOverride) {
+    queryBudget();
+}
+
+bool ResidencyManager::isVisible(const RenderObject& obj, const glm::vec4& worldBounds,
+                                 const glm::vec4 (&planes)[6]) const {
+    // Instanzen haben eigene Transformationen, ohne Bounds wissen wir nichts: immer benutzt
+    if (obj.instanceCount > 1 || worldBounds.w <= 0.0f) {
+        return true;
+    }
+    glm::vec3 center = glm::vec3(worldBounds);
+    float radius = worldBounds.w * VISIBILITY_MARGIN;
+    for (const glm::vec4& plane : planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResidencyManager::isSeenByProbe(const RenderObject& obj, const glm::vec4& worldBounds,
+                                     const ReflectionProbe& probe) {
+    if (obj.instanceCount > 1 || worldBounds.w <= 0.0f) {
+        return true;
+    }
+    float distance = glm::length(glm::vec3(worldBounds) - probe.getPosition()) - worldBounds.w * VISIBILITY_MARGIN;
+    return distance < ReflectionProbe::FAR_PLANE;
+}
+
+void ResidencyManager::markUsed(const RenderObject& obj, bool visible) {
+    if (obj.mesh) {
+        auto [it, inserted] = _meshes.try_emplace(obj.mesh.get());
+        // abgelaufener Eintrag an derselben Adresse: neu anfangen
+        if (inserted || it->second.mesh.expired()) {
+            it->second = MeshEntry{};
+            it->second.mesh = obj.mesh;
+            it->second.lastUsed = _frame;
+        }
+        if (visible) {
+            it->second.lastUsed = _frame;
+        }
+    }
+    if (obj.texture) {
+        auto [it, inserted] = _textures.try_emplace(obj.texture.get());
+        if (inserted || it->second.texture.expired()) {
+            it->second = TextureEntry{};
+            it->second.texture = obj.texture;
+            it->second.lastUsed = _frame;
+        }
+        if (visible) {
+            it->second.lastUsed = _frame;
+        }
+    }
+}
+
+void ResidencyManager::update(Scene& scene, const glm::mat4& viewProj, const ReflectionProbe* probe) {
+    _frame++;
+    MeshRegistry& registry = _factory.getMeshRegistry();
+    registry.destroyRetired();
+    while (!_pendingFree.empty() && _frame - _pendingFree.front().first > MeshRegistry::RETIRE_FRAMES) {
+        _pendingFree.pop_front();
+    }
+
+    // Frustum-Ebenen wie im MeshletCuller (Gribb/Hartmann), Normalen zeigen nach innen
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+        rows[i] = glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+    }
+    glm::vec4 planes[6] = { rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1],
+                            rows[3] - rows[1], rows[3] + rows[2], rows[3] - rows[2] };
+    for (glm::vec4& plane : planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+
+    // Letzte Benutzung: Objekte im Sichtbereich oder in Reichweite der Cubemap
+    // (Frame::renderObjectsForCubemap zeichnet alle Forward-Objekte ohne Frustum-Test)
+    bool mirrorVisible = false;
+    for (size_t i = 0; i < scene.getObjectCount(); i++) {
+        if (scene.isPending(i)) {
+            continue;
+        }
+        const RenderObject& obj = scene.getObject(i);
+        const glm::vec4& bounds = scene.getWorldBounds(i);
+        bool visible = isVisible(obj, bounds, planes);
+        if (visible && scene.isMirrorObject(i)) {
+            mirrorVisible = true;
+        }
+        if (!visible && probe && !scene.isDeferredObject(i) && !scene.isMirrorObject(i)) {
+            visible = isSeenByProbe(obj, bounds, *probe);
+        }
+        markUsed(obj, visible);
+    }
+    // Spiegelungen zeichnet Frame ohne Culling, sobald ein Spiegel im Bild ist; das gespiegelte
+    // Objekt selbst kann dabei außerhalb des Frustums liegen
+    for (size_t i = 0; i < scene.getReflectedObjectCount(); i++) {
+        const RenderObject& obj = scene.getReflectedObject(i);
+        markUsed(obj, mirrorVisible || isVisible(obj, scene.getReflectedWorldBounds(i), planes));
+    }
+    // Lichtquellen brauchen keine eigene Schleife: ihr Marker liegt als normales Objekt in der Szene
+
+    // Wieder gebraucht: Meshes nachladen, Texturen wieder streamen lassen
+    TextureStreamer* streamer = _factory.getTextureManager().getStreamer();
+    _stats.meshBytes = 0;
+    _stats.evictedMeshes = 0;
+    for (auto it = _meshes.begin(); it != _meshes.end();) {
+        MeshEntry& entry = it->second;
+        std::shared_ptr<GpuMesh> mesh = entry.mesh.lock();
+        if (!mesh) {
+            it = _meshes.erase(it);
+            continue;
+        }
+        if (entry.reload.valid() && entry.reload.ready()) {
+            AssetHandle<bool> reload = entry.reload;
+            entry.reload = {};
+            try {
+                reload.get();
+            } catch (const std::exception& e) {
+                std::cerr << "ResidencyManager: " << mesh->sourcePath << " konnte nicht nachgeladen werden: "
+                          << e.what() << std::endl;
+                entry.failed = true;
+            }
+        }
+        if (mesh->resident) {
+            // auch wenn ein neues Objekt mit gleichem Inhalt die Buffer wieder eingesetzt hat
+            if (entry.evicted) {
+                scene.refreshMesh(mesh.get());
+                entry.evicted = false;
+                _stats.meshReloads++;
+            }
+            _stats.meshBytes += mesh->byteSize;
+        } else {
+            _stats.evictedMeshes++;
+            if (entry.lastUsed == _frame && !entry.reload.valid() && !entry.failed) {
+                entry.reload = _factory.reloadMesh(mesh);
+            }
+        }
+        ++it;
+    }
+
+    _stats.textureBytes = 0;
+    _stats.suspendedTextures = 0;
+    for (auto it = _textures.begin(); it != _textures.end();) {
+        TextureEntry& entry = it->second;
+        std::shared_ptr<Texture> texture = entry.texture.lock();
+        if (!texture) {
+            it = _textures.erase(it);
+            continue;
+        }
+        if (entry.suspended && entry.lastUsed == _frame && streamer) {
+            streamer->resume(texture.get());
+            entry.suspended = false;
+        }
+        if (entry.suspended) {
+            _stats.suspendedTextures++;
+        }
+        _stats.textureBytes += texture->getByteSize();
+        ++it;
+    }
+    _stats.trackedMeshes = _meshes.size();
+    _stats.trackedTextures = _textures.size();
+
+    queryBudget();
+    if (_stats.usage > _stats.budget) {
+        // etwas Luft lassen, damit nicht jeden Frame wieder ein Objekt rausfliegt
+        evict(scene, _stats.usage - _stats.budget + _stats.budget / 20);
+    }
+}
+
+VkDeviceSize ResidencyManager::evict(Scene& scene, VkDeviceSize bytes) {
+    struct Candidate {
+        uint64_t lastUsed;
+        const GpuMesh* mesh;
+        const Texture* texture;
+    };
+    std::vector<Candidate> candidates;
+    UploadManager* uploads = _factory.getUploadManager();
+    TextureStreamer* streamer = _factory.getTextureManager().getStreamer();
+
+    for (const auto& [key, entry] : _meshes) {
+        std::shared_ptr<GpuMesh> mesh = entry.mesh.lock();
+        if (!mesh || !mesh->resident || mesh->sourcePath.empty() || entry.reload.valid()
+            || _frame - entry.lastUsed < IDLE_FRAMES) {
+            continue;
+        }
+        // Upload läuft noch
+        if (uploads && !uploads->isComplete(mesh->uploadTicket)) {
+            continue;
+        }
+        candidates.push_back({ entry.lastUsed, key, nullptr });
+    }
+    if (streamer) {
+        for (const auto& [key, entry] : _textures) {
+            if (!entry.suspended && _frame - entry.lastUsed >= IDLE_FRAMES && streamer->isTracked(key)) {
+                candidates.push_back({ entry.lastUsed, nullptr, key });
+            }
+        }
+    }
+
+    // am längsten unbenutzt zuerst
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+
+    MeshRegistry& registry = _factory.getMeshRegistry();
+    VkDeviceSize freed = 0;
+    for (const Candidate& candidate : candidates) {
+        if (freed >= bytes) {
+            break;
+        }
+        if (candidate.mesh) {
+            MeshEntry& entry = _meshes[candidate.mesh];
+            std::shared_ptr<GpuMesh> mesh = entry.mesh.lock();
+            freed += registry.evict(*mesh);
+            scene.refreshMesh(mesh.get());
+            entry.evicted = true;
+            _stats.meshEvictions++;
+        } else {
+            freed += streamer->suspend(candidate.texture);
+            _textures[candidate.texture].suspended = true;
+            _stats.textureEvictions++;
+        }
+    }
+
+    if (freed > 0) {
+        _pendingFree.emplace_back(_frame, freed);
+        _stats.evictedBytes += freed;
+    }
+    return freed;
+}
+
+void ResidencyManager::queryBudget() {
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+    budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2 props{};
+    props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    props.pNext = _memoryBudget ? &budget : nullptr;
+    vkGetPhysicalDeviceMemoryProperties2(_physicalDevice, &props);
+
+    VkDeviceSize heapSize = 0;
+    VkDeviceSize heapBudget = 0;
+    VkDeviceSize heapUsage = 0;
+    const VkPhysicalDeviceMemoryProperties& memory = props.memoryProperties;
+    for (uint32_t i = 0; i < memory.memoryHeapCount; i++) {
+        if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            heapSize += memory.memoryHeaps[i].size;
+            heapBudget += budget.heapBudget[i];
+            heapUsage += budget.heapUsage[i];
+        }
+    }
+
+    const VkDeviceSize tracked = _stats.meshBytes + _stats.textureBytes;
+    if (_memoryBudget) {
+        // Belegung des ganzen Prozesses ohne freien Platz in den Blöcken und ohne ausgelagerte,
+        // noch nicht zerstörte Buffer (die landen nach RETIRE_FRAMES im freien Platz)
+        VkDeviceSize pending = 0;
+        for (const auto& [frame, bytes] : _pendingFree) {
+            pending += bytes;
+        }
+        const VkDeviceSize unused = MemoryAllocator::of(_factory.getDevice())
+                                        .unusedBlockBytes(VK_MEMORY_HEAP_DEVICE_LOCAL_BIT);
+        _stats.budget = static_cast<VkDeviceSize>(static_cast<double>(heapBudget) * BUDGET_FRACTION);
+        _stats.usage = effectiveUsage(heapUsage, unused, pending);
+    } else {
+        // ohne Extension kennen wir nur unsere eigenen Meshes und Texturen
+        _stats.budget = static_cast<VkDeviceSize>(static_cast<double>(heapSize) * FALLBACK_FRACTION);
+        _stats.usage = tracked;
+    }
+    if (_budgetOverride > 0) {
+        _stats.budget = _budgetOverride;
+    }
+}
+
+void ResidencyManager::printStats() const {
+    std::cout << std::fixed << std::setprecision(2)
+              << "ResidencyManager: " << _stats.usage / (1024.0 * 1024.0) << " von "
+              << _stats.budget / (1024.0 * 1024.0) << " MB Budget belegt ("
+              << (_memoryBudget ? "VK_EXT_memory_budget" : "geschätzt") << "), Meshes "
+              << _stats.meshBytes / (1024.0 * 1024.0) << " MB, Texturen "
+              << _stats.textureBytes / (1024.0 * 1024.0) << " MB, "
+              << _stats.evictedMeshes << "/" << _stats.trackedMeshes << " Meshes ausgelagert, "
+              << _stats.suspendedTextures << "/" << _stats.trackedTextures << " Texturen verkleinert, "
+              << _stats.meshEvictions + _stats.textureEvictions << "x ausgelagert ("
+              << _stats.evictedBytes / (1024.0 * 1024.0) << " MB), "
+              << _stats.meshReloads << " Meshes nachgeladen"
+              << std::defaultfloat << std::endl;
+}
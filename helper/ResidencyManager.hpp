@@ -0,0 +1,106 @@
+// ResidencyManager.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+#include "../ObjectFactory.hpp"
+
+class Scene;
+class ReflectionProbe;
+
+// Verfolgt das VRAM-Budget und lagert Meshes/Texturen nach LRU aus. Nur vom Hauptthread benutzen
+class ResidencyManager {
+public:
+    // Anteil des gemeldeten Heap-Budgets, den die Anwendung nutzen soll
+    static constexpr float BUDGET_FRACTION = 0.9f;
+    // Ohne VK_EXT_memory_budget: Anteil der Heap-Größe für die verfolgten Meshes/Texturen
+    static constexpr float FALLBACK_FRACTION = 0.75f;
+    // So viele Frames nicht im Sichtbereich, dann darf ausgelagert werden
+    static constexpr uint64_t IDLE_FRAMES = 120;
+    // Bounding Spheres für die Sichtbarkeit vergrößern (rechtzeitig nachladen)
+    static constexpr float VISIBILITY_MARGIN = 1.5f;
+
+    struct Stats {
+        VkDeviceSize budget = 0;            // Gerätespeicher, den wir nutzen wollen
+        VkDeviceSize usage = 0;             // belegt (laut Extension bzw. verfolgte Bytes)
+        VkDeviceSize meshBytes = 0;         // residente Meshes
+        VkDeviceSize textureBytes = 0;      // residente Texturen
+        size_t trackedMeshes = 0;
+        size_t trackedTextures = 0;
+        size_t evictedMeshes = 0;           // gerade ausgelagert
+        size_t suspendedTextures = 0;       // gerade auf die groben Levels verkleinert
+        uint64_t meshEvictions = 0;
+        uint64_t textureEvictions = 0;
+        uint64_t meshReloads = 0;
+        VkDeviceSize evictedBytes = 0;      // insgesamt freigegeben
+    };
+
+    // memoryBudget: VK_EXT_memory_budget ist auf dem Device aktiviert
+    // budgetOverride > 0: festes Budget statt der Heap-Abfrage (zum Testen mit wenig VRAM)
+    ResidencyManager(VkPhysicalDevice physicalDevice, ObjectFactory& factory,
+                     bool memoryBudget, VkDeviceSize budgetOverride = 0);
+
+    ResidencyManager(const ResidencyManager&) = delete;
+    ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+    // Einmal pro Frame vor TextureManager::updateStreaming (die Änderungen an den Texturen
+    // trägt der Streamer in die Szene ein): Sichtbarkeit, Nachladen, Auslagern über dem Budget.
+    // probe: Objekte in ihrer Reichweite gelten als benutzt (die Cubemap zeichnet sie)
+    void update(Scene& scene, const glm::mat4& viewProj, const ReflectionProbe* probe = nullptr);
+
+    // Belegung für das Budget: heapUsage der Extension zählt ganze Blöcke des MemoryAllocators,
+    // ausgelagerte Meshes/Texturen machen darin nur Platz frei. Deshalb den freien Platz in den
+    // Blöcken und die noch nicht zerstörten ausgelagerten Buffer (pendingFree) abziehen
+    static VkDeviceSize effectiveUsage(VkDeviceSize heapUsage, VkDeviceSize unusedBlockBytes,
+                                       VkDeviceSize pendingFree) {
+        const VkDeviceSize credit = unusedBlockBytes + pendingFree;
+        return heapUsage > credit ? heapUsage - credit : 0;
+    }
+
+    bool hasMemoryBudget() const { return _memoryBudget; }
+    const Stats& getStats() const { return _stats; }
+    void printStats() const;
+
+private:
+    struct MeshEntry {
+        std::weak_ptr<GpuMesh> mesh;
+        uint64_t lastUsed = 0;
+        AssetHandle<bool> reload;           // valid() = Nachladen läuft
+        bool evicted = false;               // von uns ausgelagert, Objekte brauchen nach dem
+                                            // Nachladen wieder die Handles (Scene::refreshMesh)
+        bool failed = false;                // Nachladen fehlgeschlagen, nicht nochmal versuchen
+    };
+
+    struct TextureEntry {
+        std::weak_ptr<Texture> texture;
+        uint64_t lastUsed = 0;
+        bool suspended = false;
+    };
+
+    // Bounding Sphere von obj (worldBounds, vergrößert) schneidet das Frustum?
+    bool isVisible(const RenderObject& obj, const glm::vec4& worldBounds, const glm::vec4 (&planes)[6]) const;
+    // Bounding Sphere liegt in der Reichweite der Cubemap von probe?
+    static bool isSeenByProbe(const RenderObject& obj, const glm::vec4& worldBounds, const ReflectionProbe& probe);
+    void markUsed(const RenderObject& obj, bool visible);
+    // Budget und Belegung der DEVICE_LOCAL Heaps in _stats
+    void queryBudget();
+    // Gibt am längsten unbenutzte Meshes/Texturen frei, bis bytes erreicht sind
+    VkDeviceSize evict(Scene& scene, VkDeviceSize bytes);
+
+    VkPhysicalDevice _physicalDevice;
+    ObjectFactory& _factory;
+    bool _memoryBudget;
+    VkDeviceSize _budgetOverride;
+
+    std::unordered_map<const GpuMesh*, MeshEntry> _meshes;
+    std::unordered_map<const Texture*, TextureEntry> _textures;
+    // ausgelagert, aber noch nicht zerstört (Frames in Flight): zählt die Extension noch mit
+    std::deque<std::pair<uint64_t, VkDeviceSize>> _pendingFree;
+    uint64_t _frame = 0;
+    Stats _stats;
+};
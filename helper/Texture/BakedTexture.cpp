@@ -0,0 +1,229 @@
+#include "BakedTexture.hpp"
+#include "../ObjectLoading/MeshCache.hpp"
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+namespace {
+    const char BAKED_TEXTURE_MAGIC[4] = { 'B', 'T', 'E', 'X' };
+
+    // Level-Daten beginnen auf einer 16-Byte Grenze
+    uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    const std::array<float, 256>& srgbToLinearTable() {
+        static const std::array<float, 256> table = []() {
+            std::array<float, 256> t{};
+            for (int i = 0; i < 256; i++) {
+                float c = i / 255.0f;
+                t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    uint8_t linearToSrgb(float value) {
+        value = std::min(std::max(value, 0.0f), 1.0f);
+        float c = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        return static_cast<uint8_t>(c * 255.0f + 0.5f);
+    }
+
+    bool hashSource(const std::string& imagePath, uint64_t& size, uint64_t& hash) {
+        MappedFile source;
+        if (!source.open(imagePath)) {
+            return false;
+        }
+        size = source.size();
+        hash = MeshCache::hashBytes(source.data(), source.size());
+        return true;
+    }
+
+    // Kopf passt zur Quelle und die Levels liegen komplett in der Datei
+    bool validate(const MappedFile& file, const std::string& imagePath) {
+        if (file.size() < sizeof(BakedTextureHeader)) {
+            return false;
+        }
+        const auto* header = reinterpret_cast<const BakedTextureHeader*>(file.data());
+        if (std::memcmp(header->magic, BAKED_TEXTURE_MAGIC, sizeof(BAKED_TEXTURE_MAGIC)) != 0
+            || header->version != BakedTexture::BAKED_TEXTURE_VERSION
+            || (header->format != VK_FORMAT_R8G8B8A8_SRGB
+                && !BlockCompression::isCompressed(static_cast<VkFormat>(header->format)))
+            || header->width == 0 || header->height == 0
+            || header->mipLevels != ImageData::fullMipLevels(header->width, header->height)) {
+            return false;
+        }
+        ImageData layout;
+        layout.width = static_cast<int>(header->width);
+        layout.height = static_cast<int>(header->height);
+        layout.mipLevels = header->mipLevels;
+        layout.format = static_cast<VkFormat>(header->format);
+        if (header->dataSize != layout.byteSize() || header->dataOffset + header->dataSize > file.size()) {
+            return false;
+        }
+
+        // Quelle geändert? Nur der Inhalt zählt (mtime ändert sich z.B. schon beim Auschecken)
+        uint64_t size = 0;
+        uint64_t hash = 0;
+        return hashSource(imagePath, size, hash)
+            && size == header->sourceSize
+            && hash == header->sourceHash;
+    }
+}
+
+std::string BakedTexture::bakedPathFor(const std::string& imagePath) {
+    return imagePath + ".btex";
+}
+
+bool BakedTexture::load(const std::string& imagePath, ImageData& out) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(bakedPathFor(imagePath)) || !validate(*file, imagePath)) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const BakedTextureHeader*>(file->data());
+    out.width = static_cast<int>(header->width);
+    out.height = static_cast<int>(header->height);
+    out.mipLevels = header->mipLevels;
+    out.format = static_cast<VkFormat>(header->format);
+    out.runtimeMips = false;
+    // kein Kopieren: pixels zeigt in das Mapping und hält es am Leben
+    auto* levels = const_cast<stbi_uc*>(file->data() + header->dataOffset);
+    out.pixels = std::shared_ptr<stbi_uc>(file, levels);
+    return true;
+}
+
+bool BakedTexture::isUpToDate(const std::string& imagePath, TextureCompression compression) {
+    MappedFile file;
+    if (!file.open(bakedPathFor(imagePath)) || !validate(file, imagePath)) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const BakedTextureHeader*>(file.data());
+    return BlockCompression::matches(compression, static_cast<VkFormat>(header->format),
+                                     header->width, header->height);
+}
+
+bool BakedTexture::bake(const std::string& imagePath, TextureCompression compression, uint64_t* bakedBytes) {
+    BakedTextureHeader header{};
+    if (!hashSource(imagePath, header.sourceSize, header.sourceHash)) {
+        return false;
+    }
+    ImageData image = ImageData::decode(imagePath);
+
+    std::memcpy(header.magic, BAKED_TEXTURE_MAGIC, sizeof(BAKED_TEXTURE_MAGIC));
+    header.version = BAKED_TEXTURE_VERSION;
+    header.width = static_cast<uint32_t>(image.width);
+    header.height = static_cast<uint32_t>(image.height);
+    header.format = BlockCompression::chooseFormat(compression, image.pixels.get(), header.width, header.height);
+    std::vector<uint8_t> levels = buildMipChain(image.pixels.get(), header.width, header.height, header.mipLevels);
+    if (BlockCompression::isCompressed(static_cast<VkFormat>(header.format))) {
+        levels = compressMipChain(levels, header.width, header.height, header.mipLevels,
+                                  static_cast<VkFormat>(header.format));
+    }
+    header.dataOffset = alignUp(sizeof(BakedTextureHeader), 16);
+    header.dataSize = levels.size();
+
+    const std::string finalPath = bakedPathFor(imagePath);
+    // Eindeutiger tmp-Name wie beim MeshCache
+    const std::string tmpPath = finalPath + ".tmp" +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "BakedTexture: kann " << tmpPath << " nicht schreiben" << std::endl;
+            return false;
+        }
+        const char padding[16] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(padding, static_cast<std::streamsize>(header.dataOffset - sizeof(header)));
+        out.write(reinterpret_cast<const char*>(levels.data()), static_cast<std::streamsize>(levels.size()));
+        if (!out) {
+            std::cerr << "BakedTexture: Schreibfehler in " << tmpPath << std::endl;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    if (bakedBytes) {
+        *bakedBytes = header.dataOffset + header.dataSize;
+    }
+    return true;
+}
+
+std::vector<uint8_t> BakedTexture::buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                                 uint32_t& mipLevels, uint32_t maxLevel) {
+    ImageData layout;
+    layout.width = static_cast<int>(width);
+    layout.height = static_cast<int>(height);
+    layout.mipLevels = ImageData::fullMipLevels(layout.width, layout.height);
+    if (maxLevel < layout.mipLevels) {
+        layout.mipLevels = maxLevel + 1;
+    }
+    mipLevels = layout.mipLevels;
+
+    std::vector<uint8_t> levels(layout.byteSize());
+    std::memcpy(levels.data(), rgba, layout.levelSize(0));
+
+    const auto& toLinear = srgbToLinearTable();
+    for (uint32_t level = 1; level < mipLevels; level++) {
+        const uint8_t* src = levels.data() + layout.levelOffset(level - 1);
+        uint8_t* dst = levels.data() + layout.levelOffset(level);
+        const uint32_t srcWidth = ImageData::levelExtent(layout.width, level - 1);
+        const uint32_t srcHeight = ImageData::levelExtent(layout.height, level - 1);
+        const uint32_t dstWidth = ImageData::levelExtent(layout.width, level);
+        const uint32_t dstHeight = ImageData::levelExtent(layout.height, level);
+
+        for (uint32_t y = 0; y < dstHeight; y++) {
+            // bei ungerader Größe (oder Kante 1) den letzten Texel doppelt nehmen
+            const uint32_t y0 = std::min(y * 2, srcHeight - 1);
+            const uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+            for (uint32_t x = 0; x < dstWidth; x++) {
+                const uint32_t x0 = std::min(x * 2, srcWidth - 1);
+                const uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+                const uint8_t* texels[4] = {
+                    src + (size_t(y0) * srcWidth + x0) * 4, src + (size_t(y0) * srcWidth + x1) * 4,
+                    src + (size_t(y1) * srcWidth + x0) * 4, src + (size_t(y1) * srcWidth + x1) * 4
+                };
+                uint8_t* out = dst + (size_t(y) * dstWidth + x) * 4;
+                for (int c = 0; c < 3; c++) {
+                    float sum = toLinear[texels[0][c]] + toLinear[texels[1][c]]
+                              + toLinear[texels[2][c]] + toLinear[texels[3][c]];
+                    out[c] = linearToSrgb(sum * 0.25f);
+                }
+                out[3] = static_cast<uint8_t>((texels[0][3] + texels[1][3] + texels[2][3] + texels[3][3] + 2) / 4);
+            }
+        }
+    }
+    return levels;
+}
+
+std::vector<uint8_t> BakedTexture::compressMipChain(const std::vector<uint8_t>& rgbaLevels, uint32_t width,
+                                                    uint32_t height, uint32_t mipLevels, VkFormat format) {
+    ImageData source;
+    source.width = static_cast<int>(width);
+    source.height = static_cast<int>(height);
+    source.mipLevels = mipLevels;
+    ImageData target = source;
+    target.format = format;
+
+    std::vector<uint8_t> blocks(target.byteSize());
+    for (uint32_t level = 0; level < mipLevels; level++) {
+        BlockCompression::encodeLevel(rgbaLevels.data() + source.levelOffset(level),
+                                      ImageData::levelExtent(source.width, level),
+                                      ImageData::levelExtent(source.height, level),
+                                      format, blocks.data() + target.levelOffset(level));
+    }
+    return blocks;
+}
@@ -0,0 +1,48 @@
+// BakedTexture.hpp
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ImageData.hpp"
+
+// Dateikopf der .btex Datei. Layout-Änderungen -> BAKED_TEXTURE_VERSION hochzählen
+struct BakedTextureHeader {
+    char magic[4];              // "BTEX"
+    uint32_t version;
+    uint64_t sourceSize;        // Dateigröße der Quelle in Bytes
+    uint64_t sourceHash;        // MeshCache::hashBytes über den kompletten Inhalt der Quelle
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipLevels;
+    uint32_t format;            // VkFormat der Level-Daten: R8G8B8A8_SRGB oder BC1/BC3/BC7 (sRGB)
+    uint64_t dataOffset;        // alle Levels dicht hintereinander, Level 0 zuerst
+    uint64_t dataSize;
+};
+
+// Gebackene Texturen (.btex) mit fertiger, evtl. blockkomprimierter Mip-Kette
+class BakedTexture {
+public:
+    static constexpr uint32_t BAKED_TEXTURE_VERSION = 1;
+
+    // textures/foo.jpg -> textures/foo.jpg.btex
+    static std::string bakedPathFor(const std::string& imagePath);
+
+    // Blendet die .btex zu imagePath ein (ImageData hält das Mapping am Leben).
+    // false, wenn es keine gibt oder sie nicht mehr zum Inhalt von imagePath passt
+    static bool load(const std::string& imagePath, ImageData& out);
+    // Nur prüfen (für inkrementelles Backen); das Format muss zu compression passen
+    static bool isUpToDate(const std::string& imagePath, TextureCompression compression = TextureCompression::NONE);
+    // Dekodiert imagePath, rechnet die Mip-Kette, komprimiert sie nach Wunsch und schreibt
+    // die .btex (erst .tmp, dann rename). bakedBytes: Größe der geschriebenen Datei
+    static bool bake(const std::string& imagePath, TextureCompression compression = TextureCompression::NONE,
+                     uint64_t* bakedBytes = nullptr);
+
+    // Mip-Kette (Level 0 = rgba) bis maxLevel, sonst komplett, per 2x2 Box-Filter im linearen
+    // Farbraum, Quelle und Ergebnis sind sRGB, Alpha bleibt linear
+    static std::vector<uint8_t> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                              uint32_t& mipLevels, uint32_t maxLevel = UINT32_MAX);
+    // Kodiert jedes Level einer RGBA8-Mip-Kette einzeln in format
+    static std::vector<uint8_t> compressMipChain(const std::vector<uint8_t>& rgbaLevels, uint32_t width,
+                                                 uint32_t height, uint32_t mipLevels, VkFormat format);
+};
@@ -0,0 +1,682 @@
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    // BC7 Gewichte für 4-Bit Indizes (aus der Spezifikation)
+    const int BC7_WEIGHTS_4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct Block {
+        float px[16][4];
+    };
+
+    // 4x4 Block ab (bx, by); Randblöcke wiederholen die letzte Zeile/Spalte
+    Block fetchBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by) {
+        Block block;
+        for (uint32_t y = 0; y < 4; y++) {
+            const uint32_t sy = std::min(by * 4 + y, height - 1);
+            for (uint32_t x = 0; x < 4; x++) {
+                const uint32_t sx = std::min(bx * 4 + x, width - 1);
+                const uint8_t* texel = rgba + (size_t(sy) * width + sx) * 4;
+                for (int c = 0; c < 4; c++) {
+                    block.px[y * 4 + x][c] = texel[c];
+                }
+            }
+        }
+        return block;
+    }
+
+    void storeBlock(const uint8_t decoded[16][4], uint32_t width, uint32_t height,
+                    uint32_t bx, uint32_t by, uint8_t* rgba) {
+        for (uint32_t y = 0; y < 4 && by * 4 + y < height; y++) {
+            for (uint32_t x = 0; x < 4 && bx * 4 + x < width; x++) {
+                std::memcpy(rgba + (size_t(by * 4 + y) * width + bx * 4 + x) * 4, decoded[y * 4 + x], 4);
+            }
+        }
+    }
+
+    // Hauptachse der ersten channels Kanäle (Potenzmethode auf der Kovarianzmatrix).
+    // Liefert die Endpunkte als Extremwerte der Projektion auf die Achse
+    void fitEndpoints(const Block& block, int channels, float lo[4], float hi[4]) {
+        float mean[4] = {};
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < channels; c++) {
+                mean[c] += block.px[i][c] / 16.0f;
+            }
+        }
+        float cov[4][4] = {};
+        for (int i = 0; i < 16; i++) {
+            for (int a = 0; a < channels; a++) {
+                for (int b = 0; b < channels; b++) {
+                    cov[a][b] += (block.px[i][a] - mean[a]) * (block.px[i][b] - mean[b]);
+                }
+            }
+        }
+        float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; iteration++) {
+            float next[4] = {};
+            float length = 0.0f;
+            for (int a = 0; a < channels; a++) {
+                for (int b = 0; b < channels; b++) {
+                    next[a] += cov[a][b] * axis[b];
+                }
+                length = std::max(length, std::fabs(next[a]));
+            }
+            if (length < 1e-6f) {
+                break;                  // einfarbiger Block
+            }
+            for (int c = 0; c < channels; c++) {
+                axis[c] = next[c] / length;
+            }
+        }
+        float axisLength = 0.0f;
+        for (int c = 0; c < channels; c++) {
+            axisLength += axis[c] * axis[c];
+        }
+        float minT = 0.0f;
+        float maxT = 0.0f;
+        if (axisLength > 1e-6f) {
+            for (int i = 0; i < 16; i++) {
+                float t = 0.0f;
+                for (int c = 0; c < channels; c++) {
+                    t += (block.px[i][c] - mean[c]) * axis[c];
+                }
+                t /= axisLength;
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+        }
+        for (int c = 0; c < channels; c++) {
+            lo[c] = std::min(std::max(mean[c] + axis[c] * minT, 0.0f), 255.0f);
+            hi[c] = std::min(std::max(mean[c] + axis[c] * maxT, 0.0f), 255.0f);
+        }
+    }
+
+    // Least Squares: beste Endpunkte für feste Gewichte w (0 = lo, 1 = hi)
+    bool refineEndpoints(const Block& block, int channels, const float weights[16], float lo[4], float hi[4]) {
+        float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+        float ax[4] = {}, bx[4] = {};
+        for (int i = 0; i < 16; i++) {
+            const float b = weights[i];
+            const float a = 1.0f - b;
+            aa += a * a;
+            bb += b * b;
+            ab += a * b;
+            for (int c = 0; c < channels; c++) {
+                ax[c] += a * block.px[i][c];
+                bx[c] += b * block.px[i][c];
+            }
+        }
+        const float det = aa * bb - ab * ab;
+        if (std::fabs(det) < 1e-6f) {
+            return false;
+        }
+        for (int c = 0; c < channels; c++) {
+            lo[c] = std::min(std::max((bb * ax[c] - ab * bx[c]) / det, 0.0f), 255.0f);
+            hi[c] = std::min(std::max((aa * bx[c] - ab * ax[c]) / det, 0.0f), 255.0f);
+        }
+        return true;
+    }
+
+    float distance(const float* a, const uint8_t* b, int channels) {
+        float sum = 0.0f;
+        for (int c = 0; c < channels; c++) {
+            const float d = a[c] - b[c];
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    // ---------------- BC1 ----------------
+
+    uint16_t packColor565(const float color[4]) {
+        const uint16_t r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+        const uint16_t g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+        const uint16_t b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void unpackColor565(uint16_t packed, uint8_t color[4]) {
+        const uint8_t r = (packed >> 11) & 0x1F;
+        const uint8_t g = (packed >> 5) & 0x3F;
+        const uint8_t b = packed & 0x1F;
+        color[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+        color[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+        color[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        color[3] = 255;
+    }
+
+    // Palette wie der Dekoder sie sieht; fourColor = false: 3 Farben + schwarz/transparent
+    void bc1Palette(uint16_t c0, uint16_t c1, bool fourColor, uint8_t palette[4][4]) {
+        unpackColor565(c0, palette[0]);
+        unpackColor565(c1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            if (fourColor) {
+                palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+                palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+            } else {
+                palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+                palette[3][c] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = fourColor ? 255 : 0;
+    }
+
+    // Indizes zur Palette, Rückgabe: Fehlersumme
+    float bc1Indices(const Block& block, uint16_t c0, uint16_t c1, uint8_t indices[16]) {
+        uint8_t palette[4][4];
+        bc1Palette(c0, c1, true, palette);
+        float error = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            float best = distance(block.px[i], palette[0], 3);
+            indices[i] = 0;
+            for (uint8_t p = 1; p < 4; p++) {
+                float d = distance(block.px[i], palette[p], 3);
+                if (d < best) {
+                    best = d;
+                    indices[i] = p;
+                }
+            }
+            error += best;
+        }
+        return error;
+    }
+
+    // Immer 4-Farben-Modus (c0 > c1), damit der Block auch als Farbteil von BC3 stimmt
+    void encodeBC1Block(const Block& block, uint8_t* out) {
+        float lo[4], hi[4];
+        fitEndpoints(block, 3, lo, hi);
+        uint16_t c0 = packColor565(hi);
+        uint16_t c1 = packColor565(lo);
+        uint8_t indices[16];
+        float error = bc1Indices(block, c0, c1, indices);
+
+        // eine Least-Squares Runde mit den gefundenen Indizes
+        static const float INDEX_WEIGHT[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        float weights[16];
+        for (int i = 0; i < 16; i++) {
+            weights[i] = INDEX_WEIGHT[indices[i]];
+        }
+        if (refineEndpoints(block, 3, weights, hi, lo)) {
+            uint16_t r0 = packColor565(hi);
+            uint16_t r1 = packColor565(lo);
+            uint8_t refined[16];
+            float refinedError = bc1Indices(block, r0, r1, refined);
+            if (refinedError < error) {
+                c0 = r0;
+                c1 = r1;
+                std::memcpy(indices, refined, sizeof(indices));
+            }
+        }
+
+        if (c0 < c1) {
+            std::swap(c0, c1);
+            static const uint8_t SWAPPED[4] = { 1, 0, 3, 2 };
+            for (int i = 0; i < 16; i++) {
+                indices[i] = SWAPPED[indices[i]];
+            }
+        } else if (c0 == c1) {
+            std::memset(indices, 0, sizeof(indices));
+        }
+
+        uint32_t bits = 0;
+        for (int i = 0; i < 16; i++) {
+            bits |= uint32_t(indices[i]) << (i * 2);
+        }
+        out[0] = c0 & 0xFF;
+        out[1] = c0 >> 8;
+        out[2] = c1 & 0xFF;
+        out[3] = c1 >> 8;
+        for (int i = 0; i < 4; i++) {
+            out[4 + i] = (bits >> (i * 8)) & 0xFF;
+        }
+    }
+
+    void decodeBC1Block(const uint8_t* in, bool alwaysFourColor, uint8_t decoded[16][4]) {
+        const uint16_t c0 = uint16_t(in[0] | (in[1] << 8));
+        const uint16_t c1 = uint16_t(in[2] | (in[3] << 8));
+        uint8_t palette[4][4];
+        bc1Palette(c0, c1, alwaysFourColor || c0 > c1, palette);
+        const uint32_t bits = uint32_t(in[4]) | (uint32_t(in[5]) << 8) | (uint32_t(in[6]) << 16) | (uint32_t(in[7]) << 24);
+        for (int i = 0; i < 16; i++) {
+            std::memcpy(decoded[i], palette[(bits >> (i * 2)) & 3], 4);
+        }
+    }
+
+    // ---------------- BC3 Alpha ----------------
+
+    void alphaPalette(uint8_t a0, uint8_t a1, uint8_t palette[8]) {
+        palette[0] = a0;
+        palette[1] = a1;
+        if (a0 > a1) {
+            for (int i = 2; i < 8; i++) {
+                palette[i] = static_cast<uint8_t>(((8 - i) * a0 + (i - 1) * a1) / 7);
+            }
+        } else {
+            for (int i = 2; i < 6; i++) {
+                palette[i] = static_cast<uint8_t>(((6 - i) * a0 + (i - 1) * a1) / 5);
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    void encodeAlphaBlock(const Block& block, uint8_t* out) {
+        float minA = 255.0f;
+        float maxA = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            minA = std::min(minA, block.px[i][3]);
+            maxA = std::max(maxA, block.px[i][3]);
+        }
+        const uint8_t a0 = static_cast<uint8_t>(maxA);
+        const uint8_t a1 = static_cast<uint8_t>(minA);
+        uint8_t palette[8];
+        alphaPalette(a0, a1, palette);
+
+        uint64_t bits = 0;
+        if (a0 != a1) {
+            for (int i = 0; i < 16; i++) {
+                uint64_t best = 0;
+                float bestError = 1e9f;
+                for (int p = 0; p < 8; p++) {
+                    float d = std::fabs(block.px[i][3] - palette[p]);
+                    if (d < bestError) {
+                        bestError = d;
+                        best = p;
+                    }
+                }
+                bits |= best << (i * 3);
+            }
+        }
+        out[0] = a0;
+        out[1] = a1;
+        for (int i = 0; i < 6; i++) {
+            out[2 + i] = (bits >> (i * 8)) & 0xFF;
+        }
+    }
+
+    void decodeAlphaBlock(const uint8_t* in, uint8_t decoded[16][4]) {
+        uint8_t palette[8];
+        alphaPalette(in[0], in[1], palette);
+        uint64_t bits = 0;
+        for (int i = 0; i < 6; i++) {
+            bits |= uint64_t(in[2 + i]) << (i * 8);
+        }
+        for (int i = 0; i < 16; i++) {
+            decoded[i][3] = palette[(bits >> (i * 3)) & 7];
+        }
+    }
+
+    // ---------------- BC7 (Mode 6) ----------------
+
+    class BitWriter {
+    public:
+        explicit BitWriter(uint8_t* out) : _out(out) { std::memset(_out, 0, 16); }
+        void write(uint32_t value, int count) {
+            for (int i = 0; i < count; i++, _pos++) {
+                if (value & (1u << i)) {
+                    _out[_pos >> 3] |= uint8_t(1u << (_pos & 7));
+                }
+            }
+        }
+    private:
+        uint8_t* _out;
+        int _pos = 0;
+    };
+
+    class BitReader {
+    public:
+        explicit BitReader(const uint8_t* in) : _in(in) {}
+        uint32_t read(int count) {
+            uint32_t value = 0;
+            for (int i = 0; i < count; i++, _pos++) {
+                value |= uint32_t((_in[_pos >> 3] >> (_pos & 7)) & 1) << i;
+            }
+            return value;
+        }
+    private:
+        const uint8_t* _in;
+        int _pos = 0;
+    };
+
+    struct Mode6Endpoints {
+        uint8_t q[2][4];        // 7-Bit Werte
+        uint8_t p[2];           // p-Bit pro Endpunkt
+    };
+
+    // 8-Bit Wert eines Endpunkts: 7 Bit + p-Bit
+    uint8_t mode6Value(const Mode6Endpoints& e, int endpoint, int channel) {
+        return static_cast<uint8_t>((e.q[endpoint][channel] << 1) | e.p[endpoint]);
+    }
+
+    // Endpunkte mit festen p-Bits auf 7 Bit runden
+    Mode6Endpoints quantizeMode6(const float lo[4], const float hi[4], uint8_t p0, uint8_t p1) {
+        Mode6Endpoints e{};
+        const float* endpoints[2] = { lo, hi };
+        e.p[0] = p0;
+        e.p[1] = p1;
+        for (int ep = 0; ep < 2; ep++) {
+            for (int c = 0; c < 4; c++) {
+                long v = std::lround((endpoints[ep][c] - e.p[ep]) / 2.0f);
+                e.q[ep][c] = static_cast<uint8_t>(std::min(std::max(v, 0L), 127L));
+            }
+        }
+        return e;
+    }
+
+    void mode6Palette(const Mode6Endpoints& e, uint8_t palette[16][4]) {
+        for (int i = 0; i < 16; i++) {
+            const int w = BC7_WEIGHTS_4[i];
+            for (int c = 0; c < 4; c++) {
+                palette[i][c] = static_cast<uint8_t>(((64 - w) * mode6Value(e, 0, c) + w * mode6Value(e, 1, c) + 32) >> 6);
+            }
+        }
+    }
+
+    float mode6Indices(const Block& block, const Mode6Endpoints& e, uint8_t indices[16]) {
+        uint8_t palette[16][4];
+        mode6Palette(e, palette);
+        float error = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            float best = distance(block.px[i], palette[0], 4);
+            indices[i] = 0;
+            for (uint8_t p = 1; p < 16; p++) {
+                float d = distance(block.px[i], palette[p], 4);
+                if (d < best) {
+                    best = d;
+                    indices[i] = p;
+                }
+            }
+            error += best;
+        }
+        return error;
+    }
+
+    // Alle vier p-Bit Kombinationen durchprobieren. Opake Blöcke nur mit p-Bit 1,
+    // sonst kann 255 nicht exakt getroffen werden (Alpha 254 statt 255)
+    float bestMode6(const Block& block, const float lo[4], const float hi[4],
+                    Mode6Endpoints& best, uint8_t indices[16]) {
+        bool opaque = true;
+        for (int i = 0; i < 16; i++) {
+            opaque = opaque && block.px[i][3] == 255.0f;
+        }
+        const uint8_t firstP = opaque ? 1 : 0;
+        float bestError = 1e30f;
+        for (uint8_t p0 = firstP; p0 < 2; p0++) {
+            for (uint8_t p1 = firstP; p1 < 2; p1++) {
+                Mode6Endpoints e = quantizeMode6(lo, hi, p0, p1);
+                uint8_t candidate[16];
+                float error = mode6Indices(block, e, candidate);
+                if (error < bestError) {
+                    bestError = error;
+                    best = e;
+                    std::memcpy(indices, candidate, 16);
+                }
+            }
+        }
+        return bestError;
+    }
+
+    void encodeBC7Block(const Block& block, uint8_t* out) {
+        float lo[4], hi[4];
+        fitEndpoints(block, 4, lo, hi);
+        Mode6Endpoints e{};
+        uint8_t indices[16];
+        float error = bestMode6(block, lo, hi, e, indices);
+
+        float weights[16];
+        for (int i = 0; i < 16; i++) {
+            weights[i] = BC7_WEIGHTS_4[indices[i]] / 64.0f;
+        }
+        if (refineEndpoints(block, 4, weights, lo, hi)) {
+            Mode6Endpoints refined{};
+            uint8_t refinedIndices[16];
+            float refinedError = bestMode6(block, lo, hi, refined, refinedIndices);
+            if (refinedError < error) {
+                e = refined;
+                std::memcpy(indices, refinedIndices, sizeof(indices));
+            }
+        }
+
+        // Anker-Index (Texel 0) hat nur 3 Bit: MSB muss 0 sein, sonst Endpunkte tauschen
+        if (indices[0] & 8) {
+            std::swap(e.q[0], e.q[1]);
+            std::swap(e.p[0], e.p[1]);
+            for (int i = 0; i < 16; i++) {
+                indices[i] = static_cast<uint8_t>(15 - indices[i]);
+            }
+        }
+
+        BitWriter writer(out);
+        writer.write(1u << 6, 7);                   // Mode 6
+        for (int c = 0; c < 4; c++) {
+            writer.write(e.q[0][c], 7);
+            writer.write(e.q[1][c], 7);
+        }
+        writer.write(e.p[0], 1);
+        writer.write(e.p[1], 1);
+        writer.write(indices[0], 3);
+        for (int i = 1; i < 16; i++) {
+            writer.write(indices[i], 4);
+        }
+    }
+
+    void decodeBC7Block(const uint8_t* in, uint8_t decoded[16][4]) {
+        if ((in[0] & 0x7F) != 0x40) {
+            throw std::runtime_error("BC7: only mode 6 blocks can be decoded on the CPU");
+        }
+        BitReader reader(in);
+        reader.read(7);
+        Mode6Endpoints e{};
+        for (int c = 0; c < 4; c++) {
+            e.q[0][c] = static_cast<uint8_t>(reader.read(7));
+            e.q[1][c] = static_cast<uint8_t>(reader.read(7));
+        }
+        e.p[0] = static_cast<uint8_t>(reader.read(1));
+        e.p[1] = static_cast<uint8_t>(reader.read(1));
+        uint8_t palette[16][4];
+        mode6Palette(e, palette);
+        for (int i = 0; i < 16; i++) {
+            std::memcpy(decoded[i], palette[reader.read(i == 0 ? 3 : 4)], 4);
+        }
+    }
+}
+
+bool BlockCompression::isCompressed(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool BlockCompression::isKnown(VkFormat format) {
+    return isCompressed(format) || format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_R8G8B8A8_UNORM;
+}
+
+VkFormat BlockCompression::uncompressedFormat(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_R8G8B8A8_UNORM:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        default:
+            return VK_FORMAT_R8G8B8A8_SRGB;
+    }
+}
+
+uint32_t BlockCompression::blockBytes(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            return 8;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+size_t BlockCompression::levelSize(VkFormat format, uint32_t width, uint32_t height) {
+    if (!isCompressed(format)) {
+        return size_t(width) * height * blockBytes(format);
+    }
+    return size_t((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+}
+
+const char* BlockCompression::formatName(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: return "BC1";
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:      return "BC3";
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:      return "BC7";
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:       return "RGBA8";
+        default:                            return "?";
+    }
+}
+
+bool BlockCompression::isSupported(VkPhysicalDevice physicalDevice, VkFormat format) {
+    VkFormatProperties props{};
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &props);
+    const VkFormatFeatureFlags needed = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT
+                                      | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (props.optimalTilingFeatures & needed) == needed;
+}
+
+VkFormat BlockCompression::chooseFormat(TextureCompression mode, const uint8_t* rgba, uint32_t width, uint32_t height) {
+    switch (mode) {
+        case TextureCompression::NONE: return VK_FORMAT_R8G8B8A8_SRGB;
+        case TextureCompression::BC1:  return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+        case TextureCompression::BC3:  return VK_FORMAT_BC3_SRGB_BLOCK;
+        case TextureCompression::BC7:  return VK_FORMAT_BC7_SRGB_BLOCK;
+        case TextureCompression::AUTO: break;
+    }
+    // kleiner als ein Block: unkomprimiert bleibt kleiner
+    if (width < 4 || height < 4) {
+        return VK_FORMAT_R8G8B8A8_SRGB;
+    }
+    // opak -> BC1 (8x), sonst BC7 (4x)
+    const size_t texels = size_t(width) * height;
+    for (size_t i = 0; i < texels; i++) {
+        if (rgba[i * 4 + 3] != 255) {
+            return VK_FORMAT_BC7_SRGB_BLOCK;
+        }
+    }
+    return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+}
+
+bool BlockCompression::matches(TextureCompression mode, VkFormat format, uint32_t width, uint32_t height) {
+    switch (mode) {
+        case TextureCompression::NONE: return format == VK_FORMAT_R8G8B8A8_SRGB;
+        case TextureCompression::BC1:  return format == VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+        case TextureCompression::BC3:  return format == VK_FORMAT_BC3_SRGB_BLOCK;
+        case TextureCompression::BC7:  return format == VK_FORMAT_BC7_SRGB_BLOCK;
+        case TextureCompression::AUTO:
+            if (width < 4 || height < 4) {
+                return format == VK_FORMAT_R8G8B8A8_SRGB;
+            }
+            return format == VK_FORMAT_BC1_RGB_SRGB_BLOCK || format == VK_FORMAT_BC7_SRGB_BLOCK;
+    }
+    return false;
+}
+
+bool BlockCompression::parseMode(const std::string& name, TextureCompression& mode) {
+    if (name == "none")      mode = TextureCompression::NONE;
+    else if (name == "auto") mode = TextureCompression::AUTO;
+    else if (name == "bc1")  mode = TextureCompression::BC1;
+    else if (name == "bc3")  mode = TextureCompression::BC3;
+    else if (name == "bc7")  mode = TextureCompression::BC7;
+    else return false;
+    return true;
+}
+
+void BlockCompression::encodeLevel(const uint8_t* rgba, uint32_t width, uint32_t height, VkFormat format, uint8_t* out) {
+    if (!isCompressed(format)) {
+        std::memcpy(out, rgba, levelSize(format, width, height));
+        return;
+    }
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const uint32_t stride = blockBytes(format);
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            const Block block = fetchBlock(rgba, width, height, bx, by);
+            uint8_t* dst = out + (size_t(by) * blocksX + bx) * stride;
+            switch (blockBytes(format) == 8 ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : format) {
+                case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                    encodeBC1Block(block, dst);             // alle BC1-Varianten, immer opak
+                    break;
+                case VK_FORMAT_BC3_UNORM_BLOCK:
+                case VK_FORMAT_BC3_SRGB_BLOCK:
+                    encodeAlphaBlock(block, dst);
+                    encodeBC1Block(block, dst + 8);
+                    break;
+                default:
+                    encodeBC7Block(block, dst);
+                    break;
+            }
+        }
+    }
+}
+
+void BlockCompression::decodeLevel(const uint8_t* blocks, uint32_t width, uint32_t height, VkFormat format, uint8_t* rgba) {
+    if (!isCompressed(format)) {
+        std::memcpy(rgba, blocks, levelSize(format, width, height));
+        return;
+    }
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    const uint32_t stride = blockBytes(format);
+    uint8_t decoded[16][4];
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            const uint8_t* src = blocks + (size_t(by) * blocksX + bx) * stride;
+            switch (format) {
+                case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                    decodeBC1Block(src, false, decoded);
+                    for (int i = 0; i < 16; i++) {
+                        decoded[i][3] = 255;        // RGB-Variante: Alpha gibt es nicht
+                    }
+                    break;
+                case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+                    decodeBC1Block(src, false, decoded);
+                    break;
+                case VK_FORMAT_BC3_UNORM_BLOCK:
+                case VK_FORMAT_BC3_SRGB_BLOCK:
+                    decodeBC1Block(src + 8, true, decoded);
+                    decodeAlphaBlock(src, decoded);
+                    break;
+                default:
+                    decodeBC7Block(src, decoded);
+                    break;
+            }
+            storeBlock(decoded, width, height, bx, by, rgba);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// BlockCompression.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Wunsch beim Backen; AUTO: BC1 für opake Texturen, sonst BC7 (unter 4x4 unkomprimiert)
+enum class TextureCompression { NONE, AUTO, BC1, BC3, BC7 };
+
+// BC1/BC3/BC7: Encoder für das bake-Tool, Dekoder für Geräte ohne BC-Unterstützung
+class BlockCompression {
+public:
+    // BC1/BC3/BC7, jeweils sRGB oder UNORM (BC1 auch mit 1-Bit Alpha)
+    static bool isCompressed(VkFormat format);
+    // Formate, die ImageData/Texture hochladen können (BC oder RGBA8)
+    static bool isKnown(VkFormat format);
+    // RGBA8 mit gleicher Farbraum-Interpretation (Ziel beim Entpacken)
+    static VkFormat uncompressedFormat(VkFormat format);
+    // Bytes pro 4x4 Block, bzw. pro Texel bei unkomprimiertem RGBA8
+    static uint32_t blockBytes(VkFormat format);
+    // Bytes eines Levels mit width x height (Randblöcke zählen voll)
+    static size_t levelSize(VkFormat format, uint32_t width, uint32_t height);
+    static const char* formatName(VkFormat format);
+
+    // Kann das Gerät format mit optimal tiling linear gefiltert sampeln?
+    static bool isSupported(VkPhysicalDevice physicalDevice, VkFormat format);
+
+    // Zielformat für ein RGBA8-Bild (Level 0) nach Wunsch mode
+    static VkFormat chooseFormat(TextureCompression mode, const uint8_t* rgba, uint32_t width, uint32_t height);
+    // Passt ein vorhandenes Format zum Wunsch? (für inkrementelles Backen)
+    static bool matches(TextureCompression mode, VkFormat format, uint32_t width, uint32_t height);
+    // "none", "auto", "bc1", "bc3", "bc7"; false bei unbekanntem Namen
+    static bool parseMode(const std::string& name, TextureCompression& mode);
+
+    // Kodiert ein RGBA8-Level; out muss levelSize(format, width, height) Bytes haben
+    static void encodeLevel(const uint8_t* rgba, uint32_t width, uint32_t height, VkFormat format, uint8_t* out);
+    // Dekodiert ein Level nach RGBA8 (width * height * 4 Bytes). BC7: nur Mode 6, wirft sonst
+    static void decodeLevel(const uint8_t* blocks, uint32_t width, uint32_t height, VkFormat format, uint8_t* rgba);
+};
@@ -1,21 +1,62 @@
 #include "CubeMap.hpp"
 #include "../../stb_image.h"
 
+#include <iostream>
 #include <stdexcept>
 #include <cstring>
+#include <vector>
 
 
-void CubeMap::loadCubeMap(const std::array<const char*, 6>& faces) {
-    // Lade die erste Textur um Größe zu bestimmen
-    int texChannels;
-    stbi_uc* firstPixels = stbi_load(faces[0], &_texWidth, &_texHeight, &texChannels, STBI_rgb_alpha);
-    if (!firstPixels) {
-        throw std::runtime_error(std::string("Failed to load cubemap face: ") + faces[0]);
+std::array<ImageData, 6> CubeMap::loadFaces(const std::array<const char*, 6>& faces) {
+    std::array<ImageData, 6> images;
+    for (size_t i = 0; i < faces.size(); ++i) {
+        images[i] = ImageData::load(faces[i]);
     }
+    return images;
+}
 
-    VkDeviceSize layerSize = static_cast<VkDeviceSize>(_texWidth) * _texHeight * 4;
+void CubeMap::loadCubeMap(const std::array<ImageData, 6>& faces) {
+    // Größe kommt von der ersten Textur
+    _texWidth = faces[0].width;
+    _texHeight = faces[0].height;
+    for (const ImageData& face : faces) {
+        if (face.width != _texWidth || face.height != _texHeight) {
+            throw std::runtime_error("Cubemap faces have different dimensions!");
+        }
+    }
+
+    // Mips und BC-Format nur, wenn alle Faces gleich gebacken sind und das Gerät
+    // das Format kann (sonst wie bisher RGBA8, ggf. nur Level 0)
+    bool uniform = true;
+    for (const ImageData& face : faces) {
+        if (face.mipLevels != faces[0].mipLevels || face.format != faces[0].format) {
+            uniform = false;
+        }
+    }
+    const bool compressed = BlockCompression::isCompressed(faces[0].format);
+    std::array<ImageData, 6> images = faces;
+    if (!uniform || (compressed && !BlockCompression::isSupported(_physicalDevice, faces[0].format))) {
+        if (compressed) {
+            std::cerr << "CubeMap: " << BlockCompression::formatName(faces[0].format)
+                      << " nicht nutzbar, entpacke nach RGBA8" << std::endl;
+        }
+        for (size_t i = 0; i < images.size(); ++i) {
+            images[i] = faces[i].decompressed();
+        }
+    }
+    _format = images[0].format;
+    _mipLevels = uniform ? images[0].mipLevels : 1;
+
+    ImageData layout = images[0];
+    layout.mipLevels = _mipLevels;
+    VkDeviceSize layerSize = layout.byteSize();
+    _faceByteSize = layerSize;
     VkDeviceSize imageSize = layerSize * 6; // 6 Faces
 
+    ImageData rgbaLayout = layout;
+    rgbaLayout.format = VK_FORMAT_R8G8B8A8_SRGB;
+    _uncompressedByteSize = rgbaLayout.byteSize() * 6;
+
     // Staging Buffer erstellen
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -24,53 +65,21 @@ void CubeMap::loadCubeMap(const std::array<const char*, 6>& faces) {
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
     if (vkCreateBuffer(_device, &bufferInfo, nullptr, &_imageBuffer) != VK_SUCCESS) {
-        stbi_image_free(firstPixels);
         throw std::runtime_error("Failed to create cubemap staging buffer!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(_device, _imageBuffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = _buff.findMemoryType( memRequirements.memoryTypeBits,
-                                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, _physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_imageBufferMemory) != VK_SUCCESS) {
-        stbi_image_free(firstPixels);
+    try {
+        _imageBufferMemory = MemoryAllocator::of(_device).allocateBuffer(
+            _imageBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging);
+    } catch (const std::exception&) {
         throw std::runtime_error("Failed to allocate cubemap staging buffer memory!");
     }
 
-    vkBindBufferMemory(_device, _imageBuffer, _imageBufferMemory, 0);
-
-    // Map memory und kopiere alle Faces
-    void* data;
-    vkMapMemory(_device, _imageBufferMemory, 0, imageSize, 0, &data);
-
-    //erste Textur kopieren
-    memcpy(data, firstPixels, static_cast<size_t>(layerSize));
-    stbi_image_free(firstPixels);
-
-    // Lade und kopiere restliche 5 Faces
-    for (int i = 1; i < 6; ++i) {
-        int w, h, channels;
-        stbi_uc* pixels = stbi_load(faces[i], &w, &h, &channels, STBI_rgb_alpha);
-        if (!pixels) {
-            vkUnmapMemory(_device, _imageBufferMemory);
-            throw std::runtime_error(std::string("Failed to load cubemap face: ") + faces[i]);
-        }
-        if (w != _texWidth || h != _texHeight) {
-            stbi_image_free(pixels);
-            vkUnmapMemory(_device, _imageBufferMemory);
-            throw std::runtime_error("Cubemap faces have different dimensions!");
-        }
-        
-        memcpy(static_cast<char*>(data) + layerSize * i, pixels, static_cast<size_t>(layerSize));
-        stbi_image_free(pixels);
+    // alle Faces hintereinander in den (gemappten) Staging Buffer
+    char* data = static_cast<char*>(_imageBufferMemory.mapped);
+    for (size_t i = 0; i < images.size(); ++i) {
+        memcpy(data + layerSize * i, images[i].pixels.get(), static_cast<size_t>(layerSize));
     }
-
-    vkUnmapMemory(_device, _imageBufferMemory);
 }
 
 void CubeMap::createTextureImage() {
@@ -82,7 +91,7 @@ void CubeMap::createTextureImage() {
     imageInfo.extent.depth = 1;
     imageInfo.mipLevels = _mipLevels;
     imageInfo.arrayLayers = 6; // CubeMap hat 6 Layers
-    imageInfo.format = IMAGE_FORMAT;
+    imageInfo.format = _format;
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
     imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
@@ -96,20 +105,13 @@ void CubeMap::createTextureImage() {
 }
 
 void CubeMap::allocateTextureImageMemory() {
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(_device, _textureImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = _buff.findMemoryType( memRequirements.memoryTypeBits, 
-                                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, _physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_textureImageMemory) != VK_SUCCESS) {
+    try {
+        _textureImageMemory = MemoryAllocator::of(_device).allocateImage(_textureImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                          MemoryCategory::Cubemap);
+    } catch (const std::exception&) {
         throw std::runtime_error("Failed to allocate cubemap image memory!");
     }
-
-    vkBindImageMemory(_device, _textureImage, _textureImageMemory, 0);
+    _imageByteSize = _textureImageMemory.size;
 }
 
 void CubeMap::copyBufferToImage() {
@@ -136,28 +138,34 @@ void CubeMap::copyBufferToImage() {
         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
         0, 0, nullptr, 0, nullptr, 1, &barrier);
 
-    //copy buffer to image (alle 6 Faces)
-    VkDeviceSize layerSize = static_cast<VkDeviceSize>(_texWidth) * _texHeight * 4;
-    
+    //copy buffer to image (alle 6 Faces, bei gebackenen Faces mit allen Levels) in einem Befehl
+    ImageData layout;
+    layout.width = _texWidth;
+    layout.height = _texHeight;
+    layout.format = _format;
+    std::vector<VkBufferImageCopy> regions;
+    regions.reserve(6 * _mipLevels);
     for (uint32_t face = 0; face < 6; ++face) {
-        VkBufferImageCopy region{};
-        region.bufferOffset = layerSize * face;
-        region.bufferRowLength = 0;
-        region.bufferImageHeight = 0;
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = face;
-        region.imageSubresource.layerCount = 1;
-        region.imageOffset = {0, 0, 0};
-        region.imageExtent = {
-            static_cast<uint32_t>(_texWidth),
-            static_cast<uint32_t>(_texHeight),
-            1
-        };
-
-        vkCmdCopyBufferToImage(commandBuffer, _imageBuffer, _textureImage,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        for (uint32_t level = 0; level < _mipLevels; ++level) {
+            VkBufferImageCopy region{};
+            region.bufferOffset = _faceByteSize * face + layout.levelOffset(level);
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = level;
+            region.imageSubresource.baseArrayLayer = face;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = {0, 0, 0};
+            region.imageExtent = {
+                ImageData::levelExtent(_texWidth, level),
+                ImageData::levelExtent(_texHeight, level),
+                1
+            };
+            regions.push_back(region);
+        }
     }
+    vkCmdCopyBufferToImage(commandBuffer, _imageBuffer, _textureImage,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
 
     //TRANSFER_DST_OPTIMAL -> SHADER_READ_ONLY_OPTIMAL
     barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
@@ -177,9 +185,8 @@ void CubeMap::destroyImageBuffer() {
         vkDestroyBuffer(_device, _imageBuffer, nullptr);
         _imageBuffer = VK_NULL_HANDLE;
     }
-    if (_imageBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _imageBufferMemory, nullptr);
-        _imageBufferMemory = VK_NULL_HANDLE;
+    if (_imageBufferMemory) {
+        MemoryAllocator::of(_device).free(_imageBufferMemory);
     }
 }
 
@@ -188,7 +195,7 @@ void CubeMap::createTextureImageView() {
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = _textureImage;
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE; // CUBE weil Würfel halt
-    viewInfo.format = IMAGE_FORMAT;
+    viewInfo.format = _format;
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
     viewInfo.subresourceRange.levelCount = _mipLevels;
@@ -3,6 +3,7 @@
 #include <string>
 #include <array>
 #include "../initBuffer.hpp"
+#include "ImageData.hpp"
 
 /*
 * Klasse für die Darstellung der CubeMap Textur aka Skybox
@@ -21,7 +22,7 @@ public:
         , _queue(queue)
     {
         //speichert 6 Images aus faces
-        loadCubeMap(faces);
+        loadCubeMap(loadFaces(faces));
 
         //sollte klar sein
         createTextureImage();
@@ -32,6 +33,29 @@ public:
         createTextureSampler();
     }
 
+    // Variante mit bereits dekodierten Faces (z.B. aus dem ThreadPool)
+    CubeMap(VkPhysicalDevice physicalDevice,
+                   VkDevice device,
+                   VkCommandPool commandPool,
+                   VkQueue queue,
+                   const std::array<ImageData, 6>& faces)
+        : _physicalDevice(physicalDevice)
+        , _device(device)
+        , _commandPool(commandPool)
+        , _queue(queue)
+    {
+        loadCubeMap(faces);
+        createTextureImage();
+        allocateTextureImageMemory();
+        copyBufferToImage();
+        destroyImageBuffer();
+        createTextureImageView();
+        createTextureSampler();
+    }
+
+    // Dekodiert alle 6 Bilder (ohne Vulkan, darf auf Worker-Threads laufen)
+    static std::array<ImageData, 6> loadFaces(const std::array<const char*, 6>& faces);
+
     ~CubeMap() {
         if (_textureSampler != VK_NULL_HANDLE)
             vkDestroySampler(_device, _textureSampler, nullptr);
@@ -39,12 +63,16 @@ public:
             vkDestroyImageView(_device, _textureImageView, nullptr);
         if (_textureImage != VK_NULL_HANDLE)
             vkDestroyImage(_device, _textureImage, nullptr);
-        if (_textureImageMemory != VK_NULL_HANDLE)
-            vkFreeMemory(_device, _textureImageMemory, nullptr);
+        if (_textureImageMemory)
+            MemoryAllocator::of(_device).free(_textureImageMemory);
     }
 
     VkImageView getImageView() const { return _textureImageView; }
     VkSampler getSampler() const { return _textureSampler; }
+    VkFormat getFormat() const { return _format; }
+    // Belegter Speicher bzw. dieselben Levels als RGBA8 (für die Ersparnis durch BC-Formate)
+    VkDeviceSize getByteSize() const { return _imageByteSize; }
+    VkDeviceSize getUncompressedByteSize() const { return _uncompressedByteSize; }
 
 private:
     VkPhysicalDevice _physicalDevice;
@@ -53,21 +81,23 @@ private:
     VkQueue _queue;
 
     VkImage _textureImage = VK_NULL_HANDLE;
-    VkDeviceMemory _textureImageMemory = VK_NULL_HANDLE;
+    MemoryAllocation _textureImageMemory;
     VkImageView _textureImageView = VK_NULL_HANDLE;
     VkSampler _textureSampler = VK_NULL_HANDLE;
 
     VkBuffer _imageBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _imageBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation _imageBufferMemory;
     InitBuffer _buff;
 
     int _texWidth = 0;
     int _texHeight = 0;
-    uint32_t _mipLevels = 1;
-
-    static constexpr VkFormat IMAGE_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+    uint32_t _mipLevels = 1;                // > 1 nur mit gebackenen Faces (.btex)
+    VkDeviceSize _faceByteSize = 0;         // alle Levels einer Face im Staging Buffer
+    VkDeviceSize _imageByteSize = 0;
+    VkDeviceSize _uncompressedByteSize = 0;
+    VkFormat _format = VK_FORMAT_R8G8B8A8_SRGB; // BC-Format nur mit gebackenen Faces
 
-    void loadCubeMap(const std::array<const char*, 6>& faces);
+    void loadCubeMap(const std::array<ImageData, 6>& faces);
     void createTextureImage();
     void allocateTextureImageMemory();
     void copyBufferToImage();
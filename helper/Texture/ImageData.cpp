@@ -0,0 +1,89 @@
+#include "ImageData.hpp"
+#include "BakedTexture.hpp"
+#include "Ktx2Texture.hpp"
+#include "../MemoryReport.hpp"
+#include <cstring>
+#include <stdexcept>
+
+ImageData ImageData::load(const std::string& filename) {
+    if (Ktx2Texture::isKtx2(filename)) {
+        return Ktx2Texture::load(filename);
+    }
+    ImageData image;
+    if (BakedTexture::load(filename, image)) {
+        return image;
+    }
+    return decode(filename);
+}
+
+ImageData ImageData::decode(const std::string& filename) {
+    ImageData image;
+    int channels = 0;
+    stbi_uc* pixels = stbi_load(filename.c_str(), &image.width, &image.height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+        throw std::runtime_error("failed to load texture image: " + filename);
+    }
+    image.pixels = MemoryReport::trackHost(pixels, MemoryCategory::Texture, image.byteSize(), stbi_image_free);
+    return image;
+}
+
+ImageData ImageData::decompressed() const {
+    if (!BlockCompression::isCompressed(format)) {
+        return *this;
+    }
+    ImageData rgba;
+    rgba.width = width;
+    rgba.height = height;
+    rgba.mipLevels = mipLevels;
+    rgba.format = BlockCompression::uncompressedFormat(format);
+    rgba.runtimeMips = false;
+    rgba.baseLevel = baseLevel;
+    auto* unpacked = new stbi_uc[rgba.byteSize()];
+    rgba.pixels = MemoryReport::trackHost(unpacked, MemoryCategory::Texture, rgba.byteSize(),
+                                          std::default_delete<stbi_uc[]>());
+    for (uint32_t level = 0; level < mipLevels; level++) {
+        BlockCompression::decodeLevel(pixels.get() + levelOffset(level),
+                                      levelExtent(width, level), levelExtent(height, level),
+                                      format, unpacked + rgba.levelOffset(level));
+    }
+    return rgba;
+}
+
+ImageData ImageData::fromLevel(uint32_t level) const {
+    // JPEG/PNG liegen dekodiert im Speicher, nichts Gemapptes, das am Leben bliebe
+    if (level == 0 && runtimeMips) {
+        return *this;
+    }
+    ImageData slice;
+    slice.format = format;
+    slice.runtimeMips = runtimeMips;
+    if (runtimeMips) {
+        // gleicher sRGB-richtiger Box-Filter wie beim Backen, aber nur bis level,
+        // die restlichen Levels blittet die GPU
+        uint32_t chainLevels = 0;
+        std::vector<uint8_t> chain = BakedTexture::buildMipChain(pixels.get(), width, height, chainLevels, level);
+        ImageData layout = *this;
+        layout.mipLevels = chainLevels;
+        level = std::min(level, chainLevels - 1);
+        slice.baseLevel = baseLevel + level;
+        slice.width = static_cast<int>(levelExtent(width, level));
+        slice.height = static_cast<int>(levelExtent(height, level));
+        slice.mipLevels = 1;
+        auto* copy = new stbi_uc[slice.byteSize()];
+        std::memcpy(copy, chain.data() + layout.levelOffset(level), slice.byteSize());
+        slice.pixels = MemoryReport::trackHost(copy, MemoryCategory::Texture, slice.byteSize(),
+                                               std::default_delete<stbi_uc[]>());
+        return slice;
+    }
+    // eigene Kopie, damit die (evtl. gemappte) Quelle nicht am Leben bleibt
+    level = std::min(level, mipLevels - 1);
+    slice.baseLevel = baseLevel + level;
+    slice.width = static_cast<int>(levelExtent(width, level));
+    slice.height = static_cast<int>(levelExtent(height, level));
+    slice.mipLevels = mipLevels - level;
+    auto* copy = new stbi_uc[slice.byteSize()];
+    std::memcpy(copy, pixels.get() + levelOffset(level), slice.byteSize());
+    slice.pixels = MemoryReport::trackHost(copy, MemoryCategory::Texture, slice.byteSize(),
+                                           std::default_delete<stbi_uc[]>());
+    return slice;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "../../stb_image.h"
+#include "BlockCompression.hpp"
+
+// Bild im Hauptspeicher (RGBA8 oder blockkomprimiert aus .btex/.ktx2). Kann auf
+// einem Worker-Thread geladen und danach an Texture/CubeMap zum Hochladen übergeben werden.
+struct ImageData {
+    int width = 0;
+    int height = 0;
+    std::shared_ptr<stbi_uc> pixels;   // gibt per stbi_image_free frei (bzw. hält die gemappte .btex)
+    uint32_t mipLevels = 1;            // > 1: komplette Mip-Kette liegt schon in pixels (gebackene Textur)
+    VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;  // BC1/BC3/BC7 nur aus .btex/.ktx2
+    bool runtimeMips = true;           // nur JPEG/PNG: Mips erst auf der GPU per vkCmdBlitImage
+    uint32_t baseLevel = 0;            // Level der vollen Quelle, das hier Level 0 ist (siehe fromLevel)
+
+    // Bytes aller Levels in pixels
+    size_t byteSize() const { return levelOffset(mipLevels); }
+    // Offset von Level level innerhalb von pixels (Level 0 zuerst, dicht hintereinander)
+    size_t levelOffset(uint32_t level) const {
+        size_t offset = 0;
+        for (uint32_t i = 0; i < level; i++) {
+            offset += levelSize(i);
+        }
+        return offset;
+    }
+    size_t levelSize(uint32_t level) const {
+        return BlockCompression::levelSize(format, levelExtent(width, level), levelExtent(height, level));
+    }
+    static uint32_t levelExtent(int extent, uint32_t level) {
+        return static_cast<uint32_t>(std::max(1, extent >> level));
+    }
+    // Länge der kompletten Mip-Kette bis 1x1
+    static uint32_t fullMipLevels(int width, int height) {
+        uint32_t levels = 1;
+        for (int extent = std::max(width, height); extent > 1; extent >>= 1) {
+            levels++;
+        }
+        return levels;
+    }
+
+    // .ktx2 über Ktx2Texture, sonst die gebackene .btex (siehe BakedTexture), wenn sie
+    // zur Datei passt, sonst stbi_load mit STBI_rgb_alpha. Wirft bei Fehler
+    static ImageData load(const std::string& filename);
+    // Immer stbi_load, ohne .btex (für das bake-Tool)
+    static ImageData decode(const std::string& filename);
+
+    // Fallback für Geräte ohne BC-Unterstützung: alle Levels nach RGBA8 entpacken
+    ImageData decompressed() const;
+
+    // Bild ab Mip-Level level (wird Level 0 der Kopie), für das Texture-Streaming.
+    // Vorhandene Mip-Ketten werden ab level kopiert, JPEG/PNG auf der CPU verkleinert
+    ImageData fromLevel(uint32_t level) const;
+};
@@ -0,0 +1,127 @@
+#include "Ktx2Texture.hpp"
+#include "../ObjectLoading/MeshCache.hpp"
+#include "../MemoryReport.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    const uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    // größere Kanten garantiert Vulkan nicht (maxImageDimension2D ist mindestens 4096,
+    // übliche Desktop-GPUs haben 16384), schützt vor riesigen Allokationen aus kaputten Dateien
+    const uint32_t MAX_EXTENT = 16384;
+
+    // floor(log2(max(width, height))) + 1
+    uint32_t fullMipCount(uint32_t width, uint32_t height) {
+        uint32_t levels = 1;
+        for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+            levels++;
+        }
+        return levels;
+    }
+
+    // Liest die Datei und verteilt die Levels auf faceCount ImageData
+    std::vector<ImageData> parse(const std::string& path, uint32_t expectedFaces) {
+        MappedFile file;
+        if (!file.open(path)) {
+            throw std::runtime_error("failed to open KTX2 file: " + path);
+        }
+        Ktx2Header header{};
+        if (file.size() < sizeof(header)) {
+            throw std::runtime_error("KTX2 file too small: " + path);
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        const VkFormat format = static_cast<VkFormat>(header.vkFormat);
+        if (std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+            throw std::runtime_error("not a KTX2 file: " + path);
+        }
+        if (header.supercompressionScheme != 0) {
+            throw std::runtime_error("KTX2 supercompression is not supported: " + path);
+        }
+        if (!BlockCompression::isKnown(format)) {
+            throw std::runtime_error("KTX2 format " + std::to_string(header.vkFormat) + " is not supported: " + path);
+        }
+        if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelDepth > 1 || header.layerCount > 1) {
+            throw std::runtime_error("KTX2 file is not a 2D texture or cubemap: " + path);
+        }
+        if (header.pixelWidth > MAX_EXTENT || header.pixelHeight > MAX_EXTENT) {
+            throw std::runtime_error("KTX2 texture " + std::to_string(header.pixelWidth) + "x"
+                                     + std::to_string(header.pixelHeight) + " is too large: " + path);
+        }
+        if (header.levelCount > fullMipCount(header.pixelWidth, header.pixelHeight)) {
+            throw std::runtime_error("KTX2 file has more mip levels than its size allows: " + path);
+        }
+        if (header.faceCount != expectedFaces) {
+            throw std::runtime_error("KTX2 file has " + std::to_string(header.faceCount) + " faces, expected "
+                                     + std::to_string(expectedFaces) + ": " + path);
+        }
+        // levelCount 0: nur Level 0 gespeichert, Rest per Blit (geht nicht mit BC-Daten)
+        const bool runtimeMips = header.levelCount == 0;
+        if (runtimeMips && BlockCompression::isCompressed(format)) {
+            throw std::runtime_error("KTX2 file without mip levels needs RGBA8 data: " + path);
+        }
+        const uint32_t levelCount = std::max(header.levelCount, 1u);
+
+        std::vector<Ktx2LevelIndex> levels(levelCount);
+        if (file.size() < sizeof(header) + levels.size() * sizeof(Ktx2LevelIndex)) {
+            throw std::runtime_error("KTX2 level index truncated: " + path);
+        }
+        std::memcpy(levels.data(), file.data() + sizeof(header), levels.size() * sizeof(Ktx2LevelIndex));
+
+        std::vector<ImageData> faces(header.faceCount);
+        const MemoryCategory category = header.faceCount == 6 ? MemoryCategory::Cubemap : MemoryCategory::Texture;
+        for (ImageData& face : faces) {
+            face.width = static_cast<int>(header.pixelWidth);
+            face.height = static_cast<int>(header.pixelHeight);
+            face.mipLevels = levelCount;
+            face.format = format;
+            face.runtimeMips = runtimeMips;
+        }
+        // alle Levels aller Faces müssen in der Datei stehen, erst dann allokieren
+        if (faces[0].byteSize() * faces.size() > file.size()) {
+            throw std::runtime_error("KTX2 level data truncated: " + path);
+        }
+        for (ImageData& face : faces) {
+            face.pixels = MemoryReport::trackHost(new stbi_uc[face.byteSize()], category, face.byteSize(),
+                                                  std::default_delete<stbi_uc[]>());
+        }
+
+        // In der Datei liegt pro Level jede Face einzeln; ImageData will pro Face alle Levels
+        for (uint32_t level = 0; level < levelCount; level++) {
+            const size_t faceSize = faces[0].levelSize(level);
+            const Ktx2LevelIndex& entry = levels[level];
+            if (entry.byteLength < faceSize * faces.size() || entry.byteOffset + entry.byteLength > file.size()) {
+                throw std::runtime_error("KTX2 level " + std::to_string(level) + " out of range: " + path);
+            }
+            for (size_t f = 0; f < faces.size(); f++) {
+                std::memcpy(faces[f].pixels.get() + faces[f].levelOffset(level),
+                            file.data() + entry.byteOffset + faceSize * f, faceSize);
+            }
+        }
+        return faces;
+    }
+}
+
+bool Ktx2Texture::isKtx2(const std::string& path) {
+    const std::string extension = ".ktx2";
+    if (path.size() < extension.size()) {
+        return false;
+    }
+    return std::equal(extension.begin(), extension.end(), path.end() - extension.size(),
+                      [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+}
+
+ImageData Ktx2Texture::load(const std::string& path) {
+    return std::move(parse(path, 1)[0]);
+}
+
+std::array<ImageData, 6> Ktx2Texture::loadCubeFaces(const std::string& path) {
+    std::vector<ImageData> faces = parse(path, 6);
+    std::array<ImageData, 6> result;
+    std::move(faces.begin(), faces.end(), result.begin());
+    return result;
+}
@@ -0,0 +1,46 @@
+// Ktx2Texture.hpp
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include "ImageData.hpp"
+
+// Dateikopf inkl. Index, Layout laut Spezifikation (80 Bytes)
+struct Ktx2Header {
+    uint8_t identifier[12];     // «KTX 20»\r\n\x1A\n
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;        // 0 für 2D
+    uint32_t layerCount;        // 0 = kein Array
+    uint32_t faceCount;         // 1 oder 6
+    uint32_t levelCount;        // 0 = Mips zur Laufzeit
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+// Eintrag im Level-Index direkt hinter dem Kopf
+struct Ktx2LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+// Liest .ktx2 (RGBA8, BC1/BC3/BC7, ohne Supercompression) in ImageData
+class Ktx2Texture {
+public:
+    // Endung .ktx2 (Groß-/Kleinschreibung egal)
+    static bool isKtx2(const std::string& path);
+
+    // 2D-Textur (faceCount 1). Wirft bei Fehler
+    static ImageData load(const std::string& path);
+    // Cubemap (faceCount 6, Reihenfolge +X -X +Y -Y +Z -Z wie bei CubeMap). Wirft bei Fehler
+    static std::array<ImageData, 6> loadCubeFaces(const std::string& path);
+};
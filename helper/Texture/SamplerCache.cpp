@@ -0,0 +1,69 @@
+#include "SamplerCache.hpp"
+
+#include <stdexcept>
+
+VkSampler SamplerCache::acquire(const SamplerDesc& desc) {
+    _requests++;
+    Entry& entry = _samplers[desc];
+    if (entry.sampler == VK_NULL_HANDLE) {
+        entry.sampler = createSampler(desc);
+    }
+    entry.refs++;
+    return entry.sampler;
+}
+
+void SamplerCache::release(VkSampler sampler) {
+    for (auto it = _samplers.begin(); it != _samplers.end(); ++it) {
+        if (it->second.sampler != sampler) {
+            continue;
+        }
+        if (--it->second.refs == 0) {
+            vkDestroySampler(_device, sampler, nullptr);
+            _samplers.erase(it);
+        }
+        return;
+    }
+}
+
+void SamplerCache::destroyAll() {
+    for (auto& [desc, entry] : _samplers) {
+        vkDestroySampler(_device, entry.sampler, nullptr);
+    }
+    _samplers.clear();
+}
+
+VkSampler SamplerCache::createSampler(const SamplerDesc& desc) {
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = desc.magFilter;
+    samplerInfo.minFilter = desc.minFilter;
+    samplerInfo.addressModeU = desc.addressMode;
+    samplerInfo.addressModeV = desc.addressMode;
+    samplerInfo.addressModeW = desc.addressMode;
+
+    // Anisotropie nur, wenn das Gerät sie kann
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(_physicalDevice, &props);
+
+    VkPhysicalDeviceFeatures features{};
+    vkGetPhysicalDeviceFeatures(_physicalDevice, &features);
+
+    const bool anisotropy = desc.anisotropy && features.samplerAnisotropy;
+    samplerInfo.anisotropyEnable = anisotropy ? VK_TRUE : VK_FALSE;
+    samplerInfo.maxAnisotropy = anisotropy ? props.limits.maxSamplerAnisotropy : 1.0f;
+
+    samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    samplerInfo.unnormalizedCoordinates = VK_FALSE;
+    samplerInfo.compareEnable = VK_FALSE;
+    samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+    samplerInfo.mipmapMode = desc.mipmapMode;
+    samplerInfo.mipLodBias = 0.0f;
+    samplerInfo.minLod = desc.minLod;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+    VkSampler sampler;
+    if (vkCreateSampler(_device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create texture sampler!");
+    }
+    return sampler;
+}
@@ -0,0 +1,71 @@
+// SamplerCache.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+// Die Einstellungen, die sich zwischen unseren Samplern unterscheiden können.
+// maxLod ist immer VK_LOD_CLAMP_NONE, damit Texturen mit unterschiedlich
+// vielen Mip-Levels denselben Sampler benutzen können. minLod > 0 nur beim
+// Einblenden frisch gestreamter Mip-Levels (siehe TextureStreamer).
+struct SamplerDesc {
+    VkFilter magFilter = VK_FILTER_LINEAR;
+    VkFilter minFilter = VK_FILTER_LINEAR;
+    VkSamplerMipmapMode mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    bool anisotropy = true;     // nur wenn das Gerät es unterstützt
+    float minLod = 0.0f;        // feinstes benutzbares Level
+
+    bool operator==(const SamplerDesc& other) const {
+        return magFilter == other.magFilter && minFilter == other.minFilter
+            && mipmapMode == other.mipmapMode && addressMode == other.addressMode
+            && anisotropy == other.anisotropy && minLod == other.minLod;
+    }
+};
+
+struct SamplerDescHash {
+    size_t operator()(const SamplerDesc& desc) const {
+        uint32_t key = static_cast<uint32_t>(desc.magFilter)
+                     | static_cast<uint32_t>(desc.minFilter) << 4
+                     | static_cast<uint32_t>(desc.mipmapMode) << 8
+                     | static_cast<uint32_t>(desc.addressMode) << 12
+                     | static_cast<uint32_t>(desc.anisotropy) << 16;
+        return std::hash<uint32_t>()(key) ^ std::hash<float>()(desc.minLod);
+    }
+};
+
+// Gleiche Einstellungen ergeben denselben VkSampler, gezählt per Referenz
+class SamplerCache {
+public:
+    SamplerCache(VkPhysicalDevice physicalDevice, VkDevice device)
+        : _physicalDevice(physicalDevice), _device(device) {}
+
+    SamplerCache(const SamplerCache&) = delete;
+    SamplerCache& operator=(const SamplerCache&) = delete;
+
+    // Liefert einen (evtl. schon vorhandenen) Sampler und erhöht dessen Referenzzähler
+    VkSampler acquire(const SamplerDesc& desc);
+    // Gibt eine Referenz zurück, bei 0 wird der Sampler zerstört
+    void release(VkSampler sampler);
+    // Zerstört alle Sampler (vor vkDestroyDevice aufrufen)
+    void destroyAll();
+
+    size_t size() const { return _samplers.size(); }
+    uint64_t getRequestCount() const { return _requests; }
+
+private:
+    struct Entry {
+        VkSampler sampler = VK_NULL_HANDLE;
+        uint32_t refs = 0;
+    };
+
+    VkSampler createSampler(const SamplerDesc& desc);
+
+    VkPhysicalDevice _physicalDevice;
+    VkDevice _device;
+    std::unordered_map<SamplerDesc, Entry, SamplerDescHash> _samplers;
+    uint64_t _requests = 0;
+};
@@ -2,21 +2,44 @@
 
 #include "Texture.hpp"
 
+#include <array>
 
-void Texture::createImageBuffer(const char* filename) {
+InitBuffer buf;
+
+
+ImageData Texture::prepareImage(const ImageData& source) {
     
-    //bild laden
-    int texChannels;
-    stbi_uc* pixels = stbi_load(filename, &_texWidth, &_texHeight, &texChannels, STBI_rgb_alpha);
-    if (!pixels) {
-        throw std::runtime_error(std::string("failed to load texture image: ") + filename);
+    //bild ist schon dekodiert; BC-Daten nur, wenn das Gerät das Format sampeln kann
+    ImageData image = source;
+    if (BlockCompression::isCompressed(source.format)
+        && !BlockCompression::isSupported(_physicalDevice, source.format)) {
+        std::cerr << "Texture: " << BlockCompression::formatName(source.format)
+                  << " nicht unterstützt, entpacke nach RGBA8" << std::endl;
+        image = source.decompressed();
+    }
+    _format = image.format;
+    _texWidth = image.width;
+    _texHeight = image.height;
+    _residentLevel = image.baseLevel;
+
+    //Mipmap-level berechnen (nur JPEG/PNG; .btex/.ktx2 bringen ihre Levels schon mit)
+    _precomputedMips = !image.runtimeMips || BlockCompression::isCompressed(_format);
+    _mipLevels = _precomputedMips ? image.mipLevels
+                                  : static_cast<uint32_t>(std::floor(std::log2(std::max(_texWidth, _texHeight)))) + 1;
+    _levelOffsets.assign(1, 0);
+    for (uint32_t level = 1; level < image.mipLevels; level++) {
+        _levelOffsets.push_back(image.levelOffset(level));
     }
 
-    //Mipmap-level berechnen
-    _mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(_texWidth, _texHeight)))) + 1;
-
+    ImageData rgbaLayout = image;
+    rgbaLayout.format = VK_FORMAT_R8G8B8A8_SRGB;
+    rgbaLayout.mipLevels = _mipLevels;
+    _uncompressedByteSize = rgbaLayout.byteSize();
+    return image;
+}
 
-    VkDeviceSize imageSize = static_cast<VkDeviceSize>(_texWidth) * static_cast<VkDeviceSize>(_texHeight) * 4;
+void Texture::createImageBuffer(const ImageData& image) {
+    VkDeviceSize imageSize = image.byteSize();
 
     //staging buffer erstellen
     VkBufferCreateInfo bufferInfo{};
@@ -26,34 +49,18 @@ void Texture::createImageBuffer(const char* filename) {
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
     if (vkCreateBuffer(_device, &bufferInfo, nullptr, &_imageBuffer) != VK_SUCCESS) {
-        stbi_image_free(pixels);
         throw std::runtime_error("failed to create image staging buffer!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(_device, _imageBuffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    InitBuffer initB;
-    allocInfo.memoryTypeIndex = initB.findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, _physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_imageBufferMemory) != VK_SUCCESS) {
-        stbi_image_free(pixels);
+    try {
+        _imageBufferMemory = MemoryAllocator::of(_device).allocateBuffer(
+            _imageBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging);
+    } catch (const std::exception&) {
         throw std::runtime_error("failed to allocate image staging buffer memory!");
     }
 
-    vkBindBufferMemory(_device, _imageBuffer, _imageBufferMemory, 0);
-
     // copy pixel data into mapped memory
-    void* data;
-    vkMapMemory(_device, _imageBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory(_device, _imageBufferMemory);
-
-    stbi_image_free(pixels);
-    
+    memcpy(_imageBufferMemory.mapped, image.pixels.get(), static_cast<size_t>(imageSize));
 }
 
 void Texture::destroyImageBuffer() {
@@ -62,15 +69,18 @@ void Texture::destroyImageBuffer() {
         vkDestroyBuffer(_device, _imageBuffer, nullptr);
         _imageBuffer = VK_NULL_HANDLE;
     }
-    if (_imageBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _imageBufferMemory, nullptr);
-        _imageBufferMemory = VK_NULL_HANDLE;
+    if (_imageBufferMemory) {
+        MemoryAllocator::of(_device).free(_imageBufferMemory);
     }
 }
 
 void Texture::destroy() {
     if (_textureSampler != VK_NULL_HANDLE) {
-        vkDestroySampler(_device, _textureSampler, nullptr);
+        if (_samplerCache) {
+            _samplerCache->release(_textureSampler);
+        } else {
+            vkDestroySampler(_device, _textureSampler, nullptr);
+        }
         _textureSampler = VK_NULL_HANDLE;
     }
 
@@ -84,14 +94,156 @@ void Texture::destroy() {
         _textureImage = VK_NULL_HANDLE;
     }
 
-    if (_textureImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _textureImageMemory, nullptr);
-        _textureImageMemory = VK_NULL_HANDLE;
+    if (_textureImageMemory) {
+        MemoryAllocator::of(_device).free(_textureImageMemory);
     }
 
     destroyImageBuffer();
 }
 
+void Texture::createImage(const ImageData& image, UploadManager* uploads) {
+    ImageData upload = prepareImage(image);
+    createTextureImage();
+    allocateTextureImageMemory();
+    if (uploads) {
+        recordUpload(*uploads, upload);
+    } else {
+        createImageBuffer(upload);
+        copyBufferToImage();
+        destroyImageBuffer();
+    }
+    createTextureImageView();
+}
+
+Texture::RetiredImage Texture::releaseImage() {
+    RetiredImage retired;
+    retired.image = _textureImage;
+    retired.memory = _textureImageMemory;
+    retired.view = _textureImageView;
+    _textureImage = VK_NULL_HANDLE;
+    _textureImageMemory = MemoryAllocation{};
+    _textureImageView = VK_NULL_HANDLE;
+    return retired;
+}
+
+Texture::RetiredImage Texture::streamIn(const ImageData& slice, UploadManager* uploads) {
+    RetiredImage retired = releaseImage();
+    createImage(slice, uploads);
+    return retired;
+}
+
+Texture::RetiredImage Texture::evict(uint32_t residentLevel, UploadManager* uploads) {
+    const uint32_t dropped = residentLevel - _residentLevel;
+    const uint32_t oldMipLevels = _mipLevels;
+    if (residentLevel <= _residentLevel || dropped >= oldMipLevels) {
+        return RetiredImage{};
+    }
+    RetiredImage retired = releaseImage();
+
+    _texWidth = static_cast<int>(ImageData::levelExtent(_texWidth, dropped));
+    _texHeight = static_cast<int>(ImageData::levelExtent(_texHeight, dropped));
+    _mipLevels = oldMipLevels - dropped;
+    _residentLevel = residentLevel;
+    ImageData rgbaLayout;
+    rgbaLayout.width = _texWidth;
+    rgbaLayout.height = _texHeight;
+    rgbaLayout.mipLevels = _mipLevels;
+    _uncompressedByteSize = rgbaLayout.byteSize();
+
+    createTextureImage();
+    allocateTextureImageMemory();
+
+    // vkCmdCopyImage zwischen zwei Images, daher auf der Graphics-Queue
+    VkCommandBuffer commandBuffer = uploads ? uploads->graphicsCommands()
+                                            : buf.beginSingleTimeCommands(_device, _commandPool);
+
+    std::array<VkImageMemoryBarrier, 2> barriers{};
+    for (VkImageMemoryBarrier& barrier : barriers) {
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.subresourceRange = allLevels();
+    }
+    // altes Image: nur noch Quelle, wird danach nicht mehr gesampelt
+    barriers[0].image = retired.image;
+    barriers[0].subresourceRange.baseMipLevel = dropped;
+    barriers[0].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barriers[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barriers[1].image = _textureImage;
+    barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barriers[1].srcAccessMask = 0;
+    barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    std::vector<VkImageCopy> regions(_mipLevels);
+    for (uint32_t level = 0; level < _mipLevels; level++) {
+        VkImageCopy& region = regions[level];
+        region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level + dropped, 0, 1};
+        region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+        region.srcOffset = {0, 0, 0};
+        region.dstOffset = {0, 0, 0};
+        region.extent = {
+            ImageData::levelExtent(_texWidth, level),
+            ImageData::levelExtent(_texHeight, level),
+            1
+        };
+    }
+    vkCmdCopyImage(commandBuffer,
+        retired.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        _textureImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        static_cast<uint32_t>(regions.size()), regions.data());
+
+    VkImageMemoryBarrier barrier = barriers[1];
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    if (uploads) {
+        _uploadTicket = uploads->pendingTicket();
+    } else {
+        buf.endSingleTimeCommands(_device, _commandPool, _queue, commandBuffer);
+    }
+    createTextureImageView();
+    return retired;
+}
+
+VkSampler Texture::setMinLod(float minLod) {
+    if (!_samplerCache || minLod == _minLod) {
+        return VK_NULL_HANDLE;
+    }
+    SamplerDesc desc;
+    desc.minLod = minLod;
+    VkSampler old = _textureSampler;
+    _textureSampler = _samplerCache->acquire(desc);
+    _minLod = minLod;
+    return old;
+}
+
+void Texture::destroyRetired(VkDevice device, SamplerCache* samplerCache, const RetiredImage& retired) {
+    if (retired.sampler != VK_NULL_HANDLE && samplerCache) {
+        samplerCache->release(retired.sampler);
+    }
+    if (retired.view != VK_NULL_HANDLE) {
+        vkDestroyImageView(device, retired.view, nullptr);
+    }
+    if (retired.image != VK_NULL_HANDLE) {
+        vkDestroyImage(device, retired.image, nullptr);
+    }
+    if (retired.memory) {
+        MemoryAllocation memory = retired.memory;
+        MemoryAllocator::of(device).free(memory);
+    }
+}
+
 void Texture::createTextureImage() {
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -101,7 +253,7 @@ void Texture::createTextureImage() {
     imageInfo.extent.depth = 1;
     imageInfo.mipLevels = _mipLevels;
     imageInfo.arrayLayers = 1;
-    imageInfo.format = IMAGE_FORMAT;
+    imageInfo.format = _format;
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;                            //Für Mipmaps \/
     imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
@@ -115,29 +267,79 @@ void Texture::createTextureImage() {
 }
 
 void Texture::allocateTextureImageMemory() {
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(_device, _textureImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    InitBuffer initB;
-    allocInfo.memoryTypeIndex = initB.findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,_physicalDevice);
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_textureImageMemory) != VK_SUCCESS) {
+    try {
+        _textureImageMemory = MemoryAllocator::of(_device).allocateImage(_textureImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                          MemoryCategory::Texture);
+    } catch (const std::exception&) {
         throw std::runtime_error("failed to allocate texture image memory!");
     }
-
-    vkBindImageMemory(_device, _textureImage, _textureImageMemory, 0);
+    _imageByteSize = _textureImageMemory.size;
 }
 
-InitBuffer buf;
 void Texture::copyBufferToImage() {
     //commandBuffer anlegen
     VkCommandBuffer commandBuffer = buf.beginSingleTimeCommands(_device,_commandPool);
-  
+    recordCopy(commandBuffer, _imageBuffer, 0);
+    buf.endSingleTimeCommands(_device,_commandPool,_queue,commandBuffer);
+}
+
+VkImageSubresourceRange Texture::allLevels() const {
+    VkImageSubresourceRange range{};
+    range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.baseMipLevel = 0;
+    range.levelCount = _mipLevels;
+    range.baseArrayLayer = 0;
+    range.layerCount = 1;
+    return range;
+}
+
+void Texture::recordCopy(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
+    if (!_precomputedMips) {
+        recordLevelZeroCopy(commandBuffer, buffer, offset);
+        recordMipBlits(commandBuffer);
+        return;
+    }
+    recordPrecomputedCopy(commandBuffer, buffer, offset);
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = _textureImage;
+    barrier.subresourceRange = allLevels();
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void Texture::recordUpload(UploadManager& uploads, const ImageData& image) {
+    UploadManager::StagingRange staging = uploads.stage(image.pixels.get(), image.byteSize());
+    VkCommandBuffer transfer = uploads.transferCommands();
+
+    if (_precomputedMips) {
+        recordPrecomputedCopy(transfer, staging.buffer, staging.offset);
+        uploads.releaseImage(_textureImage, allLevels(),
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    } else {
+        // vkCmdBlitImage braucht eine Graphics-Queue: erst nach dem Acquire
+        recordLevelZeroCopy(transfer, staging.buffer, staging.offset);
+        uploads.releaseImage(_textureImage, allLevels(),
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+        recordMipBlits(uploads.graphicsCommands());
+    }
+    _uploadTicket = uploads.pendingTicket();
+}
 
-    // transition: undefined -> transfer dst optimal
+void Texture::recordLevelZeroCopy(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
+
+    // transition: undefined -> transfer dst optimal (alle Levels, die Blits schreiben hinein)
     VkImageMemoryBarrier barrierToTransfer{};
     barrierToTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrierToTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -145,11 +347,7 @@ void Texture::copyBufferToImage() {
     barrierToTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrierToTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrierToTransfer.image = _textureImage;
-    barrierToTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrierToTransfer.subresourceRange.baseMipLevel = 0;
-    barrierToTransfer.subresourceRange.levelCount = 1;
-    barrierToTransfer.subresourceRange.baseArrayLayer = 0;
-    barrierToTransfer.subresourceRange.layerCount = 1;
+    barrierToTransfer.subresourceRange = allLevels();
     barrierToTransfer.srcAccessMask = 0; // as oldLayout is undefined
     barrierToTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
 
@@ -164,7 +362,7 @@ void Texture::copyBufferToImage() {
 
     // copy buffer to image
     VkBufferImageCopy region{};
-    region.bufferOffset = 0;
+    region.bufferOffset = offset;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
     region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -180,13 +378,15 @@ void Texture::copyBufferToImage() {
 
     vkCmdCopyBufferToImage(
         commandBuffer,
-        _imageBuffer,
+        buffer,
         _textureImage,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
         1,
         &region
     );
+}
 
+void Texture::recordMipBlits(VkCommandBuffer commandBuffer) {
     int32_t mipWidth = _texWidth;
     int32_t mipHeight = _texHeight;
 //Für alle Mipmap Levels:
@@ -275,7 +475,12 @@ void Texture::copyBufferToImage() {
     } //Ende "Für alle Mipmap-Levels"
 
     // Für letztes MipMap-Level zu SHADER_READ_ONLY_OPTIMAL
-    VkImageMemoryBarrier barrierLast = barrierToTransfer;
+    VkImageMemoryBarrier barrierLast{};
+    barrierLast.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrierLast.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrierLast.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrierLast.image = _textureImage;
+    barrierLast.subresourceRange = allLevels();
     barrierLast.subresourceRange.baseMipLevel = _mipLevels - 1;
     barrierLast.subresourceRange.levelCount = 1;
     barrierLast.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
@@ -291,9 +496,45 @@ void Texture::copyBufferToImage() {
         0, nullptr,
         1, &barrierLast
     );
+}
 
-    
-    buf.endSingleTimeCommands(_device,_commandPool,_queue,commandBuffer);
+void Texture::recordPrecomputedCopy(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
+    // alle Levels auf einmal: undefined -> transfer dst
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = _textureImage;
+    barrier.subresourceRange = allLevels();
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    // eine Region pro Level, ein einziger Copy-Befehl
+    std::vector<VkBufferImageCopy> regions(_mipLevels);
+    for (uint32_t level = 0; level < _mipLevels; level++) {
+        VkBufferImageCopy& region = regions[level];
+        region.bufferOffset = offset + _levelOffsets[level];
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {
+            ImageData::levelExtent(_texWidth, level),
+            ImageData::levelExtent(_texHeight, level),
+            1
+        };
+    }
+    vkCmdCopyBufferToImage(commandBuffer, buffer, _textureImage,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
 }
 
 void Texture::createTextureImageView() {
@@ -301,7 +542,7 @@ void Texture::createTextureImageView() {
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = _textureImage;
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = IMAGE_FORMAT;
+    viewInfo.format = _format;
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
     viewInfo.subresourceRange.levelCount = _mipLevels;
@@ -9,6 +9,9 @@
 #include <stdexcept>
 
 #include "../initBuffer.hpp"
+#include "ImageData.hpp"
+#include "SamplerCache.hpp"
+#include "../UploadManager.hpp"
 
 class Texture {
 public:
@@ -17,7 +20,8 @@ public:
     , _device(device) 
     , _commandPool(commandPool)
     , _queue(queue) {
-        createImageBuffer(filename);
+        ImageData image = prepareImage(ImageData::load(filename));
+        createImageBuffer(image);
         createTextureImage();
         allocateTextureImageMemory();
         copyBufferToImage();
@@ -26,6 +30,24 @@ public:
         createTextureSampler();
     }
 
+    // Variante mit bereits dekodierten Pixeln (z.B. aus dem ThreadPool).
+    // Mit samplerCache wird der Sampler geteilt statt selbst erzeugt.
+    // Mit uploads wird der Upload nur aufgezeichnet - fertig, sobald getUploadTicket() erreicht ist
+    Texture(VkPhysicalDevice physicalDevice, VkDevice device, VkCommandPool commandPool, VkQueue queue,
+            const ImageData& image, SamplerCache* samplerCache = nullptr, UploadManager* uploads = nullptr)
+    : _physicalDevice(physicalDevice)
+    , _device(device) 
+    , _commandPool(commandPool)
+    , _queue(queue)
+    , _samplerCache(samplerCache) {
+        createImage(image, uploads);
+        if (_samplerCache) {
+            _textureSampler = _samplerCache->acquire(SamplerDesc{});
+        } else {
+            createTextureSampler();
+        }
+    }
+
     void destroy();
 
     VkImageView getImageView() {
@@ -36,8 +58,54 @@ public:
         return _textureSampler;
     }
 
+    // Belegter Speicher des Images inkl. Mip-Levels
+    VkDeviceSize getByteSize() const {
+        return _imageByteSize;
+    }
+
+    // Gleiche Mip-Kette als RGBA8 (Vergleichswert für die Ersparnis durch BC-Formate)
+    VkDeviceSize getUncompressedByteSize() const {
+        return _uncompressedByteSize;
+    }
+
+    VkFormat getFormat() const {
+        return _format;
+    }
+
+    int getWidth() const { return _texWidth; }
+    int getHeight() const { return _texHeight; }
+
+    // Ticket im UploadManager (0 = synchron hochgeladen)
+    UploadManager::Ticket getUploadTicket() const { return _uploadTicket; }
+
+    // Teil-Residenz für den TextureStreamer: das Image enthält nur die Levels ab
+    // getResidentLevel() der vollen Kette, Level 0 des Images ist also dieses Level der Quelle.
+    // Ausgetauschte Images/Sampler kommen als RetiredImage zurück und dürfen erst zerstört
+    // werden, wenn kein Frame in Flight sie mehr benutzt (destroyRetired)
+    struct RetiredImage {
+        VkImage image = VK_NULL_HANDLE;
+        MemoryAllocation memory;
+        VkImageView view = VK_NULL_HANDLE;
+        VkSampler sampler = VK_NULL_HANDLE;    // nur mit SamplerCache
+    };
+
+    uint32_t getResidentLevel() const { return _residentLevel; }
+    uint32_t getFullMipLevels() const { return _residentLevel + _mipLevels; }
+    float getMinLod() const { return _minLod; }
+
+    // Neues Image aus slice (ImageData::fromLevel, feiner als bisher)
+    RetiredImage streamIn(const ImageData& slice, UploadManager* uploads);
+    // Verwirft alle Levels feiner als residentLevel: kleineres Image, die übrigen Levels
+    // werden auf der GPU aus dem alten kopiert (ohne erneutes Laden)
+    RetiredImage evict(uint32_t residentLevel, UploadManager* uploads);
+    // Sampler mit anderem minLod aus dem SamplerCache (zum Einblenden neuer Levels).
+    // Rückgabe: alter Sampler (VK_NULL_HANDLE, wenn sich nichts geändert hat)
+    VkSampler setMinLod(float minLod);
+
+    static void destroyRetired(VkDevice device, SamplerCache* samplerCache, const RetiredImage& retired);
+
 private:
-    const VkFormat IMAGE_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+    VkFormat _format = VK_FORMAT_R8G8B8A8_SRGB;   // BC1/BC3/BC7 aus gebackenen Texturen, falls unterstützt
 
     VkPhysicalDevice _physicalDevice = VK_NULL_HANDLE;
     VkDevice _device = VK_NULL_HANDLE;
@@ -45,29 +113,49 @@ private:
     VkQueue _queue = VK_NULL_HANDLE;
 
     VkBuffer _imageBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _imageBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation _imageBufferMemory;
     int _texWidth = 0;
     int _texHeight = 0;
     uint32_t _mipLevels = 0;
+    bool _precomputedMips = false;              // Mip-Kette kommt fertig aus .btex/.ktx2
+    std::vector<VkDeviceSize> _levelOffsets;    // Offsets der Levels im Staging Buffer
 
     VkImage _textureImage = VK_NULL_HANDLE;
-    VkDeviceMemory _textureImageMemory = VK_NULL_HANDLE;
+    MemoryAllocation _textureImageMemory;
     VkImageView _textureImageView = VK_NULL_HANDLE;
     VkSampler _textureSampler = VK_NULL_HANDLE;
+    SamplerCache* _samplerCache = nullptr;      // nullptr = Sampler gehört der Textur
+    VkDeviceSize _imageByteSize = 0;
+    VkDeviceSize _uncompressedByteSize = 0;
+    UploadManager::Ticket _uploadTicket = 0;
+    uint32_t _residentLevel = 0;                // feinstes Level der Quelle im Image (ImageData::baseLevel)
+    float _minLod = 0.0f;
+
+    // prepareImage + Image, Speicher, Upload und View (ohne Sampler)
+    void createImage(const ImageData& image, UploadManager* uploads);
+    // Gibt die aktuellen Handles ab und setzt die Member zurück
+    RetiredImage releaseImage();
+
+    // pick format and mip levels for the upload
+    // - pixel data comes already decoded in source
+    // - block-compressed data is used as is if the device supports the format, otherwise decompressed to RGBA8
+    // - save texture width and height in _texWidth and _texHeight
+    // - save number of mipmap levels in _mipLevels
+    // - save image.baseLevel in _residentLevel
+    // - returns the data to upload
+    ImageData prepareImage(const ImageData& source);
 
     // create the staging buffer for the texture
-    // - load pixel data from file with name filename
+    // - copy all levels of image into it
     // - save objects in member variables _imageBuffer and _imageBufferMemory
-    // - save texture width and height in _texWidth and _texHeight
-    // - save number of mipmap levels in _mipLevels
-    void createImageBuffer(const char* filename);
+    void createImageBuffer(const ImageData& image);
 
     // destroy the staging buffer for the texture and free its memory
     void destroyImageBuffer();
 
     // create the image object for the texture
     // - use values from _texWidth, _texHeight and _mipLevels
-    // - format should be VK_FORMAT_R8G8B8A8_SRGB
+    // - format is _format (VK_FORMAT_R8G8B8A8_SRGB or a BC format)
     // - tiling shoud be "optimal"
     // - layout has to be "undefined"
     // - usage is "transfer source", "transfer destination" and "sampled"
@@ -102,6 +190,22 @@ private:
     // - free the command buffer
     void copyBufferToImage();
 
+    // Zeichnet den Upload aus buffer (ab offset) in commandBuffer auf, ohne abzuschicken
+    void recordCopy(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset);
+    // Gleicher Upload über den UploadManager: Copy auf der Transfer-Queue,
+    // Mip-Blits nach dem Ownership-Transfer auf der Graphics-Queue
+    void recordUpload(UploadManager& uploads, const ImageData& image);
+
+    // alle Levels undefined -> transfer dst, dann Level 0 aus buffer kopieren (JPEG/PNG)
+    void recordLevelZeroCopy(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset);
+    // Blit-Kette ab Level 0 (alle Levels in transfer dst), endet mit allen Levels in shader read-only
+    void recordMipBlits(VkCommandBuffer commandBuffer);
+
+    // Variante für .btex/.ktx2: alle Levels liegen schon im Staging Buffer,
+    // ein vkCmdCopyBufferToImage mit einer Region pro Level, kein Blit (endet in transfer dst)
+    void recordPrecomputedCopy(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset);
+    VkImageSubresourceRange allLevels() const;
+
     // create an image view for _textureImage
     // - subresource range has to contain all mipmap levels
     // - save to _textureImageView
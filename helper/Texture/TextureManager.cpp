@@ -0,0 +1,167 @@
+#include "TextureManager.hpp"
+#include "../ObjectLoading/MeshRegistry.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+VkDeviceSize TextureManager::compressionSaving(const Texture& texture) {
+    if (!BlockCompression::isCompressed(texture.getFormat())) {
+        return 0;
+    }
+    return texture.getUncompressedByteSize() > texture.getByteSize()
+        ? texture.getUncompressedByteSize() - texture.getByteSize() : 0;
+}
+
+bool TextureManager::contains(const std::string& path) const {
+    return _textures.count(MeshRegistry::normalizePath(path)) > 0;
+}
+
+std::shared_ptr<Texture> TextureManager::find(const std::string& path) {
+    auto it = _textures.find(MeshRegistry::normalizePath(path));
+    if (it == _textures.end()) {
+        return nullptr;
+    }
+    _stats.hits++;
+    _stats.savedBytes += it->second->getByteSize();
+    return it->second;
+}
+
+std::shared_ptr<Texture> TextureManager::acquire(const std::string& path, const ImageData& image) {
+    if (std::shared_ptr<Texture> existing = find(path)) {
+        return existing;
+    }
+
+    // schon auf dem Worker verkleinert (initialLevels) oder erst hier
+    auto texture = std::make_shared<Texture>(_physicalDevice, _device, _commandPool, _queue,
+                                             image.baseLevel > 0 ? image : initialLevels(image),
+                                             &_samplerCache, _batching ? _uploadManager : nullptr);
+    _textures[MeshRegistry::normalizePath(path)] = texture;
+    if (_streamer && texture->getResidentLevel() > 0) {
+        _streamer->track(MeshRegistry::normalizePath(path), texture.get());
+    }
+
+    _stats.misses++;
+    if (_batching) {
+        _batchUploads++;
+    }
+    _stats.residentBytes += texture->getByteSize();
+    _stats.compressionSavedBytes += compressionSaving(*texture);
+    _stats.textureCount = _textures.size();
+
+    if (BlockCompression::isCompressed(texture->getFormat())) {
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Textur " << path << ": " << BlockCompression::formatName(texture->getFormat()) << " "
+                  << texture->getWidth() << "x" << texture->getHeight() << ", "
+                  << texture->getByteSize() / (1024.0 * 1024.0) << " MB statt "
+                  << texture->getUncompressedByteSize() / (1024.0 * 1024.0) << " MB ("
+                  << double(texture->getUncompressedByteSize()) / double(texture->getByteSize()) << "x)"
+                  << std::defaultfloat << std::endl;
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureManager::acquire(const std::string& path) {
+    if (std::shared_ptr<Texture> existing = find(path)) {
+        return existing;
+    }
+    return acquire(path, ImageData::load(path));
+}
+
+void TextureManager::enableStreaming(VkDeviceSize budget) {
+    if (_streamer) {
+        _streamer->setBudget(budget);
+        return;
+    }
+    _streamer = std::make_unique<TextureStreamer>(_device, _samplerCache, _uploadManager, budget);
+}
+
+ImageData TextureManager::initialLevels(const ImageData& image) const {
+    if (!_streamer || !image.pixels) {
+        return image;
+    }
+    return image.fromLevel(TextureStreamer::initialLevel(image));
+}
+
+void TextureManager::updateStreaming(Scene& scene, const glm::vec3& eye, float pixelsPerUnit) {
+    if (!_streamer) {
+        return;
+    }
+    _streamer->update(scene, eye, pixelsPerUnit);
+    recountResidentBytes();
+}
+
+void TextureManager::recountResidentBytes() {
+    _stats.residentBytes = 0;
+    _stats.compressionSavedBytes = 0;
+    for (const auto& [path, texture] : _textures) {
+        _stats.residentBytes += texture->getByteSize();
+        _stats.compressionSavedBytes += compressionSaving(*texture);
+    }
+}
+
+void TextureManager::beginBatch() {
+    _batching = _uploadManager != nullptr;
+    _batchUploads = 0;
+}
+
+size_t TextureManager::endBatch() {
+    _batching = false;
+    return _batchUploads;
+}
+
+size_t TextureManager::releaseUnused() {
+    size_t released = 0;
+    for (auto it = _textures.begin(); it != _textures.end();) {
+        if (it->second.use_count() == 1) {
+            // nicht zerstören, solange der Upload noch läuft
+            if (_uploadManager) {
+                _uploadManager->wait(it->second->getUploadTicket());
+            }
+            _stats.residentBytes -= it->second->getByteSize();
+            _stats.compressionSavedBytes -= compressionSaving(*it->second);
+            if (_streamer) {
+                _streamer->untrack(it->second.get());
+            }
+            it->second->destroy();
+            it = _textures.erase(it);
+            released++;
+        } else {
+            ++it;
+        }
+    }
+    _stats.textureCount = _textures.size();
+    return released;
+}
+
+void TextureManager::destroyAll() {
+    if (_uploadManager) {
+        _uploadManager->waitIdle();
+    }
+    _batching = false;
+    // ausgetauschte Images und Fade-Sampler vor den Texturen und dem SamplerCache
+    if (_streamer) {
+        _streamer->destroyAll();
+    }
+    for (auto& [path, texture] : _textures) {
+        texture->destroy();
+    }
+    _textures.clear();
+    _samplerCache.destroyAll();
+    _stats.residentBytes = 0;
+    _stats.compressionSavedBytes = 0;
+    _stats.textureCount = 0;
+}
+
+void TextureManager::printStats() const {
+    std::cout << std::fixed << std::setprecision(2)
+              << "TextureManager: " << _stats.textureCount << " Texturen, "
+              << _samplerCache.size() << " Sampler (" << _samplerCache.getRequestCount() << " Anfragen), "
+              << _stats.hits << " Treffer / " << _stats.misses << " Uploads, "
+              << _stats.residentBytes / (1024.0 * 1024.0) << " MB belegt, "
+              << _stats.savedBytes / (1024.0 * 1024.0) << " MB eingespart, "
+              << _stats.compressionSavedBytes / (1024.0 * 1024.0) << " MB durch Kompression gespart"
+              << std::defaultfloat << std::endl;
+    if (_streamer) {
+        _streamer->printStats();
+    }
+}
@@ -0,0 +1,97 @@
+// TextureManager.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <glm/glm.hpp>
+#include <string>
+#include <unordered_map>
+
+#include "Texture.hpp"
+#include "ImageData.hpp"
+#include "SamplerCache.hpp"
+#include "TextureStreamer.hpp"
+#include "../UploadManager.hpp"
+
+class Scene;
+
+// Jede Bilddatei wird nur einmal hochgeladen, Texturen werden per shared_ptr geteilt
+class TextureManager {
+public:
+    struct Stats {
+        uint64_t hits = 0;              // Textur war schon geladen
+        uint64_t misses = 0;            // Textur musste hochgeladen werden
+        VkDeviceSize residentBytes = 0; // aktuell belegter Image-Speicher
+        VkDeviceSize savedBytes = 0;    // durch Treffer eingesparter Speicher
+        VkDeviceSize compressionSavedBytes = 0; // durch BC-Formate gegenüber RGBA8 eingespart (resident)
+        size_t textureCount = 0;
+    };
+
+    // uploadManager == nullptr: jede Textur wird einzeln synchron hochgeladen
+    TextureManager(VkPhysicalDevice physicalDevice, VkDevice device,
+                   VkCommandPool commandPool, VkQueue queue,
+                   UploadManager* uploadManager = nullptr)
+        : _physicalDevice(physicalDevice), _device(device),
+          _commandPool(commandPool), _queue(queue),
+          _samplerCache(physicalDevice, device),
+          _uploadManager(uploadManager) {}
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    // Nur nachsehen, zählt nicht in die Statistik
+    bool contains(const std::string& path) const;
+
+    // Schon geladene Textur (zählt als hit) oder nullptr
+    std::shared_ptr<Texture> find(const std::string& path);
+
+    // Liefert die Textur zu path; image wird nur hochgeladen, wenn es sie noch nicht gibt
+    std::shared_ptr<Texture> acquire(const std::string& path, const ImageData& image);
+    // Synchrone Variante, dekodiert die Datei bei Bedarf selbst
+    std::shared_ptr<Texture> acquire(const std::string& path);
+
+    // Folgende Uploads laufen über den UploadManager; benutzbar, sobald er sie abgeschickt hat
+    // (Befehle danach auf der Graphics-Queue sind über die Acquire-Barriere synchronisiert)
+    void beginBatch();
+    // Rückgabe: Anzahl der seit beginBatch() aufgezeichneten Texturen
+    size_t endBatch();
+
+    // Mip-Streaming mit VRAM-Budget für alle danach geladenen Texturen
+    void enableStreaming(VkDeviceSize budget = TextureStreamer::DEFAULT_BUDGET);
+    bool isStreaming() const { return _streamer != nullptr; }
+    // Auf einem Worker-Thread: reduziert image auf die anfangs residenten Levels
+    // (unverändert ohne Streaming oder bei kleinen Bildern)
+    ImageData initialLevels(const ImageData& image) const;
+    // Einmal pro Frame, siehe TextureStreamer::update
+    void updateStreaming(Scene& scene, const glm::vec3& eye, float pixelsPerUnit);
+    TextureStreamer* getStreamer() { return _streamer.get(); }
+
+    // Zerstört alle Texturen, die nur noch vom Manager referenziert werden
+    size_t releaseUnused();
+    // Zerstört alle Texturen und Sampler (vor vkDestroyDevice aufrufen)
+    void destroyAll();
+
+    SamplerCache& getSamplerCache() { return _samplerCache; }
+    const Stats& getStats() const { return _stats; }
+    void printStats() const;
+
+private:
+    // RGBA8-Größe minus tatsächliche Größe (0 bei unkomprimierten Texturen)
+    static VkDeviceSize compressionSaving(const Texture& texture);
+    // residentBytes/compressionSavedBytes neu zählen (Streaming ändert die Größen)
+    void recountResidentBytes();
+
+    VkPhysicalDevice _physicalDevice;
+    VkDevice _device;
+    VkCommandPool _commandPool;
+    VkQueue _queue;
+
+    SamplerCache _samplerCache;
+    UploadManager* _uploadManager;
+    bool _batching = false;
+    size_t _batchUploads = 0;
+    std::unordered_map<std::string, std::shared_ptr<Texture>> _textures;
+    std::unique_ptr<TextureStreamer> _streamer;
+    Stats _stats;
+};
@@ -0,0 +1,382 @@
+#include "TextureStreamer.hpp"
+#include "../../Scene.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+TextureStreamer::TextureStreamer(VkDevice device, SamplerCache& samplerCache, UploadManager* uploads,
+                                 VkDeviceSize budget)
+    : _device(device), _samplerCache(samplerCache), _uploads(uploads), _budget(budget) {
+    _stats.budget = budget;
+}
+
+uint32_t TextureStreamer::initialLevel(const ImageData& image) {
+    if (image.baseLevel > 0) {
+        return 0;   // schon verkleinert
+    }
+    const uint32_t coarsest = image.runtimeMips ? ImageData::fullMipLevels(image.width, image.height) - 1
+                                                : image.mipLevels - 1;
+    uint32_t level = 0;
+    while (level < coarsest && std::max(ImageData::levelExtent(image.width, level),
+                                        ImageData::levelExtent(image.height, level)) > INITIAL_MAX_EXTENT) {
+        level++;
+    }
+    return level;
+}
+
+void TextureStreamer::track(const std::string& path, Texture* texture) {
+    Entry entry;
+    entry.path = path;
+    entry.texture = texture;
+    entry.initialLevel = texture->getResidentLevel();
+    entry.neededLevel = entry.initialLevel;
+    // Größe der Quelle nur zurückgerechnet - reicht für Schätzungen
+    entry.layout.width = texture->getWidth() << entry.initialLevel;
+    entry.layout.height = texture->getHeight() << entry.initialLevel;
+    entry.layout.format = texture->getFormat();
+    entry.layout.mipLevels = texture->getFullMipLevels();
+    _entries[texture] = std::move(entry);
+    updateStats();
+}
+
+void TextureStreamer::untrack(const Texture* texture) {
+    _entries.erase(texture);
+    _changed.erase(texture);
+    updateStats();
+}
+
+uint32_t TextureStreamer::levelFor(const RenderObject& obj, const glm::vec4& worldBounds, const Entry& entry,
+                                   const glm::vec3& eye, float pixelsPerUnit) const {
+    // Instanzen haben eigene Transformationen, da sagen Scene::getModelMatrix und
+    // die Weltraum-Bounds nichts über ihren Abstand
+    if (obj.instanceCount > 1 || worldBounds.w <= 0.0f || pixelsPerUnit <= 0.0f) {
+        return 0;
+    }
+
+    float radius = worldBounds.w;
+    float distance = glm::length(glm::vec3(worldBounds) - eye) - radius;
+    if (distance <= 0.0f) {
+        return 0;   // Kamera in der Bounding Sphere
+    }
+
+    // Annahme: die Textur liegt einmal über dem ganzen Objekt
+    float screenPixels = 2.0f * radius * pixelsPerUnit / distance;
+    float texels = static_cast<float>(std::max(entry.layout.width, entry.layout.height));
+    if (screenPixels >= texels) {
+        return 0;
+    }
+    uint32_t level = static_cast<uint32_t>(std::floor(std::log2(texels / screenPixels)));
+    return std::min(level, entry.layout.mipLevels - 1);
+}
+
+VkDeviceSize TextureStreamer::chainBytes(const Entry& entry, uint32_t level) {
+    return entry.layout.byteSize() - entry.layout.levelOffset(std::min(level, entry.layout.mipLevels));
+}
+
+VkDeviceSize TextureStreamer::residentBytes() const {
+    VkDeviceSize bytes = 0;
+    for (const auto& [key, entry] : _entries) {
+        bytes += entry.texture->getByteSize();
+    }
+    return bytes;
+}
+
+void TextureStreamer::update(Scene& scene, const glm::vec3& eye, float pixelsPerUnit) {
+    _frame++;
+    destroyRetired(false);
+
+    // Benötigtes Level = feinstes über alle Objekte mit dieser Textur
+    for (auto& [key, entry] : _entries) {
+        entry.neededLevel = entry.initialLevel;
+    }
+    for (size_t i = 0; i < scene.getObjectCount(); i++) {
+        const RenderObject& obj = scene.getObject(i);
+        if (scene.isPending(i) || !obj.texture) {
+            continue;
+        }
+        auto it = _entries.find(obj.texture.get());
+        if (it != _entries.end() && !it->second.suspended) {
+            it->second.neededLevel = std::min(it->second.neededLevel, levelFor(obj, scene.getWorldBounds(i), it->second, eye, pixelsPerUnit));
+        }
+    }
+
+    finishLoads();
+
+    // auch ohne neue Ladevorgänge nicht dauerhaft über dem Budget bleiben (z.B. nach setBudget)
+    VkDeviceSize resident = residentBytes();
+    if (resident > _budget) {
+        evict(resident - _budget, nullptr);
+    }
+
+    startLoads();
+
+    for (auto& [key, entry] : _entries) {
+        fadeIn(entry);
+    }
+
+    if (!_changed.empty()) {
+        if (_uploads) {
+            _uploads->submit();
+        }
+        for (const Texture* texture : _changed) {
+            scene.refreshTexture(texture);
+        }
+        _changed.clear();
+    }
+    updateStats();
+}
+
+void TextureStreamer::finishLoads() {
+    for (auto& [key, entry] : _entries) {
+        if (!entry.loading.valid()
+            || entry.loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continue;
+        }
+        ImageData slice;
+        try {
+            slice = entry.loading.get();
+        } catch (const std::exception& e) {
+            std::cerr << "TextureStreamer: " << entry.path << " konnte nicht nachgeladen werden: "
+                      << e.what() << std::endl;
+            entry.failed = true;
+            continue;
+        }
+
+        Texture& texture = *entry.texture;
+        const uint32_t previous = texture.getResidentLevel();
+        if (entry.suspended || slice.baseLevel >= previous) {
+            continue;
+        }
+        retire(texture.streamIn(slice, _uploads), 0);
+        _stats.streamedIn++;
+
+        // Sampler bleibt erstmal beim bisher feinsten Level, fadeIn() gibt die neuen Levels frei
+        setMinLod(texture, texture.getMinLod() + static_cast<float>(previous - texture.getResidentLevel()));
+        _changed.insert(&texture);
+    }
+}
+
+void TextureStreamer::startLoads() {
+    std::vector<Entry*> candidates;
+    size_t pending = 0;
+    VkDeviceSize reserved = 0;      // Zuwachs der laufenden Ladevorgänge
+    for (auto& [key, entry] : _entries) {
+        if (entry.loading.valid()) {
+            pending++;
+            VkDeviceSize target = chainBytes(entry, entry.loadingLevel);
+            VkDeviceSize current = entry.texture->getByteSize();
+            reserved += target > current ? target - current : 0;
+        } else if (!entry.failed && entry.neededLevel < entry.texture->getResidentLevel()) {
+            candidates.push_back(&entry);
+        }
+    }
+
+    // größter Rückstand zuerst
+    std::sort(candidates.begin(), candidates.end(), [](const Entry* a, const Entry* b) {
+        return a->texture->getResidentLevel() - a->neededLevel > b->texture->getResidentLevel() - b->neededLevel;
+    });
+
+    _stats.budgetLimited = 0;
+    VkDeviceSize resident = residentBytes();
+    for (Entry* entry : candidates) {
+        if (pending >= MAX_PENDING_LOADS) {
+            break;
+        }
+        Texture& texture = *entry->texture;
+        const VkDeviceSize current = texture.getByteSize();
+        auto projected = [&](uint32_t level) {
+            return resident + reserved - current + chainBytes(*entry, level);
+        };
+
+        if (projected(entry->neededLevel) > _budget) {
+            resident -= evict(projected(entry->neededLevel) - _budget, entry);
+        }
+        // passt das benötigte Level nicht, wenigstens das feinste, das noch passt
+        uint32_t level = entry->neededLevel;
+        while (level < texture.getResidentLevel() && projected(level) > _budget) {
+            level++;
+        }
+        if (level != entry->neededLevel) {
+            _stats.budgetLimited++;
+        }
+        if (level >= texture.getResidentLevel()) {
+            continue;
+        }
+
+        entry->loadingLevel = level;
+        std::string path = entry->path;
+        entry->loading = _loader.submit([path, level]() { return ImageData::load(path).fromLevel(level); });
+        VkDeviceSize target = chainBytes(*entry, level);
+        reserved += target > current ? target - current : 0;
+        pending++;
+    }
+}
+
+VkDeviceSize TextureStreamer::evict(VkDeviceSize bytes, const Entry* except) {
+    std::vector<Entry*> candidates;
+    for (auto& [key, entry] : _entries) {
+        if (&entry != except && !entry.loading.valid()
+            && entry.texture->getResidentLevel() < entry.neededLevel) {
+            candidates.push_back(&entry);
+        }
+    }
+
+    // meiste überflüssige Bytes zuerst
+    auto surplus = [](const Entry* entry) {
+        VkDeviceSize needed = chainBytes(*entry, entry->neededLevel);
+        VkDeviceSize current = entry->texture->getByteSize();
+        return current > needed ? current - needed : 0;
+    };
+    std::sort(candidates.begin(), candidates.end(), [&](const Entry* a, const Entry* b) {
+        return surplus(a) > surplus(b);
+    });
+
+    VkDeviceSize freed = 0;
+    for (Entry* entry : candidates) {
+        if (freed >= bytes) {
+            break;
+        }
+        Texture& texture = *entry->texture;
+        const VkDeviceSize before = texture.getByteSize();
+        const uint32_t dropped = entry->neededLevel - texture.getResidentLevel();
+
+        // die Copy auf der GPU liest noch aus dem alten Image
+        retire(texture.evict(entry->neededLevel, _uploads), _uploads ? _uploads->pendingTicket() : 0);
+        setMinLod(texture, std::max(0.0f, texture.getMinLod() - static_cast<float>(dropped)));
+
+        const VkDeviceSize after = texture.getByteSize();
+        freed += before > after ? before - after : 0;
+        _stats.evictions++;
+        _changed.insert(&texture);
+    }
+    return freed;
+}
+
+VkDeviceSize TextureStreamer::suspend(const Texture* texture) {
+    auto it = _entries.find(texture);
+    if (it == _entries.end()) {
+        return 0;
+    }
+    Entry& entry = it->second;
+    entry.suspended = true;
+    entry.neededLevel = entry.initialLevel;
+    if (entry.texture->getResidentLevel() >= entry.initialLevel) {
+        return 0;
+    }
+    // ein laufender Ladevorgang wird in finishLoads() verworfen
+    Texture& image = *entry.texture;
+    const VkDeviceSize before = image.getByteSize();
+    const uint32_t dropped = entry.initialLevel - image.getResidentLevel();
+    retire(image.evict(entry.initialLevel, _uploads), _uploads ? _uploads->pendingTicket() : 0);
+    setMinLod(image, std::max(0.0f, image.getMinLod() - static_cast<float>(dropped)));
+    _stats.evictions++;
+    _changed.insert(&image);
+
+    const VkDeviceSize after = image.getByteSize();
+    return before > after ? before - after : 0;
+}
+
+void TextureStreamer::resume(const Texture* texture) {
+    auto it = _entries.find(texture);
+    if (it != _entries.end()) {
+        it->second.suspended = false;
+    }
+}
+
+void TextureStreamer::fadeIn(Entry& entry) {
+    Texture& texture = *entry.texture;
+    if (texture.getMinLod() > 0.0f) {
+        setMinLod(texture, std::max(0.0f, texture.getMinLod() - FADE_STEP));
+        _changed.insert(&texture);
+    }
+}
+
+void TextureStreamer::setMinLod(Texture& texture, float minLod) {
+    VkSampler old = texture.setMinLod(minLod);
+    if (old != VK_NULL_HANDLE) {
+        Texture::RetiredImage retired;
+        retired.sampler = old;
+        retire(retired, 0);
+    }
+}
+
+void TextureStreamer::retire(const Texture::RetiredImage& image, UploadManager::Ticket ticket) {
+    Retired retired;
+    retired.image = image;
+    retired.frame = _frame;
+    retired.ticket = ticket;
+    _retired.push_back(retired);
+}
+
+void TextureStreamer::destroyRetired(bool all) {
+    while (!_retired.empty()) {
+        const Retired& front = _retired.front();
+        if (!all) {
+            if (_frame - front.frame < RETIRE_FRAMES) {
+                break;
+            }
+            if (_uploads && !_uploads->isComplete(front.ticket)) {
+                break;
+            }
+        }
+        Texture::destroyRetired(_device, &_samplerCache, front.image);
+        _retired.pop_front();
+    }
+}
+
+void TextureStreamer::updateStats() {
+    _stats.streamedTextures = _entries.size();
+    _stats.fullyResident = 0;
+    _stats.pendingLoads = 0;
+    _stats.fullBytes = 0;
+    for (const auto& [key, entry] : _entries) {
+        if (entry.texture->getResidentLevel() == 0) {
+            _stats.fullyResident++;
+        }
+        if (entry.loading.valid()) {
+            _stats.pendingLoads++;
+        }
+        _stats.fullBytes += chainBytes(entry, 0);
+    }
+    _stats.residentBytes = residentBytes();
+    _stats.budget = _budget;
+}
+
+void TextureStreamer::printStats() const {
+    std::cout << std::fixed << std::setprecision(2)
+              << "TextureStreamer: " << _stats.streamedTextures << " Texturen ("
+              << _stats.fullyResident << " mit allen Levels), "
+              << _stats.residentBytes / (1024.0 * 1024.0) << " von "
+              << _stats.budget / (1024.0 * 1024.0) << " MB Budget belegt (voll resident ca. "
+              << _stats.fullBytes / (1024.0 * 1024.0) << " MB), "
+              << _stats.streamedIn << " Levels nachgeladen, "
+              << _stats.evictions << " verkleinert, "
+              << _stats.pendingLoads << " laden, "
+              << _stats.budgetLimited << " durch Budget begrenzt"
+              << std::defaultfloat << std::endl;
+}
+
+void TextureStreamer::printResidency() const {
+    for (const auto& [key, entry] : _entries) {
+        const Texture& texture = *entry.texture;
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  " << entry.path << ": Level " << texture.getResidentLevel()
+                  << " resident (benötigt " << entry.neededLevel
+                  << ", " << texture.getFullMipLevels() << " Levels), "
+                  << texture.getWidth() << "x" << texture.getHeight() << ", "
+                  << texture.getByteSize() / (1024.0 * 1024.0) << " MB"
+                  << (entry.loading.valid() ? ", lädt Level " + std::to_string(entry.loadingLevel) : "")
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void TextureStreamer::destroyAll() {
+    destroyRetired(true);
+    _entries.clear();
+    _changed.clear();
+    updateStats();
+}
@@ -0,0 +1,136 @@
+// TextureStreamer.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <glm/glm.hpp>
+
+#include "Texture.hpp"
+#include "ImageData.hpp"
+#include "SamplerCache.hpp"
+#include "../UploadManager.hpp"
+#include "../Threading/ThreadPool.hpp"
+
+class Scene;
+struct RenderObject;
+
+// Mip-Streaming großer Texturen nach Bildschirmgröße und VRAM-Budget. Nur vom Hauptthread benutzen
+class TextureStreamer {
+public:
+    // Größte Kante der anfangs residenten Levels
+    static constexpr uint32_t INITIAL_MAX_EXTENT = 256;
+    static constexpr VkDeviceSize DEFAULT_BUDGET = 128ull * 1024 * 1024;
+    // Gleichzeitig laufende Ladevorgänge
+    static constexpr size_t MAX_PENDING_LOADS = 2;
+    // Ausgetauschte Images leben noch so viele update()-Aufrufe (> MAX_FRAMES_IN_FLIGHT)
+    static constexpr uint64_t RETIRE_FRAMES = 3;
+    // minLod-Schritt pro Frame beim Einblenden neuer Levels
+    static constexpr float FADE_STEP = 0.25f;
+
+    struct Stats {
+        size_t streamedTextures = 0;    // Texturen mit Teil-Residenz
+        size_t fullyResident = 0;       // davon gerade mit allen Levels
+        size_t pendingLoads = 0;
+        size_t budgetLimited = 0;       // bekommen wegen des Budgets nicht das benötigte Level
+        VkDeviceSize residentBytes = 0; // Image-Speicher der gestreamten Texturen
+        VkDeviceSize fullBytes = 0;     // dieselben Texturen mit voller Mip-Kette (geschätzt)
+        VkDeviceSize budget = 0;
+        uint64_t streamedIn = 0;        // eingesetzte feinere Levels
+        uint64_t evictions = 0;         // wegen des Budgets verkleinert
+    };
+
+    // uploads == nullptr: Austausch synchron über commandPool/queue der Texturen
+    TextureStreamer(VkDevice device, SamplerCache& samplerCache, UploadManager* uploads,
+                    VkDeviceSize budget = DEFAULT_BUDGET);
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // Level, ab dem image anfangs hochgeladen wird (0 = klein genug, kein Streaming)
+    static uint32_t initialLevel(const ImageData& image);
+
+    // Textur, die aus ImageData::fromLevel erzeugt wurde; path wird zum Nachladen neu gelesen.
+    // Die Textur gehört weiter dem TextureManager, vor destroy() untrack() aufrufen
+    void track(const std::string& path, Texture* texture);
+    void untrack(const Texture* texture);
+
+    // Einmal pro Frame vor dem Schreiben der Descriptor Sets: schätzt die benötigten Levels,
+    // setzt fertig geladene ein, verkleinert über dem Budget, stößt neue Ladevorgänge an und
+    // trägt geänderte Views/Sampler in die Szene ein.
+    // pixelsPerUnit = Bildhöhe * 0.5 * |proj[1][1]| (wie Frame::LodView)
+    void update(Scene& scene, const glm::vec3& eye, float pixelsPerUnit);
+
+    // Für den ResidencyManager: texture bis resume() auf ihre anfangs residenten Levels
+    // verkleinern und nichts nachladen. Rückgabe: freigegebene Bytes (0 = schon so klein)
+    VkDeviceSize suspend(const Texture* texture);
+    void resume(const Texture* texture);
+    // Wird gestreamt, lässt sich also per suspend() verkleinern
+    bool isTracked(const Texture* texture) const { return _entries.count(texture) > 0; }
+
+    void setBudget(VkDeviceSize budget) { _budget = budget; }
+    VkDeviceSize getBudget() const { return _budget; }
+
+    const Stats& getStats() const { return _stats; }
+    void printStats() const;
+    // Eine Zeile pro Textur: residentes / benötigtes / volles Level
+    void printResidency() const;
+
+    // Zerstört alle ausgetauschten Images (GPU muss idle sein) und vergisst alle Texturen
+    void destroyAll();
+
+private:
+    struct Entry {
+        std::string path;
+        Texture* texture = nullptr;
+        ImageData layout;                   // volle Kette ohne Pixel, nur für Byte-Schätzungen
+        uint32_t initialLevel = 0;          // gröber wird nie verkleinert
+        uint32_t neededLevel = 0;
+        uint32_t loadingLevel = 0;
+        std::future<ImageData> loading;     // valid() = Laden läuft
+        bool failed = false;                // Nachladen fehlgeschlagen, nicht nochmal versuchen
+        bool suspended = false;             // ResidencyManager: bleibt bei initialLevel
+    };
+
+    struct Retired {
+        Texture::RetiredImage image;
+        uint64_t frame = 0;
+        UploadManager::Ticket ticket = 0;   // Copy beim Verkleinern liest noch aus dem alten Image
+    };
+
+    // Benötigtes Level von entry für obj: ein Texel pro Pixel über den Durchmesser des Objekts
+    // (worldBounds aus Scene::getWorldBounds)
+    uint32_t levelFor(const RenderObject& obj, const glm::vec4& worldBounds, const Entry& entry,
+                      const glm::vec3& eye, float pixelsPerUnit) const;
+    // Geschätzte Bytes von entry, wenn ab level resident
+    static VkDeviceSize chainBytes(const Entry& entry, uint32_t level);
+    VkDeviceSize residentBytes() const;
+
+    void finishLoads();
+    void startLoads();
+    // Verkleinert andere Texturen auf ihr benötigtes Level, bis bytes frei sind
+    VkDeviceSize evict(VkDeviceSize bytes, const Entry* except);
+    void retire(const Texture::RetiredImage& image, UploadManager::Ticket ticket);
+    void destroyRetired(bool all);
+    void fadeIn(Entry& entry);
+    // minLod von texture ändern, alten Sampler zurückstellen
+    void setMinLod(Texture& texture, float minLod);
+    void updateStats();
+
+    VkDevice _device;
+    SamplerCache& _samplerCache;
+    UploadManager* _uploads;
+    VkDeviceSize _budget;
+
+    ThreadPool _loader{1};
+    std::unordered_map<const Texture*, Entry> _entries;
+    std::deque<Retired> _retired;
+    std::unordered_set<const Texture*> _changed;    // Views/Sampler neu in die Szene eintragen
+    uint64_t _frame = 0;
+    Stats _stats;
+};
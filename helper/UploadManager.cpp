@@ -0,0 +1,421 @@
+#include "UploadManager.hpp"
+#include "initBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+UploadManager::UploadManager(VkPhysicalDevice physicalDevice, VkDevice device,
+                             uint32_t graphicsFamily, VkQueue graphicsQueue,
+                             uint32_t transferFamily, VkQueue transferQueue,
+                             VkDeviceSize ringSize)
+    : _physicalDevice(physicalDevice), _device(device),
+      _graphicsFamily(graphicsFamily), _graphicsQueue(graphicsQueue),
+      _transferFamily(transferFamily), _transferQueue(transferQueue),
+      _ringSize(ringSize) {
+    _graphicsPool = createPool(_graphicsFamily);
+    _transferPool = usesTransferQueue() ? createPool(_transferFamily) : _graphicsPool;
+
+    // bufferOffset bei Image-Copies: Vielfaches von 4 und der Texel-/Blockgröße (BC: 16)
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(_physicalDevice, &props);
+    _alignment = std::max<VkDeviceSize>(16, props.limits.optimalBufferCopyOffsetAlignment);
+    // Ringgröße als Vielfaches davon, damit auch der Anfang nach dem Umbruch ausgerichtet ist
+    _ringSize = (_ringSize + _alignment - 1) / _alignment * _alignment;
+}
+
+// ------------------------------------------------------------
+// Staging
+// ------------------------------------------------------------
+
+UploadManager::StagingRange UploadManager::stage(const void* data, VkDeviceSize size) {
+    _stats.uploads++;
+    _stats.stagedBytes += size;
+
+    StagingRange range;
+    if (size > _ringSize) {
+        // passt nie in den Ring: eigener Buffer, wird mit dem Submit freigegeben
+        StagingBuffer staging = createStagingBuffer(size);
+        std::memcpy(staging.mapped, data, static_cast<size_t>(size));
+        _pendingOversized.push_back(staging);
+        _stats.oversizedUploads++;
+        range.buffer = staging.buffer;
+        return range;
+    }
+
+    if (_ring.buffer == VK_NULL_HANDLE) {
+        _ring = createStagingBuffer(_ringSize);
+    }
+
+    for (;;) {
+        // leerer Ring: am Anfang des Buffers weitermachen
+        if (_ringTail == _ringHead) {
+            _ringHead = _ringTail = (_ringHead + _ringSize - 1) / _ringSize * _ringSize;
+        }
+
+        VkDeviceSize offset = (_ringHead + _alignment - 1) / _alignment * _alignment;
+        VkDeviceSize position = offset % _ringSize;
+        if (position + size > _ringSize) {
+            // kein Umbruch mitten in einem Upload: Rest bis zum Ende überspringen
+            offset += _ringSize - position;
+            position = 0;
+        }
+        if (offset + size - _ringTail <= _ringSize) {
+            std::memcpy(static_cast<char*>(_ring.mapped) + position, data, static_cast<size_t>(size));
+            _ringHead = offset + size;
+            range.buffer = _ring.buffer;
+            range.offset = position;
+            return range;
+        }
+
+        // Ring voll: ältesten Submit abwarten (den laufenden vorher abschicken, falls er alles belegt)
+        _stats.ringStalls++;
+        if (_inFlight.empty()) {
+            submit();
+        }
+        if (!retireOldest(true)) {
+            _ringTail = _ringHead;
+        }
+    }
+}
+
+VkCommandBuffer UploadManager::transferCommands() {
+    if (_transferCommands == VK_NULL_HANDLE) {
+        _transferCommands = beginCommands(_transferPool);
+    }
+    return _transferCommands;
+}
+
+VkCommandBuffer UploadManager::graphicsCommands() {
+    if (!usesTransferQueue()) {
+        return transferCommands();
+    }
+    if (_graphicsCommands == VK_NULL_HANDLE) {
+        _graphicsCommands = beginCommands(_graphicsPool);
+    }
+    return _graphicsCommands;
+}
+
+// ------------------------------------------------------------
+// Ownership-Transfer
+// ------------------------------------------------------------
+
+void UploadManager::releaseBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                                  VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+    VkBufferMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.buffer = buffer;
+    barrier.offset = offset;
+    barrier.size = size;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    if (!usesTransferQueue()) {
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(transferCommands(), VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+                             0, 0, nullptr, 1, &barrier, 0, nullptr);
+        return;
+    }
+
+    // Release auf der Transfer-Queue ...
+    barrier.srcQueueFamilyIndex = _transferFamily;
+    barrier.dstQueueFamilyIndex = _graphicsFamily;
+    barrier.dstAccessMask = 0;
+    vkCmdPipelineBarrier(transferCommands(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    // ... Acquire auf der Graphics-Queue (nach dem Semaphor, deshalb ALL_COMMANDS als Quelle)
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = dstAccess;
+    vkCmdPipelineBarrier(graphicsCommands(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, dstStage,
+                         0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+void UploadManager::releaseImage(VkImage image, const VkImageSubresourceRange& range,
+                                 VkImageLayout oldLayout, VkImageLayout newLayout,
+                                 VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.image = image;
+    barrier.subresourceRange = range;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    if (!usesTransferQueue()) {
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstAccessMask = dstAccess;
+        vkCmdPipelineBarrier(transferCommands(), VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+        return;
+    }
+
+    // Layout-Wechsel steht in Release und Acquire identisch und passiert genau einmal
+    barrier.srcQueueFamilyIndex = _transferFamily;
+    barrier.dstQueueFamilyIndex = _graphicsFamily;
+    barrier.dstAccessMask = 0;
+    vkCmdPipelineBarrier(transferCommands(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = dstAccess;
+    vkCmdPipelineBarrier(graphicsCommands(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, dstStage,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+UploadManager::Ticket UploadManager::uploadBuffer(VkBuffer dst, const void* data, VkDeviceSize size,
+                                                  VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+    StagingRange staging = stage(data, size);
+
+    VkBufferCopy region{};
+    region.srcOffset = staging.offset;
+    region.dstOffset = 0;
+    region.size = size;
+    vkCmdCopyBuffer(transferCommands(), staging.buffer, dst, 1, &region);
+
+    releaseBuffer(dst, 0, size, dstStage, dstAccess);
+    return pendingTicket();
+}
+
+// ------------------------------------------------------------
+// Submit und Fertigmeldung
+// ------------------------------------------------------------
+
+UploadManager::Ticket UploadManager::submit() {
+    if (_transferCommands == VK_NULL_HANDLE && _graphicsCommands == VK_NULL_HANDLE) {
+        return _nextTicket - 1;
+    }
+
+    Submission submission;
+    submission.ticket = _nextTicket++;
+    submission.fence = acquireFence();
+    submission.ringEnd = _ringHead;
+    submission.oversized = std::move(_pendingOversized);
+    _pendingOversized.clear();
+
+    if (usesTransferQueue()) {
+        // beide Seiten gibt es immer, damit Semaphor und Fence gleich ablaufen
+        transferCommands();
+        graphicsCommands();
+        if (vkEndCommandBuffer(_transferCommands) != VK_SUCCESS
+            || vkEndCommandBuffer(_graphicsCommands) != VK_SUCCESS) {
+            throw std::runtime_error("UploadManager: failed to end command buffer!");
+        }
+        submission.semaphore = acquireSemaphore();
+
+        VkSubmitInfo transferSubmit{};
+        transferSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        transferSubmit.commandBufferCount = 1;
+        transferSubmit.pCommandBuffers = &_transferCommands;
+        transferSubmit.signalSemaphoreCount = 1;
+        transferSubmit.pSignalSemaphores = &submission.semaphore;
+        if (vkQueueSubmit(_transferQueue, 1, &transferSubmit, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("UploadManager: failed to submit to transfer queue!");
+        }
+
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        VkSubmitInfo graphicsSubmit{};
+        graphicsSubmit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        graphicsSubmit.waitSemaphoreCount = 1;
+        graphicsSubmit.pWaitSemaphores = &submission.semaphore;
+        graphicsSubmit.pWaitDstStageMask = &waitStage;
+        graphicsSubmit.commandBufferCount = 1;
+        graphicsSubmit.pCommandBuffers = &_graphicsCommands;
+        if (vkQueueSubmit(_graphicsQueue, 1, &graphicsSubmit, submission.fence) != VK_SUCCESS) {
+            throw std::runtime_error("UploadManager: failed to submit to graphics queue!");
+        }
+    } else {
+        if (vkEndCommandBuffer(_transferCommands) != VK_SUCCESS) {
+            throw std::runtime_error("UploadManager: failed to end command buffer!");
+        }
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &_transferCommands;
+        if (vkQueueSubmit(_graphicsQueue, 1, &submitInfo, submission.fence) != VK_SUCCESS) {
+            throw std::runtime_error("UploadManager: failed to submit to graphics queue!");
+        }
+    }
+
+    submission.transferCommands = _transferCommands;
+    submission.graphicsCommands = _graphicsCommands;
+    _transferCommands = VK_NULL_HANDLE;
+    _graphicsCommands = VK_NULL_HANDLE;
+    _inFlight.push_back(std::move(submission));
+    _stats.submits++;
+    return _inFlight.back().ticket;
+}
+
+bool UploadManager::retireOldest(bool wait) {
+    if (_inFlight.empty()) {
+        return false;
+    }
+    Submission& oldest = _inFlight.front();
+    if (wait) {
+        vkWaitForFences(_device, 1, &oldest.fence, VK_TRUE, UINT64_MAX);
+    } else if (vkGetFenceStatus(_device, oldest.fence) != VK_SUCCESS) {
+        return false;
+    }
+
+    vkResetFences(_device, 1, &oldest.fence);
+    _freeFences.push_back(oldest.fence);
+    if (oldest.semaphore != VK_NULL_HANDLE) {
+        _freeSemaphores.push_back(oldest.semaphore);
+    }
+    if (oldest.transferCommands != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(_device, _transferPool, 1, &oldest.transferCommands);
+    }
+    if (oldest.graphicsCommands != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(_device, _graphicsPool, 1, &oldest.graphicsCommands);
+    }
+    for (StagingBuffer& staging : oldest.oversized) {
+        destroyStagingBuffer(staging);
+    }
+
+    _ringTail = std::max(_ringTail, oldest.ringEnd);
+    _completed = oldest.ticket;
+    _inFlight.pop_front();
+    return true;
+}
+
+UploadManager::Ticket UploadManager::completedValue() {
+    while (retireOldest(false)) {
+    }
+    return _completed;
+}
+
+void UploadManager::wait(Ticket ticket) {
+    if (ticket >= _nextTicket) {
+        submit();
+    }
+    while (_completed < ticket && retireOldest(true)) {
+    }
+}
+
+void UploadManager::waitIdle() {
+    submit();
+    while (retireOldest(true)) {
+    }
+}
+
+void UploadManager::printStats() const {
+    std::cout << std::fixed << std::setprecision(2)
+              << "UploadManager: " << (usesTransferQueue() ? "eigene Transfer-Queue (Familie " : "Graphics-Queue (Familie ")
+              << _transferFamily << "), " << _stats.submits << " Submits, "
+              << _stats.uploads << " Uploads, "
+              << _stats.stagedBytes / (1024.0 * 1024.0) << " MB über "
+              << _ringSize / (1024.0 * 1024.0) << " MB Ring, "
+              << _stats.ringStalls << "x auf freien Ring gewartet, "
+              << _stats.oversizedUploads << " übergroß"
+              << std::defaultfloat << std::endl;
+}
+
+void UploadManager::destroy() {
+    waitIdle();
+    destroyStagingBuffer(_ring);
+    for (VkFence fence : _freeFences) {
+        vkDestroyFence(_device, fence, nullptr);
+    }
+    _freeFences.clear();
+    for (VkSemaphore semaphore : _freeSemaphores) {
+        vkDestroySemaphore(_device, semaphore, nullptr);
+    }
+    _freeSemaphores.clear();
+    if (_transferPool != _graphicsPool && _transferPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(_device, _transferPool, nullptr);
+    }
+    if (_graphicsPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(_device, _graphicsPool, nullptr);
+    }
+    _transferPool = VK_NULL_HANDLE;
+    _graphicsPool = VK_NULL_HANDLE;
+}
+
+// ------------------------------------------------------------
+// Vulkan-Objekte
+// ------------------------------------------------------------
+
+UploadManager::StagingBuffer UploadManager::createStagingBuffer(VkDeviceSize size) {
+    StagingBuffer staging;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(_device, &bufferInfo, nullptr, &staging.buffer) != VK_SUCCESS) {
+        throw std::runtime_error("UploadManager: failed to create staging buffer!");
+    }
+
+    try {
+        staging.memory = MemoryAllocator::of(_device).allocateBuffer(
+            staging.buffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging);
+    } catch (const std::exception&) {
+        vkDestroyBuffer(_device, staging.buffer, nullptr);
+        throw std::runtime_error("UploadManager: failed to allocate staging memory!");
+    }
+    staging.mapped = staging.memory.mapped;
+    return staging;
+}
+
+void UploadManager::destroyStagingBuffer(StagingBuffer& staging) {
+    if (staging.buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(_device, staging.buffer, nullptr);
+    }
+    if (staging.memory) {
+        MemoryAllocator::of(_device).free(staging.memory);
+    }
+    staging = StagingBuffer{};
+}
+
+VkCommandPool UploadManager::createPool(uint32_t family) {
+    VkCommandPoolCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    info.queueFamilyIndex = family;
+    info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+    VkCommandPool pool = VK_NULL_HANDLE;
+    if (vkCreateCommandPool(_device, &info, nullptr, &pool) != VK_SUCCESS) {
+        throw std::runtime_error("UploadManager: failed to create command pool!");
+    }
+    return pool;
+}
+
+VkCommandBuffer UploadManager::beginCommands(VkCommandPool pool) {
+    InitBuffer initB;
+    return initB.beginSingleTimeCommands(_device, pool);
+}
+
+VkFence UploadManager::acquireFence() {
+    if (!_freeFences.empty()) {
+        VkFence fence = _freeFences.back();
+        _freeFences.pop_back();
+        return fence;
+    }
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence = VK_NULL_HANDLE;
+    if (vkCreateFence(_device, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+        throw std::runtime_error("UploadManager: failed to create fence!");
+    }
+    return fence;
+}
+
+VkSemaphore UploadManager::acquireSemaphore() {
+    if (!_freeSemaphores.empty()) {
+        VkSemaphore semaphore = _freeSemaphores.back();
+        _freeSemaphores.pop_back();
+        return semaphore;
+    }
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    if (vkCreateSemaphore(_device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+        throw std::runtime_error("UploadManager: failed to create semaphore!");
+    }
+    return semaphore;
+}
@@ -0,0 +1,135 @@
+// UploadManager.hpp
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "MemoryAllocator.hpp"
+
+// Asynchrone Uploads über einen Staging-Ring mit Ticket pro Submit. Nur vom Hauptthread benutzen
+class UploadManager {
+public:
+    // Fortlaufender Wert, 0 = "nichts hochgeladen"
+    using Ticket = uint64_t;
+
+    static constexpr VkDeviceSize DEFAULT_RING_SIZE = 64ull * 1024 * 1024;
+
+    struct StagingRange {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+    };
+
+    struct Stats {
+        uint64_t submits = 0;           // abgeschickte Command Buffer (pro Queue-Paar einer)
+        uint64_t uploads = 0;           // stage()-Aufrufe
+        VkDeviceSize stagedBytes = 0;   // insgesamt durch den Ring kopiert
+        uint64_t ringStalls = 0;        // musste auf einen älteren Submit warten, weil der Ring voll war
+        uint64_t oversizedUploads = 0;  // größer als der Ring, eigener Staging Buffer
+    };
+
+    // transferFamily == graphicsFamily: kein Ownership-Transfer, alles auf der Graphics-Queue
+    UploadManager(VkPhysicalDevice physicalDevice, VkDevice device,
+                  uint32_t graphicsFamily, VkQueue graphicsQueue,
+                  uint32_t transferFamily, VkQueue transferQueue,
+                  VkDeviceSize ringSize = DEFAULT_RING_SIZE);
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+
+    bool usesTransferQueue() const { return _transferFamily != _graphicsFamily; }
+
+    // Kopiert data in den Ring und liefert die Quelle für den Copy-Befehl.
+    // Vor dem Aufzeichnen aufrufen: ist der Ring voll, wird der laufende Submit vorher abgeschickt
+    StagingRange stage(const void* data, VkDeviceSize size);
+    // Copy-Befehle (Transfer-Queue bzw. Graphics-Queue ohne eigene Transfer-Familie)
+    VkCommandBuffer transferCommands();
+    // Befehle nach dem Acquire auf der Graphics-Queue (z.B. vkCmdBlitImage für Mips)
+    VkCommandBuffer graphicsCommands();
+
+    // Übergibt den Buffer bzw. das Image nach dem Copy an die Graphics-Queue
+    // (Release/Acquire-Paar oder einfache Barriere) und macht ihn für dstStage/dstAccess sichtbar
+    void releaseBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                       VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+    void releaseImage(VkImage image, const VkImageSubresourceRange& range,
+                      VkImageLayout oldLayout, VkImageLayout newLayout,
+                      VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    // Staging + Copy + Release in einem (für device local Vertex-/Index-/Storage-Buffer)
+    Ticket uploadBuffer(VkBuffer dst, const void* data, VkDeviceSize size,
+                        VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    // Ticket, das der gerade aufgezeichnete Submit bekommen wird
+    Ticket pendingTicket() const { return _nextTicket; }
+    // Schickt alles Aufgezeichnete ab, ohne zu warten. Rückgabe: Ticket des Submits
+    // (oder des letzten, falls nichts aufgezeichnet war)
+    Ticket submit();
+    // Fragt die Fences ab und gibt fertigen Staging-Speicher frei
+    Ticket completedValue();
+    bool isComplete(Ticket ticket) { return completedValue() >= ticket; }
+    // Blockiert, bis ticket fertig ist (schickt es vorher ab, falls nötig)
+    void wait(Ticket ticket);
+    void waitIdle();
+
+    const Stats& getStats() const { return _stats; }
+    void printStats() const;
+
+    // Wartet alles ab und zerstört Ring, Fences, Semaphore und Command Pools (vor vkDestroyDevice)
+    void destroy();
+
+private:
+    struct StagingBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        MemoryAllocation memory;
+        void* mapped = nullptr;         // = memory.mapped
+    };
+
+    struct Submission {
+        Ticket ticket = 0;
+        VkFence fence = VK_NULL_HANDLE;
+        VkSemaphore semaphore = VK_NULL_HANDLE;          // nur mit Transfer-Queue
+        VkCommandBuffer transferCommands = VK_NULL_HANDLE;
+        VkCommandBuffer graphicsCommands = VK_NULL_HANDLE;
+        VkDeviceSize ringEnd = 0;                        // _ringHead beim Submit
+        std::vector<StagingBuffer> oversized;
+    };
+
+    StagingBuffer createStagingBuffer(VkDeviceSize size);
+    void destroyStagingBuffer(StagingBuffer& staging);
+    VkCommandPool createPool(uint32_t family);
+    VkCommandBuffer beginCommands(VkCommandPool pool);
+    VkFence acquireFence();
+    VkSemaphore acquireSemaphore();
+    // Ältesten Submit abwarten (wait) bzw. nur abholen, wenn fertig
+    bool retireOldest(bool wait);
+
+    VkPhysicalDevice _physicalDevice;
+    VkDevice _device;
+    uint32_t _graphicsFamily;
+    VkQueue _graphicsQueue;
+    uint32_t _transferFamily;
+    VkQueue _transferQueue;
+
+    VkCommandPool _graphicsPool = VK_NULL_HANDLE;
+    VkCommandPool _transferPool = VK_NULL_HANDLE;    // == _graphicsPool ohne eigene Transfer-Familie
+
+    // Ring: _ringHead/_ringTail zählen fortlaufend, Position im Buffer ist Wert % _ringSize
+    StagingBuffer _ring;
+    VkDeviceSize _ringSize;
+    VkDeviceSize _ringHead = 0;
+    VkDeviceSize _ringTail = 0;
+    VkDeviceSize _alignment = 16;
+
+    // laufender (noch nicht abgeschickter) Submit
+    VkCommandBuffer _transferCommands = VK_NULL_HANDLE;
+    VkCommandBuffer _graphicsCommands = VK_NULL_HANDLE;
+    std::vector<StagingBuffer> _pendingOversized;
+
+    std::deque<Submission> _inFlight;
+    std::vector<VkFence> _freeFences;
+    std::vector<VkSemaphore> _freeSemaphores;
+    Ticket _nextTicket = 1;
+    Ticket _completed = 0;
+    Stats _stats;
+};
@@ -1,5 +1,6 @@
 // initBuffer.cpp
 #include "initBuffer.hpp"
+#include "UploadManager.hpp"
 #define STB_IMAGE_IMPLEMENTATION
 #include "../stb_image.h"
 
@@ -71,18 +72,21 @@ void InitBuffer::copyBuffer(VkDevice device, VkCommandPool commandPool, VkQueue
     endSingleTimeCommands(device, commandPool, queue, commandBuffer);
 }
 
-VkBuffer InitBuffer::createVertexBuffer(VkPhysicalDevice physicalDevice, VkDevice device,
-                                        VkCommandPool commandPool, VkQueue graphicsQueue,
-                                        const std::vector<Vertex>& vertices) {
-    if (vertices.empty()) {
-        throw std::runtime_error("InitBuffer::createVertexBuffer: vertices is empty");
+void InitBuffer::createDeviceLocalBuffer(VkDevice device,
+                                         VkCommandPool commandPool, VkQueue queue,
+                                         const void* srcData, VkDeviceSize bufferSize,
+                                         VkBufferUsageFlags usage,
+                                         VkBuffer& outBuffer, MemoryAllocation& outMemory,
+                                         const char* caller) {
+    if (_uploadManager) {
+        createDeviceLocalBufferAsync(device, srcData, bufferSize, usage, outBuffer, outMemory, caller);
+        return;
     }
-
-    VkDeviceSize bufferSize = sizeof(Vertex) * vertices.size();
+    MemoryAllocator& allocator = MemoryAllocator::of(device);
 
     //Staging Buffer erstellen
     VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation stagingBufferMemory;
 
     VkBufferCreateInfo stagingInfo{};
     stagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -92,88 +96,221 @@ VkBuffer InitBuffer::createVertexBuffer(VkPhysicalDevice physicalDevice, VkDevic
 
     VkResult res = vkCreateBuffer(device, &stagingInfo, nullptr, &stagingBuffer);
     if (res != VK_SUCCESS) {
-        throw std::runtime_error("InitBuffer::createVertexBuffer: failed to create staging buffer");
+        throw std::runtime_error(std::string(caller) + ": failed to create staging buffer");
     }
 
-    VkMemoryRequirements stagingMemReq;
-    vkGetBufferMemoryRequirements(device, stagingBuffer, &stagingMemReq);
-
-    VkMemoryAllocateInfo stagingAlloc{};
-    stagingAlloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    stagingAlloc.allocationSize = stagingMemReq.size;
-    stagingAlloc.memoryTypeIndex = findMemoryType(stagingMemReq.memoryTypeBits,
-                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                                 physicalDevice);
-
-    if (vkAllocateMemory(device, &stagingAlloc, nullptr, &stagingBufferMemory) != VK_SUCCESS) {
+    try {
+        stagingBufferMemory = allocator.allocateBuffer(stagingBuffer,
+                                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                       MemoryCategory::Staging);
+    } catch (const std::exception&) {
         vkDestroyBuffer(device, stagingBuffer, nullptr);
-        throw std::runtime_error("InitBuffer::createVertexBuffer: failed to allocate staging buffer memory");
+        throw std::runtime_error(std::string(caller) + ": failed to allocate staging buffer memory");
     }
 
-    vkBindBufferMemory(device, stagingBuffer, stagingBufferMemory, 0);
+    //Daten -> staging buffer (bleibt gemappt)
+    std::memcpy(stagingBufferMemory.mapped, srcData, static_cast<size_t>(bufferSize));
 
-    //vertex Daten -> staging buffer
-    void* data = nullptr;
-    vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-    std::memcpy(data, vertices.data(), static_cast<size_t>(bufferSize));
-    vkUnmapMemory(device, stagingBufferMemory);
-
-    //device local VertexBuffer
-    VkBufferCreateInfo vertexInfo{};
-    vertexInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    vertexInfo.size = bufferSize;
-    vertexInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-    vertexInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    //device local Buffer
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = bufferSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    res = vkCreateBuffer(device, &vertexInfo, nullptr, &_vertexBuffer);
+    res = vkCreateBuffer(device, &bufferInfo, nullptr, &outBuffer);
     if (res != VK_SUCCESS) {
         vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
-        throw std::runtime_error("InitBuffer::createVertexBuffer: failed to create vertex buffer");
+        allocator.free(stagingBufferMemory);
+        throw std::runtime_error(std::string(caller) + ": failed to create device local buffer");
     }
 
-    VkMemoryRequirements vertexMemReq;
-    vkGetBufferMemoryRequirements(device, _vertexBuffer, &vertexMemReq);
-
-    VkMemoryAllocateInfo vertexAlloc{};
-    vertexAlloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    vertexAlloc.allocationSize = vertexMemReq.size;
-    vertexAlloc.memoryTypeIndex = findMemoryType(vertexMemReq.memoryTypeBits,
-                                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                                                physicalDevice);
-
-    if (vkAllocateMemory(device, &vertexAlloc, nullptr, &_vertexBufferMemory) != VK_SUCCESS) {
-        vkDestroyBuffer(device, _vertexBuffer, nullptr);
+    try {
+        outMemory = allocator.allocateBuffer(outBuffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Mesh);
+    } catch (const std::exception&) {
+        vkDestroyBuffer(device, outBuffer, nullptr);
         vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
-        throw std::runtime_error("InitBuffer::createVertexBuffer: failed to allocate vertex buffer memory");
+        allocator.free(stagingBufferMemory);
+        throw std::runtime_error(std::string(caller) + ": failed to allocate device local buffer memory");
     }
 
-    vkBindBufferMemory(device, _vertexBuffer, _vertexBufferMemory, 0);
-
-    // 3) staging -> device lokal
-    copyBuffer(device, commandPool, graphicsQueue, stagingBuffer, _vertexBuffer, bufferSize);
+    // staging -> device lokal
+    copyBuffer(device, commandPool, queue, stagingBuffer, outBuffer, bufferSize);
 
     // Cleanup
     vkDestroyBuffer(device, stagingBuffer, nullptr);
-    vkFreeMemory(device, stagingBufferMemory, nullptr);
+    allocator.free(stagingBufferMemory);
+}
 
-    std::cout << "[DEBUG] Vertex buffer created via staging buffer (" << vertices.size() << " vertices)" << std::endl;
+void InitBuffer::createDeviceLocalBufferAsync(VkDevice device,
+                                              const void* srcData, VkDeviceSize bufferSize,
+                                              VkBufferUsageFlags usage,
+                                              VkBuffer& outBuffer, MemoryAllocation& outMemory,
+                                              const char* caller) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = bufferSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &outBuffer) != VK_SUCCESS) {
+        throw std::runtime_error(std::string(caller) + ": failed to create device local buffer");
+    }
+
+    try {
+        outMemory = MemoryAllocator::of(device).allocateBuffer(outBuffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                           MemoryCategory::Mesh);
+    } catch (const std::exception&) {
+        vkDestroyBuffer(device, outBuffer, nullptr);
+        throw std::runtime_error(std::string(caller) + ": failed to allocate device local buffer memory");
+    }
+
+    // wer liest den Buffer danach? (Index Buffer liest auch der Meshlet-Culler als Storage Buffer)
+    VkPipelineStageFlags dstStage = 0;
+    VkAccessFlags dstAccess = 0;
+    if (usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) {
+        dstStage |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        dstAccess |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+    }
+    if (usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT) {
+        dstStage |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        dstAccess |= VK_ACCESS_INDEX_READ_BIT;
+    }
+    if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) {
+        dstStage |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+        dstAccess |= VK_ACCESS_SHADER_READ_BIT;
+    }
+    if (dstStage == 0) {
+        dstStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        dstAccess = VK_ACCESS_MEMORY_READ_BIT;
+    }
+
+    _uploadTicket = _uploadManager->uploadBuffer(outBuffer, srcData, bufferSize, dstStage, dstAccess);
+}
+
+VkBuffer InitBuffer::createVertexBuffer(VkPhysicalDevice physicalDevice, VkDevice device,
+                                        VkCommandPool commandPool, VkQueue graphicsQueue,
+                                        const std::vector<Vertex>& vertices) {
+    return createVertexBuffer(physicalDevice, device, commandPool, graphicsQueue,
+                              vertices.data(), static_cast<uint32_t>(vertices.size()));
+}
+
+VkBuffer InitBuffer::createVertexBuffer(VkPhysicalDevice /*physicalDevice*/, VkDevice device,
+                                        VkCommandPool commandPool, VkQueue graphicsQueue,
+                                        const void* vertexData, uint32_t vertexCount,
+                                        uint32_t vertexStride) {
+    if (vertexData == nullptr || vertexCount == 0) {
+        throw std::runtime_error("InitBuffer::createVertexBuffer: vertices is empty");
+    }
+
+    VkDeviceSize bufferSize = static_cast<VkDeviceSize>(vertexStride) * static_cast<VkDeviceSize>(vertexCount);
+    createDeviceLocalBuffer(device, commandPool, graphicsQueue,
+                            vertexData, bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                            _vertexBuffer, _vertexBufferMemory, "InitBuffer::createVertexBuffer");
+
+    std::cout << "[DEBUG] Vertex buffer created via staging buffer (" << vertexCount << " vertices)" << std::endl;
     return _vertexBuffer;
 }
 
+VkIndexType InitBuffer::chooseIndexType(uint32_t vertexCount) {
+    // größter Index ist vertexCount - 1
+    return vertexCount <= static_cast<uint32_t>(std::numeric_limits<uint16_t>::max()) + 1u
+        ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
+
+namespace {
+    // Index Buffer dienen dem Meshlet-Culler auch als Storage Buffer (Quelle der Kompaktierung)
+    constexpr VkBufferUsageFlags INDEX_BUFFER_USAGE = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+}
+
+VkBuffer InitBuffer::createIndexBuffer(VkPhysicalDevice /*physicalDevice*/, VkDevice device,
+                                       VkCommandPool commandPool, VkQueue graphicsQueue,
+                                       const std::vector<uint32_t>& indices, uint32_t vertexCount) {
+    if (indices.empty()) {
+        throw std::runtime_error("InitBuffer::createIndexBuffer: indices is empty");
+    }
+
+    _indexType = chooseIndexType(vertexCount);
+
+    if (_indexType == VK_INDEX_TYPE_UINT16) {
+        std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        // auf 4 Byte auffüllen, der Meshlet-Culler liest den Buffer wortweise
+        if (shortIndices.size() % 2 != 0) {
+            shortIndices.push_back(0);
+        }
+        createDeviceLocalBuffer(device, commandPool, graphicsQueue,
+                                shortIndices.data(), sizeof(uint16_t) * shortIndices.size(),
+                                INDEX_BUFFER_USAGE,
+                                _indexBuffer, _indexBufferMemory, "InitBuffer::createIndexBuffer");
+    } else {
+        createDeviceLocalBuffer(device, commandPool, graphicsQueue,
+                                indices.data(), sizeof(uint32_t) * indices.size(),
+                                INDEX_BUFFER_USAGE,
+                                _indexBuffer, _indexBufferMemory, "InitBuffer::createIndexBuffer");
+    }
+
+    return _indexBuffer;
+}
+
+VkBuffer InitBuffer::createIndexBuffer(VkPhysicalDevice /*physicalDevice*/, VkDevice device,
+                                       VkCommandPool commandPool, VkQueue graphicsQueue,
+                                       const void* indexData, uint32_t indexCount, VkIndexType indexType) {
+    if (indexData == nullptr || indexCount == 0) {
+        throw std::runtime_error("InitBuffer::createIndexBuffer: indices is empty");
+    }
+
+    _indexType = indexType;
+    VkDeviceSize indexSize = indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    if (indexType == VK_INDEX_TYPE_UINT16 && indexCount % 2 != 0) {
+        // auf 4 Byte auffüllen, der Meshlet-Culler liest den Buffer wortweise
+        std::vector<uint16_t> padded(indexCount + 1, 0);
+        std::memcpy(padded.data(), indexData, indexSize * indexCount);
+        createDeviceLocalBuffer(device, commandPool, graphicsQueue,
+                                padded.data(), indexSize * padded.size(),
+                                INDEX_BUFFER_USAGE,
+                                _indexBuffer, _indexBufferMemory, "InitBuffer::createIndexBuffer");
+    } else {
+        createDeviceLocalBuffer(device, commandPool, graphicsQueue,
+                                indexData, indexSize * indexCount,
+                                INDEX_BUFFER_USAGE,
+                                _indexBuffer, _indexBufferMemory, "InitBuffer::createIndexBuffer");
+    }
+
+    return _indexBuffer;
+}
+
+VkBuffer InitBuffer::createStorageBuffer(VkPhysicalDevice /*physicalDevice*/, VkDevice device,
+                                         VkCommandPool commandPool, VkQueue graphicsQueue,
+                                         const void* data, VkDeviceSize size) {
+    if (data == nullptr || size == 0) {
+        throw std::runtime_error("InitBuffer::createStorageBuffer: data is empty");
+    }
+
+    createDeviceLocalBuffer(device, commandPool, graphicsQueue,
+                            data, size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                            _storageBuffer, _storageBufferMemory, "InitBuffer::createStorageBuffer");
+
+    return _storageBuffer;
+}
+
 void InitBuffer::destroyVertexBuffer(VkDevice device) {
     if (_vertexBuffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(device, _vertexBuffer, nullptr);
         _vertexBuffer = VK_NULL_HANDLE;
     }
-    if (_vertexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, _vertexBufferMemory, nullptr);
-        _vertexBufferMemory = VK_NULL_HANDLE;
+    if (_vertexBufferMemory) {
+        MemoryAllocator::of(device).free(_vertexBufferMemory);
+    }
+    if (_indexBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(device, _indexBuffer, nullptr);
+        _indexBuffer = VK_NULL_HANDLE;
+    }
+    if (_indexBufferMemory) {
+        MemoryAllocator::of(device).free(_indexBufferMemory);
     }
 }
 
-VkBuffer InitBuffer::createImageBuffer(VkPhysicalDevice physicalDevice, VkDevice device, const char* imagePath) {
+VkBuffer InitBuffer::createImageBuffer(VkPhysicalDevice /*physicalDevice*/, VkDevice device, const char* imagePath) {
     // rgba Bild laden
     int texChannels = 0;
     stbi_uc* pixels = stbi_load(imagePath, &_texWidth, &_texHeight, &texChannels, STBI_rgb_alpha);
@@ -195,29 +332,17 @@ VkBuffer InitBuffer::createImageBuffer(VkPhysicalDevice physicalDevice, VkDevice
         throw std::runtime_error("InitBuffer::createImageBuffer: failed to create image buffer!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(device, _imageBuffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits,
-                                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                              physicalDevice);
-
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &_imageBufferMemory) != VK_SUCCESS) {
+    try {
+        _imageBufferMemory = MemoryAllocator::of(device).allocateBuffer(
+            _imageBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging);
+    } catch (const std::exception&) {
         vkDestroyBuffer(device, _imageBuffer, nullptr);
         stbi_image_free(pixels);
         throw std::runtime_error("InitBuffer::createImageBuffer: failed to allocate image buffer memory!");
     }
 
-    vkBindBufferMemory(device, _imageBuffer, _imageBufferMemory, 0);
-
-    // pixel Daten -> buffer
-    void* data = nullptr;
-    vkMapMemory(device, _imageBufferMemory, 0, imageSize, 0, &data);
-    std::memcpy(data, pixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory(device, _imageBufferMemory);
+    // pixel Daten -> buffer (bleibt gemappt)
+    std::memcpy(_imageBufferMemory.mapped, pixels, static_cast<size_t>(imageSize));
 
     stbi_image_free(pixels);
 
@@ -229,9 +354,8 @@ void InitBuffer::destroyImageBuffer(VkDevice device) {
         vkDestroyBuffer(device, _imageBuffer, nullptr);
         _imageBuffer = VK_NULL_HANDLE;
     }
-    if (_imageBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, _imageBufferMemory, nullptr);
-        _imageBufferMemory = VK_NULL_HANDLE;
+    if (_imageBufferMemory) {
+        MemoryAllocator::of(device).free(_imageBufferMemory);
     }
 }
 
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <vector>
 #include <cstring>
+#include <string>
 #include <cstdlib>
 #include <cstdint>
 #include <limits>
@@ -22,17 +23,30 @@
 #include <GLFW/glfw3.h>
 #include "../stb_image.h"
 #include "Rendering/GraphicsPipeline.hpp"
+#include "MemoryAllocator.hpp"
+
+class UploadManager;
 
 class InitBuffer {
 public:
     // buffer handles
     VkBuffer _vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _vertexBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation _vertexBufferMemory;
+    VkBuffer _indexBuffer = VK_NULL_HANDLE;
+    MemoryAllocation _indexBufferMemory;
+    VkIndexType _indexType = VK_INDEX_TYPE_UINT32;
+    VkBuffer _storageBuffer = VK_NULL_HANDLE;
+    MemoryAllocation _storageBufferMemory;
     VkBuffer _imageBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory _imageBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation _imageBufferMemory;
     int _texWidth = 0;
     int _texHeight = 0;
 
+    // Gesetzt: device local Buffer werden über den Ring des UploadManagers hochgeladen,
+    // ohne vkQueueWaitIdle (fertig, sobald _uploadTicket erreicht ist)
+    UploadManager* _uploadManager = nullptr;
+    uint64_t _uploadTicket = 0;
+
     //Finde memory Type index auf physical device, dass zu typeFilter und properties passt
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, VkPhysicalDevice physicalDevice);
 
@@ -43,10 +57,29 @@ public:
     //Selbsterklärend 
     void copyBuffer(VkDevice device, VkCommandPool commandPool, VkQueue queue, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
     VkBuffer createVertexBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkCommandPool commandPool, VkQueue graphicsQueue, const std::vector<Vertex>& vertices);
+    //Variante für rohe Vertex-Daten (z.B. direkt aus dem gemappten Mesh-Cache oder komprimierte Vertices)
+    VkBuffer createVertexBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkCommandPool commandPool, VkQueue graphicsQueue, const void* vertexData, uint32_t vertexCount, uint32_t vertexStride = sizeof(Vertex));
     void destroyVertexBuffer(VkDevice device);
+    //Index Buffer: 16 Bit wenn vertexCount es erlaubt, sonst 32 Bit (Typ landet in _indexType)
+    VkBuffer createIndexBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkCommandPool commandPool, VkQueue graphicsQueue, const std::vector<uint32_t>& indices, uint32_t vertexCount);
+    //Variante für Indices, die schon im Zielformat vorliegen (indexType wird übernommen)
+    VkBuffer createIndexBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkCommandPool commandPool, VkQueue graphicsQueue, const void* indexData, uint32_t indexCount, VkIndexType indexType);
+    static VkIndexType chooseIndexType(uint32_t vertexCount);
+    //Device local Storage Buffer für Compute Shader (z.B. Meshlet-Tabelle)
+    VkBuffer createStorageBuffer(VkPhysicalDevice physicalDevice, VkDevice device, VkCommandPool commandPool, VkQueue graphicsQueue, const void* data, VkDeviceSize size);
     VkBuffer createImageBuffer(VkPhysicalDevice physicalDevice, VkDevice device, const char* imagePath);
     void destroyImageBuffer(VkDevice device);
 
     int getTexWidth() const;
     int getTexHeight() const;
+
+private:
+    // Staging Buffer -> device local Buffer mit gegebener usage
+    void createDeviceLocalBuffer(VkDevice device, VkCommandPool commandPool, VkQueue queue,
+                                 const void* srcData, VkDeviceSize bufferSize, VkBufferUsageFlags usage,
+                                 VkBuffer& outBuffer, MemoryAllocation& outMemory, const char* caller);
+    // Variante über _uploadManager: nur aufzeichnen, kein eigener Staging Buffer
+    void createDeviceLocalBufferAsync(VkDevice device,
+                                      const void* srcData, VkDeviceSize bufferSize, VkBufferUsageFlags usage,
+                                      VkBuffer& outBuffer, MemoryAllocation& outMemory, const char* caller);
 };
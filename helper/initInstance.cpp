@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <set>
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <iostream>
@@ -197,16 +198,92 @@ VkPhysicalDevice InitInstance::pickPhysicalDevice(
     throw std::runtime_error("Keine geeignete GPU");
 }
 
+uint32_t InitInstance::findTransferQueueFamily(VkPhysicalDevice physicalDevice, uint32_t graphicsQueueFamilyIndex) {
+    uint32_t qCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &qCount, nullptr);
+    std::vector<VkQueueFamilyProperties> qfam(qCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &qCount, qfam.data());
+
+    // Kopiert werden immer ganze Mip-Levels, die Transfer-Granularität spielt deshalb keine Rolle
+    uint32_t asyncCompute = UINT32_MAX;
+    for (uint32_t i = 0; i < qCount; i++) {
+        VkQueueFlags flags = qfam[i].queueFlags;
+        if (i == graphicsQueueFamilyIndex || qfam[i].queueCount == 0 || (flags & VK_QUEUE_GRAPHICS_BIT))
+            continue;
+        // Compute-Familien können auch kopieren, auch ohne gesetztes Transfer-Bit
+        if (!(flags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT)))
+            continue;
+        if (!(flags & VK_QUEUE_COMPUTE_BIT))
+            return i;
+        if (asyncCompute == UINT32_MAX)
+            asyncCompute = i;
+    }
+    return asyncCompute != UINT32_MAX ? asyncCompute : graphicsQueueFamilyIndex;
+}
+
+bool InitInstance::supportsBindless(VkPhysicalDevice physicalDevice) {
+    // Descriptor Indexing ist ab 1.2 Core, die Instance fordert 1.2 an
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &props);
+    if (props.apiVersion < VK_API_VERSION_1_2)
+        return false;
+
+    VkPhysicalDeviceDescriptorIndexingFeatures indexing{};
+    indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    VkPhysicalDeviceFeatures2 features{};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &indexing;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+    return indexing.runtimeDescriptorArray &&
+           indexing.descriptorBindingPartiallyBound &&
+           indexing.descriptorBindingSampledImageUpdateAfterBind;
+}
+
+uint32_t InitInstance::bindlessTextureCapacity(VkPhysicalDevice physicalDevice) {
+    VkPhysicalDeviceDescriptorIndexingProperties indexing{};
+    indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+    VkPhysicalDeviceProperties2 props{};
+    props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    props.pNext = &indexing;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &props);
+
+    uint32_t capacity = MAX_BINDLESS_TEXTURES;
+    // COMBINED_IMAGE_SAMPLER zählt als Sampled Image und als Sampler
+    capacity = std::min(capacity, indexing.maxPerStageDescriptorUpdateAfterBindSampledImages);
+    capacity = std::min(capacity, indexing.maxDescriptorSetUpdateAfterBindSampledImages);
+    capacity = std::min(capacity, indexing.maxPerStageDescriptorUpdateAfterBindSamplers);
+    capacity = std::min(capacity, indexing.maxDescriptorSetUpdateAfterBindSamplers);
+    return capacity;
+}
+
+bool InitInstance::hasDeviceExtension(VkPhysicalDevice physicalDevice, const char* name) {
+    uint32_t count = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> available(count);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, available.data());
+
+    for (const auto& ext : available) {
+        if (strcmp(ext.extensionName, name) == 0)
+            return true;
+    }
+    return false;
+}
+
 /* ============================================================
    Logical Device
    ============================================================ */
 VkDevice InitInstance::createLogicalDevice(
     VkPhysicalDevice physicalDevice,
     uint32_t gQueue,
-    uint32_t pQueue) {
+    uint32_t pQueue,
+    uint32_t tQueue,
+    bool bindless) {
 
     float priority = 1.0f;
     std::set<uint32_t> families = { gQueue, pQueue };
+    if (tQueue != UINT32_MAX)
+        families.insert(tQueue);
     std::vector<VkDeviceQueueCreateInfo> queues;
 
     for (uint32_t f : families) {
@@ -225,12 +302,24 @@ VkDevice InitInstance::createLogicalDevice(
 #ifdef __APPLE__
     //extensions.push_back(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME);
 #endif
+    // Heap-Budgets für den ResidencyManager, sonst schätzt er aus den Heap-Größen
+    if (hasDeviceExtension(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+        extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
 
     VkPhysicalDeviceFeatures features{};
     features.samplerAnisotropy = VK_TRUE;
 
+    // Textur-Index kommt aus den Push Constants und ist pro Draw uniform,
+    // nonuniform-Indizierung wird deshalb nicht gebraucht
+    VkPhysicalDeviceDescriptorIndexingFeatures indexing{};
+    indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    indexing.runtimeDescriptorArray = VK_TRUE;
+    indexing.descriptorBindingPartiallyBound = VK_TRUE;
+    indexing.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+
     VkDeviceCreateInfo info{};
     info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    info.pNext = bindless ? &indexing : nullptr;
     info.queueCreateInfoCount = static_cast<uint32_t>(queues.size());
     info.pQueueCreateInfos = queues.data();
     info.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
@@ -303,10 +392,10 @@ void InitInstance::destroyDescriptorPool(VkDevice device, VkDescriptorPool descr
 }
 
 VkDescriptorSetLayout InitInstance::createStandardDescriptorSetLayout(VkDevice device) {
-    // Binding 0: Uniform Buffer
+    // Binding 0: Uniform Buffer (Dynamic Offset = Ansicht im UniformAllocator des Frames)
     VkDescriptorSetLayoutBinding ubo{};
     ubo.binding = 0;
-    ubo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    ubo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     ubo.descriptorCount = 1;
     ubo.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
@@ -331,10 +420,10 @@ VkDescriptorSetLayout InitInstance::createStandardDescriptorSetLayout(VkDevice d
     return layout;
 }
 VkDescriptorSetLayout InitInstance::createSnowDescriptorSetLayout(VkDevice device) {
-    // Binding 0: UBO (model, view, proj)
+    // Binding 0: UBO (model, view, proj), dynamisch
     VkDescriptorSetLayoutBinding uboBinding{};
     uboBinding.binding = 0;
-    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     uboBinding.descriptorCount = 1;
     uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
@@ -369,10 +458,10 @@ VkDescriptorSetLayout InitInstance::createSnowDescriptorSetLayout(VkDevice devic
     return descriptorSetLayout;
 }
 VkDescriptorSetLayout InitInstance::createLitDescriptorSetLayout(VkDevice device) {
-    // Binding 0: UBO mit Licht-Daten
+    // Binding 0: UBO mit Licht-Daten, dynamisch
     VkDescriptorSetLayoutBinding uboBinding{};
     uboBinding.binding = 0;
-    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     uboBinding.descriptorCount = 1;
     uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
@@ -400,6 +489,73 @@ VkDescriptorSetLayout InitInstance::createLitDescriptorSetLayout(VkDevice device
     return descriptorSetLayout;
 }
 
+VkDescriptorSetLayout InitInstance::createBindlessDescriptorSetLayout(VkDevice device) {
+    // Set 0 im Bindless-Modus, beide UBOs dynamisch (Ansicht über die Dynamic Offsets).
+    // Dynamic UBOs sind in Update-After-Bind-Layouts verboten, deshalb liegen die
+    // Texturen in einem eigenen Set (createBindlessTextureSetLayout)
+
+    // Binding 0: UBO (Kamera), auch renderToTexture.frag liest cameraPos
+    VkDescriptorSetLayoutBinding uboBinding{};
+    uboBinding.binding = 0;
+    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    uboBinding.descriptorCount = 1;
+    uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // Binding 1: UBO mit Licht-Daten (lit.vert/lit.frag)
+    VkDescriptorSetLayoutBinding litBinding{};
+    litBinding.binding = 1;
+    litBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    litBinding.descriptorCount = 1;
+    litBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings = { uboBinding, litBinding };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    VkDescriptorSetLayout descriptorSetLayout;
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create bindless descriptor set layout!");
+    }
+
+    return descriptorSetLayout;
+}
+
+VkDescriptorSetLayout InitInstance::createBindlessTextureSetLayout(VkDevice device, uint32_t textureCapacity) {
+    // Set 1, Binding 0: alle Texturen (2D und Cube), Index pro Draw über die Push Constants
+    VkDescriptorSetLayoutBinding textureBinding{};
+    textureBinding.binding = 0;
+    textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    textureBinding.descriptorCount = textureCapacity;
+    textureBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // Nicht benutzte Einträge dürfen leer bleiben, neue Texturen werden
+    // nach dem Binden (während der Aufnahme) eingetragen
+    VkDescriptorBindingFlags bindingFlags =
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+    flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    flagsInfo.bindingCount = 1;
+    flagsInfo.pBindingFlags = &bindingFlags;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &flagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &textureBinding;
+
+    VkDescriptorSetLayout descriptorSetLayout;
+    if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create bindless texture set layout!");
+    }
+
+    return descriptorSetLayout;
+}
+
 void InitInstance::destroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout) {
     if (descriptorSetLayout!= VK_NULL_HANDLE) {
         vkDestroyDescriptorSetLayout(device, descriptorSetLayout,nullptr);
@@ -431,7 +587,7 @@ VkDescriptorSetLayout InitInstance::createLightingDescriptorSetLayout(VkDevice d
     //UBO
     VkDescriptorSetLayoutBinding uboBinding{};
     uboBinding.binding = 3;  // ✅ Jetzt Binding 3!
-    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     uboBinding.descriptorCount = 1;
     uboBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
@@ -29,10 +29,29 @@ public:
         uint32_t* presentQueueFamilyIndex
     );
 
+    // Familie nur für Transfers (ohne Graphics/Compute), sonst eine ohne Graphics,
+    // sonst graphicsQueueFamilyIndex (dann gibt es keine eigene Transfer-Queue)
+    uint32_t findTransferQueueFamily(VkPhysicalDevice physicalDevice, uint32_t graphicsQueueFamilyIndex);
+
+    // Descriptor Indexing (Vulkan 1.2) für ein globales Textur-Array: Runtime Arrays,
+    // Partially Bound und Update After Bind für Sampled Images
+    bool supportsBindless(VkPhysicalDevice physicalDevice);
+    // Größe des Textur-Arrays: MAX_BINDLESS_TEXTURES, begrenzt durch die Device-Limits
+    uint32_t bindlessTextureCapacity(VkPhysicalDevice physicalDevice);
+    static constexpr uint32_t MAX_BINDLESS_TEXTURES = 4096;
+
+    // Device-Extension vorhanden? (z.B. VK_EXT_memory_budget für den ResidencyManager)
+    bool hasDeviceExtension(VkPhysicalDevice physicalDevice, const char* name);
+
+    // transferQueueFamilyIndex: zusätzliche Queue für den UploadManager (UINT32_MAX = keine)
+    // bindless: Descriptor-Indexing-Features aktivieren (vorher supportsBindless prüfen)
+    // VK_EXT_memory_budget wird aktiviert, wenn das Device es kann
     VkDevice createLogicalDevice(
         VkPhysicalDevice physicalDevice,
         uint32_t graphicsQueueFamilyIndex,
-        uint32_t presentQueueFamilyIndex
+        uint32_t presentQueueFamilyIndex,
+        uint32_t transferQueueFamilyIndex = UINT32_MAX,
+        bool bindless = false
     );
 
     VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
@@ -54,6 +73,11 @@ public:
     VkDescriptorSetLayout createLitDescriptorSetLayout(VkDevice device);
     //Für deferredShading
     VkDescriptorSetLayout createLightingDescriptorSetLayout(VkDevice device);
+    // Bindless-Modus: zwei Sets für alle Mesh-Pipelines (siehe shaders/bindless.glsl)
+    // Set 0: binding 0 UBO, binding 1 LitUBO (beide dynamisch)
+    VkDescriptorSetLayout createBindlessDescriptorSetLayout(VkDevice device);
+    // Set 1: binding 0 Array aus textureCapacity Texturen (Update After Bind)
+    VkDescriptorSetLayout createBindlessTextureSetLayout(VkDevice device, uint32_t textureCapacity);
 
     void destroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout descriptorSetLayout);
 };
@@ -31,9 +31,8 @@ void CubemapRenderTarget::cleanup() {
         _depthImage = VK_NULL_HANDLE;
     }
 
-    if (_depthMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _depthMemory, nullptr);
-        _depthMemory = VK_NULL_HANDLE;
+    if (_depthMemory) {
+        MemoryAllocator::of(_device).free(_depthMemory);
     }
 
     for (auto view : _faceViews) {
@@ -53,9 +52,8 @@ void CubemapRenderTarget::cleanup() {
         _cubemapImage = VK_NULL_HANDLE;
     }
 
-    if (_cubemapMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(_device, _cubemapMemory, nullptr);
-        _cubemapMemory = VK_NULL_HANDLE;
+    if (_cubemapMemory) {
+        MemoryAllocator::of(_device).free(_cubemapMemory);
     }
     _device = VK_NULL_HANDLE;
 }
@@ -81,23 +79,13 @@ void CubemapRenderTarget::createCubemapImage() {
         throw std::runtime_error("Failed to create cubemap image!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(_device, _cubemapImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = initB.findMemoryType(
-        memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, _physicalDevice
-    );
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_cubemapMemory) != VK_SUCCESS) {
+    try {
+        _cubemapMemory = MemoryAllocator::of(_device).allocateImage(_cubemapImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                     MemoryCategory::ReflectionProbe);
+    } catch (const std::exception&) {
         throw std::runtime_error("Failed to allocate cubemap memory!");
     }
 
-    vkBindImageMemory(_device, _cubemapImage, _cubemapMemory, 0);
-
     std::cout << "Cubemap image created: " << _resolution << "x" << _resolution << std::endl;
 }
 
@@ -161,23 +149,13 @@ void CubemapRenderTarget::createDepthResources() {
         throw std::runtime_error("Failed to create depth image!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(_device, _depthImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = initB.findMemoryType(
-        memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,_physicalDevice
-    );
-
-    if (vkAllocateMemory(_device, &allocInfo, nullptr, &_depthMemory) != VK_SUCCESS) {
+    try {
+        _depthMemory = MemoryAllocator::of(_device).allocateImage(_depthImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                   MemoryCategory::ReflectionProbe);
+    } catch (const std::exception&) {
         throw std::runtime_error("Failed to allocate depth memory!");
     }
 
-    vkBindImageMemory(_device, _depthImage, _depthMemory, 0);
-
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = _depthImage;
@@ -231,13 +209,29 @@ void CubemapRenderTarget::createRenderPass() {
     subpass.pColorAttachments = &colorRef;
     subpass.pDepthStencilAttachment = &depthRef;
 
-    VkSubpassDependency dependency{};
-    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependency.dstSubpass = 0;
-    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependency.srcAccessMask = 0;
-    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    // Alle 6 Seiten laufen ohne Warten in einem Command Buffer:
+    // vorher muss die vorige Seite mit dem geteilten Depth-Image fertig sein und
+    // der letzte Frame die Cubemap nicht mehr lesen
+    std::array<VkSubpassDependency, 2> dependencies{};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+                                 | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
+                                 | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+                                 | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT
+                                 | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+                                  | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    // nachher: der Haupt-Render-Pass sampelt die fertige Seite
+    dependencies[1].srcSubpass = 0;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
     std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
 
@@ -247,8 +241,8 @@ void CubemapRenderTarget::createRenderPass() {
     renderPassInfo.pAttachments = attachments.data();
     renderPassInfo.subpassCount = 1;
     renderPassInfo.pSubpasses = &subpass;
-    renderPassInfo.dependencyCount = 1;
-    renderPassInfo.pDependencies = &dependency;
+    renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    renderPassInfo.pDependencies = dependencies.data();
 
     if (vkCreateRenderPass(_device, &renderPassInfo, nullptr, &_renderPass) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create render pass!");
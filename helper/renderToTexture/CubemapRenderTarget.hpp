@@ -58,13 +58,13 @@ private:
     uint32_t _resolution;
     //Cubemap ressourcen
     VkImage _cubemapImage = VK_NULL_HANDLE;
-    VkDeviceMemory _cubemapMemory = VK_NULL_HANDLE;
+    MemoryAllocation _cubemapMemory;
     std::array<VkImageView, 6> _faceViews;
     VkImageView _cubemapView = VK_NULL_HANDLE;
     VkSampler _sampler = VK_NULL_HANDLE;
     //depth Kram
     VkImage _depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory _depthMemory = VK_NULL_HANDLE;
+    MemoryAllocation _depthMemory;
     VkImageView _depthView = VK_NULL_HANDLE;
     //RenderPass & Framebuffers
     std::array<VkFramebuffer, 6> _framebuffers;
@@ -9,26 +9,26 @@
 /*
 * Liefert Bilder für die Render-To-Texture Cubemap
 * Platziert Quasi die 6 Kameras und schießt die Fotos
+* Aufgezeichnet werden die Seiten im Command Buffer des Frames (Frame::renderCubemap)
 */
 class ReflectionProbe {
 public:
+    // Near/Far Plane der 6 Seiten (getProjection), weiter entfernte Objekte sieht die Cubemap nicht
+    static constexpr float NEAR_PLANE = 0.1f;
+    static constexpr float FAR_PLANE = 100.0f;
+
     ReflectionProbe(VkDevice device, 
                    VkPhysicalDevice physicalDevice,
-                   VkCommandPool commandPool,
                    const glm::vec3& position,
                    uint32_t resolution = 512)
         : _device(device)
         , _physicalDevice(physicalDevice)
-        , _commandPool(commandPool)
         , _position(position)
         , _resolution(resolution)
-        , _commandBuffer(VK_NULL_HANDLE)
     {
         _renderTarget = std::make_unique<CubemapRenderTarget>(
             device, physicalDevice, resolution
         );
-        
-        createCommandBuffer();
         std::cout << "ReflectionProbe created at position (" 
                   << position.x << ", " << position.y << ", " << position.z 
                   << ")" << std::endl;
@@ -44,10 +44,6 @@ public:
     // 90Grad FOV Projection für Cubemap
     glm::mat4 getProjection() const ;
 
-    VkCommandBuffer getCommandBuffer() const {
-        return _commandBuffer;
-    }
-
     CubemapRenderTarget* getRenderTarget() const {
         return _renderTarget.get();
     }
@@ -85,11 +81,6 @@ public:
             return;
         }
         vkDeviceWaitIdle(_device);
-        if (_commandBuffer != VK_NULL_HANDLE) {
-            vkFreeCommandBuffers(_device, _commandPool, 1, &_commandBuffer);
-            _commandBuffer = VK_NULL_HANDLE;
-        }
-        
         if (_renderTarget) {
             _renderTarget.reset();
         }
@@ -99,13 +90,9 @@ public:
 private:
     VkDevice _device;
     VkPhysicalDevice _physicalDevice;
-    VkCommandPool _commandPool;
     
     glm::vec3 _position;
     uint32_t _resolution;
     
     std::unique_ptr<CubemapRenderTarget> _renderTarget;
-    VkCommandBuffer _commandBuffer = VK_NULL_HANDLE;
-
-    void createCommandBuffer();
 };
\ No newline at end of file
@@ -4,6 +4,12 @@
 #include <vector>
 #include <stdexcept>
 #include <map>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <charconv>
+#include <limits>
 
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
@@ -21,11 +27,74 @@
 #include "helper/Rendering/RenderPass.hpp"
 #include "helper/Frames/Camera.hpp"
 #include "helper/Compute/Snow.hpp"
+#include "helper/Compute/MeshletCuller.hpp"
 #include "helper/MirrorSystem.hpp"
+#include "helper/ResidencyManager.hpp"
+#include "helper/MemoryAllocator.hpp"
+#include "helper/MemoryReport.hpp"
+#include "helper/DeletionQueue.hpp"
 #include "helper/renderToTexture/CubemapRenderTarget.hpp"
 #include "helper/renderToTexture/ReflectionProbe.hpp"
+#include "helper/ObjectLoading/MeshCache.hpp"
+#include "helper/ObjectLoading/SceneLoader.hpp"
+
+// Wert eines Arguments wie --texture-budget=<MB> in Bytes, false bei keiner Zahl, 0 oder Überlauf
+static bool parseMegabytes(const std::string& text, VkDeviceSize& bytes) {
+    constexpr VkDeviceSize MB = 1024 * 1024;
+    VkDeviceSize value = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc() || ptr != end || value == 0 || value > std::numeric_limits<VkDeviceSize>::max() / MB) {
+        return false;
+    }
+    bytes = value * MB;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    auto startTime = std::chrono::steady_clock::now();
+    // Standard: Render Loop startet sofort, Objekte erscheinen, sobald sie geladen sind.
+    // --blocking-load wartet wie früher auf die ganze Szene
+    bool blockingLoad = false;
+    // --no-transfer-queue: Uploads auch auf Geräten mit eigener Transfer-Queue über die Graphics-Queue
+    bool useTransferQueue = true;
+    // --texture-budget=<MB>: VRAM-Budget für gestreamte Mip-Levels, --no-texture-streaming: alles sofort laden
+    bool textureStreaming = true;
+    VkDeviceSize textureBudget = TextureStreamer::DEFAULT_BUDGET;
+    // --no-bindless: Descriptor Sets pro Objekt statt globalem Textur-Array (auch ohne Descriptor Indexing)
+    bool bindless = true;
+    // --vram-budget=<MB>: festes Budget für den ResidencyManager statt der Heap-Abfrage
+    VkDeviceSize vramBudget = 0;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--blocking-load") {
+            blockingLoad = true;
+        }
+        if (std::string(argv[i]) == "--no-transfer-queue") {
+            useTransferQueue = false;
+        }
+        if (std::string(argv[i]) == "--no-texture-streaming") {
+            textureStreaming = false;
+        }
+        if (std::string(argv[i]) == "--no-bindless") {
+            bindless = false;
+        }
+        if (std::string(argv[i]).rfind("--texture-budget=", 0) == 0 &&
+            !parseMegabytes(std::string(argv[i]).substr(17), textureBudget)) {
+            std::cerr << "Usage: " << argv[0] << " --texture-budget=<MB> (ganze Zahl > 0), nicht "
+                      << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (std::string(argv[i]).rfind("--vram-budget=", 0) == 0 &&
+            !parseMegabytes(std::string(argv[i]).substr(14), vramBudget)) {
+            std::cerr << "Usage: " << argv[0] << " --vram-budget=<MB> (ganze Zahl > 0), nicht "
+                      << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    auto millisSinceStart = [&startTime]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
 
-int main() {
     InitInstance inst;
     Scene* scene = new Scene();
     Window* window = new Window();
@@ -52,7 +121,17 @@ int main() {
         instance, surface, &graphicsIndex, &presentIndex
     );
     
-    VkDevice device = inst.createLogicalDevice(physicalDevice, graphicsIndex, presentIndex);
+    uint32_t transferIndex = useTransferQueue ? inst.findTransferQueueFamily(physicalDevice, graphicsIndex)
+                                              : graphicsIndex;
+    if (bindless && !inst.supportsBindless(physicalDevice)) {
+        std::cout << "Descriptor Indexing nicht unterstützt, Descriptor Sets pro Objekt" << std::endl;
+        bindless = false;
+    }
+    // createLogicalDevice aktiviert VK_EXT_memory_budget, wenn vorhanden
+    bool memoryBudget = inst.hasDeviceExtension(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    VkDevice device = inst.createLogicalDevice(physicalDevice, graphicsIndex, presentIndex, transferIndex, bindless);
+    // Gerätespeicher aller Buffer/Images kommt aus Blöcken pro Memory Type (MemoryAllocator::of(device))
+    MemoryAllocator* memoryAllocator = new MemoryAllocator(physicalDevice, device);
    
     
     VkQueue graphicsQueue;
@@ -63,6 +142,13 @@ int main() {
 
     VkQueue computeQueue;
     vkGetDeviceQueue(device, graphicsIndex, 0, &computeQueue);
+
+    // Staging-Ring + eigene Transfer-Queue für Vertex-/Index-Buffer und Texturen
+    VkQueue transferQueue;
+    vkGetDeviceQueue(device, transferIndex, 0, &transferQueue);
+    UploadManager* uploadManager = new UploadManager(physicalDevice, device,
+                                                     graphicsIndex, graphicsQueue,
+                                                     transferIndex, transferQueue);
     
     SwapChain* swapChain = new SwapChain(
         surface, physicalDevice, device,
@@ -88,7 +174,21 @@ int main() {
     VkDescriptorSetLayout snowDescriptorSetLayout = inst.createSnowDescriptorSetLayout(device);
     VkDescriptorSetLayout litDescriptorSetLayout = inst.createLitDescriptorSetLayout(device);
     VkDescriptorSetLayout lightingDescriptorSetLayout = inst.createLightingDescriptorSetLayout(device);
-    scene->setDescriptorSetLayout(descriptorSetLayout);
+    // Bindless: globale Sets pro Frame für alle Mesh-Pipelines (normale, deferred, lit),
+    // Set 0 die UBOs, Set 1 das Textur-Array
+    uint32_t bindlessCapacity = 0;
+    VkDescriptorSetLayout bindlessDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout bindlessTextureSetLayout = VK_NULL_HANDLE;
+    if (bindless) {
+        bindlessCapacity = inst.bindlessTextureCapacity(physicalDevice);
+        bindlessDescriptorSetLayout = inst.createBindlessDescriptorSetLayout(device);
+        bindlessTextureSetLayout = inst.createBindlessTextureSetLayout(device, bindlessCapacity);
+        std::cout << "Bindless-Texturen: Array mit " << bindlessCapacity << " Einträgen" << std::endl;
+    }
+    VkDescriptorSetLayout meshDescriptorSetLayout = bindless ? bindlessDescriptorSetLayout : descriptorSetLayout;
+    VkDescriptorSetLayout litMeshDescriptorSetLayout = bindless ? bindlessDescriptorSetLayout : litDescriptorSetLayout;
+    scene->setDescriptorSetLayout(meshDescriptorSetLayout);
+    scene->setBindless(bindless, bindlessTextureSetLayout);
 
     // Schneeflocken-Simulation erstellen
     Snow* snow = new Snow(physicalDevice, device, graphicsIndex);
@@ -97,7 +197,18 @@ int main() {
 
     ObjectFactory factory(physicalDevice, device, commandPool, graphicsQueue,
                          swapChain->getImageFormat(), depthBuffer->getImageFormat(),
-                         descriptorSetLayout, litDescriptorSetLayout);
+                         meshDescriptorSetLayout, litMeshDescriptorSetLayout, uploadManager);
+    if (bindless) {
+        factory.enableBindless(bindlessTextureSetLayout);
+    }
+    if (textureStreaming) {
+        factory.getTextureManager().enableStreaming(textureBudget);
+    }
+    // Lange nicht sichtbare Meshes/Texturen über dem VRAM-Budget auslagern
+    ResidencyManager residency(physicalDevice, factory, memoryBudget, vramBudget);
+
+    // Alle Assets zuerst anstoßen: OBJ/Cache und Bilder werden parallel im ThreadPool
+    // geladen, die GPU-Uploads passieren erst bei get() hier auf dem Hauptthread
 
     // Skybox
     std::array<const char*, 6> skyboxFaces = {
@@ -108,122 +219,102 @@ int main() {
         "textures/skybox/front.jpg",
         "textures/skybox/back.jpg"
     };
-    RenderObject skybox = factory.createSkybox(renderPass, skyboxFaces);
-    scene->setRenderObject(skybox);
+    auto skyboxHandle = factory.createSkyboxAsync(renderPass, skyboxFaces);
 
     // Licht 1 (Beim Zwerg)
-    LightSourceObject light1 = factory.createLightSource(
+    auto light1Handle = factory.createLightSourceAsync(
         glm::vec3(-2.3f, 3.0f, 0.2f),
         glm::vec3(1.0f, 0.5f, 0.5f),
         5.0f,
         10.0f,
         renderPass
     );
-    scene->addLightSource(light1);
-    scene->setRenderObject(light1.renderObject);
 
     // Licht 2 (Bei der Lampe)
     //glm::vec3(-8.2f, 12.2f, -6.5f)
-    LightSourceObject light2 = factory.createLightSource(
+    auto light2Handle = factory.createLightSourceAsync(
         glm::vec3(-8.0f, 12.2f, -6.0f),
         glm::vec3(0.0f, 0.1f, 0.7f),
         5.0f,
         300.0f,
         renderPass
     );
-    scene->addLightSource(light2);
-    scene->setRenderObject(light2.renderObject);
 
     //Fliege, die die Kamera darstellt
     glm::mat4 modelCamera = glm::mat4(1.0f);
-    RenderObject cam = factory.createGenericObject(
+    auto camHandle = factory.createGenericObjectAsync(
         "./models/fly.obj",
         "shaders/test.vert.spv",
         "shaders/testapp.frag.spv",
         "textures/black.png",
-        modelCamera, renderPass,PipelineType::STANDARD, static_cast<uint32_t>(SubpassIndex::LIGHTING));
-        scene->setRenderObject(cam);
-        size_t camIndex = scene->getObjectCount()-1;
-    
+        renderPass,PipelineType::STANDARD, static_cast<uint32_t>(SubpassIndex::LIGHTING));
 
     //Monobloc Gartenstuhl
     glm::mat4 modelChair = glm::mat4(1.0f);
     modelChair = glm::translate(modelChair, glm::vec3(-2.0f, 0.92f, 0.0f));
     modelChair = glm::scale(modelChair, glm::vec3(3.0f, 3.0f, 3.0f));
-    DeferredRenderObject chair = factory.createDeferredObject(
+    auto chairHandle = factory.createDeferredObjectAsync(
         "./models/plastic_monobloc_chair.obj",
         "textures/plastic_monobloc_chair.jpg",
-        modelChair, renderPass);
-    scene->setDeferredRenderObject(chair);
-    size_t chairIndex = scene->getObjectCount() - 1;
+        renderPass);
 
     // //Fliegender Holländer
     glm::mat4 modelDutch = glm::mat4(1.0f);
-    RenderObject dutch = factory.createGenericObject(
+    auto dutchHandle = factory.createGenericObjectAsync(
         "./models/flying_dutchman.obj",
         "shaders/test.vert.spv",
         "shaders/testapp.frag.spv",
         "textures/duck.jpg",
-        modelDutch, renderPass, PipelineType::STANDARD, static_cast<uint32_t>(SubpassIndex::LIGHTING));
-    scene->setRenderObject(dutch);
-    size_t dutchIndex = scene->getObjectCount() - 1;
+        renderPass, PipelineType::STANDARD, static_cast<uint32_t>(SubpassIndex::LIGHTING));
 
     //Gartenzwerg
     glm::mat4 modelGnome = glm::mat4(1.0f);
     modelGnome = glm::translate(modelGnome, glm::vec3(-2.0f, 2.25f, 0.0f));
     modelGnome = glm::scale(modelGnome, glm::vec3(3.0f, 3.0f, 3.0f));
-    DeferredRenderObject gnome = factory.createDeferredObject(
+    auto gnomeHandle = factory.createDeferredObjectAsync(
         "./models/garden_gnome.obj",
         "textures/garden_gnome.jpg",
-        modelGnome, renderPass);
-    scene->setDeferredRenderObject(gnome);
-    size_t gnomeIndex = scene->getObjectCount() - 1;
+        renderPass, VertexFormat::COMPACT_QUANTIZED);
 
     // Sonnenschirm
     glm::mat4 modelUmbrella = glm::mat4(1.0f);
     modelUmbrella = glm::translate(modelUmbrella, glm::vec3(-1.0f, 0.3f, 0.0f));
     modelUmbrella = glm::scale(modelUmbrella, glm::vec3(0.04f, 0.04f, 0.04f));
     modelUmbrella = glm::rotate(modelUmbrella, glm::radians(-100.0f), glm::vec3(1.0f,0.0f,0.0f));
-    RenderObject umbrella = factory.createGenericObject("./models/sonnenschirm.obj", "shaders/test.vert.spv", "shaders/testapp.frag.spv",
-        "textures/sonnenschirm.jpg", modelUmbrella, renderPass,PipelineType::STANDARD,static_cast<uint32_t>(SubpassIndex::LIGHTING));
-    scene->setRenderObject(umbrella);
-    size_t umbrellaIndex = scene->getObjectCount() - 1;
+    auto umbrellaHandle = factory.createGenericObjectAsync("./models/sonnenschirm.obj", "shaders/test.vert.spv", "shaders/testapp.frag.spv",
+        "textures/sonnenschirm.jpg", renderPass,PipelineType::STANDARD,static_cast<uint32_t>(SubpassIndex::LIGHTING),
+        VertexFormat::COMPACT_QUANTIZED);
 
     // Lampe
     glm::mat4 modelLamp = glm::mat4(1.0f);
     modelLamp = glm::translate(modelLamp, glm::vec3(-10.0f, 0.0f, -10.0f));
     modelLamp = glm::scale(modelLamp, glm::vec3(20.0f, 20.0f, 20.0f));
     modelLamp = glm::rotate(modelLamp, glm::radians(90.0f), glm::vec3(0.0f,1.0f,0.0f));
-    DeferredRenderObject lamp = factory.createDeferredObject("./models/desk_lamp.obj",
-        "textures/desk_lamp.jpg", modelLamp, renderPass);
-    scene->setDeferredRenderObject(lamp);
-    
+    auto lampHandle = factory.createDeferredObjectAsync("./models/desk_lamp.obj",
+        "textures/desk_lamp.jpg", renderPass, VertexFormat::COMPACT_QUANTIZED);
 
     // Boden
     glm::mat4 modelGround = glm::mat4(1.0f);
     modelGround = glm::scale(modelGround, glm::vec3(20.0f, 10.0f, 20.0f));
-    RenderObject ground = factory.createGenericObject("./models/wooden_bowl.obj",
+    auto groundHandle = factory.createGenericObjectAsync("./models/wooden_bowl.obj",
         "shaders/test.vert.spv",
         "shaders/testapp.frag.spv",
-        "textures/wooden_bowl.jpg", modelGround, renderPass,PipelineType::STANDARD,static_cast<uint32_t>(SubpassIndex::LIGHTING));
-    scene->setRenderObject(ground); 
+        "textures/wooden_bowl.jpg", renderPass,PipelineType::STANDARD,static_cast<uint32_t>(SubpassIndex::LIGHTING),
+        VertexFormat::COMPACT);
 
     //Tisch unter der reflektierenden Kugel
     glm::mat4 modelTable = glm::mat4(1.0f);
     modelTable = glm::translate(modelTable, glm::vec3(5.0f, 1.0f,0.0f));
     modelTable= glm::scale(modelTable, glm::vec3(2.0f,2.0f,2.0f));
-    RenderObject table = factory.createGenericObject("./models/table.obj",
+    auto tableHandle = factory.createGenericObjectAsync("./models/table.obj",
         "shaders/test.vert.spv",
         "shaders/testapp.frag.spv",
-        "textures/table.jpg", modelTable, renderPass,PipelineType::STANDARD,static_cast<uint32_t>(SubpassIndex::LIGHTING));
-
-    scene->setRenderObject(table);
+        "textures/table.jpg", renderPass,PipelineType::STANDARD,static_cast<uint32_t>(SubpassIndex::LIGHTING));
     
     // Reflektierende (magische) Kugel
     ReflectionProbe* reflectionProbe = new ReflectionProbe(
         device,
         physicalDevice,
-        commandPool,
         glm::vec3(5.0f, 2.5f, 0.0f),
         1024  // Auflösung
     );
@@ -231,24 +322,39 @@ int main() {
     modelReflective = glm::translate(modelReflective, glm::vec3(5.0f, 2.5f, 0.0f));
     modelReflective = glm::scale(modelReflective, glm::vec3(0.25f, 0.25f, 0.25f));
     
-    RenderObject reflectiveSphere = factory.createReflectiveObject(
+    auto reflectiveHandle = factory.createReflectiveObjectAsync(
         "./models/sphere.obj",
         reflectionProbe,
-        modelReflective,
         renderPass
     );
-    scene->setRenderObject(reflectiveSphere);
-    size_t reflectiveIndex = scene->getObjectCount() - 1;
-    scene->markObjectAsReflective(reflectiveIndex);
-    scene->setReflectionUpdateInterval(3);
 
     // Schneeflocken zuletzt hinzufügen
-    RenderObject snowflakes = factory.createSnowflake(
+    auto snowHandle = factory.createSnowflakeAsync(
         "textures/snowflake.png",
         renderPass,
         snow->getCurrentBuffer(),
         snowDescriptorSetLayout);
-    scene->setRenderObject(snowflakes);
+
+    // Skybox sofort (ist ab dem ersten Frame zu sehen), alles andere bekommt einen
+    // Platzhalter in fester Reihenfolge (die Indizes in der Scene hängen davon ab)
+    RenderObject skybox = skyboxHandle.get();
+    scene->setRenderObject(skybox);
+
+    SceneLoader sceneLoader(&factory, scene);
+    sceneLoader.addLightSource(light1Handle);
+    sceneLoader.addLightSource(light2Handle);
+    size_t camIndex = sceneLoader.addObject(camHandle, modelCamera);
+    size_t chairIndex = sceneLoader.addDeferredObject(chairHandle, modelChair);
+    size_t dutchIndex = sceneLoader.addObject(dutchHandle, modelDutch);
+    size_t gnomeIndex = sceneLoader.addDeferredObject(gnomeHandle, modelGnome);
+    size_t umbrellaIndex = sceneLoader.addObject(umbrellaHandle, modelUmbrella);
+    sceneLoader.addDeferredObject(lampHandle, modelLamp);
+    sceneLoader.addObject(groundHandle, modelGround);
+    sceneLoader.addObject(tableHandle, modelTable);
+    size_t reflectiveIndex = sceneLoader.addObject(reflectiveHandle, modelReflective);
+    scene->markObjectAsReflective(reflectiveIndex);
+    scene->setReflectionUpdateInterval(3);
+    sceneLoader.addObject(snowHandle, glm::mat4(1.0f), ObjectKind::Snow);
 
     //####### Spiegel System Setup ##############
     
@@ -277,8 +383,14 @@ int main() {
     scene->markObjectAsReflectable(umbrellaIndex);
     scene->markObjectAsReflectable(camIndex);
     
-    // Reflexionen erstellen
+    // Reflexionen erstellen (für noch ladende Objekte erst, wenn sie fertig sind)
     mirrorSystem->createReflections(scene);
+    sceneLoader.setReadyCallback([scene, mirrorSystem](size_t index) {
+        mirrorSystem->onObjectReady(scene, index);
+    });
+    if (blockingLoad) {
+        sceneLoader.finish();
+    }
 
     // Lighting Quad für deferred Shading
     std::cout << "Creating lighting quad..." << std::endl;
@@ -289,33 +401,31 @@ int main() {
     scene->setLightingQuad(lightingQuad);
     std::cout << "Lighting quad created successfully!" << std::endl;
 
+    if (blockingLoad) {
+        // Ladezeiten Mesh-Cache vs. OBJ-Parser für alle Modelle (lädt alles nochmal,
+        // beim progressiven Laden deshalb weggelassen)
+        MeshCache::printStartupReport("models");
+        factory.getMeshRegistry().printStats();
+        factory.getTextureManager().printStats();
+        uploadManager->printStats();
+        memoryAllocator->printStats();
+    }
 
-    
-    // Zähle Forward Objects nach Typ
-    size_t normalForwardCount = 0;
-    size_t snowCount = 0;
-    size_t litCount = 0;
 
-    for (size_t i = 0; i < scene->getObjectCount(); i++) {
-        const auto& obj = scene->getObject(i);
-        if (obj.isDeferred) continue;  // Deferred werden separat gezählt
-        if (obj.isSnow) {
-            snowCount++;
-        } else if (obj.isLit) {
-            litCount++;
-        } else {
-            normalForwardCount++;
-        }
-    }
+    
+    // Forward Objects nach Typ, direkt aus der Slot-Tabelle der Szene
+    size_t normalForwardCount = scene->getNormalDescriptorSetCount();
+    size_t snowCount = scene->getSnowObjectCount();
+    size_t litCount = scene->getLitDescriptorSetCount();
 
     //Descriptor Sets & -Pool
 
-    //normale Descriptor Sets:
-    size_t normalDescriptorSets = (scene->getDeferredObjectCount() * 2) + normalForwardCount;
+    //normale Descriptor Sets (Bindless: keine, alles im globalen Set):
+    size_t normalDescriptorSets = bindless ? 0 : (scene->getDeferredObjectCount() * 2) + normalForwardCount;
     //snow Descriptor Sets
     size_t snowDescriptorSets = snowCount;
     // Lit Descriptor Sets
-    size_t litDescriptorSets = litCount;
+    size_t litDescriptorSets = bindless ? 0 : litCount;
     //Lighting Descriptor Sets
     size_t lightingDescriptorSets = scene->hasLightingQuad() ? 1 : 0;
 
@@ -324,17 +434,19 @@ int main() {
     uint32_t maxSnowSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * snowDescriptorSets);
     uint32_t maxLitSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * litDescriptorSets);
     uint32_t maxLightingSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT * lightingDescriptorSets);
+    // Bindless: zwei Sets pro Frame (2 UBOs, Textur-Array), unabhängig von der Objektanzahl
+    uint32_t maxBindlessSets = bindless ? MAX_FRAMES_IN_FLIGHT : 0;
 
     // Descriptor pool
     std::array<VkDescriptorPoolSize, 4> poolSizes{};
 
-    // UBOs: Normal + Snow + Lit + Lighting 
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = maxNormalSets + maxSnowSets + maxLitSets+ maxLightingSets;
+    // UBOs (dynamisch, aus dem UniformAllocator des Frames): Normal + Snow + Lit + Lighting + Bindless
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = maxNormalSets + maxSnowSets + maxLitSets+ maxLightingSets + maxBindlessSets * 2;
 
-    // Samplers: Normal + Snow + Lit
+    // Samplers: Normal + Snow + Lit + Bindless
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = maxNormalSets + maxSnowSets + maxLitSets;
+    poolSizes[1].descriptorCount = maxNormalSets + maxSnowSets + maxLitSets + maxBindlessSets * bindlessCapacity;
 
     // Storage Buffers: Nur Snow
     poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
@@ -348,13 +460,19 @@ int main() {
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = maxNormalSets + maxSnowSets + maxLitSets + maxLightingSets;
+    poolInfo.maxSets = maxNormalSets + maxSnowSets + maxLitSets + maxLightingSets + maxBindlessSets * 2;
+    if (bindless) {
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    }
     //Descriptor Pool
     VkDescriptorPool descriptorPool;
     if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("failed to create descriptor pool in main");
     }
 
+    // Cluster-Culling für große Meshes (eigene Ressourcen pro Frame in Flight)
+    MeshletCuller* meshletCuller = new MeshletCuller(physicalDevice, device, MAX_FRAMES_IN_FLIGHT);
+
     // Frames in flight
     std::vector<Frame*> framesInFlight(MAX_FRAMES_IN_FLIGHT);
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
@@ -362,10 +480,17 @@ int main() {
         
         framesInFlight[i] = new Frame(physicalDevice, device, swapChain, framebuffers,
                                     graphicsQueue, commandPool);
+        framesInFlight[i]->setMeshletCuller(meshletCuller, static_cast<uint32_t>(i));
         
         // Normale Descriptor Sets
-        std::cout << "Allocating " << normalDescriptorSets << " normal descriptor sets..." << std::endl;
-        framesInFlight[i]->allocateDescriptorSets(descriptorPool, descriptorSetLayout, normalDescriptorSets);
+        if (bindless) {
+            std::cout << "Allocating bindless descriptor set..." << std::endl;
+            framesInFlight[i]->allocateBindlessDescriptorSet(descriptorPool, bindlessDescriptorSetLayout,
+                                                             bindlessTextureSetLayout, bindlessCapacity);
+        } else {
+            std::cout << "Allocating " << normalDescriptorSets << " normal descriptor sets..." << std::endl;
+            framesInFlight[i]->allocateDescriptorSets(descriptorPool, descriptorSetLayout, normalDescriptorSets);
+        }
         
         // Snow Descriptor Sets
         if (snowDescriptorSets > 0) {
@@ -395,10 +520,55 @@ int main() {
     float lastTime = static_cast<float>(glfwGetTime());
     float dutchAngle = 0.0f;
     uint32_t currentFrame = 0;
+    float lastLodReport = lastTime;
+    bool firstFrame = true;
+    bool sceneLoaded = sceneLoader.isDone();
+    bool memoryKeyDown = false;
+    bool swapChainOutdated = false;
     
     while (!window->shouldClose()) {
         window->pollEvents();
 
+        // Veraltete Swapchain vor Compute und Render neu anlegen. Minimiert (0x0) lässt sich
+        // keine anlegen, dann blockieren bis zum nächsten Event statt leer durchzulaufen
+        if (swapChainOutdated || window->wasResized()) {
+            VkExtent2D windowExtent = window->getExtent();
+            while ((windowExtent.width == 0 || windowExtent.height == 0) && !window->shouldClose()) {
+                window->waitEvents();
+                windowExtent = window->getExtent();
+            }
+            if (window->shouldClose()) {
+                break;
+            }
+            swapChainOutdated = false;
+            // ohne vkDeviceWaitIdle: die alten Ressourcen leben weiter, bis jeder Frame
+            // in beginFrame auf seinen letzten Submit gewartet hat
+            auto retired = std::make_shared<DeletionQueue>();
+            swapChain->recreate(*retired);
+            depthBuffer->recreate(swapChain->getExtent(), *retired);
+            framebuffers->recreate(*retired);
+            for (Frame* frame : framesInFlight) {
+                frame->retire(retired);
+            }
+            // die Wartezeit nicht als einen riesigen Frame in die Animation übernehmen
+            lastTime = static_cast<float>(glfwGetTime());
+        }
+
+        // Fertig geladene Objekte übernehmen (vor den Updates, damit sie gleich richtig stehen)
+        if (!sceneLoaded) {
+            sceneLoader.poll();
+            if (sceneLoader.isDone()) {
+                sceneLoaded = true;
+                std::cout << "Szene vollständig geladen nach " << millisSinceStart() << " ms" << std::endl;
+                factory.getMeshRegistry().printStats();
+                factory.getTextureManager().printStats();
+                uploadManager->printStats();
+                residency.printStats();
+                memoryAllocator->printStats();
+                MemoryReport::print();
+            }
+        }
+
         float currentTime = static_cast<float>(glfwGetTime());
         float deltaTime = currentTime - lastTime;
         lastTime = currentTime;
@@ -427,8 +597,14 @@ int main() {
             window->setInputMode(GLFW_CURSOR, GLFW_CURSOR_NORMAL);
             firstMouse = true;
         }
-        scene->updateObject(camIndex,modelCamera);
-        mirrorSystem->updateReflections(scene, camIndex);
+        // M: Speicher nach Kategorie ausgeben (nur beim Drücken, nicht jeden Frame)
+        bool memoryKey = window->getKey(GLFW_KEY_M) == GLFW_PRESS;
+        if (memoryKey && !memoryKeyDown) {
+            memoryAllocator->printStats();
+            MemoryReport::print();
+            MemoryReport::writeJson("memory_report.json");
+        }
+        memoryKeyDown = memoryKey;
 
         //Schiff animation
         dutchAngle += deltaTime * glm::radians(5.0f);
@@ -439,13 +615,18 @@ int main() {
         modelDutch = glm::translate(modelDutch, glm::vec3(circleX, -10.0f, circleY));
         modelDutch = glm::rotate(modelDutch, -1.75f - dutchAngle, glm::vec3(0.0f, 1.0f, 0.0f));
         modelDutch = glm::scale(modelDutch, glm::vec3(2.0f, 2.0f, 2.0f));
-        scene->updateObject(dutchIndex, modelDutch);
 
         //Kugel schwebt über Tisch
         modelReflective = glm::mat4(1.0f);
         modelReflective = glm::translate(modelReflective, glm::vec3(5.0f, 2.5+ 0.25*sin(currentTime), 0.0f));
         modelReflective = glm::scale(modelReflective, glm::vec3(0.25f, 0.25f, 0.25f));
-        scene->updateObject(reflectiveIndex, modelReflective);
+
+        // Alle Transformationen des Frames gesammelt in die Szene, danach einmal die Bounds
+        const size_t animatedIndices[] = { camIndex, dutchIndex, reflectiveIndex };
+        const glm::mat4 animatedModels[] = { modelCamera, modelDutch, modelReflective };
+        scene->updateObjects(animatedIndices, animatedModels, 3);
+        scene->flushTransforms();
+        mirrorSystem->updateReflections(scene, camIndex);
 
 
         // Compute Shader für Schnee ausführen
@@ -459,7 +640,22 @@ int main() {
         if (vkQueueSubmit(graphicsQueue, 1, &computeSubmit, snow->getComputeFence()) != VK_SUCCESS) {
             throw std::runtime_error("failed to submit compute command buffer");
         }
-        //UBOs & DescriptorSets updaten
+        // Über dem VRAM-Budget auslagern, wieder sichtbare Meshes nachladen (vor dem Streaming,
+        // das die verkleinerten Texturen in die Szene einträgt)
+        glm::mat4 residencyProj = glm::perspective(glm::radians(camera->getZoom()),
+                                                   swapChain->getExtent().width / static_cast<float>(swapChain->getExtent().height),
+                                                   0.1f, 100.0f);
+        residencyProj[1][1] *= -1.0f;
+        residency.update(*scene, residencyProj * camera->getViewMatrix(), reflectionProbe);
+
+        // Mip-Levels der Texturen nach Bildschirmgröße nachladen/verdrängen (vor den Descriptor Sets)
+        float pixelsPerUnit = swapChain->getExtent().height * 0.5f
+                            / std::tan(glm::radians(camera->getZoom()) * 0.5f);
+        factory.getTextureManager().updateStreaming(*scene, camera->getPosition(), pixelsPerUnit);
+
+        //UBOs & DescriptorSets updaten, vorher muss die GPU mit dem letzten Submit
+        //dieses Frames fertig sein (UBO-Stücke werden neu vergeben)
+        framesInFlight[currentFrame]->beginFrame();
         framesInFlight[currentFrame]->updateUniformBuffer(camera);
         framesInFlight[currentFrame]->updateLitUniformBuffer(camera, scene);
         framesInFlight[currentFrame]->updateLightingUniformBuffer(camera,scene);
@@ -469,19 +665,17 @@ int main() {
         }
                 
         // Update snow descriptor sets
-        size_t snowIdx = 0;
-        for (size_t i = 0; i < scene->getObjectCount(); i++) {
-            if (scene->isSnowObject(i)) {
-                const auto& obj = scene->getObject(i);
+        scene->getSnowObjects().forEach([&](size_t i) {
+            if (!scene->isPending(i)) {
+                const DrawItem& draw = scene->getDraw(i);
                 framesInFlight[currentFrame]->updateSnowDescriptorSet(
-                    snowIdx,
+                    scene->getDescriptorSetIndex(i),
                     snow->getCurrentBuffer(),
-                    obj.textureImageView,
-                    obj.textureSampler
+                    draw.textureImageView,
+                    draw.textureSampler
                 );
-                snowIdx++;
             }
-        }
+        });
         if (scene->hasLightingQuad()) {
             framesInFlight[currentFrame]->updateLightingDescriptorSet(
                 framebuffers->getGBufferNormalView(),
@@ -492,11 +686,30 @@ int main() {
 
         // Render
         bool recreate = framesInFlight[currentFrame]->render(scene,reflectionProbe);
+        if (firstFrame) {
+            std::cout << "Erster Frame nach " << millisSinceStart() << " ms ("
+                      << sceneLoader.getPendingCount() << " Objekte laden noch)" << std::endl;
+            firstFrame = false;
+        }
+
+        // LOD-Statistik einmal pro Sekunde
+        if (currentTime - lastLodReport >= 1.0f) {
+            const LodStats& lodStats = framesInFlight[currentFrame]->getLodStats();
+            uint64_t fullTriangles = lodStats.trianglesDrawn + lodStats.trianglesSaved;
+            std::cout << "LOD: " << lodStats.trianglesDrawn << " Dreiecke gezeichnet, "
+                      << lodStats.trianglesSaved << " gespart ("
+                      << (fullTriangles > 0 ? 100 * lodStats.trianglesSaved / fullTriangles : 0)
+                      << "%)" << std::endl;
+            const MeshletStats& meshletStats = meshletCuller->getStats();
+            if (meshletStats.meshletsTotal > 0) {
+                std::cout << "Meshlets: " << meshletStats.meshletsVisible << "/" << meshletStats.meshletsTotal
+                          << " sichtbar, " << meshletStats.trianglesVisible << "/" << meshletStats.trianglesTotal
+                          << " Dreiecke" << std::endl;
+            }
+            lastLodReport = currentTime;
+        }
         if (recreate || window->wasResized()) {
-            vkDeviceWaitIdle(device);
-            swapChain->recreate();
-            depthBuffer->recreate(swapChain->getExtent());
-            framebuffers->recreate();
+            swapChainOutdated = true;
         }
         currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
     }
@@ -504,31 +717,30 @@ int main() {
     // ###### Cleanup in main ###########
     vkDeviceWaitIdle(device);
 
+    // Speicher nach Kategorie, solange noch alles lebt
+    MemoryReport::print();
+    if (MemoryReport::writeJson("memory_report.json")) {
+        std::cout << "Speicherbericht nach memory_report.json geschrieben" << std::endl;
+    }
+
     // 1. Frames zerstören
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        const UniformAllocator& uniforms = framesInFlight[i]->getUniformAllocator();
+        std::cout << "Frame " << i << ": UniformAllocator höchstens " << uniforms.getPeak()
+                  << " von " << uniforms.getCapacity() << " Bytes belegt" << std::endl;
         delete framesInFlight[i];
     }
 
     // 2. Sammle unique Ressourcen
     std::set<GraphicsPipeline*> uniquePipelines;
-    std::set<Texture*> uniqueTextures;
-    std::map<VkBuffer, VkDeviceMemory> uniqueVertexBuffers;  // Buffer + Memory
 
     // Normale Objekte
     for (size_t i = 0; i < scene->getObjectCount(); i++) {
         const RenderObject& obj = scene->getObject(i);
         
-        if (obj.texture) {
-            uniqueTextures.insert(obj.texture);
-        }
-        
         if (obj.pipeline) {
             uniquePipelines.insert(obj.pipeline);
         }
-        
-        if (obj.vertexBuffer != VK_NULL_HANDLE) {
-            uniqueVertexBuffers[obj.vertexBuffer] = obj.vertexBufferMemory;
-        }
     }
     if(reflectionProbe){
         delete reflectionProbe;
@@ -538,34 +750,28 @@ int main() {
     for (size_t i = 0; i < scene->getReflectedObjectCount(); i++) {
         const RenderObject& obj = scene->getReflectedObject(i);
         
-        if (obj.texture) {
-            uniqueTextures.insert(obj.texture);
-        }
-        
         if (obj.pipeline) {
             uniquePipelines.insert(obj.pipeline);
         }
-        
-        if (obj.vertexBuffer != VK_NULL_HANDLE) {
-            uniqueVertexBuffers[obj.vertexBuffer] = obj.vertexBufferMemory;
-        }
     }
 
-    //Vertex-Buffer & memory zerstören
-    for (const auto& [buffer, memory] : uniqueVertexBuffers) {
-        vkDestroyBuffer(device, buffer, nullptr);
-        if (memory != VK_NULL_HANDLE) {
-            vkFreeMemory(device, memory, nullptr);
-        }
-    }
+    residency.printStats();
 
-    // Texturen zerstören
-    for (Texture* tex : uniqueTextures) {
-        if (tex) {
-            tex->destroy();
-            delete tex;
-        }
+    //Vertex-/Index-Buffer & memory zerstören (gehören der MeshRegistry)
+    factory.getMeshRegistry().printStats();
+    factory.getMeshRegistry().destroyAll();
+
+    // Texturen + Sampler zerstören (gehören dem TextureManager)
+    factory.getTextureManager().printStats();
+    if (TextureStreamer* streamer = factory.getTextureManager().getStreamer()) {
+        streamer->printResidency();
     }
+    factory.getTextureManager().destroyAll();
+
+    // Staging-Ring, Fences und Command Pools der Uploads
+    uploadManager->printStats();
+    uploadManager->destroy();
+    delete uploadManager;
 
     // Pipelines zerstören
     for (GraphicsPipeline* pipeline : uniquePipelines) {
@@ -582,6 +788,10 @@ int main() {
     snow->destroy();
     delete snow;
 
+    //Meshlet-Culling
+    meshletCuller->destroy();
+    delete meshletCuller;
+
     //Scene
     delete scene;
 
@@ -599,10 +809,17 @@ int main() {
     inst.destroyDescriptorSetLayout(device, descriptorSetLayout);
     inst.destroyDescriptorSetLayout(device, snowDescriptorSetLayout);
     inst.destroyDescriptorSetLayout(device, litDescriptorSetLayout);
+    inst.destroyDescriptorSetLayout(device, bindlessDescriptorSetLayout);
+    inst.destroyDescriptorSetLayout(device, bindlessTextureSetLayout);
 
     // Command Pool
     inst.destroyCommandPool(device, commandPool);
 
+    // Blöcke des Allocators (alle Buffer/Images sind jetzt weg)
+    memoryAllocator->printStats();
+    memoryAllocator->destroy();
+    delete memoryAllocator;
+
     //  Device
     inst.destroyDevice(device);
 
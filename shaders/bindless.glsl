@@ -0,0 +1,15 @@
+// bindless.glsl
+// Globale Descriptor Sets im Bindless-Modus (nur mit -DBINDLESS kompiliert, siehe
+// InitInstance::createBindlessDescriptorSetLayout/createBindlessTextureSetLayout):
+// Set 0 binding 0 UBO, binding 1 LitUBO (dynamisch), Set 1 binding 0 alle Texturen als ein Array.
+// 2D- und Cube-Texturen teilen sich das Array,
+// der Eintrag kommt pro Draw über die Push Constants (MeshPushConstants::textureIndex).
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+layout(set = 1, binding = 0) uniform samplerCube cubeTextures[];
+
+// Liegt hinter dem Block aus vertex_decode.glsl (model, posScale, posOffset)
+layout(push_constant) uniform MaterialPushConstants {
+    layout(offset = 96) uint textureIndex;
+} material;
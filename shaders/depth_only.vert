@@ -1,17 +1,15 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 layout(binding = 0) uniform UniformBufferObject {
     mat4 view;
     mat4 proj;
 } ubo;
 
-layout(push_constant) uniform PushConstants {
-    mat4 model;
-} push;
+#include "vertex_decode.glsl"
 
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec2 inTexCoord;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * push.model * vec4(inPosition, 1.0);
-}
\ No newline at end of file
+    gl_Position = ubo.proj * ubo.view * push.model * vec4(decodePosition(inPosition), 1.0);
+}
@@ -1,7 +1,15 @@
 //gbuffer.frag
 #version 450
+#ifdef BINDLESS
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+#endif
 
+#ifdef BINDLESS
+#define texSampler textures[material.textureIndex]
+#else
 layout(binding = 1) uniform sampler2D texSampler;
+#endif
 
 layout(location = 0) in vec3 fragWorldPos;
 layout(location = 1) in vec3 fragWorldNormal; 
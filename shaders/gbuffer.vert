@@ -1,14 +1,13 @@
 //gbuffer.vert
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 layout(binding = 0) uniform UniformBufferObject {
     mat4 view;
     mat4 proj;
 } ubo;
 
-layout(push_constant) uniform PushConstants {
-    mat4 model;
-} push;
+#include "vertex_decode.glsl"
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal; 
@@ -19,13 +18,13 @@ layout(location = 1) out vec3 fragWorldNormal;
 layout(location = 2) out vec2 fragTexCoord;
 
 void main() {
-    vec4 worldPos = push.model * vec4(inPosition, 1.0);
+    vec4 worldPos = push.model * vec4(decodePosition(inPosition), 1.0);
     fragWorldPos = worldPos.xyz;
     
     // Normale in World Space transformieren
     // Verwende die Inverse-Transpose der Model-Matrix für korrekte Normalen-Transformation
     mat3 normalMatrix = transpose(inverse(mat3(push.model)));
-    fragWorldNormal = normalize(normalMatrix * inNormal);
+    fragWorldNormal = normalize(normalMatrix * decodeNormal(inNormal));
     
     fragTexCoord = inTexCoord;
     
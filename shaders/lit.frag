@@ -1,4 +1,8 @@
 #version 450
+#ifdef BINDLESS
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+#endif
 
 layout(location = 0) in vec3 FragPos;
 layout(location = 1) in vec3 Normal;
@@ -13,7 +17,11 @@ struct PointLight {
     float radius;
 };
 
+#ifdef BINDLESS
+layout(set=0, binding=1) uniform LitUBO {
+#else
 layout(set=0, binding=0) uniform LitUBO {
+#endif
     mat4 view;
     mat4 proj;
     vec3 viewPos;
@@ -21,7 +29,11 @@ layout(set=0, binding=0) uniform LitUBO {
     PointLight lights[4];
 } ubo;
 
+#ifdef BINDLESS
+#define texSampler textures[material.textureIndex]
+#else
 layout(set=0, binding=1) uniform sampler2D texSampler;
+#endif
 
 void main() {
     vec3 texColor = texture(texSampler, TexCoord).rgb;
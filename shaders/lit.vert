@@ -1,26 +1,31 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec2 aTexCoord;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aTexCoord;
 
 layout(location = 0) out vec3 FragPos;
 layout(location = 1) out vec3 Normal;
 layout(location = 2) out vec2 TexCoord;
 
+// Im Bindless-Modus liegt das LitUBO neben dem Kamera-UBO im globalen Set
+#ifdef BINDLESS
+layout(set=0, binding=1) uniform LitUBO {
+#else
 layout(set=0, binding=0) uniform LitUBO {
+#endif
     mat4 view;
     mat4 proj;
     vec3 viewPos;
     int numLights;
 } ubo;
 
-layout(push_constant) uniform PushMod {
-    mat4 model;
-} pushModel;
+#include "vertex_decode.glsl"
 
 void main() {
-    FragPos = vec3(pushModel.model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(pushModel.model))) * normalize(aPos); 
+    FragPos = vec3(push.model * vec4(decodePosition(aPos), 1.0));
+    Normal = mat3(transpose(inverse(push.model))) * decodeNormal(aNormal);
     TexCoord = aTexCoord;
     
     gl_Position = ubo.proj * ubo.view * vec4(FragPos, 1.0);
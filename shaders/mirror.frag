@@ -1,7 +1,15 @@
 //mirror.frag - Fragment Shader für halbtransparenten Spiegel
 #version 450
+#ifdef BINDLESS
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+#endif
 
+#ifdef BINDLESS
+#define tex textures[material.textureIndex]
+#else
 layout(set = 0, binding = 1) uniform sampler2D tex;
+#endif
 
 layout(location = 0) in vec2 texCoord;
 
@@ -1,5 +1,9 @@
 //renderToTexture.frag (Vereinfacht - ohne Licht-Array)
 #version 450
+#ifdef BINDLESS
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+#endif
 
 layout(location = 0) in vec3 fragWorldPos;
 layout(location = 1) in vec3 fragWorldNormal;
@@ -10,7 +14,11 @@ layout(binding = 0) uniform UniformBufferObject {
     vec3 cameraPos;
 } ubo;
 
+#ifdef BINDLESS
+#define cubemapSampler cubeTextures[material.textureIndex]
+#else
 layout(binding = 1) uniform samplerCube cubemapSampler;
+#endif
 
 layout(location = 0) out vec4 outColor;
 
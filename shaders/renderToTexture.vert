@@ -1,5 +1,6 @@
 //renderToTexture.vert
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;     
@@ -11,21 +12,19 @@ layout(binding = 0) uniform UniformBufferObject {
     vec3 cameraPos;
 } ubo;
 
-layout(push_constant) uniform PushConstants {
-    mat4 model;
-} push;
+#include "vertex_decode.glsl"
 
 layout(location = 0) out vec3 fragWorldPos;
 layout(location = 1) out vec3 fragWorldNormal; 
 
 void main() {
     // World Position
-    vec4 worldPos = push.model * vec4(inPosition, 1.0);
+    vec4 worldPos = push.model * vec4(decodePosition(inPosition), 1.0);
     fragWorldPos = worldPos.xyz;
     
     // Normale korrekt in World Space transformieren
     mat3 normalMatrix = transpose(inverse(mat3(push.model)));
-    fragWorldNormal = normalize(normalMatrix * inNormal);
+    fragWorldNormal = normalize(normalMatrix * decodeNormal(inNormal));
     
     gl_Position = ubo.proj * ubo.view * worldPos;
 }
\ No newline at end of file
@@ -1,6 +1,14 @@
 #version 450
+#ifdef BINDLESS
+#extension GL_GOOGLE_include_directive : require
+#include "bindless.glsl"
+#endif
 
+#ifdef BINDLESS
+#define skybox cubeTextures[material.textureIndex]
+#else
 layout(set=0, binding = 1) uniform samplerCube skybox;
+#endif
 
 layout(location = 0) in vec3 texCoord;
 
@@ -18,7 +18,7 @@ layout(set = 0, binding = 1) readonly buffer particles {
 };
 
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec2 inTexCoord;
+layout(location = 2) in vec2 inTexCoord;
 
 layout(location = 0) out vec2 texCoord;
 
@@ -1,22 +1,21 @@
 //Shader, um zu schauen, ob objekte wirklich verschiedene Shader haben können
 #version 450
+#extension GL_GOOGLE_include_directive : require
 
 layout(set=0, binding = 0) uniform UniformBufferObject {
     mat4 view;
     mat4 proj;
 } ubo;
-layout(push_constant) uniform PushModel {
-    mat4 model;
-} pushModel;
+#include "vertex_decode.glsl"
 
 mat4 model = mat4(1.0f);
 
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec2 inTexCoord;
+layout(location = 2) in vec2 inTexCoord;
 
 layout(location = 0) out vec2 texCoord;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * pushModel.model * vec4(inPosition, 1.0);
+    gl_Position = ubo.proj * ubo.view * push.model * vec4(decodePosition(inPosition), 1.0);
     texCoord = inTexCoord;
 }
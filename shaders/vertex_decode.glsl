@@ -0,0 +1,29 @@
+// vertex_decode.glsl
+// Gemeinsame Push Constants + Dekodierung der Vertex-Formate (siehe VertexFormat
+// in GraphicsPipeline.hpp). Bei FULL ist posScale = (1,1,1,0) und posOffset = 0,
+// die Funktionen geben die Werte dann unverändert zurück.
+
+layout(push_constant) uniform PushConstants {
+    mat4 model;
+    vec4 posScale;      // xyz: Skalierung, w = 1 -> Normale ist oktaeder-kodiert
+    vec4 posOffset;     // xyz: Verschiebung (Mittelpunkt der AABB)
+    // Offset 96: textureIndex, nur im Fragment Shader (bindless.glsl)
+} push;
+
+// Quantisierte Position (snorm16) zurück in Modell-Koordinaten
+vec3 decodePosition(vec3 position) {
+    return position * push.posScale.xyz + push.posOffset.xyz;
+}
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+// Bei kompakten Formaten kommen nur 2 Komponenten an (z wird mit 0 aufgefüllt)
+vec3 decodeNormal(vec3 normal) {
+    return push.posScale.w > 0.5 ? octDecode(normal.xy) : normal;
+}